@@ -757,6 +757,7 @@ class MixxxCore(Feature):
                    "src/control/controlproxy.cpp",
                    "src/control/controlpushbutton.cpp",
                    "src/control/controlttrotary.cpp",
+                   "src/control/controlupdatecoalescer.cpp",
                    "src/control/controlencoder.cpp",
 
                    "src/controllers/dlgcontrollerlearning.cpp",
@@ -871,6 +872,7 @@ class MixxxCore(Feature):
                    "src/engine/enginexfader.cpp",
                    "src/engine/channelmixer_autogen.cpp",
                    "src/engine/positionscratchcontroller.cpp",
+                   "src/engine/scratchtickqueue.cpp",
                    "src/engine/controls/bpmcontrol.cpp",
                    "src/engine/controls/clockcontrol.cpp",
                    "src/engine/controls/cuecontrol.cpp",
@@ -904,9 +906,11 @@ class MixxxCore(Feature):
                    "src/controllers/controllerenumerator.cpp",
                    "src/controllers/controllerlearningeventfilter.cpp",
                    "src/controllers/controllermanager.cpp",
+                   "src/controllers/controlleroutputscheduler.cpp",
                    "src/controllers/controllerpresetfilehandler.cpp",
                    "src/controllers/controllerpresetinfo.cpp",
                    "src/controllers/controllerpresetinfoenumerator.cpp",
+                   "src/controllers/controllerreader.cpp",
                    "src/controllers/controlpickermenu.cpp",
                    "src/controllers/controllermappingtablemodel.cpp",
                    "src/controllers/controllerinputmappingtablemodel.cpp",
@@ -1030,6 +1034,7 @@ class MixxxCore(Feature):
                    "src/library/proxytrackmodel.cpp",
                    "src/library/coverart.cpp",
                    "src/library/coverartcache.cpp",
+                   "src/library/coverartthumbnailcache.cpp",
                    "src/library/coverartutils.cpp",
 
                    "src/library/crate/cratestorage.cpp",
@@ -1132,7 +1137,9 @@ class MixxxCore(Feature):
 
                    "src/waveform/sharedglcontext.cpp",
                    "src/waveform/waveform.cpp",
+                   "src/waveform/waveformblockfile.cpp",
                    "src/waveform/waveformfactory.cpp",
+                   "src/waveform/waveformprefetcher.cpp",
                    "src/waveform/waveformwidgetfactory.cpp",
                    "src/waveform/vsyncthread.cpp",
                    "src/waveform/guitick.cpp",
@@ -1150,6 +1157,8 @@ class MixxxCore(Feature):
                    "src/waveform/renderers/waveformrendererfilteredsignal.cpp",
                    "src/waveform/renderers/waveformrendererhsv.cpp",
                    "src/waveform/renderers/waveformrendererrgb.cpp",
+                   "src/waveform/renderers/waveformrendererrgbscanline.cpp",
+                   "src/waveform/renderers/waveformscanlinerasterizer.cpp",
                    "src/waveform/renderers/qtwaveformrendererfilteredsignal.cpp",
                    "src/waveform/renderers/qtwaveformrenderersimplesignal.cpp",
                    "src/waveform/renderers/qtvsynctestrenderer.cpp",
@@ -1172,6 +1181,7 @@ class MixxxCore(Feature):
                    "src/waveform/widgets/softwarewaveformwidget.cpp",
                    "src/waveform/widgets/hsvwaveformwidget.cpp",
                    "src/waveform/widgets/rgbwaveformwidget.cpp",
+                   "src/waveform/widgets/scanlinergbwaveformwidget.cpp",
                    "src/waveform/widgets/qthsvwaveformwidget.cpp",
                    "src/waveform/widgets/qtrgbwaveformwidget.cpp",
                    "src/waveform/widgets/qtwaveformwidget.cpp",
@@ -1192,6 +1202,7 @@ class MixxxCore(Feature):
                    "src/skin/legacyskinparser.cpp",
                    "src/skin/colorschemeparser.cpp",
                    "src/skin/tooltips.cpp",
+                   "src/skin/skincache.cpp",
                    "src/skin/skincontext.cpp",
                    "src/skin/svgparser.cpp",
                    "src/skin/pixmapsource.cpp",
@@ -1236,6 +1247,7 @@ class MixxxCore(Feature):
 
                    "src/soundio/sounddevice.cpp",
                    "src/soundio/sounddevicenetwork.cpp",
+                   "src/engine/sidechain/encodedpacketbuffer.cpp",
                    "src/engine/sidechain/enginenetworkstream.cpp",
                    "src/soundio/soundmanager.cpp",
                    "src/soundio/soundmanagerconfig.cpp",
@@ -1251,6 +1263,7 @@ class MixxxCore(Feature):
                    "src/encoder/encodervorbissettings.cpp",
                    "src/encoder/encoderwave.cpp",
                    "src/encoder/encoderwavesettings.cpp",
+                   "src/encoder/sharedencoderpool.cpp",
                    'src/encoder/encoderopussettings.cpp',
 
                    "src/util/sleepableqthread.cpp",
@@ -1296,6 +1309,7 @@ class MixxxCore(Feature):
                    "src/util/logger.cpp",
                    "src/util/logging.cpp",
                    "src/util/cmdlineargs.cpp",
+                   "src/util/asyncfilewriter.cpp",
                    "src/util/audiosignal.cpp",
                    "src/util/widgethider.cpp",
                    "src/util/autohidpi.cpp",
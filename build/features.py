@@ -230,6 +230,36 @@ class CoreAudio(Feature):
                 'lib/apple/CAStreamBasicDescription.cpp']
 
 
+class Jack(Feature):
+
+    def description(self):
+        return "Native JACK sound API support"
+
+    def enabled(self, build):
+        build.flags['jack'] = util.get_flags(build.env, 'jack', 0)
+        if int(build.flags['jack']):
+            return True
+        return False
+
+    def add_options(self, build, vars):
+        vars.Add('jack', 'Set to 1 to enable native JACK sound API support.', 0)
+
+    def configure(self, build, conf):
+        if not self.enabled(build):
+            return
+
+        if not conf.CheckLib('jack'):
+            raise Exception('Could not find libjack.')
+
+        if not conf.CheckHeader('jack/jack.h'):
+            raise Exception('Could not find the JACK development headers.')
+
+        build.env.Append(CPPDEFINES='__JACK__')
+
+    def sources(self, build):
+        return ['src/soundio/sounddevicejack.cpp']
+
+
 class MediaFoundation(Feature):
     FLAG = 'mediafoundation'
 
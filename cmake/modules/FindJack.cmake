@@ -0,0 +1,86 @@
+# This file is part of Mixxx, Digital DJ'ing software.
+# Copyright (C) 2001-2020 Mixxx Development Team
+# Distributed under the GNU General Public Licence (GPL) version 2 or any later
+# later version. See the LICENSE file for details.
+
+#[=======================================================================[.rst:
+FindJack
+-----------
+
+Finds the Jack library.
+
+Imported Targets
+^^^^^^^^^^^^^^^^
+
+This module provides the following imported targets, if found:
+
+``Jack::Jack``
+  The Jack library
+
+Result Variables
+^^^^^^^^^^^^^^^^
+
+This will define the following variables:
+
+``Jack_FOUND``
+  True if the system has the Jack library.
+``Jack_INCLUDE_DIRS``
+  Include directories needed to use Jack.
+``Jack_LIBRARIES``
+  Libraries needed to link to Jack.
+``Jack_DEFINITIONS``
+  Compile definitions needed to use Jack.
+
+Cache Variables
+^^^^^^^^^^^^^^^
+
+The following cache variables may also be set:
+
+``Jack_INCLUDE_DIR``
+  The directory containing ``jack/jack.h``.
+``Jack_LIBRARY``
+  The path to the Jack library.
+
+#]=======================================================================]
+
+find_package(PkgConfig QUIET)
+if(PkgConfig_FOUND)
+  pkg_check_modules(PC_Jack QUIET jack)
+endif()
+
+find_path(Jack_INCLUDE_DIR
+  NAMES jack/jack.h
+  PATHS ${PC_Jack_INCLUDE_DIRS}
+  DOC "Jack include directory")
+mark_as_advanced(Jack_INCLUDE_DIR)
+
+find_library(Jack_LIBRARY
+  NAMES jack
+  PATHS ${PC_Jack_LIBRARY_DIRS}
+  DOC "Jack library"
+)
+mark_as_advanced(Jack_LIBRARY)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(
+  Jack
+  DEFAULT_MSG
+  Jack_LIBRARY
+  Jack_INCLUDE_DIR
+)
+
+if(Jack_FOUND)
+  set(Jack_LIBRARIES "${Jack_LIBRARY}")
+  set(Jack_INCLUDE_DIRS "${Jack_INCLUDE_DIR}")
+  set(Jack_DEFINITIONS ${PC_Jack_CFLAGS_OTHER})
+
+  if(NOT TARGET Jack::Jack)
+    add_library(Jack::Jack UNKNOWN IMPORTED)
+    set_target_properties(Jack::Jack
+      PROPERTIES
+        IMPORTED_LOCATION "${Jack_LIBRARY}"
+        INTERFACE_COMPILE_OPTIONS "${PC_Jack_CFLAGS_OTHER}"
+        INTERFACE_INCLUDE_DIRECTORIES "${Jack_INCLUDE_DIR}"
+    )
+  endif()
+endif()
@@ -52,6 +52,8 @@ class BroadcastManager : public QObject {
     UserSettingsPointer m_pConfig;
     BroadcastSettingsPointer m_pBroadcastSettings;
     QSharedPointer<EngineNetworkStream> m_pNetworkStream;
+    // Shared by all connections to encode each stream format only once
+    SharedEncoderPoolPointer m_pEncoderPool;
 
     ControlPushButton* m_pBroadcastEnabled;
     ControlObject* m_pStatusCO;
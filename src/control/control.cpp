@@ -3,6 +3,7 @@
 
 #include "control/control.h"
 
+#include "control/controlupdatecoalescer.h"
 #include "util/stat.h"
 
 // Static member variable definition
@@ -40,6 +41,8 @@ ControlDoublePrivate::ControlDoublePrivate(ConfigKey key,
           m_trackFlags(Stat::COUNT | Stat::SUM | Stat::AVERAGE |
                        Stat::SAMPLE_VARIANCE | Stat::MIN | Stat::MAX),
           m_confirmRequired(false),
+          m_coalescerIndex(-1),
+          m_pLastCoalescedSetter(nullptr),
           m_pCreatorCO(pCreatorCO) {
     initialize(defaultValue);
 }
@@ -197,6 +200,14 @@ void ControlDoublePrivate::setInner(double value, QObject* pSender) {
     m_value.setValue(value);
     emit valueChanged(value, pSender);
 
+    const int coalescerIndex = atomicLoadRelaxed(m_coalescerIndex);
+    if (coalescerIndex >= 0) {
+        // Allows the coalescer to filter out echos of the setter like
+        // ControlProxy does for valueChanged()
+        m_pLastCoalescedSetter.storeRelease(pSender);
+        ControlUpdateCoalescer::markDirty(coalescerIndex);
+    }
+
     if (m_bTrack) {
         Stat::track(m_trackKey, static_cast<Stat::StatType>(m_trackType),
                     static_cast<Stat::ComputeFlags>(m_trackFlags), value);
@@ -4,11 +4,13 @@
 #include <QHash>
 #include <QString>
 #include <QObject>
+#include <QAtomicInt>
 #include <QAtomicPointer>
 
 #include "control/controlbehavior.h"
 #include "control/controlvalue.h"
 #include "preferences/usersettings.h"
+#include "util/compatibility.h"
 #include "util/mutex.h"
 
 class ControlObject;
@@ -124,6 +126,22 @@ class ControlDoublePrivate : public QObject {
         return m_confirmRequired;
     }
 
+    // The index of this control in the ControlUpdateCoalescer or -1
+    // if no ControlProxy subscribed to coalesced updates.
+    int coalescerIndex() const {
+        return atomicLoadRelaxed(m_coalescerIndex);
+    }
+    void setCoalescerIndex(int index) {
+        m_coalescerIndex.storeRelease(index);
+    }
+
+    // The setter of the most recent value change that has been marked
+    // as dirty in the ControlUpdateCoalescer (potentially NULL). Only
+    // used for comparison and never dereferenced.
+    QObject* lastCoalescedSetter() const {
+        return atomicLoadAcquire(m_pLastCoalescedSetter);
+    }
+
   signals:
     // Emitted when the ControlDoublePrivate value changes. pSender is a
     // pointer to the setter of the value (potentially NULL).
@@ -160,6 +178,9 @@ class ControlDoublePrivate : public QObject {
     int m_trackFlags;
     bool m_confirmRequired;
 
+    QAtomicInt m_coalescerIndex;
+    QAtomicPointer<QObject> m_pLastCoalescedSetter;
+
     // The control value.
     ControlValueAtomic<double> m_value;
     // The default control value.
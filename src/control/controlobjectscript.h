@@ -24,6 +24,12 @@ class ControlObjectScript : public ControlProxy {
             return m_scriptConnections.first(); };
     void disconnectAllConnectionsToFunction(const QScriptValue& function);
 
+    // Returns the ControlObject that has created the control without
+    // looking it up by its key, or nullptr if it has been deleted.
+    ControlObject* getControlObject() const {
+        return m_pControl ? m_pControl->getCreatorCO() : nullptr;
+    }
+
     // Called from update();
     void emitValueChanged() override {
         emit trigger(get(), this);
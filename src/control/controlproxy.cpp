@@ -2,36 +2,80 @@
 
 #include "control/controlproxy.h"
 #include "control/control.h"
+#include "control/controlupdatecoalescer.h"
+#include "util/assert.h"
 
 ControlProxy::ControlProxy(QObject* pParent)
         : QObject(pParent),
-          m_pControl(NULL) {
+          m_pControl(NULL),
+          m_bCoalescedRequested(false),
+          m_bCoalesced(false) {
 }
 
 ControlProxy::ControlProxy(const QString& g, const QString& i, QObject* pParent)
-        : QObject(pParent) {
+        : QObject(pParent),
+          m_bCoalescedRequested(false),
+          m_bCoalesced(false) {
     initialize(ConfigKey(g, i));
 }
 
 ControlProxy::ControlProxy(const char* g, const char* i, QObject* pParent)
-        : QObject(pParent) {
+        : QObject(pParent),
+          m_bCoalescedRequested(false),
+          m_bCoalesced(false) {
     initialize(ConfigKey(g, i));
 }
 
 ControlProxy::ControlProxy(const ConfigKey& key, QObject* pParent)
-        : QObject(pParent) {
+        : QObject(pParent),
+          m_bCoalescedRequested(false),
+          m_bCoalesced(false) {
     initialize(key);
 }
 
 void ControlProxy::initialize(const ConfigKey& key, bool warn) {
+    // The coalesced subscription is bound to the ControlDoublePrivate
+    // and needs to be moved to the new control
+    unsubscribeCoalesced();
     m_key = key;
     // Don't bother looking up the control if key is NULL. Prevents log spew.
     if (!key.isNull()) {
         m_pControl = ControlDoublePrivate::getControl(key, warn);
     }
+    if (m_bCoalescedRequested && m_pControl) {
+        subscribeCoalesced();
+    }
 }
 
 ControlProxy::~ControlProxy() {
     //qDebug() << "ControlProxy::~ControlProxy()";
+    unsubscribeCoalesced();
+}
+
+void ControlProxy::subscribeCoalesced() {
+    DEBUG_ASSERT(!m_bCoalesced);
+    DEBUG_ASSERT(m_pControl);
+    m_bCoalescedRequested = true;
+    m_bCoalesced = ControlUpdateCoalescer::subscribe(this, m_pControl);
+    if (!m_bCoalesced) {
+        // Fall back to a queued signal for every change
+        connect(m_pControl.data(),
+                &ControlDoublePrivate::valueChanged,
+                this,
+                &ControlProxy::slotValueChangedAuto,
+                Qt::UniqueConnection);
+    }
+}
+
+void ControlProxy::unsubscribeCoalesced() {
+    if (m_bCoalesced) {
+        ControlUpdateCoalescer::unsubscribe(this, m_pControl);
+        m_bCoalesced = false;
+    } else if (m_bCoalescedRequested && m_pControl) {
+        disconnect(m_pControl.data(),
+                &ControlDoublePrivate::valueChanged,
+                this,
+                &ControlProxy::slotValueChangedAuto);
+    }
 }
 
@@ -102,6 +102,26 @@ class ControlProxy : public QObject {
         return true;
     }
 
+    // Connects a slot in the GUI thread that receives at most one update
+    // per GUI frame with the latest value. Intermediate changes are
+    // dropped. Falls back to queued signals if coalescing is not
+    // available. Like with connectValueChanged(), changes made through
+    // this proxy are not delivered back to it. The subscription follows
+    // the control when the proxy is re-initialized with a different key.
+    // Must be called from the GUI thread and must not be mixed with
+    // connectValueChanged() on the same proxy.
+    template<typename Receiver, typename Slot>
+    bool connectValueChangedCoalesced(Receiver receiver, Slot func) {
+        if (!m_pControl) {
+            return false;
+        }
+        if (!m_bCoalescedRequested) {
+            subscribeCoalesced();
+        }
+        // The updates are delivered from the GUI thread
+        return connect(this, &ControlProxy::valueChanged, receiver, func, Qt::DirectConnection);
+    }
+
     // Called from update();
     virtual void emitValueChanged() {
         emit valueChanged(get());
@@ -199,6 +219,15 @@ class ControlProxy : public QObject {
     ConfigKey m_key;
     // Pointer to connected control.
     QSharedPointer<ControlDoublePrivate> m_pControl;
+
+  private:
+    void subscribeCoalesced();
+    void unsubscribeCoalesced();
+
+    // Set once connectValueChangedCoalesced() has been invoked
+    bool m_bCoalescedRequested;
+    // Subscribed to the ControlUpdateCoalescer instead of the fallback
+    bool m_bCoalesced;
 };
 
 #endif // CONTROLPROXY_H
@@ -0,0 +1,121 @@
+#include "control/controlupdatecoalescer.h"
+
+#include "control/control.h"
+#include "control/controlproxy.h"
+#include "util/assert.h"
+#include "util/counter.h"
+
+bool ControlUpdateCoalescer::s_enabled = false;
+
+std::atomic<quint64> ControlUpdateCoalescer::s_dirtyWords[kWordCount] = {};
+
+std::atomic<quint64> ControlUpdateCoalescer::s_savedEvents(0);
+
+std::vector<ControlUpdateCoalescer::Slot> ControlUpdateCoalescer::s_slots;
+
+QVector<int> ControlUpdateCoalescer::s_freeSlots;
+
+quint64 ControlUpdateCoalescer::s_reportedSavedEvents = 0;
+
+//static
+void ControlUpdateCoalescer::setEnabled(bool enabled) {
+    // Existing subscriptions are not affected and still need to be
+    // drained until they are unsubscribed.
+    s_enabled = enabled;
+}
+
+//static
+bool ControlUpdateCoalescer::subscribe(
+        ControlProxy* pProxy,
+        const QSharedPointer<ControlDoublePrivate>& pControl) {
+    VERIFY_OR_DEBUG_ASSERT(pProxy && pControl) {
+        return false;
+    }
+    if (!s_enabled) {
+        return false;
+    }
+    int index = pControl->coalescerIndex();
+    if (index < 0) {
+        if (!s_freeSlots.isEmpty()) {
+            index = s_freeSlots.takeLast();
+        } else if (s_slots.size() < static_cast<size_t>(kMaxControls)) {
+            index = static_cast<int>(s_slots.size());
+            s_slots.emplace_back();
+        } else {
+            return false;
+        }
+        s_slots[index].pControl = pControl;
+        pControl->setCoalescerIndex(index);
+    }
+    DEBUG_ASSERT(!s_slots[index].subscribers.contains(pProxy));
+    s_slots[index].subscribers.append(pProxy);
+    return true;
+}
+
+//static
+void ControlUpdateCoalescer::unsubscribe(
+        ControlProxy* pProxy,
+        const QSharedPointer<ControlDoublePrivate>& pControl) {
+    const int index = pControl->coalescerIndex();
+    VERIFY_OR_DEBUG_ASSERT(index >= 0) {
+        return;
+    }
+    Slot& slot = s_slots[index];
+    slot.subscribers.removeOne(pProxy);
+    if (slot.subscribers.isEmpty()) {
+        // A pending or concurrent markDirty() for this index might
+        // still arrive and wake up the next control that reuses this
+        // slot. That is harmless, because only the current value of
+        // this control will be delivered.
+        pControl->setCoalescerIndex(-1);
+        slot.pControl.clear();
+        s_freeSlots.append(index);
+    }
+}
+
+//static
+int ControlUpdateCoalescer::drain() {
+    int updatedControls = 0;
+    for (int word = 0; word < kWordCount; ++word) {
+        if (s_dirtyWords[word].load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        const quint64 bits = s_dirtyWords[word].exchange(0, std::memory_order_acq_rel);
+        for (int bit = 0; bit < kBitsPerWord; ++bit) {
+            if ((bits & (quint64(1) << bit)) == 0) {
+                continue;
+            }
+            const size_t index = word * kBitsPerWord + bit;
+            if (index >= s_slots.size()) {
+                continue;
+            }
+            const QSharedPointer<ControlDoublePrivate> pControl =
+                    s_slots[index].pControl.lock();
+            if (!pControl) {
+                continue;
+            }
+            // Like ControlProxy::slotValueChangedAuto() the setter of the
+            // latest value does not receive its own change, otherwise
+            // widgets would fight with the user's input.
+            const QObject* pSetter = pControl->lastCoalescedSetter();
+            // Subscribers might unsubscribe while an update is delivered
+            // to another subscriber of the same control.
+            const QVector<ControlProxy*> subscribers = s_slots[index].subscribers;
+            for (ControlProxy* pProxy : subscribers) {
+                if (pProxy != pSetter &&
+                        s_slots[index].subscribers.contains(pProxy)) {
+                    pProxy->emitValueChanged();
+                }
+            }
+            ++updatedControls;
+        }
+    }
+
+    const quint64 savedEvents = savedEventCount();
+    if (savedEvents != s_reportedSavedEvents) {
+        Counter counter("ControlUpdateCoalescer saved events");
+        counter.increment(static_cast<int>(savedEvents - s_reportedSavedEvents));
+        s_reportedSavedEvents = savedEvents;
+    }
+    return updatedControls;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QSharedPointer>
+#include <QVector>
+#include <atomic>
+#include <vector>
+
+class ControlDoublePrivate;
+class ControlProxy;
+
+// Delivers value changes of controls to subscribed ControlProxys in the
+// GUI thread at most once per GUI frame.
+//
+// Instead of emitting a queued signal for every change, a changed control
+// only sets its dirty bit in a lock-free bitmap. The bitmap is drained by
+// GuiTick once per frame and each subscriber receives the latest value of
+// the control. All changes that happen between two frames collapse into
+// a single update.
+//
+// Subscribing, unsubscribing and draining must only be done from the GUI
+// thread. Marking a control as dirty is lock-free and may be done from any
+// thread, including the engine thread.
+class ControlUpdateCoalescer {
+  public:
+    // The maximum number of distinct controls with subscribers. Proxies
+    // that fail to subscribe fall back to queued signals.
+    static constexpr int kMaxControls = 16384;
+
+    // Subscriptions are only accepted while enabled, i.e. while there is
+    // a GuiTick that drains the updates.
+    static void setEnabled(bool enabled);
+    static bool isEnabled() {
+        return s_enabled;
+    }
+
+    static bool subscribe(
+            ControlProxy* pProxy,
+            const QSharedPointer<ControlDoublePrivate>& pControl);
+    static void unsubscribe(
+            ControlProxy* pProxy,
+            const QSharedPointer<ControlDoublePrivate>& pControl);
+
+    static void markDirty(int index) {
+        const quint64 mask = quint64(1) << (index % kBitsPerWord);
+        const quint64 previous = s_dirtyWords[index / kBitsPerWord].fetch_or(
+                mask, std::memory_order_acq_rel);
+        if (previous & mask) {
+            // The update from the previous change is still pending
+            s_savedEvents.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Delivers the latest values of all controls that have changed since
+    // the last invocation. Returns the number of updated controls.
+    static int drain();
+
+    // The number of value changes that did not need to be delivered,
+    // because they have been superseded by a later change within the
+    // same frame.
+    static quint64 savedEventCount() {
+        return s_savedEvents.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr int kBitsPerWord = 64;
+    static constexpr int kWordCount = kMaxControls / kBitsPerWord;
+
+    struct Slot {
+        QWeakPointer<ControlDoublePrivate> pControl;
+        QVector<ControlProxy*> subscribers;
+    };
+
+    static bool s_enabled;
+    static std::atomic<quint64> s_dirtyWords[kWordCount];
+    static std::atomic<quint64> s_savedEvents;
+    // Only accessed from the GUI thread
+    static std::vector<Slot> s_slots;
+    static QVector<int> s_freeSlots;
+    static quint64 s_reportedSavedEvents;
+};
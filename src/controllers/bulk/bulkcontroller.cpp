@@ -12,51 +12,41 @@
 #include "controllers/defs_controllers.h"
 #include "controllers/controllerdebug.h"
 #include "util/compatibility.h"
-#include "util/trace.h"
-#include "util/time.h"
 
 BulkReader::BulkReader(libusb_device_handle *handle, unsigned char in_epaddr)
-        : QThread(),
+        : ControllerReader(),
           m_phandle(handle),
-          m_stop(0),
           m_in_epaddr(in_epaddr) {
 }
 
 BulkReader::~BulkReader() {
 }
 
-void BulkReader::stop() {
-    m_stop = 1;
-}
-
-void BulkReader::run() {
-    m_stop = 0;
-    unsigned char data[255];
-
-    while (atomicLoadAcquire(m_stop) == 0) {
-        // Blocked polling: The only problem with this is that we can't close
-        // the device until the block is released, which means the controller
-        // has to send more data
-        //result = hid_read_timeout(m_pHidDevice, data, 255, -1);
-
-        // This relieves that at the cost of higher CPU usage since we only
-        // block for a short while (500ms)
-        int transferred;
-        int result;
-
-        result = libusb_bulk_transfer(m_phandle,
+int BulkReader::read(unsigned char* pData, int maxSize, int timeoutMillis) {
+    int transferred = 0;
+    int result = libusb_bulk_transfer(m_phandle,
                                       m_in_epaddr,
-                                      data, sizeof(data),
-                                      &transferred, 500);
-        Trace timeout("BulkReader timeout");
-        if (result >= 0) {
-            Trace process("BulkReader process packet");
-            //qDebug() << "Read" << result << "bytes, pointer:" << data;
-            QByteArray outData((char*)data, transferred);
-            emit incomingData(outData, mixxx::Time::elapsed());
-        }
+                                      pData, maxSize,
+                                      &transferred, timeoutMillis);
+    switch (result) {
+    case LIBUSB_SUCCESS:
+        return transferred;
+    case LIBUSB_ERROR_TIMEOUT:
+    case LIBUSB_ERROR_INTERRUPTED:
+        // Incomplete transfers are dropped
+        return 0;
+    case LIBUSB_ERROR_OVERFLOW:
+        // The device sent more data than requested. Only this transfer
+        // is lost and the next one might succeed.
+        qWarning() << "Dropped oversized transfer from" << objectName();
+        return 0;
+    default:
+        // The device has been unplugged or failed otherwise and the
+        // reader stops
+        controllerDebug("libusb_bulk_transfer() failed:"
+                << libusb_error_name(result));
+        return result;
     }
-    qDebug() << "Stopped Reader";
 }
 
 static QString get_string(libusb_device_handle *handle, u_int8_t id) {
@@ -8,9 +8,8 @@
 #ifndef BULKCONTROLLER_H
 #define BULKCONTROLLER_H
 
-#include <QAtomicInt>
-
 #include "controllers/controller.h"
+#include "controllers/controllerreader.h"
 #include "controllers/hid/hidcontrollerpreset.h"
 #include "controllers/hid/hidcontrollerpresetfilehandler.h"
 #include "util/duration.h"
@@ -19,23 +18,17 @@ struct libusb_device_handle;
 struct libusb_context;
 struct libusb_device_descriptor;
 
-class BulkReader : public QThread {
+class BulkReader : public ControllerReader {
     Q_OBJECT
   public:
     BulkReader(libusb_device_handle *handle, unsigned char in_epaddr);
-    virtual ~BulkReader();
-
-    void stop();
-
-  signals:
-    void incomingData(QByteArray data, mixxx::Duration timestamp);
+    ~BulkReader() override;
 
   protected:
-    void run();
+    int read(unsigned char* pData, int maxSize, int timeoutMillis) override;
 
   private:
     libusb_device_handle* m_phandle;
-    QAtomicInt m_stop;
     unsigned char m_in_epaddr;
 };
 
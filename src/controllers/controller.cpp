@@ -19,7 +19,12 @@ Controller::Controller()
           m_bIsOutputDevice(false),
           m_bIsInputDevice(false),
           m_bIsOpen(false),
-          m_bLearning(false) {
+          m_bLearning(false),
+          m_outputScheduler(
+                  [this](const ControllerOutputScheduler::Batch& batch) {
+                      writeOutput(batch);
+                  },
+                  this) {
         m_userActivityInhibitTimer.start();
 }
 
@@ -47,6 +52,10 @@ void Controller::stopEngine() {
     m_pEngine->gracefulShutdown();
     delete m_pEngine;
     m_pEngine = NULL;
+
+    // Write the parting messages of the scripts before the device is closed
+    m_outputScheduler.flushAll();
+    qDebug() << "Output of" << m_sDeviceName << ":" << m_outputScheduler.stats();
 }
 
 bool Controller::applyPreset(QList<QString> scriptPaths, bool initializeScripts) {
@@ -94,7 +103,13 @@ void Controller::send(QList<int> data, unsigned int length) {
     for (unsigned int i = 0; i < length; ++i) {
         msg[i] = data.at(i);
     }
-    send(msg);
+    scheduleOutput(ControllerOutputScheduler::kNoCoalescing, msg);
+}
+
+void Controller::writeOutput(const ControllerOutputScheduler::Batch& batch) {
+    for (const auto& message : batch) {
+        send(message.data);
+    }
 }
 
 void Controller::triggerActivity()
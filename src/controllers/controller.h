@@ -13,6 +13,7 @@
 #define CONTROLLER_H
 
 #include "controllers/controllerengine.h"
+#include "controllers/controlleroutputscheduler.h"
 #include "controllers/controllervisitor.h"
 #include "controllers/controllerpreset.h"
 #include "controllers/controllerpresetinfo.h"
@@ -66,6 +67,11 @@ class Controller : public QObject, ConstControllerPresetVisitor {
 
     virtual bool matchPreset(const PresetInfo& preset) = 0;
 
+    // Statistics about the output that has been sent to the device
+    const ControllerOutputScheduler::Stats& getOutputStats() const {
+        return m_outputScheduler.stats();
+    }
+
   signals:
     // Emitted when a new preset is loaded. pPreset is a /clone/ of the loaded
     // preset, not a pointer to the preset itself.
@@ -105,6 +111,17 @@ class Controller : public QObject, ConstControllerPresetVisitor {
     // To be called when receiving events
     void triggerActivity();
 
+    // Queues output for the next batch that is written by writeOutput().
+    // Pending output with the same key is replaced, unless the key is
+    // ControllerOutputScheduler::kNoCoalescing.
+    void scheduleOutput(qint64 key, const QByteArray& data) {
+        m_outputScheduler.schedule(key, data);
+    }
+    // For setting up the rate limit of the device
+    ControllerOutputScheduler* outputScheduler() {
+        return &m_outputScheduler;
+    }
+
     inline ControllerEngine* getEngine() const {
         return m_pEngine;
     }
@@ -143,6 +160,10 @@ class Controller : public QObject, ConstControllerPresetVisitor {
     // controller.
     virtual void send(QByteArray data) = 0;
 
+    // Writes a batch of scheduled output to the device. The default
+    // implementation passes each message to send().
+    virtual void writeOutput(const ControllerOutputScheduler::Batch& batch);
+
     // Returns a pointer to the currently loaded controller preset. For internal
     // use only.
     virtual ControllerPreset* preset() = 0;
@@ -161,6 +182,7 @@ class Controller : public QObject, ConstControllerPresetVisitor {
     bool m_bIsOpen;
     bool m_bLearning;
     QElapsedTimer m_userActivityInhibitTimer;
+    ControllerOutputScheduler m_outputScheduler;
 
     // accesses lots of our stuff, but in the same thread
     friend class ControllerManager;
@@ -12,6 +12,7 @@
 #include "controllers/controllerdebug.h"
 #include "control/controlobject.h"
 #include "control/controlobjectscript.h"
+#include "engine/scratchtickqueue.h"
 #include "errordialoghandler.h"
 #include "mixer/playermanager.h"
 // to tell the msvs compiler about `isnan`
@@ -29,11 +30,15 @@ const int kDecks = 16;
 const int kScratchTimerMs = 1;
 const double kAlphaBetaDt = kScratchTimerMs / 1000.0;
 
+// Enough for the code strings of all connections and timers of a preset
+const int kMaxCachedScriptPrograms = 256;
+
 ControllerEngine::ControllerEngine(Controller* controller)
         : m_pEngine(nullptr),
           m_pController(controller),
           m_bPopups(false),
-          m_pBaClass(nullptr) {
+          m_pBaClass(nullptr),
+          m_scriptProgramCache(kMaxCachedScriptPrograms) {
     // Handle error dialog buttons
     qRegisterMetaType<QMessageBox::StandardButton>("QMessageBox::StandardButton");
 
@@ -47,11 +52,21 @@ ControllerEngine::ControllerEngine(Controller* controller)
     m_rampFactor.resize(kDecks);
     m_brakeActive.resize(kDecks);
     m_softStartActive.resize(kDecks);
+    m_scratchInEngine.resize(kDecks);
+    m_scratchSessions.resize(kDecks);
+    m_scratchStopPending.resize(kDecks);
+    m_scratchStopTime.resize(kDecks);
+    m_scratchAlpha.resize(kDecks);
+    m_scratchBeta.resize(kDecks);
+    m_scratchTickQueues.resize(kDecks);
     // Initialize arrays used for testing and pointers
     for (int i = 0; i < kDecks; ++i) {
         m_dx[i] = 0.0;
         m_scratchFilters[i] = new AlphaBetaFilter();
         m_ramp[i] = false;
+        m_scratchInEngine[i] = false;
+        m_scratchSessions[i] = 0;
+        m_scratchStopPending[i] = false;
     }
 
     initializeScriptEngine();
@@ -158,6 +173,9 @@ void ControllerEngine::gracefulShutdown() {
 
     // Prevents leaving decks in an unstable state
     //  if the controller is shut down while scratching
+    for (int deck = 0; deck < m_scratchInEngine.size(); ++deck) {
+        stopScratchInEngine(deck, false);
+    }
     QHashIterator<int, int> i(m_scratchTimers);
     while (i.hasNext()) {
         i.next();
@@ -173,6 +191,7 @@ void ControllerEngine::gracefulShutdown() {
 
     // Clear the cache of function wrappers
     m_scriptWrappedFunctionCache.clear();
+    m_scriptProgramCache.clear();
 
     // Free all the ControlObjectScripts
     QList<ConfigKey> keys = m_controlCache.keys();
@@ -357,11 +376,20 @@ bool ControllerEngine::internalExecute(QScriptValue thisObject,
         return false;
     }
 
-    if (!syntaxIsValid(scriptCode)) {
-        return false;
+    // A copy, the cached program may be evicted while it is evaluated
+    QScriptProgram program;
+    const QScriptProgram* pCachedProgram = m_scriptProgramCache.object(scriptCode);
+    if (pCachedProgram) {
+        program = *pCachedProgram;
+    } else {
+        if (!syntaxIsValid(scriptCode)) {
+            return false;
+        }
+        program = QScriptProgram(scriptCode);
+        m_scriptProgramCache.insert(scriptCode, new QScriptProgram(program));
     }
 
-    QScriptValue scriptFunction = m_pEngine->evaluate(scriptCode);
+    QScriptValue scriptFunction = m_pEngine->evaluate(program);
 
     if (checkException()) {
         qDebug() << "Exception evaluating:" << scriptCode;
@@ -580,10 +608,14 @@ void ControllerEngine::setValue(QString group, QString name, double newValue) {
     ControlObjectScript* coScript = getControlObjectScript(group, name);
 
     if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(coScript->getKey());
-        if (pControl && !m_st.ignore(pControl, coScript->getParameterForValue(newValue))) {
-            coScript->slotSet(newValue);
-        }
+        setControlValue(coScript, newValue);
+    }
+}
+
+void ControllerEngine::setControlValue(ControlObjectScript* coScript, double newValue) {
+    ControlObject* pControl = coScript->getControlObject();
+    if (pControl && !m_st.ignore(pControl, coScript->getParameterForValue(newValue))) {
+        coScript->slotSet(newValue);
     }
 }
 
@@ -617,10 +649,14 @@ void ControllerEngine::setParameter(QString group, QString name, double newParam
     ControlObjectScript* coScript = getControlObjectScript(group, name);
 
     if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(coScript->getKey());
-        if (pControl && !m_st.ignore(pControl, newParameter)) {
-          coScript->setParameter(newParameter);
-        }
+        setControlParameter(coScript, newParameter);
+    }
+}
+
+void ControllerEngine::setControlParameter(ControlObjectScript* coScript, double newParameter) {
+    ControlObject* pControl = coScript->getControlObject();
+    if (pControl && !m_st.ignore(pControl, newParameter)) {
+        coScript->setParameter(newParameter);
     }
 }
 
@@ -690,6 +726,89 @@ double ControllerEngine::getDefaultParameter(QString group, QString name) {
     return coScript->getParameterForValue(coScript->getDefault());
 }
 
+/* -------- ------------------------------------------------------
+   Purpose: Resolves a Mixxx control once for repeated access (for scripts)
+   Input:   Control group, Key name
+   Output:  a ScriptControlHandle turned into a QtScriptValue.
+            If the control does not exist, returns undefined.
+   -------- ------------------------------------------------------ */
+QScriptValue ControllerEngine::getControl(QString group, QString name) {
+    VERIFY_OR_DEBUG_ASSERT(m_pEngine != nullptr) {
+        return QScriptValue();
+    }
+
+    ControlObjectScript* coScript = getControlObjectScript(group, name);
+    if (coScript == nullptr) {
+        qWarning() << "ControllerEngine: script tried to get ControlObject (" +
+                      group + ", " + name +
+                      ") which is non-existent, ignoring.";
+        return QScriptValue();
+    }
+
+    return m_pEngine->newQObject(
+        new ScriptControlHandle(this, coScript),
+        QScriptEngine::ScriptOwnership);
+}
+
+ScriptControlHandle::ScriptControlHandle(ControllerEngine* pEngine,
+                                         ControlObjectScript* pControl)
+        : m_pEngine(pEngine),
+          m_pControl(pControl) {
+}
+
+QString ScriptControlHandle::readGroup() const {
+    return m_pControl ? m_pControl->getKey().group : QString();
+}
+
+QString ScriptControlHandle::readName() const {
+    return m_pControl ? m_pControl->getKey().item : QString();
+}
+
+double ScriptControlHandle::get() const {
+    // The control is gone after the engine has been shut down
+    if (!m_pControl) {
+        return 0.0;
+    }
+    return m_pControl->get();
+}
+
+void ScriptControlHandle::set(double newValue) {
+    if (!m_pControl) {
+        return;
+    }
+    if (isnan(newValue)) {
+        qWarning() << "ControllerEngine: script setting [" << readGroup() << ","
+                   << readName() << "] to NotANumber, ignoring.";
+        return;
+    }
+    m_pEngine->setControlValue(m_pControl, newValue);
+}
+
+double ScriptControlHandle::getParameter() const {
+    if (!m_pControl) {
+        return 0.0;
+    }
+    return m_pControl->getParameter();
+}
+
+void ScriptControlHandle::setParameter(double newParameter) {
+    if (!m_pControl) {
+        return;
+    }
+    if (isnan(newParameter)) {
+        qWarning() << "ControllerEngine: script setting [" << readGroup() << ","
+                   << readName() << "] to NotANumber, ignoring.";
+        return;
+    }
+    m_pEngine->setControlParameter(m_pControl, newParameter);
+}
+
+void ScriptControlHandle::reset() {
+    if (m_pControl) {
+        m_pControl->reset();
+    }
+}
+
 /* -------- ------------------------------------------------------
    Purpose: qDebugs script output so it ends up in mixxx.log
    Input:   String to log
@@ -1193,6 +1312,8 @@ void ControllerEngine::scratchEnable(int deck, int intervalsPerRev, double rpm,
     m_ramp[deck] = false;
     m_rampFactor[deck] = 0.001;
     m_brakeActive[deck] = false;
+    // The stop of an overridden session in the engine needs no take over
+    m_scratchStopPending[deck] = false;
 
     // PlayerManager::groupForDeck is 0-indexed.
     QString group = PlayerManager::groupForDeck(deck - 1);
@@ -1226,14 +1347,39 @@ void ControllerEngine::scratchEnable(int deck, int intervalsPerRev, double rpm,
     } else {
         // Use filter's defaults if not specified
         m_scratchFilters[deck]->init(kAlphaBetaDt, initVelocity);
+        alpha = 0.0;
+        beta = 0.0;
+    }
+    m_scratchAlpha[deck] = alpha;
+    m_scratchBeta[deck] = beta;
+
+    // The engine integrates the ticks in every callback by their
+    // timestamps, independent of when this thread is scheduled. This
+    // only works while the engine actually reads the queue.
+    ScratchTickQueue* pQueue = scratchTickQueue(deck);
+    ScratchTickEvent event;
+    event.type = ScratchTickEvent::Type::Enable;
+    event.session = pQueue->beginSession();
+    event.timestamp = mixxx::Time::elapsed();
+    event.interval = 0;
+    event.dx = m_dx[deck];
+    event.velocity = initVelocity;
+    event.alpha = alpha;
+    event.beta = beta;
+    m_scratchSessions[deck] = event.session;
+    m_scratchInEngine[deck] = pQueue->isConsumed(event.timestamp) &&
+            pQueue->write(event);
+    if (!m_scratchInEngine[deck]) {
+        // Also stops a previous session in the engine that is overridden
+        pQueue->requestDisable(event.session, event.timestamp);
+        // The engine is not running, fall back to processing the ticks here.
+        // 1ms is shortest possible, OS dependent
+        int timerId = startTimer(kScratchTimerMs);
+
+        // Associate this virtual deck with this timer for later processing
+        m_scratchTimers[timerId] = deck;
     }
 
-    // 1ms is shortest possible, OS dependent
-    int timerId = startTimer(kScratchTimerMs);
-
-    // Associate this virtual deck with this timer for later processing
-    m_scratchTimers[timerId] = deck;
-
     // Set scratch2_enable
     if (pScratch2Enable != nullptr) {
         pScratch2Enable->slotSet(1);
@@ -1247,9 +1393,90 @@ void ControllerEngine::scratchEnable(int deck, int intervalsPerRev, double rpm,
     -------- ------------------------------------------------------ */
 void ControllerEngine::scratchTick(int deck, int interval) {
     m_lastMovement[deck] = mixxx::Time::elapsed();
+    if (m_scratchInEngine[deck]) {
+        ScratchTickQueue* pQueue = scratchTickQueue(deck);
+        if (pQueue->isConsumed(m_lastMovement[deck])) {
+            ScratchTickEvent event;
+            event.type = ScratchTickEvent::Type::Tick;
+            event.session = m_scratchSessions[deck];
+            event.timestamp = m_lastMovement[deck];
+            event.interval = interval;
+            event.dx = 0.0;
+            event.velocity = 0.0;
+            event.alpha = 0.0;
+            event.beta = 0.0;
+            if (pQueue->write(event)) {
+                return;
+            }
+        }
+        // The engine has stalled, e.g. because the audio device has been
+        // closed. Continue scratching with the timer.
+        stopScratchInEngine(deck);
+    }
     m_intervalAccumulator[deck] += interval;
 }
 
+ScratchTickQueue* ControllerEngine::scratchTickQueue(int deck) {
+    if (m_scratchTickQueues[deck].isNull()) {
+        // PlayerManager::groupForDeck is 0-indexed.
+        m_scratchTickQueues[deck] = ScratchTickQueue::getScratchTickQueue(
+                PlayerManager::groupForDeck(deck - 1));
+    }
+    return m_scratchTickQueues[deck].data();
+}
+
+void ControllerEngine::stopScratchInEngine(int deck, bool takeOverRate) {
+    if (!m_scratchInEngine[deck]) {
+        return;
+    }
+    m_scratchInEngine[deck] = false;
+
+    const mixxx::Duration stopTime = mixxx::Time::elapsed();
+    scratchTickQueue(deck)->requestDisable(m_scratchSessions[deck], stopTime);
+    // The engine acknowledges the stop within one audio buffer. The
+    // timer picks up the acknowledgement instead of waiting for it here.
+    m_scratchStopPending[deck] = takeOverRate;
+    m_scratchStopTime[deck] = stopTime;
+    m_intervalAccumulator[deck] = 0;
+
+    int timerId = startTimer(kScratchTimerMs);
+    m_scratchTimers[timerId] = deck;
+}
+
+bool ControllerEngine::takeOverScratchFromEngine(int deck) {
+    if (!m_scratchStopPending[deck]) {
+        return true;
+    }
+    ScratchTickQueue* pQueue = scratchTickQueue(deck);
+    // Continue from the last rate of the jog wheel in the engine. It is
+    // only final after the engine has acknowledged the stop.
+    double velocity = 0.0;
+    if (!pQueue->isDisableAcknowledged(m_scratchSessions[deck], &velocity)) {
+        const mixxx::Duration now = mixxx::Time::elapsed();
+        if (pQueue->isConsumed(now) &&
+                now - m_scratchStopTime[deck] <= ScratchTickQueue::kMaxReadInterval) {
+            // Check again on the next timer event
+            return false;
+        }
+        // The engine has stalled, continue from the last published rate
+        qWarning() << "The engine did not stop scratching deck" << deck;
+        // PlayerManager::groupForDeck is 0-indexed.
+        QString group = PlayerManager::groupForDeck(deck - 1);
+        ControlObjectScript* pScratch2 = getControlObjectScript(group, "scratch2");
+        if (pScratch2 != nullptr) {
+            velocity = pScratch2->get();
+        }
+    }
+    m_scratchStopPending[deck] = false;
+    if (m_scratchAlpha[deck] && m_scratchBeta[deck]) {
+        m_scratchFilters[deck]->init(kAlphaBetaDt, velocity,
+                                     m_scratchAlpha[deck], m_scratchBeta[deck]);
+    } else {
+        m_scratchFilters[deck]->init(kAlphaBetaDt, velocity);
+    }
+    return true;
+}
+
 /* -------- ------------------------------------------------------
     Purpose: Applies the accumulated movement to the track speed
     Input:   ID of timer for this deck
@@ -1264,6 +1491,10 @@ void ControllerEngine::scratchProcess(int timerId) {
         qWarning() << "Scratch filter pointer is null on deck" << deck;
         return;
     }
+    if (!takeOverScratchFromEngine(deck)) {
+        // The engine still scratches with the ticks of the jog wheel
+        return;
+    }
 
     const double oldRate = filter->predictedVelocity();
 
@@ -1344,6 +1575,9 @@ void ControllerEngine::scratchDisable(int deck, bool ramp) {
     // PlayerManager::groupForDeck is 0-indexed.
     QString group = PlayerManager::groupForDeck(deck - 1);
 
+    // The ramp is processed by scratchProcess()
+    stopScratchInEngine(deck);
+
     m_rampTo[deck] = 0.0;
 
     // If no ramping is desired, disable scratching immediately
@@ -1433,6 +1667,9 @@ void ControllerEngine::brake(int deck, bool activate, double factor, double rate
     // PlayerManager::groupForDeck is 0-indexed.
     QString group = PlayerManager::groupForDeck(deck - 1);
 
+    // Stops scratching with the jog wheel, the initial rate is set below
+    stopScratchInEngine(deck, false);
+
     // kill timer when both enabling or disabling
     int timerId = m_scratchTimers.key(deck);
     killTimer(timerId);
@@ -1501,6 +1738,9 @@ void ControllerEngine::softStart(int deck, bool activate, double factor) {
     // PlayerManager::groupForDeck is 0-indexed.
     QString group = PlayerManager::groupForDeck(deck - 1);
 
+    // Stops scratching with the jog wheel, the initial rate is set below
+    stopScratchInEngine(deck, false);
+
     // kill timer when both enabling or disabling
     int timerId = m_scratchTimers.key(deck);
     killTimer(timerId);
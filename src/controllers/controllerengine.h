@@ -8,9 +8,11 @@
 #ifndef CONTROLLERENGINE_H
 #define CONTROLLERENGINE_H
 
+#include <QCache>
 #include <QTimerEvent>
 #include <QFileSystemWatcher>
 #include <QMessageBox>
+#include <QPointer>
 #include <QtScript>
 
 #include "bytearrayclass.h"
@@ -26,6 +28,7 @@
 class Controller;
 class ControlObjectScript;
 class ControllerEngine;
+class ScratchTickQueue;
 
 // ScriptConnection represents a connection between
 // a ControlObject and a script callback function that gets executed when
@@ -77,6 +80,30 @@ class ScriptConnectionInvokableWrapper : public QObject {
     bool m_isConnected;
 };
 
+// ScriptControlHandle gives scripts fast access to a single control. It
+// is resolved once by engine.getControl(group, name), so its methods don't
+// need to look up the control by group and name like engine.getValue()
+// and engine.setValue() do on every call.
+class ScriptControlHandle : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QString group READ readGroup)
+    Q_PROPERTY(QString name READ readName)
+  public:
+    ScriptControlHandle(ControllerEngine* pEngine, ControlObjectScript* pControl);
+    QString readGroup() const;
+    QString readName() const;
+    Q_INVOKABLE double get() const;
+    Q_INVOKABLE void set(double newValue);
+    Q_INVOKABLE double getParameter() const;
+    Q_INVOKABLE void setParameter(double newParameter);
+    Q_INVOKABLE void reset();
+
+  private:
+    ControllerEngine* m_pEngine;
+    // Owned by the engine, which deletes it during shutdown
+    QPointer<ControlObjectScript> m_pControl;
+};
+
 class ControllerEngine : public QObject {
     Q_OBJECT
   public:
@@ -115,6 +142,8 @@ class ControllerEngine : public QObject {
     Q_INVOKABLE void reset(QString group, QString name);
     Q_INVOKABLE double getDefaultValue(QString group, QString name);
     Q_INVOKABLE double getDefaultParameter(QString group, QString name);
+    // Returns a ScriptControlHandle or undefined for an unknown control
+    Q_INVOKABLE QScriptValue getControl(QString group, QString name);
     Q_INVOKABLE QScriptValue makeConnection(QString group, QString name,
                                             const QScriptValue callback);
     // DEPRECATED: Use makeConnection instead.
@@ -190,9 +219,19 @@ class ControllerEngine : public QObject {
     QScriptEngine *m_pEngine;
 
     ControlObjectScript* getControlObjectScript(const QString& group, const QString& name);
+    // Applies soft takeover to the new value or parameter of a control
+    void setControlValue(ControlObjectScript* coScript, double newValue);
+    void setControlParameter(ControlObjectScript* coScript, double newParameter);
 
     // Scratching functions & variables
     void scratchProcess(int timerId);
+    ScratchTickQueue* scratchTickQueue(int deck);
+    // Hands jog wheel scratching over from the engine to scratchProcess().
+    // Unless takeOverRate is false, scratchProcess() continues from the
+    // last rate of the jog wheel once the engine has acknowledged the stop.
+    void stopScratchInEngine(int deck, bool takeOverRate = true);
+    // Returns false while the engine has not acknowledged a pending stop
+    bool takeOverScratchFromEngine(int deck);
 
     bool isDeckPlaying(const QString& group);
     double getDeckRate(const QString& group);
@@ -218,12 +257,24 @@ class ControllerEngine : public QObject {
     QVarLengthArray<double> m_dx, m_rampTo, m_rampFactor;
     QVarLengthArray<bool> m_ramp, m_brakeActive, m_softStartActive;
     QVarLengthArray<AlphaBetaFilter*> m_scratchFilters;
+    // The ticks of a scratching jog wheel are integrated by the engine
+    QVarLengthArray<bool> m_scratchInEngine;
+    QVarLengthArray<int> m_scratchSessions;
+    QVarLengthArray<bool> m_scratchStopPending;
+    QVarLengthArray<mixxx::Duration> m_scratchStopTime;
+    QVarLengthArray<double> m_scratchAlpha, m_scratchBeta;
+    QVector<QSharedPointer<ScratchTickQueue>> m_scratchTickQueues;
     QHash<int, int> m_scratchTimers;
     QHash<QString, QScriptValue> m_scriptWrappedFunctionCache;
+    // Code strings that are executed repeatedly, e.g. by timers, are only
+    // checked and compiled once. Scripts may also execute generated code
+    // strings, so only the most recently used programs are kept.
+    QCache<QString, QScriptProgram> m_scriptProgramCache;
     // Filesystem watcher for script auto-reload
     QFileSystemWatcher m_scriptWatcher;
     QList<QString> m_lastScriptPaths;
 
+    friend class ScriptControlHandle;
     friend class ControllerEngineTest;
 };
 
@@ -30,7 +30,10 @@
 namespace {
 // http://developer.qt.nokia.com/wiki/Threads_Events_QObjects
 
-// Poll every 1ms (where possible) for good controller response
+// Poll every 1ms (where possible) for good controller response. Only
+// devices without a ControllerReader thread are polled, i.e. PortMidi
+// devices: PortMidi provides nothing to wait on and must not be accessed
+// from multiple threads concurrently.
 #ifdef __LINUX__
 // Many Linux distros ship with the system tick set to 250Hz so 1ms timer
 // reportedly causes CPU hosage. See Bug #990992 rryan 6/2012
@@ -76,6 +79,9 @@ ControllerManager::ControllerManager(UserSettingsPointer pConfig)
     }
 
     m_pollTimer.setInterval(kPollIntervalMillis);
+    // Coarse timers may fire up to 5% of the interval late, which adds to
+    // the latency of jog wheels
+    m_pollTimer.setTimerType(Qt::PreciseTimer);
     connect(&m_pollTimer, SIGNAL(timeout()),
             this, SLOT(pollDevices()));
 
@@ -0,0 +1,158 @@
+#include "controllers/controlleroutputscheduler.h"
+
+#include <QtDebug>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+ControllerOutputScheduler::ControllerOutputScheduler(BatchWriter writer, QObject* parent)
+        : QObject(parent),
+          m_writer(std::move(writer)),
+          m_flushIntervalMillis(kDefaultFlushIntervalMillis),
+          m_maxMessagesPerBatch(kUnlimited),
+          m_pendingCount(0),
+          m_flushTimer(this) {
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_flushTimer, &QTimer::timeout,
+            this, &ControllerOutputScheduler::slotFlush);
+}
+
+ControllerOutputScheduler::~ControllerOutputScheduler() {
+    // Pending messages are lost, the device may already be closed
+}
+
+void ControllerOutputScheduler::setFlushInterval(int millis) {
+    VERIFY_OR_DEBUG_ASSERT(millis >= 0) {
+        millis = 0;
+    }
+    m_flushIntervalMillis = millis;
+}
+
+void ControllerOutputScheduler::setMaxMessagesPerBatch(int maxMessages) {
+    VERIFY_OR_DEBUG_ASSERT(maxMessages >= 0) {
+        maxMessages = kUnlimited;
+    }
+    m_maxMessagesPerBatch = maxMessages;
+}
+
+void ControllerOutputScheduler::schedule(qint64 key, const QByteArray& data) {
+    DEBUG_ASSERT(key != kReplaced);
+    bool replaced = false;
+    if (key != kNoCoalescing) {
+        const auto it = m_pendingIndex.find(key);
+        if (it != m_pendingIndex.end()) {
+            // Leave an empty slot instead of moving the following messages
+            Message& message = m_pending[it.value()];
+            message.key = kReplaced;
+            message.data = QByteArray();
+            --m_pendingCount;
+            m_pendingIndex.erase(it);
+            ++m_stats.coalesced;
+            replaced = true;
+        }
+    }
+    if (!replaced && m_pendingCount >= kMaxPendingMessages) {
+        ++m_stats.dropped;
+        return;
+    }
+    if (m_pending.size() >= 2 * kMaxPendingMessages) {
+        compactPending();
+    }
+    if (key != kNoCoalescing) {
+        m_pendingIndex.insert(key, m_pending.size());
+    }
+    m_pending.append(Message{key, data});
+    ++m_pendingCount;
+    startTimer();
+}
+
+void ControllerOutputScheduler::flushAll() {
+    m_flushTimer.stop();
+    if (m_pendingCount > 0) {
+        writeBatch(m_pendingCount);
+    }
+}
+
+void ControllerOutputScheduler::slotFlush() {
+    int count = m_pendingCount;
+    if (m_maxMessagesPerBatch != kUnlimited) {
+        count = math_min(count, m_maxMessagesPerBatch);
+    }
+    if (count > 0) {
+        writeBatch(count);
+    }
+    if (m_pendingCount > 0) {
+        // The rest is written after the next interval
+        startTimer();
+    }
+}
+
+void ControllerOutputScheduler::writeBatch(int count) {
+    DEBUG_ASSERT(count > 0 && count <= m_pendingCount);
+    Batch batch;
+    batch.reserve(count);
+    int end = 0;
+    while (batch.size() < count) {
+        DEBUG_ASSERT(end < m_pending.size());
+        const Message& message = m_pending[end++];
+        if (message.key != kReplaced) {
+            batch.append(message);
+        }
+    }
+    if (end == m_pending.size()) {
+        m_pending.clear();
+        m_pendingIndex.clear();
+    } else {
+        m_pending.remove(0, end);
+        reindexPending();
+    }
+    m_pendingCount -= count;
+    m_lastFlush.start();
+    m_stats.sent += batch.size();
+    ++m_stats.batches;
+    // The queue is consistent at this point in case the writer schedules
+    // new messages
+    m_writer(batch);
+}
+
+void ControllerOutputScheduler::compactPending() {
+    Batch pending;
+    pending.reserve(m_pendingCount);
+    for (const auto& message : qAsConst(m_pending)) {
+        if (message.key != kReplaced) {
+            pending.append(message);
+        }
+    }
+    m_pending.swap(pending);
+    reindexPending();
+}
+
+void ControllerOutputScheduler::reindexPending() {
+    m_pendingIndex.clear();
+    for (int i = 0; i < m_pending.size(); ++i) {
+        const qint64 key = m_pending[i].key;
+        if (key != kNoCoalescing && key != kReplaced) {
+            m_pendingIndex.insert(key, i);
+        }
+    }
+}
+
+void ControllerOutputScheduler::startTimer() {
+    if (m_flushTimer.isActive()) {
+        return;
+    }
+    int delayMillis = 0;
+    if (m_lastFlush.isValid()) {
+        delayMillis = math_max(
+                0, m_flushIntervalMillis - static_cast<int>(m_lastFlush.elapsed()));
+    }
+    m_flushTimer.start(delayMillis);
+}
+
+QDebug operator<<(QDebug dbg, const ControllerOutputScheduler::Stats& stats) {
+    return dbg << "sent" << stats.sent
+               << "in" << stats.batches << "batches,"
+               << "coalesced" << stats.coalesced
+               << "dropped" << stats.dropped;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <functional>
+
+// Coalesces the output of a controller and writes it in batches.
+//
+// Scripts and output mappings may update the same LED, VU meter or HID
+// report many times between two writes to the device. The scheduler keeps
+// only the last pending message per key and writes the pending messages at
+// most once per flush interval, limited to a maximum number of messages
+// per batch. The first message after an idle period is written on the next
+// iteration of the event loop without waiting for the interval.
+//
+// Messages are written in the order of their last update. A replaced
+// message moves to the end of the queue, so it is never written before
+// messages that have been scheduled in between, e.g. a SysEx message
+// that switches the mode of the device.
+//
+// The scheduler must be used from the thread it lives in.
+class ControllerOutputScheduler : public QObject {
+    Q_OBJECT
+  public:
+    // Messages with this key are never replaced, e.g. SysEx messages
+    static constexpr qint64 kNoCoalescing = -1;
+
+    static constexpr int kDefaultFlushIntervalMillis = 10;
+    // Without a limit on the number of messages per batch
+    static constexpr int kUnlimited = 0;
+    // Pending messages beyond this limit are dropped
+    static constexpr int kMaxPendingMessages = 4096;
+
+    struct Message {
+        qint64 key;
+        QByteArray data;
+    };
+    typedef QVector<Message> Batch;
+    typedef std::function<void(const Batch& batch)> BatchWriter;
+
+    struct Stats {
+        // Messages that have been handed to the writer
+        qint64 sent = 0;
+        // Batches that have been handed to the writer
+        qint64 batches = 0;
+        // Messages that have been replaced by a newer message with the same
+        // key before they were written
+        qint64 coalesced = 0;
+        // Messages that have been dropped, because too many messages were
+        // pending
+        qint64 dropped = 0;
+    };
+
+    ControllerOutputScheduler(BatchWriter writer, QObject* parent = nullptr);
+    ~ControllerOutputScheduler() override;
+
+    void setFlushInterval(int millis);
+    int flushInterval() const {
+        return m_flushIntervalMillis;
+    }
+    // kUnlimited writes all pending messages in a single batch
+    void setMaxMessagesPerBatch(int maxMessages);
+    int maxMessagesPerBatch() const {
+        return m_maxMessagesPerBatch;
+    }
+
+    // Queues a message for the next batch. A pending message with the same
+    // key is removed from the queue.
+    void schedule(qint64 key, const QByteArray& data);
+
+    // Writes all pending messages immediately, ignoring the rate limit.
+    // Needed before closing the device.
+    void flushAll();
+
+    int pendingMessages() const {
+        return m_pendingCount;
+    }
+    const Stats& stats() const {
+        return m_stats;
+    }
+
+  private slots:
+    void slotFlush();
+
+  private:
+    // Marks the slot of a message that has been replaced
+    static constexpr qint64 kReplaced = -2;
+
+    void writeBatch(int count);
+    // Removes the slots of replaced messages
+    void compactPending();
+    void reindexPending();
+    void startTimer();
+
+    const BatchWriter m_writer;
+    int m_flushIntervalMillis;
+    int m_maxMessagesPerBatch;
+
+    // Pending messages in the order in which they have been scheduled
+    // last, including the empty slots of replaced messages
+    Batch m_pending;
+    // The number of messages in m_pending that have not been replaced
+    int m_pendingCount;
+    // Index into m_pending by key
+    QHash<qint64, int> m_pendingIndex;
+
+    QTimer m_flushTimer;
+    // Measures the time since the last batch
+    QElapsedTimer m_lastFlush;
+    Stats m_stats;
+};
+
+QDebug operator<<(QDebug dbg, const ControllerOutputScheduler::Stats& stats);
@@ -0,0 +1,92 @@
+#include "controllers/controllerreader.h"
+
+#include <QtDebug>
+
+#include "util/assert.h"
+#include "util/compatibility.h"
+#include "util/time.h"
+#include "util/trace.h"
+
+ControllerReader::ControllerReader(bool writesOutput)
+        : QThread(),
+          m_bWritesOutput(writesOutput),
+          m_stop(0) {
+}
+
+ControllerReader::~ControllerReader() {
+}
+
+void ControllerReader::stop() {
+    m_stop = 1;
+}
+
+void ControllerReader::queueOutput(const QList<QByteArray>& packets) {
+    VERIFY_OR_DEBUG_ASSERT(m_bWritesOutput) {
+        return;
+    }
+    QMutexLocker locker(&m_outputMutex);
+    m_queuedOutput.append(packets);
+}
+
+void ControllerReader::write(const QByteArray& packet) {
+    Q_UNUSED(packet);
+    DEBUG_ASSERT(!"ControllerReader::write() not implemented");
+}
+
+bool ControllerReader::writeQueuedOutput() {
+    QList<QByteArray> packets;
+    {
+        QMutexLocker locker(&m_outputMutex);
+        packets.swap(m_queuedOutput);
+    }
+    for (const auto& packet : packets) {
+        write(packet);
+    }
+    return !packets.isEmpty();
+}
+
+void ControllerReader::run() {
+    const auto activeTimeout = mixxx::Duration::fromMillis(kActiveTimeoutMillis);
+    // The time of the last input or output while the device is in use
+    mixxx::Duration lastActivity;
+    bool active = false;
+    unsigned char data[kMaxPacketSize];
+    while (atomicLoadAcquire(m_stop) == 0) {
+        int timeoutMillis = kReadTimeoutMillis;
+        if (m_bWritesOutput) {
+            const mixxx::Duration now = mixxx::Time::elapsed();
+            if (writeQueuedOutput()) {
+                active = true;
+                lastActivity = now;
+            } else if (active && now - lastActivity > activeTimeout) {
+                // Let the idle device sleep
+                active = false;
+            }
+            if (active) {
+                // Output that is queued in response to input must not
+                // wait for the timeout
+                timeoutMillis = kMaxOutputDelayMillis;
+            }
+        }
+        const int result = read(data, sizeof(data), timeoutMillis);
+        if (result > 0) {
+            // The thread has been woken up by the new data
+            const mixxx::Duration timestamp = mixxx::Time::elapsed();
+            Trace process("ControllerReader process packet");
+            emit incomingData(
+                    QByteArray(reinterpret_cast<const char*>(data), result),
+                    timestamp);
+            active = true;
+            lastActivity = timestamp;
+        } else if (result < 0) {
+            // Retrying would spin, e.g. after the device has been unplugged
+            qWarning() << "Failed to read from" << objectName()
+                       << "- input of the device stopped";
+            return;
+        }
+    }
+    if (m_bWritesOutput) {
+        writeQueuedOutput();
+    }
+    qDebug() << "Stopped" << objectName();
+}
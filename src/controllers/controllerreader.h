@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+
+#include "util/duration.h"
+
+// Reads the input of a controller in a dedicated thread.
+//
+// The thread sleeps in read() until the device has data, so idle devices
+// don't use any CPU and new input does not have to wait for the next poll
+// of the controller thread. Each packet is timestamped as soon as read()
+// returns and delivered through incomingData().
+//
+// Devices whose API must not be used concurrently from different threads,
+// like hidapi, also write their output through the reader thread. The
+// queued output is written between two reads. A blocking read cannot be
+// interrupted, so these readers wait at most kMaxOutputDelayMillis per
+// read while the device is in use, i.e. until kActiveTimeoutMillis have
+// passed without any input or output. Idle devices wait for the regular
+// kReadTimeoutMillis and the first output after an idle period is
+// delayed by that timeout at most.
+class ControllerReader : public QThread {
+    Q_OBJECT
+  public:
+    explicit ControllerReader(bool writesOutput = false);
+    ~ControllerReader() override;
+
+    // Requests the thread to stop. The thread notices the request after
+    // the pending read() has returned, i.e. after kReadTimeoutMillis at
+    // most. Output that has been queued before is still written.
+    void stop();
+
+    // Queues output that is written by the reader thread in order. Only
+    // supported if the reader has been constructed with writesOutput.
+    void queueOutput(const QList<QByteArray>& packets);
+
+    static constexpr int kReadTimeoutMillis = 100;
+    static constexpr int kMaxOutputDelayMillis = 5;
+    static constexpr int kActiveTimeoutMillis = 1000;
+    // The largest packet of all supported devices
+    static constexpr int kMaxPacketSize = 255;
+
+  signals:
+    void incomingData(QByteArray data, mixxx::Duration timestamp);
+
+  protected:
+    // Blocks until data is available or timeoutMillis have elapsed.
+    // Returns the number of bytes that have been written to pData, 0 on
+    // timeout or a negative value if the device has failed.
+    virtual int read(unsigned char* pData, int maxSize, int timeoutMillis) = 0;
+
+    // Writes a packet of queued output. Only invoked from the reader
+    // thread if the reader has been constructed with writesOutput.
+    virtual void write(const QByteArray& packet);
+
+    void run() override;
+
+  private:
+    // Returns true if any output has been written
+    bool writeQueuedOutput();
+
+    const bool m_bWritesOutput;
+    QAtomicInt m_stop;
+    QMutex m_outputMutex;
+    QList<QByteArray> m_queuedOutput;
+};
@@ -12,12 +12,49 @@
 #include "util/path.h" // for PATH_MAX on Windows
 #include "controllers/hid/hidcontroller.h"
 #include "controllers/defs_controllers.h"
-#include "util/trace.h"
 #include "controllers/controllerdebug.h"
-#include "util/time.h"
+
+namespace {
+
+// The report starts with the report ID
+void writeReport(hid_device* pHidDevice,
+        const QByteArray& report,
+        const QString& deviceName) {
+    int result = hid_write(pHidDevice,
+            reinterpret_cast<const unsigned char*>(report.constData()),
+            report.size());
+    if (result == -1) {
+        qWarning() << "Unable to send data to" << deviceName << ":"
+                   << HidController::safeDecodeWideString(hid_error(pHidDevice), 512);
+    } else {
+        controllerDebug(result << "bytes sent to" << deviceName
+                 << "(including report ID of"
+                 << static_cast<unsigned char>(report.at(0)) << ")");
+    }
+}
+
+} // anonymous namespace
+
+HidReader::HidReader(hid_device* pHidDevice, const QString& deviceName)
+        : ControllerReader(true),
+          m_pHidDevice(pHidDevice),
+          m_deviceName(deviceName) {
+}
+
+HidReader::~HidReader() {
+}
+
+int HidReader::read(unsigned char* pData, int maxSize, int timeoutMillis) {
+    return hid_read_timeout(m_pHidDevice, pData, maxSize, timeoutMillis);
+}
+
+void HidReader::write(const QByteArray& report) {
+    writeReport(m_pHidDevice, report, m_deviceName);
+}
 
 HidController::HidController(const hid_device_info deviceInfo)
-        : m_pHidDevice(NULL) {
+        : m_pHidDevice(NULL),
+          m_pReader(NULL) {
     // Copy required variables from deviceInfo, which will be freed after
     // this class is initialized by caller.
     hid_vendor_id = deviceInfo.vendor_id;
@@ -222,6 +259,20 @@ int HidController::open() {
     setOpen(true);
     startEngine();
 
+    if (m_pReader != NULL) {
+        qWarning() << "HidReader already present for" << getName();
+    } else {
+        m_pReader = new HidReader(m_pHidDevice, getName());
+        m_pReader->setObjectName(QString("HidReader %1").arg(getName()));
+
+        connect(m_pReader, SIGNAL(incomingData(QByteArray, mixxx::Duration)),
+                this, SLOT(receive(QByteArray, mixxx::Duration)));
+
+        // Controller input needs to be prioritized since it can affect the
+        // audio directly, like when scratching
+        m_pReader->start(QThread::HighPriority);
+    }
+
     return 0;
 }
 
@@ -233,6 +284,20 @@ int HidController::close() {
 
     qDebug() << "Shutting down HID device" << getName();
 
+    // Stop the reading thread
+    if (m_pReader == NULL) {
+        qWarning() << "HidReader not present for" << getName()
+                   << "yet the device is open!";
+    } else {
+        disconnect(m_pReader, SIGNAL(incomingData(QByteArray, mixxx::Duration)),
+                   this, SLOT(receive(QByteArray, mixxx::Duration)));
+        m_pReader->stop();
+        controllerDebug("  Waiting on reader to finish");
+        m_pReader->wait();
+        delete m_pReader;
+        m_pReader = NULL;
+    }
+
     // Stop controller engine here to ensure it's done before the device is closed
     //  in case it has any final parting messages
     stopEngine();
@@ -244,32 +309,37 @@ int HidController::close() {
     return 0;
 }
 
-bool HidController::poll() {
-    Trace hidRead("HidController poll");
-
-    int result = hid_read(m_pHidDevice, m_pPollData, sizeof(m_pPollData) / sizeof(m_pPollData[0]));
-    if (result == -1) {
-        return false;
-    } else if (result > 0) {
-        Trace process("HidController process packet");
-        QByteArray outData(reinterpret_cast<char*>(m_pPollData), result);
-        receive(outData, mixxx::Time::elapsed());
-    }
-
-    return true;
-}
-
-bool HidController::isPolling() const {
-    return isOpen();
-}
-
 void HidController::send(QList<int> data, unsigned int length, unsigned int reportID) {
     Q_UNUSED(length);
     QByteArray temp;
     foreach (int datum, data) {
         temp.append(datum);
     }
-    send(temp, reportID);
+    if (reportID == 0) {
+        // Devices with a single unnumbered report, but also scripts that
+        // send different reports with ID 0 and tell them apart by their
+        // content, e.g. the Traktor S4 MK2. These must not replace each
+        // other.
+        scheduleOutput(ControllerOutputScheduler::kNoCoalescing, temp);
+    } else {
+        scheduleOutput(reportID, temp);
+    }
+}
+
+void HidController::writeOutput(const ControllerOutputScheduler::Batch& batch) {
+    QList<QByteArray> reports;
+    reports.reserve(batch.size());
+    for (const auto& message : batch) {
+        unsigned int reportID = 0;
+        if (message.key != ControllerOutputScheduler::kNoCoalescing) {
+            reportID = static_cast<unsigned int>(message.key);
+        }
+        // Append the Report ID to the beginning of data[] per the API..
+        QByteArray report = message.data;
+        report.prepend(reportID);
+        reports.append(report);
+    }
+    writeReports(reports);
 }
 
 void HidController::send(QByteArray data) {
@@ -279,21 +349,19 @@ void HidController::send(QByteArray data) {
 void HidController::send(QByteArray data, unsigned int reportID) {
     // Append the Report ID to the beginning of data[] per the API..
     data.prepend(reportID);
+    writeReports(QList<QByteArray>{data});
+}
 
-    int result = hid_write(m_pHidDevice, (unsigned char*)data.constData(), data.size());
-    if (result == -1) {
-        if (ControllerDebug::enabled()) {
-            qWarning() << "Unable to send data to" << getName()
-                       << "serial #" << hid_serial << ":"
-                       << safeDecodeWideString(hid_error(m_pHidDevice), 512);
-        } else {
-            qWarning() << "Unable to send data to" << getName() << ":"
-                       << safeDecodeWideString(hid_error(m_pHidDevice), 512);
-        }
-    } else {
-        controllerDebug(result << "bytes sent to" << getName()
-                 << "serial #" << hid_serial
-                 << "(including report ID of" << reportID << ")");
+void HidController::writeReports(const QList<QByteArray>& reports) {
+    // hidapi must not write while the reader thread reads from the same
+    // device. Without a running reader, e.g. while closing the device,
+    // the reports are written directly.
+    if (m_pReader != NULL && m_pReader->isRunning()) {
+        m_pReader->queueOutput(reports);
+        return;
+    }
+    for (const auto& report : reports) {
+        writeReport(m_pHidDevice, report, getName());
     }
 }
 
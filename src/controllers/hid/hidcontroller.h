@@ -13,10 +13,30 @@
 #include <QAtomicInt>
 
 #include "controllers/controller.h"
+#include "controllers/controllerreader.h"
 #include "controllers/hid/hidcontrollerpreset.h"
 #include "controllers/hid/hidcontrollerpresetfilehandler.h"
 #include "util/duration.h"
 
+// Blocks in hid_read_timeout() until the device sends a report.
+//
+// hidapi is not thread-safe for a single device, so the output reports
+// are written by this thread as well while it is running.
+class HidReader : public ControllerReader {
+    Q_OBJECT
+  public:
+    HidReader(hid_device* pHidDevice, const QString& deviceName);
+    ~HidReader() override;
+
+  protected:
+    int read(unsigned char* pData, int maxSize, int timeoutMillis) override;
+    void write(const QByteArray& report) override;
+
+  private:
+    hid_device* m_pHidDevice;
+    const QString m_deviceName;
+};
+
 class HidController final : public Controller {
     Q_OBJECT
   public:
@@ -51,20 +71,24 @@ class HidController final : public Controller {
     static QString safeDecodeWideString(const wchar_t* pStr, size_t max_length);
 
   protected:
+    // Queues the report for the next batch of output. An output report
+    // holds the complete state of its part of the device, so a pending
+    // report with the same ID is replaced. Unnumbered reports with ID 0
+    // are never replaced.
     Q_INVOKABLE void send(QList<int> data, unsigned int length, unsigned int reportID = 0);
 
   private slots:
     int open() override;
     int close() override;
 
-    bool poll() override;
-    bool isPolling() const override;
-
   private:
     // For devices which only support a single report, reportID must be set to
     // 0x0.
     void send(QByteArray data) override;
     void virtual send(QByteArray data, unsigned int reportID);
+    void writeOutput(const ControllerOutputScheduler::Batch& batch) override;
+    // Each report starts with its report ID
+    void writeReports(const QList<QByteArray>& reports);
 
     // Returns a pointer to the currently loaded controller preset. For internal
     // use only.
@@ -89,9 +113,8 @@ class HidController final : public Controller {
 
     QString m_sUID;
     hid_device* m_pHidDevice;
+    HidReader* m_pReader;
     HidControllerPreset m_preset;
-
-    unsigned char m_pPollData[255];
 };
 
 #endif
@@ -169,8 +169,8 @@ int Hss1394Controller::close() {
     return 0;
 }
 
-void Hss1394Controller::sendShortMsg(unsigned char status, unsigned char byte1,
-                                     unsigned char byte2) {
+void Hss1394Controller::writeShortMsg(unsigned char status, unsigned char byte1,
+                                      unsigned char byte2) {
     unsigned char data[3] = { status, byte1, byte2 };
 
     int bytesSent = m_pChannel->SendChannelBytes(data, 3);
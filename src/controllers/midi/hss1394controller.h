@@ -51,8 +51,8 @@ class Hss1394Controller : public MidiController {
     int close() override;
 
   protected:
-    void sendShortMsg(unsigned char status, unsigned char byte1,
-                      unsigned char byte2) override;
+    void writeShortMsg(unsigned char status, unsigned char byte1,
+                       unsigned char byte2) override;
 
   private:
     // The sysex data must already contain the start byte 0xf0 and the end byte
@@ -17,9 +17,19 @@
 #include "util/math.h"
 #include "util/screensaver.h"
 
+namespace {
+
+// Limits the output to 3200 messages per second with the default flush
+// interval of 10 ms. Larger bursts, e.g. when a script initializes all
+// LEDs, are spread across several batches.
+const int kMaxMessagesPerBatch = 32;
+
+} // anonymous namespace
+
 MidiController::MidiController()
         : Controller() {
     setDeviceCategory(tr("MIDI Controller"));
+    outputScheduler()->setMaxMessagesPerBatch(kMaxMessagesPerBatch);
 }
 
 MidiController::~MidiController() {
@@ -37,6 +47,70 @@ void MidiController::visit(const MidiControllerPreset* preset) {
     emit presetLoaded(getPreset());
 }
 
+void MidiController::sendShortMsg(unsigned char status,
+                                  unsigned char byte1, unsigned char byte2) {
+    QByteArray message(3, 0);
+    message[0] = status;
+    message[1] = byte1;
+    message[2] = byte2;
+    scheduleOutput(shortMsgOutputKey(status, byte1), message);
+}
+
+// static
+qint64 MidiController::shortMsgOutputKey(unsigned char status, unsigned char byte1) {
+    const unsigned char channel = MidiUtils::channelFromStatus(status);
+    switch (MidiUtils::opCodeFromStatus(status)) {
+    case MIDI_NOTE_OFF:
+    case MIDI_NOTE_ON:
+        // Note on and off set the same LED, so the last one of both wins
+        return (static_cast<qint64>(MIDI_NOTE_ON | channel) << 8) | byte1;
+    case MIDI_AFTERTOUCH:
+        return (static_cast<qint64>(status) << 8) | byte1;
+    case MIDI_CC:
+        switch (byte1) {
+        case 0x06: // Data entry MSB
+        case 0x26: // Data entry LSB
+        case 0x60: // Data increment
+        case 0x61: // Data decrement
+        case 0x62: // NRPN LSB
+        case 0x63: // NRPN MSB
+        case 0x64: // RPN LSB
+        case 0x65: // RPN MSB
+            // The meaning of these depends on the preceding messages
+            return ControllerOutputScheduler::kNoCoalescing;
+        default:
+            return (static_cast<qint64>(status) << 8) | byte1;
+        }
+    case MIDI_CH_AFTERTOUCH:
+    case MIDI_PITCH_BEND:
+        // byte1 is part of the value
+        return static_cast<qint64>(status) << 8;
+    default:
+        // Program changes and system messages are events, not states
+        return ControllerOutputScheduler::kNoCoalescing;
+    }
+}
+
+void MidiController::writeOutput(const ControllerOutputScheduler::Batch& batch) {
+    for (const auto& message : batch) {
+        const unsigned char status = message.data.at(0);
+        if (status == MIDI_SYSEX) {
+            send(message.data);
+        } else if (message.data.size() <= 3) {
+            // Short messages like program changes have less than two data
+            // bytes. The device only sends the bytes that belong to the
+            // status.
+            const unsigned char byte1 =
+                    message.data.size() > 1 ? message.data.at(1) : 0;
+            const unsigned char byte2 =
+                    message.data.size() > 2 ? message.data.at(2) : 0;
+            writeShortMsg(status, byte1, byte2);
+        } else {
+            send(message.data);
+        }
+    }
+}
+
 int MidiController::close() {
     destroyOutputHandlers();
     return 0;
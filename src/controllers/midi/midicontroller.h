@@ -56,8 +56,14 @@ class MidiController : public Controller {
                          unsigned char value);
 
   protected:
-    Q_INVOKABLE virtual void sendShortMsg(unsigned char status,
-                                          unsigned char byte1, unsigned char byte2) = 0;
+    // Queues a short message for the next batch of output. A pending message
+    // that sets the same note, control or channel value is replaced.
+    Q_INVOKABLE void sendShortMsg(unsigned char status,
+                                  unsigned char byte1, unsigned char byte2);
+
+    // Writes a short message to the device immediately
+    virtual void writeShortMsg(unsigned char status,
+                               unsigned char byte1, unsigned char byte2) = 0;
 
     // Alias for send()
     // The length parameter is here for backwards compatibility for when scripts
@@ -83,6 +89,11 @@ class MidiController : public Controller {
     void commitTemporaryInputMappings();
 
   private:
+    void writeOutput(const ControllerOutputScheduler::Batch& batch) override;
+    // Returns the key of pending messages that are replaced by a short
+    // message or ControllerOutputScheduler::kNoCoalescing
+    static qint64 shortMsgOutputKey(unsigned char status, unsigned char byte1);
+
     void processInputMapping(const MidiInputMapping& mapping,
                              unsigned char status,
                              unsigned char control,
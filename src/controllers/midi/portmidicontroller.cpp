@@ -204,8 +204,8 @@ bool PortMidiController::poll() {
     return numEvents > 0;
 }
 
-void PortMidiController::sendShortMsg(unsigned char status, unsigned char byte1,
-                                      unsigned char byte2) {
+void PortMidiController::writeShortMsg(unsigned char status, unsigned char byte1,
+                                       unsigned char byte2) {
     if (m_pOutputDevice.isNull() || !m_pOutputDevice->isOpen()) {
         return;
     }
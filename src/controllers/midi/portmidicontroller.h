@@ -72,8 +72,8 @@ class PortMidiController : public MidiController {
 
   protected:
     // MockPortMidiController needs this to not be private.
-    void sendShortMsg(unsigned char status, unsigned char byte1,
-                      unsigned char byte2) override;
+    void writeShortMsg(unsigned char status, unsigned char byte1,
+                       unsigned char byte2) override;
 
   private:
     // The sysex data must already contain the start byte 0xf0 and the end byte
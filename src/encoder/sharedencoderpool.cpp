@@ -0,0 +1,317 @@
+#include "encoder/sharedencoderpool.h"
+
+#include <QMutexLocker>
+
+#include "recording/defs_recording.h"
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SharedEncoderPool");
+
+// A subscriber takes over feeding the shared encoder if it has received
+// this many buffers in a row without the feeder having fed the encoder in
+// between, e.g. because the feeder's connection has been lost. Connections
+// receive their buffers at the same rate, so this only happens once the
+// feeder has stopped.
+const int kMaxMissedFeeds = 4;
+
+EncoderPointer createEncoderWithFactory(
+        EncoderSettingsPointer pSettings,
+        EncoderCallback* pCallback) {
+    return EncoderFactory::getFactory().createEncoder(pSettings, pCallback);
+}
+
+} // anonymous namespace
+
+// Receives the encoded data of the shared encoder and queues it for all
+// subscribers.
+class SharedEncoderPool::SharedEncoder : public EncoderCallback {
+  public:
+    explicit SharedEncoder(const QString& key)
+            : m_key(key),
+              m_pFeeder(nullptr),
+              m_feedCount(0) {
+    }
+
+    ~SharedEncoder() {
+        // The encoder may write its remaining data, which is dropped
+        DEBUG_ASSERT(m_subscribers.isEmpty());
+        m_pEncoder.reset();
+        kLogger.debug() << "Released shared encoder" << m_key;
+    }
+
+    void setEncoder(EncoderPointer pEncoder) {
+        m_pEncoder = std::move(pEncoder);
+    }
+    const EncoderPointer& encoder() const {
+        return m_pEncoder;
+    }
+
+    void subscribe(Client* pClient) {
+        QMutexLocker locker(&m_mutex);
+        m_subscribers.append(pClient);
+        kLogger.debug() << "Shared encoder" << m_key
+                        << "has" << m_subscribers.size() << "subscribers";
+    }
+
+    void unsubscribe(Client* pClient) {
+        QMutexLocker locker(&m_mutex);
+        m_subscribers.removeOne(pClient);
+        if (m_pFeeder == pClient) {
+            // The next subscriber that receives samples feeds the encoder
+            m_pFeeder = nullptr;
+        }
+    }
+
+    void encode(Client* pClient, const CSAMPLE* pSamples, int size);
+
+    // Called by the encoder with m_mutex locked
+    void write(const unsigned char* header,
+            const unsigned char* body,
+            int headerLen,
+            int bodyLen) override;
+    int tell() override {
+        return -1;
+    }
+    void seek(int pos) override {
+        Q_UNUSED(pos);
+    }
+    int filelen() override {
+        return 0;
+    }
+
+  private:
+    const QString m_key;
+    EncoderPointer m_pEncoder;
+
+    QMutex m_mutex;
+    QList<Client*> m_subscribers;
+    // The subscriber whose samples are encoded
+    Client* m_pFeeder;
+    // The number of buffers that the feeder has encoded
+    quint64 m_feedCount;
+};
+
+// The encoder of a single connection
+class SharedEncoderPool::Client
+        : public Encoder,
+          public std::enable_shared_from_this<Client> {
+  public:
+    Client(SharedEncoderPool* pPool,
+            EncoderSettingsPointer pSettings,
+            EncoderCallback* pCallback)
+            : m_pPool(pPool),
+              m_pSettings(std::move(pSettings)),
+              m_pCallback(pCallback),
+              m_queuedBytes(0),
+              m_droppedBytes(0),
+              m_lastFeedCount(0),
+              m_missedFeeds(0) {
+    }
+
+    ~Client() override {
+        if (m_pSharedEncoder) {
+            m_pSharedEncoder->unsubscribe(this);
+        }
+    }
+
+    int initEncoder(int samplerate, QString errorMessage) override {
+        if (m_pSharedEncoder) {
+            m_pSharedEncoder->unsubscribe(this);
+        }
+        m_pSharedEncoder = m_pPool->subscribe(m_pSettings, samplerate, this, &errorMessage);
+        return m_pSharedEncoder ? 0 : -1;
+    }
+
+    void encodeBuffer(const CSAMPLE* samples, const int size) override {
+        if (!m_pSharedEncoder) {
+            return;
+        }
+        // The connection may release this encoder when a write fails
+        const auto pKeepAlive = shared_from_this();
+        m_pSharedEncoder->encode(this, samples, size);
+        writeQueued();
+    }
+
+    void updateMetaData(const QString& artist,
+            const QString& title,
+            const QString& album) override {
+        // The metadata of MP3 streams is sent by the connection
+        Q_UNUSED(artist);
+        Q_UNUSED(title);
+        Q_UNUSED(album);
+    }
+
+    void flush() override {
+        const auto pKeepAlive = shared_from_this();
+        writeQueued();
+    }
+
+    void setEncoderSettings(const EncoderSettings& settings) override {
+        // The settings are passed to the constructor, they must match the
+        // shared encoder
+        Q_UNUSED(settings);
+    }
+
+    // Called by the shared encoder with its mutex locked. Returns true if
+    // the feeder has not encoded any buffers during the last
+    // kMaxMissedFeeds buffers of this subscriber.
+    bool hasFeederStopped(quint64 feedCount) {
+        if (feedCount != m_lastFeedCount) {
+            m_lastFeedCount = feedCount;
+            m_missedFeeds = 0;
+            return false;
+        }
+        return ++m_missedFeeds >= kMaxMissedFeeds;
+    }
+
+    // Called by the shared encoder from the thread of the feeder
+    void enqueue(const QByteArray& data) {
+        QMutexLocker locker(&m_queueMutex);
+        while (!m_queue.isEmpty() && m_queuedBytes + data.size() > kMaxQueuedBytes) {
+            m_queuedBytes -= m_queue.first().size();
+            m_droppedBytes += m_queue.first().size();
+            m_queue.removeFirst();
+        }
+        m_queue.append(data);
+        m_queuedBytes += data.size();
+    }
+
+  private:
+    void writeQueued() {
+        QList<QByteArray> queue;
+        int droppedBytes;
+        {
+            QMutexLocker locker(&m_queueMutex);
+            queue.swap(m_queue);
+            m_queuedBytes = 0;
+            droppedBytes = m_droppedBytes;
+            m_droppedBytes = 0;
+        }
+        if (droppedBytes > 0) {
+            kLogger.warning() << "Dropped" << droppedBytes
+                              << "bytes of encoded data, the connection is too slow";
+        }
+        for (const QByteArray& data : queue) {
+            m_pCallback->write(nullptr,
+                    reinterpret_cast<const unsigned char*>(data.constData()),
+                    0,
+                    data.size());
+        }
+    }
+
+    SharedEncoderPool* const m_pPool;
+    const EncoderSettingsPointer m_pSettings;
+    EncoderCallback* const m_pCallback;
+    std::shared_ptr<SharedEncoder> m_pSharedEncoder;
+
+    QMutex m_queueMutex;
+    QList<QByteArray> m_queue;
+    int m_queuedBytes;
+    int m_droppedBytes;
+
+    // Only accessed by the shared encoder with its mutex locked
+    quint64 m_lastFeedCount;
+    int m_missedFeeds;
+};
+
+void SharedEncoderPool::SharedEncoder::encode(
+        Client* pClient, const CSAMPLE* pSamples, int size) {
+    QMutexLocker locker(&m_mutex);
+    // A connection only receives samples while it is connected to its
+    // server, so the subscribers must not rely on a fixed leader.
+    if (pClient != m_pFeeder) {
+        if (m_pFeeder && !pClient->hasFeederStopped(m_feedCount)) {
+            // Encoded by the feeder
+            return;
+        }
+        kLogger.debug() << "Shared encoder" << m_key << "is fed by a new subscriber";
+        m_pFeeder = pClient;
+    }
+    ++m_feedCount;
+    // Calls write() below
+    m_pEncoder->encodeBuffer(pSamples, size);
+}
+
+void SharedEncoderPool::SharedEncoder::write(const unsigned char* header,
+        const unsigned char* body,
+        int headerLen,
+        int bodyLen) {
+    QByteArray data;
+    data.reserve(headerLen + bodyLen);
+    if (headerLen > 0) {
+        data.append(reinterpret_cast<const char*>(header), headerLen);
+    }
+    data.append(reinterpret_cast<const char*>(body), bodyLen);
+    // The implicitly shared data is not copied
+    for (Client* pClient : m_subscribers) {
+        pClient->enqueue(data);
+    }
+}
+
+SharedEncoderPool::SharedEncoderPool(EncoderCreator creator)
+        : m_creator(creator ? std::move(creator) : EncoderCreator(createEncoderWithFactory)) {
+}
+
+EncoderPointer SharedEncoderPool::createEncoder(
+        EncoderSettingsPointer pSettings,
+        EncoderCallback* pCallback) {
+    VERIFY_OR_DEBUG_ASSERT(pSettings) {
+        return m_creator(pSettings, pCallback);
+    }
+    if (!isShareable(*pSettings)) {
+        return m_creator(pSettings, pCallback);
+    }
+    return std::make_shared<Client>(this, pSettings, pCallback);
+}
+
+// static
+bool SharedEncoderPool::isShareable(const EncoderSettings& settings) {
+    return settings.getFormat() == ENCODING_MP3;
+}
+
+int SharedEncoderPool::sharedEncoderCount() const {
+    QMutexLocker locker(&m_mutex);
+    int count = 0;
+    for (const auto& pSharedEncoder : m_sharedEncoders) {
+        if (!pSharedEncoder.expired()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::shared_ptr<SharedEncoderPool::SharedEncoder> SharedEncoderPool::subscribe(
+        EncoderSettingsPointer pSettings,
+        int sampleRate,
+        Client* pClient,
+        QString* pErrorMessage) {
+    const QString key = sharedEncoderKey(*pSettings, sampleRate);
+    QMutexLocker locker(&m_mutex);
+    std::shared_ptr<SharedEncoder> pSharedEncoder = m_sharedEncoders.value(key).lock();
+    if (!pSharedEncoder) {
+        pSharedEncoder = std::make_shared<SharedEncoder>(key);
+        pSharedEncoder->setEncoder(m_creator(pSettings, pSharedEncoder.get()));
+        if (!pSharedEncoder->encoder() ||
+                pSharedEncoder->encoder()->initEncoder(sampleRate, *pErrorMessage) < 0) {
+            kLogger.warning() << "Failed to initialize shared encoder" << key;
+            return nullptr;
+        }
+        m_sharedEncoders.insert(key, pSharedEncoder);
+        kLogger.debug() << "Created shared encoder" << key;
+    }
+    pSharedEncoder->subscribe(pClient);
+    return pSharedEncoder;
+}
+
+// static
+QString SharedEncoderPool::sharedEncoderKey(
+        const EncoderSettings& settings, int sampleRate) {
+    return QString("%1 %2 kbit/s channels %3 %4 Hz")
+            .arg(settings.getFormat(),
+                    QString::number(settings.getQuality()),
+                    QString::number(static_cast<int>(settings.getChannelMode())),
+                    QString::number(sampleRate));
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <functional>
+#include <memory>
+
+#include "encoder/encoder.h"
+#include "encoder/encodercallback.h"
+#include "encoder/encodersettings.h"
+#include "util/types.h"
+
+// Shares one encoder between all broadcast connections that stream with the
+// same codec, bitrate, channels and sample rate, so the expensive encode runs
+// once instead of once per connection.
+//
+// Every connection gets its own lightweight Encoder from createEncoder(). The
+// first subscriber that receives samples (the feeder) feeds the shared
+// encoder in its own thread, the samples of the other subscribers are
+// discarded. The encoded data is queued for all subscribers and passed to
+// their EncoderCallback from their own thread, so a stalled server connection
+// never blocks the others. A connection only receives samples while it is
+// connected, so when the feeder leaves or stops receiving samples, another
+// subscriber that still receives them takes over.
+//
+// Only MP3 streams are shared. An Ogg stream starts with header pages that a
+// connection joining later would miss and its metadata is part of the stream,
+// which is different for every connection.
+class SharedEncoderPool {
+  public:
+    typedef std::function<EncoderPointer(
+            EncoderSettingsPointer pSettings, EncoderCallback* pCallback)>
+            EncoderCreator;
+
+    // Limits the encoded data queued for a connection that does not process
+    // its samples, about 20 s of MP3 at 192 kbit/s. Older data is dropped.
+    static constexpr int kMaxQueuedBytes = 491520;
+
+    // Creates the encoders with the EncoderFactory by default
+    explicit SharedEncoderPool(EncoderCreator creator = EncoderCreator());
+
+    // Returns a new encoder that writes to pCallback. The encoder is
+    // subscribed to the shared encoder in initEncoder(). The pool must
+    // outlive the returned encoder. Thread-safe.
+    EncoderPointer createEncoder(
+            EncoderSettingsPointer pSettings,
+            EncoderCallback* pCallback);
+
+    static bool isShareable(const EncoderSettings& settings);
+
+    // The number of encoders that are currently shared
+    int sharedEncoderCount() const;
+
+  private:
+    class SharedEncoder;
+    class Client;
+
+    std::shared_ptr<SharedEncoder> subscribe(
+            EncoderSettingsPointer pSettings,
+            int sampleRate,
+            Client* pClient,
+            QString* pErrorMessage);
+
+    static QString sharedEncoderKey(const EncoderSettings& settings, int sampleRate);
+
+    const EncoderCreator m_creator;
+
+    mutable QMutex m_mutex;
+    QHash<QString, std::weak_ptr<SharedEncoder>> m_sharedEncoders;
+};
+
+typedef std::shared_ptr<SharedEncoderPool> SharedEncoderPoolPointer;
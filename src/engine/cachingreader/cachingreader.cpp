@@ -272,6 +272,19 @@ void CachingReader::process() {
                 // Reset the readable frame index range
                 m_readableFrameIndexRange = update.readableFrameIndexRange();
                 m_state.storeRelease(STATE_TRACK_LOADED);
+                // Request the chunks around the main cue point and at
+                // the start of the track right away. Playback will most
+                // likely start from one of these positions and they are
+                // already decoded when the engine seeks to it.
+                HintVector preloadHints;
+                Hint preloadHint;
+                preloadHint.frameCount = Hint::kFrameCountForward;
+                preloadHint.priority = 1;
+                preloadHint.frame = update.preloadFrame();
+                preloadHints.append(preloadHint);
+                preloadHint.frame = m_readableFrameIndexRange.start();
+                preloadHints.append(preloadHint);
+                hintAndMaybeWake(preloadHints);
             } else {
                 DEBUG_ASSERT(update.status == TRACK_UNLOADED);
                 // This message could be processed later when a new
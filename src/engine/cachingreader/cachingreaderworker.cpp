@@ -9,6 +9,7 @@
 #include "util/compatibility.h"
 #include "util/event.h"
 #include "util/logger.h"
+#include "util/sample.h"
 
 
 namespace {
@@ -26,6 +27,7 @@ CachingReaderWorker::CachingReaderWorker(
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
           m_pReaderStatusFIFO(pReaderStatusFIFO),
           m_newTrackAvailable(false),
+          m_firstChunkPending(false),
           m_stop(0) {
 }
 
@@ -69,6 +71,14 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         }
     }
 
+    if (m_firstChunkPending && status == CHUNK_READ_SUCCESS) {
+        m_firstChunkPending = false;
+        kLogger.debug()
+                << m_group
+                << "Time to first audio:"
+                << m_loadTimer.elapsed().formatMillisWithUnit();
+    }
+
     ReaderStatusUpdate result;
     result.init(status, pChunk, m_pAudioSource ? m_pAudioSource->frameIndexRange() : mixxx::IndexRange());
     return result;
@@ -123,6 +133,7 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
 
     // Unload the track
     m_pAudioSource.reset(); // Close open file handles
+    m_firstChunkPending = false;
 
     if (!pTrack) {
         // If no new track is available then we are done
@@ -134,6 +145,8 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
     // Emit that a new track is loading, stops the current track
     emit trackLoading();
 
+    m_loadTimer.start();
+
     QString filename = pTrack->getLocation();
     if (filename.isEmpty() || !pTrack->checkFileExists()) {
         kLogger.warning()
@@ -185,10 +198,25 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
         mixxx::SampleBuffer(tempReadBufferSize).swap(m_tempReadBuffer);
     }
 
+    // The chunks around the main cue point are requested by the owner
+    // as soon as it receives this update. Decoding starts immediately
+    // without waiting until the track has been handed over to the
+    // engine and the play position has been restored.
+    SINT preloadFrame = SampleUtil::floorPlayPosToFrame(
+            pTrack->getCuePoint().getPosition());
+    if (!m_pAudioSource->frameIndexRange().containsIndex(preloadFrame)) {
+        preloadFrame = m_pAudioSource->frameIndexRange().start();
+    }
     const auto update =
             ReaderStatusUpdate::trackLoaded(
-                    m_pAudioSource->frameIndexRange());
+                    m_pAudioSource->frameIndexRange(),
+                    preloadFrame);
     m_pReaderStatusFIFO->writeBlocking(&update, 1);
+    m_firstChunkPending = true;
+    kLogger.debug()
+            << m_group
+            << "Opening audio source took"
+            << m_loadTimer.elapsed().formatMillisWithUnit();
 
     // Emit that the track is loaded.
     const SINT sampleCount =
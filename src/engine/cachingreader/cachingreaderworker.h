@@ -12,6 +12,7 @@
 #include "engine/engineworker.h"
 #include "sources/audiosource.h"
 #include "util/fifo.h"
+#include "util/performancetimer.h"
 
 
 // POD with trivial ctor/dtor/copy for passing through FIFO
@@ -40,6 +41,7 @@ typedef struct ReaderStatusUpdate {
     CachingReaderChunk* chunk;
     SINT readableFrameIndexRangeStart;
     SINT readableFrameIndexRangeEnd;
+    SINT preloadFrameIndex;
 
   public:
     ReaderStatus status;
@@ -52,6 +54,7 @@ typedef struct ReaderStatusUpdate {
         chunk = chunkArg;
         readableFrameIndexRangeStart = readableFrameIndexRangeArg.start();
         readableFrameIndexRangeEnd = readableFrameIndexRangeArg.end();
+        preloadFrameIndex = readableFrameIndexRangeStart;
     }
 
     static ReaderStatusUpdate readDiscarded(
@@ -62,10 +65,12 @@ typedef struct ReaderStatusUpdate {
     }
 
     static ReaderStatusUpdate trackLoaded(
-            const mixxx::IndexRange& readableFrameIndexRange) {
+            const mixxx::IndexRange& readableFrameIndexRange,
+            SINT preloadFrameIndex) {
         DEBUG_ASSERT(!readableFrameIndexRange.empty());
         ReaderStatusUpdate update;
         update.init(TRACK_LOADED, nullptr, readableFrameIndexRange);
+        update.preloadFrameIndex = preloadFrameIndex;
         return update;
     }
 
@@ -91,6 +96,12 @@ typedef struct ReaderStatusUpdate {
                 readableFrameIndexRangeStart,
                 readableFrameIndexRangeEnd);
     }
+
+    // The frame where playback is expected to start after loading
+    // a track, i.e. the main cue point. Only valid for TRACK_LOADED.
+    SINT preloadFrame() const {
+        return preloadFrameIndex;
+    }
 } ReaderStatusUpdate;
 
 class CachingReaderWorker : public EngineWorker {
@@ -136,6 +147,11 @@ class CachingReaderWorker : public EngineWorker {
     // Internal method to load a track. Emits trackLoaded when finished.
     void loadTrack(const TrackPointer& pTrack);
 
+    // Measures the time from the start of loading a track until the
+    // first chunk of audio data has been decoded.
+    PerformanceTimer m_loadTimer;
+    bool m_firstChunkPending;
+
     ReaderStatusUpdate processReadRequest(
             const CachingReaderChunkReadRequest& request);
 
@@ -392,6 +392,13 @@ double RateControl::calculateSpeed(double baserate, double speed, bool paused,
 
     processTempRate(iSamplesPerBuffer);
 
+    double scratchTickRate;
+    if (m_pScratchController->processScratchTicks(&scratchTickRate)) {
+        // Publish the rate of the jog wheel. The scripts continue from it
+        // when they disable scratching.
+        m_pScratch2->set(scratchTickRate);
+    }
+
     double rate = (paused ? 0 : 1.0);
     double searching = m_pRateSearch->get();
     if (searching) {
@@ -3,6 +3,7 @@
 #include "engine/positionscratchcontroller.h"
 #include "engine/bufferscalers/enginebufferscale.h" // for MIN_SEEK_SPEED
 #include "util/math.h"
+#include "util/time.h"
 
 class VelocityController {
   public:
@@ -78,6 +79,7 @@ PositionScratchController::PositionScratchController(QString group)
     m_pMasterSampleRate = ControlObject::getControl(ConfigKey("[Master]", "samplerate"));
     m_pVelocityController = new VelocityController();
     m_pRateIIFilter = new RateIIFilter;
+    m_pScratchTickQueue = ScratchTickQueue::getScratchTickQueue(group);
 }
 
 PositionScratchController::~PositionScratchController() {
@@ -274,6 +276,11 @@ double PositionScratchController::getRate() {
     return m_dRate;
 }
 
+bool PositionScratchController::processScratchTicks(double* pRate) {
+    return m_scratchTickIntegrator.process(
+            m_pScratchTickQueue.data(), mixxx::Time::elapsed(), pRate);
+}
+
 void PositionScratchController::notifySeek(double currentSample) {
     // scratching continues after seek due to calculating the relative distance traveled
     // in m_dPositionDeltaSum
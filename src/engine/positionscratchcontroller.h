@@ -2,9 +2,11 @@
 #define POSITIONSCRATCHCONTROLLER_H
 
 #include <QObject>
+#include <QSharedPointer>
 #include <QString>
 
 #include "control/controlobject.h"
+#include "engine/scratchtickqueue.h"
 
 class VelocityController;
 class RateIIFilter;
@@ -20,6 +22,11 @@ class PositionScratchController : public QObject {
     double getRate();
     void notifySeek(double currentSample);
 
+    // Integrates the jog wheel ticks that controller scripts have sent by
+    // engine.scratchTick(). Returns true and the scratch rate while a
+    // controller is scratching the deck.
+    bool processScratchTicks(double* pRate);
+
   private:
     const QString m_group;
     ControlObject* m_pScratchEnable;
@@ -27,6 +34,8 @@ class PositionScratchController : public QObject {
     ControlObject* m_pMasterSampleRate;
     VelocityController* m_pVelocityController;
     RateIIFilter* m_pRateIIFilter;
+    QSharedPointer<ScratchTickQueue> m_pScratchTickQueue;
+    ScratchTickIntegrator m_scratchTickIntegrator;
     bool m_bScratching;
     bool m_bEnableInertia;
     double m_dLastPlaypos;
@@ -0,0 +1,209 @@
+#include "engine/scratchtickqueue.h"
+
+#include <QMutexLocker>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+// static
+QMutex ScratchTickQueue::s_mutex;
+// static
+QMap<QString, QWeakPointer<ScratchTickQueue>> ScratchTickQueue::s_queues;
+
+// static
+const mixxx::Duration ScratchTickQueue::kMaxReadInterval =
+        mixxx::Duration::fromMillis(200);
+
+ScratchTickQueue::ScratchTickQueue()
+        : m_fifo(kSize),
+          m_lastSession(0),
+          m_disableTimestampNanos(0),
+          m_disabledSession(0),
+          m_acknowledgedRate(0.0),
+          m_acknowledgedSession(0),
+          m_lastReadNanos(-1) {
+}
+
+// static
+QSharedPointer<ScratchTickQueue> ScratchTickQueue::getScratchTickQueue(
+        const QString& group) {
+    QMutexLocker locker(&s_mutex);
+    QSharedPointer<ScratchTickQueue> pQueue = s_queues.value(group);
+    if (pQueue.isNull()) {
+        pQueue = QSharedPointer<ScratchTickQueue>(new ScratchTickQueue());
+        s_queues.insert(group, pQueue);
+    }
+    return pQueue;
+}
+
+bool ScratchTickQueue::write(const ScratchTickEvent& event) {
+    return m_fifo.write(&event, 1) == 1;
+}
+
+void ScratchTickQueue::requestDisable(int session, mixxx::Duration timestamp) {
+    m_disableTimestampNanos.store(
+            timestamp.toIntegerNanos(), std::memory_order_relaxed);
+    // Publishes the timestamp
+    m_disabledSession.store(session, std::memory_order_release);
+}
+
+bool ScratchTickQueue::isDisableAcknowledged(int session, double* pRate) const {
+    if (m_acknowledgedSession.load(std::memory_order_acquire) < session) {
+        return false;
+    }
+    *pRate = m_acknowledgedRate.load(std::memory_order_relaxed);
+    return true;
+}
+
+bool ScratchTickQueue::isConsumed(mixxx::Duration now) const {
+    const qint64 lastReadNanos = m_lastReadNanos.load(std::memory_order_acquire);
+    if (lastReadNanos < 0) {
+        return false;
+    }
+    return now - mixxx::Duration::fromNanos(lastReadNanos) < kMaxReadInterval;
+}
+
+int ScratchTickQueue::disabledSession(mixxx::Duration* pTimestamp) const {
+    const int session = m_disabledSession.load(std::memory_order_acquire);
+    *pTimestamp = mixxx::Duration::fromNanos(
+            m_disableTimestampNanos.load(std::memory_order_relaxed));
+    return session;
+}
+
+void ScratchTickQueue::acknowledgeDisable(int session, double rate) {
+    m_acknowledgedRate.store(rate, std::memory_order_relaxed);
+    // Publishes the rate
+    m_acknowledgedSession.store(session, std::memory_order_release);
+}
+
+// static
+const mixxx::Duration ScratchTickIntegrator::kAlphaBetaDt =
+        mixxx::Duration::fromMillis(1);
+// static
+const mixxx::Duration ScratchTickIntegrator::kMaxCatchUp =
+        mixxx::Duration::fromMillis(100);
+
+ScratchTickIntegrator::ScratchTickIntegrator()
+        : m_pendingBegin(0),
+          m_enabled(false),
+          m_session(0),
+          m_dx(0.0),
+          m_rate(0.0) {
+    // Never allocate in the engine thread
+    m_pending.reserve(ScratchTickQueue::kSize);
+}
+
+void ScratchTickIntegrator::readEvents(ScratchTickQueue* pQueue) {
+    // Move the remaining events to the front
+    if (m_pendingBegin > 0) {
+        m_pending.erase(m_pending.begin(), m_pending.begin() + m_pendingBegin);
+        m_pendingBegin = 0;
+    }
+    const int capacity = static_cast<int>(m_pending.capacity() - m_pending.size());
+    const int count = math_min(pQueue->readAvailable(), capacity);
+    if (count <= 0) {
+        return;
+    }
+    const size_t size = m_pending.size();
+    m_pending.resize(size + count);
+    const int read = pQueue->read(&m_pending[size], count);
+    DEBUG_ASSERT(read == count);
+    m_pending.resize(size + read);
+}
+
+void ScratchTickIntegrator::enable(const ScratchTickEvent& event) {
+    const double dt = kAlphaBetaDt.toDoubleSeconds();
+    if (event.alpha != 0.0 && event.beta != 0.0) {
+        m_filter.init(dt, event.velocity, event.alpha, event.beta);
+    } else {
+        m_filter.init(dt, event.velocity);
+    }
+    m_dx = event.dx;
+    m_rate = event.velocity;
+    m_enabled = true;
+    m_session = event.session;
+}
+
+bool ScratchTickIntegrator::process(
+        ScratchTickQueue* pQueue, mixxx::Duration now, double* pRate) {
+    pQueue->markRead(now);
+    // The disable request must be loaded before the events. Otherwise the
+    // Enable event of a session that is disabled could be read later.
+    mixxx::Duration disableTimestamp;
+    const int disabledSession = pQueue->disabledSession(&disableTimestamp);
+    readEvents(pQueue);
+
+    if (!m_enabled) {
+        // Skip everything up to the next enable event of a session that
+        // has not been disabled yet
+        while (m_pendingBegin < m_pending.size()) {
+            const ScratchTickEvent& event = m_pending[m_pendingBegin++];
+            if (event.type != ScratchTickEvent::Type::Enable) {
+                continue;
+            }
+            if (event.session <= disabledSession) {
+                // The controller continues from the initial velocity
+                m_rate = event.velocity;
+                continue;
+            }
+            enable(event);
+            m_stepStart = event.timestamp;
+            break;
+        }
+    }
+
+    double rateSum = 0.0;
+    int steps = 0;
+    if (m_enabled) {
+        if (now - m_stepStart > kMaxCatchUp) {
+            m_stepStart = now - kMaxCatchUp;
+        }
+        const bool disable = m_session <= disabledSession;
+        const mixxx::Duration end =
+                (disable && disableTimestamp < now) ? disableTimestamp : now;
+        while (m_stepStart + kAlphaBetaDt <= end) {
+            const mixxx::Duration stepEnd = m_stepStart + kAlphaBetaDt;
+            int intervals = 0;
+            while (m_pendingBegin < m_pending.size() &&
+                    m_pending[m_pendingBegin].timestamp < stepEnd) {
+                const ScratchTickEvent& event = m_pending[m_pendingBegin++];
+                switch (event.type) {
+                case ScratchTickEvent::Type::Enable:
+                    // Scratching has been restarted with new parameters.
+                    // A later session is only disabled if this one is.
+                    if (event.session > disabledSession) {
+                        enable(event);
+                        intervals = 0;
+                    }
+                    break;
+                case ScratchTickEvent::Type::Tick:
+                    // Ticks that arrive late are accounted to the first step
+                    if (m_stepStart - event.timestamp < kMaxCatchUp) {
+                        intervals += event.interval;
+                    }
+                    break;
+                }
+            }
+            // This is 0 if no ticks have been received, i.e. the wheel is
+            // stopped
+            m_filter.observation(m_dx * intervals);
+            rateSum += m_filter.predictedVelocity();
+            ++steps;
+            m_stepStart = stepEnd;
+        }
+        if (steps > 0) {
+            m_rate = rateSum / steps;
+        }
+        if (m_session <= disabledSession) {
+            m_enabled = false;
+        }
+    }
+
+    if (disabledSession > pQueue->acknowledgedSession()) {
+        // The controller continues from this rate
+        pQueue->acknowledgeDisable(disabledSession, m_rate);
+    }
+
+    *pRate = m_rate;
+    return m_enabled || steps > 0;
+}
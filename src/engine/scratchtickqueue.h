@@ -0,0 +1,155 @@
+#pragma once
+
+#include <QMap>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <atomic>
+#include <vector>
+
+#include "util/alphabetafilter.h"
+#include "util/duration.h"
+#include "util/fifo.h"
+
+// An event of a jog wheel that is scratching a deck, sent by
+// engine.scratchEnable() and engine.scratchTick() of the controller scripts.
+// Disabling is not an event, see ScratchTickQueue::requestDisable().
+struct ScratchTickEvent {
+    enum class Type {
+        Enable,
+        Tick,
+    };
+
+    Type type;
+    // Enable: The session returned by ScratchTickQueue::beginSession()
+    int session;
+    // mixxx::Time::elapsed() when the script has called the function
+    mixxx::Duration timestamp;
+    // Tick: The number of intervals the wheel has been turned
+    int interval;
+    // Enable: The distance of one interval in seconds of the track at
+    // normal speed, the initial velocity and the filter parameters (0 for
+    // the defaults)
+    double dx;
+    double velocity;
+    double alpha;
+    double beta;
+};
+
+// Passes the scratch events of a deck from the controller thread to the
+// engine thread without locking. There is a single writer, because all
+// controller scripts run in the controller thread.
+//
+// Events may be lost when the FIFO is full, so scratching is disabled by
+// a separate request for the session that the engine acknowledges together
+// with the last rate of the jog wheel. The engine also reports each read
+// to let the controller fall back to its own timer when the engine is not
+// running.
+class ScratchTickQueue {
+  public:
+    static constexpr int kSize = 1024;
+    // The engine is considered to be stalled if it has not read the queue
+    // for this long, e.g. with the largest audio buffers.
+    static const mixxx::Duration kMaxReadInterval;
+
+    ScratchTickQueue();
+
+    // Returns the queue for the deck, which is shared between all
+    // controllers and the engine. Don't call this from the engine callback.
+    static QSharedPointer<ScratchTickQueue> getScratchTickQueue(const QString& group);
+
+    // Called from the controller thread. Returns false if the engine has not
+    // read the previous events, e.g. because no audio device is running.
+    bool write(const ScratchTickEvent& event);
+
+    // Called from the controller thread. Returns the session for the next
+    // Enable event.
+    int beginSession() {
+        return ++m_lastSession;
+    }
+    // Called from the controller thread. Disables the session and all
+    // sessions before it at the given time.
+    void requestDisable(int session, mixxx::Duration timestamp);
+    // Called from the controller thread. Returns true and the last rate of
+    // the jog wheel if the engine has disabled the session.
+    bool isDisableAcknowledged(int session, double* pRate) const;
+    // Called from the controller thread. Returns false if the engine has
+    // not read the queue within kMaxReadInterval before now.
+    bool isConsumed(mixxx::Duration now) const;
+
+    // Called from the engine thread
+    void markRead(mixxx::Duration now) {
+        m_lastReadNanos.store(now.toIntegerNanos(), std::memory_order_release);
+    }
+    int disabledSession(mixxx::Duration* pTimestamp) const;
+    int acknowledgedSession() const {
+        return m_acknowledgedSession.load(std::memory_order_relaxed);
+    }
+    void acknowledgeDisable(int session, double rate);
+    int readAvailable() const {
+        return m_fifo.readAvailable();
+    }
+    int read(ScratchTickEvent* pEvents, int count) {
+        return m_fifo.read(pEvents, count);
+    }
+
+  private:
+    FIFO<ScratchTickEvent> m_fifo;
+
+    // Only accessed by the controller thread
+    int m_lastSession;
+
+    std::atomic<qint64> m_disableTimestampNanos;
+    std::atomic<int> m_disabledSession;
+    std::atomic<double> m_acknowledgedRate;
+    std::atomic<int> m_acknowledgedSession;
+    // A negative value if the engine has never read the queue
+    std::atomic<qint64> m_lastReadNanos;
+
+    static QMutex s_mutex;
+    static QMap<QString, QWeakPointer<ScratchTickQueue>> s_queues;
+};
+
+// Runs the alpha-beta filter of a scratching jog wheel in the engine
+// thread.
+//
+// The filter expects an observation of the distance the wheel has moved
+// every kAlphaBetaDt. The ticks are assigned to these fixed steps by their
+// timestamps and the steps up to the current time are integrated at once
+// in every callback. This reproduces a perfectly regular 1 ms timer, so the
+// scratch rate no longer depends on when the controller thread is
+// scheduled.
+class ScratchTickIntegrator {
+  public:
+    static const mixxx::Duration kAlphaBetaDt;
+    // Bounds the work after the engine has not been running for a while.
+    // Older ticks are dropped.
+    static const mixxx::Duration kMaxCatchUp;
+
+    ScratchTickIntegrator();
+
+    // Reads the new events and integrates the ticks up to now or until the
+    // session has been disabled. Returns true if the jog wheel is
+    // scratching, and the average rate since the last call in pRate.
+    bool process(ScratchTickQueue* pQueue, mixxx::Duration now, double* pRate);
+
+    bool isEnabled() const {
+        return m_enabled;
+    }
+
+  private:
+    void readEvents(ScratchTickQueue* pQueue);
+    void enable(const ScratchTickEvent& event);
+
+    // Events that have been read from the queue but are not due yet
+    std::vector<ScratchTickEvent> m_pending;
+    size_t m_pendingBegin;
+
+    AlphaBetaFilter m_filter;
+    bool m_enabled;
+    int m_session;
+    double m_dx;
+    // The start of the first step that has not been integrated yet
+    mixxx::Duration m_stepStart;
+    double m_rate;
+};
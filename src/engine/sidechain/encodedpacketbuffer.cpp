@@ -0,0 +1,89 @@
+#include "engine/sidechain/encodedpacketbuffer.h"
+
+#include "util/assert.h"
+#include "util/math.h"
+
+EncodedPacketBuffer::EncodedPacketBuffer(
+        int maxBacklogBytes, OverflowPolicy overflowPolicy)
+        : m_backlogBytes(0),
+          m_maxBacklogBytes(maxBacklogBytes),
+          m_overflowPolicy(overflowPolicy) {
+    DEBUG_ASSERT(maxBacklogBytes > 0);
+}
+
+void EncodedPacketBuffer::setMaxBacklogBytes(int maxBacklogBytes) {
+    VERIFY_OR_DEBUG_ASSERT(maxBacklogBytes > 0) {
+        return;
+    }
+    m_maxBacklogBytes = maxBacklogBytes;
+}
+
+EncodedPacketBuffer::AppendResult EncodedPacketBuffer::append(
+        const unsigned char* header,
+        int headerLen,
+        const unsigned char* body,
+        int bodyLen) {
+    const int packetBytes = headerLen + bodyLen;
+    if (packetBytes <= 0) {
+        return AppendResult::Appended;
+    }
+
+    AppendResult result = AppendResult::Appended;
+    if (m_backlogBytes + packetBytes > m_maxBacklogBytes) {
+        if (m_overflowPolicy == OverflowPolicy::Reject) {
+            return AppendResult::Rejected;
+        }
+        while (!m_packets.isEmpty() &&
+                m_backlogBytes + packetBytes > m_maxBacklogBytes) {
+            const QByteArray dropped = m_packets.dequeue();
+            m_backlogBytes -= dropped.size();
+            m_stats.bytesDropped += dropped.size();
+            ++m_stats.packetsDropped;
+        }
+        result = AppendResult::DroppedOldest;
+    }
+
+    QByteArray packet;
+    packet.reserve(packetBytes);
+    if (headerLen > 0) {
+        packet.append(reinterpret_cast<const char*>(header), headerLen);
+    }
+    if (bodyLen > 0) {
+        packet.append(reinterpret_cast<const char*>(body), bodyLen);
+    }
+    m_packets.enqueue(packet);
+    m_backlogBytes += packetBytes;
+    m_stats.maxBacklogBytes = math_max(m_stats.maxBacklogBytes, m_backlogBytes);
+    return result;
+}
+
+int EncodedPacketBuffer::send(const Sender& sender, int maxBytes) {
+    int sentBytes = 0;
+    while (!m_packets.isEmpty() && sentBytes < maxBytes) {
+        // The sender may clear the buffer, e.g. when reconnecting
+        const QByteArray packet = m_packets.head();
+        if (!sender(packet)) {
+            break;
+        }
+        if (m_packets.isEmpty()) {
+            break;
+        }
+        m_packets.dequeue();
+        m_backlogBytes -= packet.size();
+        m_stats.bytesSent += packet.size();
+        sentBytes += packet.size();
+    }
+    return sentBytes;
+}
+
+void EncodedPacketBuffer::clear() {
+    m_packets.clear();
+    m_backlogBytes = 0;
+}
+
+QDebug operator<<(QDebug dbg, const EncodedPacketBuffer::Stats& stats) {
+    return dbg << "sent" << stats.bytesSent << "bytes,"
+               << "dropped" << stats.bytesDropped << "bytes in"
+               << stats.packetsDropped << "packets,"
+               << "max backlog" << stats.maxBacklogBytes << "bytes";
+}
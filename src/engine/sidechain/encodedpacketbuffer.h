@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDebug>
+#include <QQueue>
+#include <functional>
+
+// Holds the encoded stream of a broadcast connection until the server
+// accepts it, so encoding never waits for the network.
+//
+// The backlog is bounded. When a slow or stalled server lets it grow beyond
+// the limit, either the oldest packets are dropped, which keeps the stream
+// running with gaps, or the new packet is rejected and the caller reconnects.
+class EncodedPacketBuffer {
+  public:
+    enum class OverflowPolicy {
+        Reject,
+        DropOldest,
+    };
+
+    enum class AppendResult {
+        Appended,
+        // The packet was appended after dropping older packets
+        DroppedOldest,
+        Rejected,
+    };
+
+    struct Stats {
+        Stats()
+                : bytesSent(0),
+                  bytesDropped(0),
+                  packetsDropped(0),
+                  maxBacklogBytes(0) {
+        }
+        qint64 bytesSent;
+        qint64 bytesDropped;
+        int packetsDropped;
+        int maxBacklogBytes;
+    };
+
+    // Sends a packet and returns false if sending failed. The packet is kept
+    // in this case.
+    typedef std::function<bool(const QByteArray& packet)> Sender;
+
+    EncodedPacketBuffer(int maxBacklogBytes, OverflowPolicy overflowPolicy);
+
+    void setMaxBacklogBytes(int maxBacklogBytes);
+    int maxBacklogBytes() const {
+        return m_maxBacklogBytes;
+    }
+    void setOverflowPolicy(OverflowPolicy overflowPolicy) {
+        m_overflowPolicy = overflowPolicy;
+    }
+
+    AppendResult append(const unsigned char* header,
+            int headerLen,
+            const unsigned char* body,
+            int bodyLen);
+
+    // Sends the oldest packets until at least maxBytes have been sent, the
+    // buffer is empty or sending fails. Returns the number of bytes sent.
+    int send(const Sender& sender, int maxBytes);
+
+    void clear();
+
+    bool isEmpty() const {
+        return m_packets.isEmpty();
+    }
+    int backlogBytes() const {
+        return m_backlogBytes;
+    }
+
+    const Stats& stats() const {
+        return m_stats;
+    }
+    void resetStats() {
+        m_stats = Stats();
+    }
+
+  private:
+    QQueue<QByteArray> m_packets;
+    int m_backlogBytes;
+    int m_maxBacklogBytes;
+    OverflowPolicy m_overflowPolicy;
+    Stats m_stats;
+};
+
+QDebug operator<<(QDebug dbg, const EncodedPacketBuffer::Stats& stats);
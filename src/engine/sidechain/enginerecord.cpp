@@ -16,6 +16,13 @@
 #include "mixer/playerinfo.h"
 #include "recording/defs_recording.h"
 #include "util/event.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("EngineRecord");
+
+} // anonymous namespace
 
 const int kMetaDataLifeTimeout = 16;
 
@@ -187,6 +194,18 @@ void EngineRecord::process(const CSAMPLE* pBuffer, const int iBufferSize) {
         }
     }
 
+    if (fileOpen() && m_fileWriter.hasError()) {
+        // The disk is full or has been removed
+        kLogger.warning() << "Failed to write" << m_fileName;
+        Event::end(tag);
+        closeFile();
+        if (m_bCueIsEnabled) {
+            closeCueFile();
+        }
+        m_pRecReady->slotSet(RECORD_OFF);
+        emit isRecording(false, true);
+    }
+
     // Checking again from m_pRecReady since its status might have changed
     // in the previous "if" blocks.
     if (m_pRecReady->get() == RECORD_ON) {
@@ -256,10 +275,10 @@ void EngineRecord::write(const unsigned char *header, const unsigned char *body,
     }
     // Relevant for OGG
     if (headerLen > 0) {
-        m_dataStream.writeRawData((const char*) header, headerLen);
+        m_fileWriter.write((const char*) header, headerLen);
     }
     // Always write body
-    m_dataStream.writeRawData((const char*) body, bodyLen);
+    m_fileWriter.write((const char*) body, bodyLen);
     emit bytesRecorded((headerLen+bodyLen));
 
 }
@@ -268,43 +287,37 @@ int EngineRecord::tell() {
     if (!fileOpen()) {
         return -1;
     }
-    return m_dataStream.device()->pos();
+    return static_cast<int>(m_fileWriter.pos());
 }
 // Encoder calls this method to write compressed audio
 void EngineRecord::seek(int pos) {
     if (!fileOpen()) {
         return;
     }
-    m_dataStream.device()->seek(static_cast<qint64>(pos));
+    m_fileWriter.seek(static_cast<qint64>(pos));
 }
 // These are not used for streaming, but the interface requires them
 int EngineRecord::filelen() {
     if (!fileOpen()) {
         return 0;
     }
-    return m_dataStream.device()->size();
+    return static_cast<int>(m_fileWriter.size());
 }
 
 bool EngineRecord::fileOpen() {
-    return (m_file.handle() != -1);
+    return m_fileWriter.isOpen();
 }
 
 bool EngineRecord::openFile() {
-    // We can use a QFile to write compressed audio.
-    if (m_pEncoder) {
-        m_file.setFileName(m_fileName);
-        if (!m_file.open(QIODevice::WriteOnly)) {
-            return false;
-        }
-        if (m_file.handle() != -1) {
-            m_dataStream.setDevice(&m_file);
-        }
-    } else {
+    if (!m_pEncoder) {
         return false;
     }
-
-    // Return whether the file is really open.
-    return fileOpen();
+    // Opening is not deferred to the writer thread to report errors at once
+    if (!m_fileWriter.open(m_fileName)) {
+        return false;
+    }
+    m_fileWriter.resetStats();
+    return true;
 }
 
 bool EngineRecord::openCueFile() {
@@ -344,13 +357,16 @@ bool EngineRecord::openCueFile() {
 }
 
 void EngineRecord::closeFile() {
-    if (m_file.handle() != -1) {
-        // Close QFile and encoder, if open.
+    if (fileOpen()) {
+        // Close file and encoder, if open.
         if (m_pEncoder) {
             m_pEncoder->flush();
             m_pEncoder.reset();
         }
-        m_file.close();
+        // The remaining data is written and the file is closed in the
+        // background while the next file is already being recorded.
+        m_fileWriter.close();
+        kLogger.info() << "Closing" << m_fileName << m_fileWriter.stats();
     }
 }
 
@@ -8,7 +8,6 @@
 #ifndef ENGINERECORD_H
 #define ENGINERECORD_H
 
-#include <QDataStream>
 #include <QFile>
 
 #include "preferences/usersettings.h"
@@ -16,6 +15,7 @@
 #include "encoder/encoder.h"
 #include "engine/sidechain/sidechainworker.h"
 #include "track/track.h"
+#include "util/asyncfilewriter.h"
 
 class ConfigKey;
 class ControlProxy;
@@ -52,9 +52,9 @@ class EngineRecord : public QObject, public EncoderCallback, public SideChainWor
     void bytesRecorded(int bytes);
 
     // Emitted when recording state changes. 'recording' represents whether
-    // recording is active and 'error' is true if an error occurred. Currently
-    // only one error can occur: the specified file was unable to be opened for
-    // writing.
+    // recording is active and 'error' is true if an error occurred: the
+    // specified file was unable to be opened for writing or writing to it
+    // failed.
     void isRecording(bool recording, bool error);
     void durationRecorded(quint64 durationInt);
 
@@ -75,9 +75,10 @@ class EngineRecord : public QObject, public EncoderCallback, public SideChainWor
     QString m_baAuthor;
     QString m_baAlbum;
 
-    QFile m_file;
+    // Writes the recording in its own thread, so a slow disk never blocks
+    // the sidechain
+    AsyncFileWriter m_fileWriter;
     QFile m_cueFile;
-    QDataStream m_dataStream;
 
     ControlProxy* m_pRecReady;
     ControlProxy* m_pSamplerate;
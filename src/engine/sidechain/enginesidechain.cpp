@@ -38,7 +38,9 @@ EngineSideChain::EngineSideChain(UserSettingsPointer pConfig)
         : m_pConfig(pConfig),
           m_bStopThread(false),
           m_sampleFifo(SIDECHAIN_BUFFER_SIZE),
-          m_pWorkBuffer(SampleUtil::alloc(SIDECHAIN_BUFFER_SIZE)) {
+          m_pSampleReader(m_sampleFifo.createReader()),
+          m_pWorkBuffer(SampleUtil::alloc(SIDECHAIN_BUFFER_SIZE)),
+          m_samplesSinceWakeUp(0) {
     // We use HighPriority to prevent starvation by lower-priority processes (Qt
     // main thread, analysis, etc.). This used to be LowPriority but that is not
     // a suitable choice since we do semi-realtime tasks
@@ -88,13 +90,13 @@ void EngineSideChain::writeSamples(const CSAMPLE* pBuffer, int iFrames) {
     // TODO: remove assumption of stereo buffer
     const int kChannels = 2;
     const int iSamples = iFrames * kChannels;
-    int samples_written = m_sampleFifo.write(pBuffer, iSamples);
+    m_sampleFifo.write(pBuffer, iSamples);
 
-    if (samples_written != iSamples) {
-        Counter("EngineSideChain::writeSamples buffer overrun").increment();
-    }
-
-    if (m_sampleFifo.writeAvailable() < SIDECHAIN_BUFFER_SIZE / 5) {
+    // The writer doesn't stop at a full buffer but overwrites the oldest
+    // samples, so the sidechain is woken up well before.
+    m_samplesSinceWakeUp += iSamples;
+    if (m_samplesSinceWakeUp >= SIDECHAIN_BUFFER_SIZE / 4) {
+        m_samplesSinceWakeUp = 0;
         // Signal to the sidechain that samples are available.
         Trace wakeup("EngineSideChain::writeSamples wake up");
         m_waitForSamples.wakeAll();
@@ -118,8 +120,8 @@ void EngineSideChain::run() {
         Event::start(tag);
 
         int samples_read;
-        while ((samples_read = m_sampleFifo.read(m_pWorkBuffer,
-                                                 SIDECHAIN_BUFFER_SIZE))) {
+        while ((samples_read = m_pSampleReader->read(m_pWorkBuffer,
+                                                     SIDECHAIN_BUFFER_SIZE))) {
             Trace process("EngineSideChain::process");
             MMutexLocker locker(&m_workerLock);
             foreach (SideChainWorker* pWorker, m_workers) {
@@ -127,6 +129,12 @@ void EngineSideChain::run() {
             }
         }
 
+        if (m_pSampleReader->overflowCount() > 0) {
+            Counter("EngineSideChain::writeSamples buffer overrun").increment(
+                    m_pSampleReader->overflowCount());
+            m_pSampleReader->resetOverflowCount();
+        }
+
         // Check to see if we're supposed to exit/stop this thread.
         if (m_bStopThread) {
             return;
@@ -25,7 +25,7 @@
 #include "preferences/usersettings.h"
 #include "engine/sidechain/sidechainworker.h"
 #include "soundio/soundmanagerutil.h"
-#include "util/fifo.h"
+#include "util/multireaderfifo.h"
 #include "util/mutex.h"
 #include "util/types.h"
 
@@ -58,8 +58,12 @@ class EngineSideChain : public QThread, public AudioDestination {
     // Indicates that the thread should exit.
     volatile bool m_bStopThread;
 
-    FIFO<CSAMPLE> m_sampleFifo;
+    // Written once by the engine and read by the sidechain thread
+    MultiReaderFifo<CSAMPLE> m_sampleFifo;
+    const std::unique_ptr<MultiReaderFifo<CSAMPLE>::Reader> m_pSampleReader;
     CSAMPLE* m_pWorkBuffer;
+    // Only used by the writer
+    int m_samplesSinceWakeUp;
 
     // Provides thread safety around the wait condition below.
     QMutex m_waitLock;
@@ -30,13 +30,20 @@
 #include "recording/defs_recording.h"
 #include "track/track.h"
 #include "util/logger.h"
+#include "util/math.h"
 
 #include <engine/sidechain/shoutconnection.h>
 
 namespace {
 
 const int kConnectRetries = 30;
-const int kMaxNetworkCache = 491520;  // 10 s mp3 @ 192 kbit/s
+// The data that is passed to libshout at once. The rest of the backlog stays
+// in m_sendBuffer, which is bounded, while the queue of libshout is not.
+const int kMaxShoutQueue = 16384;
+// The minimum backlog, for low bit rates
+const int kMinNetworkBacklogBytes = 65536;
+// Retry sending a backlog after this time if no new samples arrive
+const int kSendRetryMillis = 10;
 // Shoutcast default receive buffer 1048576 and autodumpsourcetime 30 s
 // http://wiki.shoutcast.com/wiki/SHOUTcast_DNAS_Server_2
 const int kMaxShoutFailures = 3;
@@ -46,7 +53,8 @@ const mixxx::Logger kLogger("ShoutConnection");
 }
 
 ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
-        UserSettingsPointer pConfig)
+        UserSettingsPointer pConfig,
+        SharedEncoderPoolPointer pEncoderPool)
         : m_pTextCodec(nullptr),
           m_pMetaData(),
           m_pShout(nullptr),
@@ -56,7 +64,10 @@ ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
           m_iShoutFailures(0),
           m_pConfig(pConfig),
           m_pProfile(profile),
+          m_pEncoderPool(pEncoderPool),
           m_encoder(nullptr),
+          m_sendBuffer(kMinNetworkBacklogBytes, EncodedPacketBuffer::OverflowPolicy::Reject),
+          m_droppingPackets(false),
           m_pMasterSamplerate(new ControlProxy("[Master]", "samplerate", this)),
           m_pBroadcastEnabled(new ControlProxy(BROADCAST_PREF_KEY, "enabled", this)),
           m_custom_metadata(false),
@@ -270,6 +281,15 @@ void ShoutConnection::updateFromPreferences() {
 
     m_metadataFormat = m_pProfile->getMetadataFormat();
 
+    // The bit rate is in kbit/s
+    const double backlogBytes = m_pProfile->getNetworkBacklog() *
+            m_pProfile->getBitrate() * 1000 / 8;
+    m_sendBuffer.setMaxBacklogBytes(math_max(
+            static_cast<int>(backlogBytes), kMinNetworkBacklogBytes));
+    m_sendBuffer.setOverflowPolicy(m_pProfile->getDropOldestOnOverflow()
+                    ? EncodedPacketBuffer::OverflowPolicy::DropOldest
+                    : EncodedPacketBuffer::OverflowPolicy::Reject);
+
     bool enableReconnect = m_pProfile->getEnableReconnect();
     if (enableReconnect) {
         m_reconnectFirstDelay = m_pProfile->getReconnectFirstDelay();
@@ -439,8 +459,7 @@ void ShoutConnection::updateFromPreferences() {
     // Initialize m_encoder
     EncoderSettingsPointer pBroadcastSettings =
             std::make_shared<EncoderBroadcastSettings>(m_pProfile);
-    m_encoder = EncoderFactory::getFactory().createEncoder(
-                    pBroadcastSettings, this);
+    m_encoder = m_pEncoderPool->createEncoder(pBroadcastSettings, this);
 
     QString errorMsg;
     if(m_encoder->initEncoder(iMasterSamplerate, errorMsg) < 0) {
@@ -572,6 +591,11 @@ bool ShoutConnection::processConnect() {
             if(m_pOutputFifo->readAvailable()) {
             	m_pOutputFifo->flushReadData(m_pOutputFifo->readAvailable());
             }
+            // Data of a previous connection is outdated
+            m_sendBuffer.clear();
+            m_sendBuffer.resetStats();
+            m_droppingPackets = false;
+            m_connectedTimer.start();
             m_threadWaiting = true;
 
             setStatus(BroadcastProfile::STATUS_CONNECTED);
@@ -616,6 +640,15 @@ bool ShoutConnection::processDisconnect() {
         shout_close(m_pShout);
         m_iShoutStatus = SHOUTERR_UNCONNECTED;
 
+        const qint64 connectedMillis = m_connectedTimer.elapsed();
+        const EncodedPacketBuffer::Stats& stats = m_sendBuffer.stats();
+        kLogger.info() << m_pProfile->getProfileName()
+                       << "disconnected after" << connectedMillis << "ms:"
+                       << stats << ","
+                       << (connectedMillis > 0 ? stats.bytesSent * 8 / connectedMillis : 0)
+                       << "kbit/s";
+        m_sendBuffer.clear();
+
         emit broadcastDisconnected();
         disconnected = true;
     }
@@ -634,25 +667,52 @@ void ShoutConnection::write(const unsigned char* header, const unsigned char* bo
         return;
     }
 
-    // Send header if there is one
-    if (headerLen > 0) {
-        if(!writeSingle(header, headerLen)) {
-            return;
+    // The data is sent from the buffer, so a slow server never blocks
+    // encoding
+    switch (m_sendBuffer.append(header, headerLen, body, bodyLen)) {
+    case EncodedPacketBuffer::AppendResult::Appended:
+        m_droppingPackets = false;
+        break;
+    case EncodedPacketBuffer::AppendResult::DroppedOldest:
+        if (!m_droppingPackets) {
+            kLogger.warning() << m_pProfile->getProfileName()
+                              << "network backlog full, dropping data";
+            m_droppingPackets = true;
         }
+        break;
+    case EncodedPacketBuffer::AppendResult::Rejected:
+        m_lastErrorStr = tr("Network cache overflow");
+        tryReconnect();
+        return;
     }
 
-    if(!writeSingle(body, bodyLen)) {
+    sendBuffered();
+}
+
+void ShoutConnection::sendBuffered() {
+    if (!m_pShout || m_iShoutStatus != SHOUTERR_CONNECTED) {
         return;
     }
 
     ssize_t queuelen = shout_queuelen(m_pShout);
     if (queuelen > 0) {
-        kLogger.debug() << "shout_queuelen" << queuelen;
-        if (queuelen > kMaxNetworkCache) {
-            m_lastErrorStr = tr("Network cache overflow");
-            tryReconnect();
-        }
+        // Send the data that is queued by libshout. This does not block
+        // in non-blocking mode.
+        (void)shout_send_raw(m_pShout, nullptr, 0);
+        queuelen = shout_queuelen(m_pShout);
+    }
+    if (queuelen >= kMaxShoutQueue) {
+        // The server is too slow, keep the data in our bounded buffer
+        return;
     }
+
+    m_sendBuffer.send(
+            [this](const QByteArray& packet) {
+                return writeSingle(
+                        reinterpret_cast<const unsigned char*>(packet.constData()),
+                        packet.size());
+            },
+            kMaxShoutQueue - static_cast<int>(queuelen));
 }
 // These are not used for streaming, but the interface requires them
 int ShoutConnection::tell() {
@@ -675,12 +735,9 @@ bool ShoutConnection::writeSingle(const unsigned char* data, size_t len) {
     setFunctionCode(8);
     int ret = shout_send_raw(m_pShout, data, len);
     if (ret == SHOUTERR_BUSY) {
-        // in case of busy, frames are queued
-        // try to flush queue after a short sleep
-        kLogger.warning() << "writeSingle() SHOUTERR_BUSY, trying again";
-        usleep(10000); // wait 10 ms until "busy" is over. TODO() tweak for an optimum.
-        // if this fails, the queue is transmitted after the next regular shout_send_raw()
-        (void)shout_send_raw(m_pShout, nullptr, 0);
+        // The data is queued by libshout and sent with the next call
+        // of sendBuffered()
+        kLogger.debug() << "writeSingle() SHOUTERR_BUSY";
     } else if (ret < SHOUTERR_SUCCESS) {
         m_lastErrorStr = shout_get_error(m_pShout);
         kLogger.warning()
@@ -997,7 +1054,9 @@ void ShoutConnection::run() {
 
         setFunctionCode(1);
         incRunCount();
-        if(!m_readSema.tryAcquire(1, 1000)) {
+        // Wake up early to continue sending a backlog
+        if (!m_readSema.tryAcquire(1, m_sendBuffer.isEmpty() ? 1000 : kSendRetryMillis)) {
+            sendBuffered();
             continue;
         }
 
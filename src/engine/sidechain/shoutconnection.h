@@ -8,6 +8,7 @@
 #include <QMessageBox>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QElapsedTimer>
 #include <QObject>
 #include <QSemaphore>
 #include <QTextCodec>
@@ -19,6 +20,8 @@
 #include "control/controlproxy.h"
 #include "encoder/encodercallback.h"
 #include "encoder/encoder.h"
+#include "encoder/sharedencoderpool.h"
+#include "engine/sidechain/encodedpacketbuffer.h"
 #include "errordialoghandler.h"
 #include "preferences/usersettings.h"
 #include "track/track.h"
@@ -36,7 +39,11 @@ class ShoutConnection
         : public QThread, public EncoderCallback, public NetworkOutputStreamWorker {
     Q_OBJECT
   public:
-    ShoutConnection(BroadcastProfilePtr profile, UserSettingsPointer pConfig);
+    // Connections with the same encoder settings share the encoder of the
+    // pool
+    ShoutConnection(BroadcastProfilePtr profile,
+            UserSettingsPointer pConfig,
+            SharedEncoderPoolPointer pEncoderPool);
     virtual ~ShoutConnection();
 
     // This is called by the Engine implementation for each sample. Encode and
@@ -46,8 +53,8 @@ class ShoutConnection
     void shutdown() override {
     }
 
-    // Called by the encoder in method 'encodebuffer()' to flush the stream to
-    // the server.
+    // Called by the encoder in method 'encodebuffer()' to send the stream to
+    // the server. The data is buffered while the server is busy.
     void write(const unsigned char* header, const unsigned char* body,
                int headerLen, int bodyLen) override;
     // gets stream position
@@ -110,6 +117,9 @@ class ShoutConnection
 #endif
 
     bool writeSingle(const unsigned char *data, size_t len);
+    // Passes as much buffered data to libshout as it can send without
+    // blocking
+    void sendBuffered();
 
     QByteArray encodeString(const QString& string);
 
@@ -127,7 +137,11 @@ class ShoutConnection
     long m_iShoutFailures;
     UserSettingsPointer m_pConfig;
     BroadcastProfilePtr m_pProfile;
+    SharedEncoderPoolPointer m_pEncoderPool;
     EncoderPointer m_encoder;
+    EncodedPacketBuffer m_sendBuffer;
+    bool m_droppingPackets;
+    QElapsedTimer m_connectedTimer;
     ControlProxy* m_pMasterSamplerate;
     ControlProxy* m_pBroadcastEnabled;
     // static metadata according to prefereneces
@@ -351,6 +351,11 @@ TrackPointer BansheePlaylistModel::getTrack(const QModelIndex& index) const {
     return pTrack;
 }
 
+QList<TrackPointer> BansheePlaylistModel::getTracks(const QModelIndexList& indices) const {
+    // Each track is imported individually by getTrack()
+    return TrackModel::getTracks(indices);
+}
+
 TrackId BansheePlaylistModel::getTrackId(const QModelIndex& index) const {
     const auto track = getTrack(index);
     if (track) {
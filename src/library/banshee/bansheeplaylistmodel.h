@@ -20,6 +20,7 @@ class BansheePlaylistModel : public BaseSqlTableModel {
     void setTableModel(int playlistId);
 
     TrackPointer getTrack(const QModelIndex& index) const final;
+    QList<TrackPointer> getTracks(const QModelIndexList& indices) const final;
     TrackId getTrackId(const QModelIndex& index) const final;
 
     QString getTrackLocation(const QModelIndex& index) const final;
@@ -68,6 +68,11 @@ TrackPointer BaseExternalPlaylistModel::getTrack(const QModelIndex& index) const
     return pTrack;
 }
 
+QList<TrackPointer> BaseExternalPlaylistModel::getTracks(const QModelIndexList& indices) const {
+    // Each track is imported individually by getTrack()
+    return TrackModel::getTracks(indices);
+}
+
 TrackId BaseExternalPlaylistModel::getTrackId(const QModelIndex& index) const {
     const auto track = getTrack(index);
     if (track) {
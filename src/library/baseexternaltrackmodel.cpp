@@ -79,6 +79,11 @@ TrackPointer BaseExternalTrackModel::getTrack(const QModelIndex& index) const {
     return pTrack;
 }
 
+QList<TrackPointer> BaseExternalTrackModel::getTracks(const QModelIndexList& indices) const {
+    // Each track is imported individually by getTrack()
+    return TrackModel::getTracks(indices);
+}
+
 TrackId BaseExternalTrackModel::getTrackId(const QModelIndex& index) const {
     const auto track = getTrack(index);
     if (track) {
@@ -23,6 +23,7 @@ class BaseExternalTrackModel : public BaseSqlTableModel {
     CapabilitiesFlags getCapabilities() const override;
     TrackId getTrackId(const QModelIndex& index) const override;
     TrackPointer getTrack(const QModelIndex& index) const override;
+    QList<TrackPointer> getTracks(const QModelIndexList& indices) const override;
     void trackLoaded(QString group, TrackPointer pTrack) override;
     bool isColumnInternal(int column) override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
@@ -586,11 +586,12 @@ void BasePlaylistFeature::slotExportTrackFiles() {
     pPlaylistTableModel->select();
 
     int rows = pPlaylistTableModel->rowCount();
-    QList<TrackPointer> tracks;
+    QModelIndexList indices;
+    indices.reserve(rows);
     for (int i = 0; i < rows; ++i) {
-        QModelIndex index = pPlaylistTableModel->index(i, 0);
-        tracks.push_back(pPlaylistTableModel->getTrack(index));
+        indices.append(pPlaylistTableModel->index(i, 0));
     }
+    const QList<TrackPointer> tracks = pPlaylistTableModel->getTracks(indices);
 
     TrackExportWizard track_export(nullptr, m_pConfig, tracks);
     track_export.exportTracks();
@@ -943,6 +943,15 @@ TrackPointer BaseSqlTableModel::getTrack(const QModelIndex& index) const {
     return m_pTrackCollectionManager->internalCollection()->getTrackById(getTrackId(index));
 }
 
+QList<TrackPointer> BaseSqlTableModel::getTracks(const QModelIndexList& indices) const {
+    QList<TrackId> trackIds;
+    trackIds.reserve(indices.size());
+    for (const QModelIndex& index : indices) {
+        trackIds.append(getTrackId(index));
+    }
+    return m_pTrackCollectionManager->internalCollection()->getTracksById(trackIds);
+}
+
 QString BaseSqlTableModel::getTrackLocation(const QModelIndex& index) const {
     if (!index.isValid()) {
         return "";
@@ -18,14 +18,6 @@ QString pixmapCacheKey(quint16 hash, int width) {
             .arg(QString::number(hash), QString::number(width));
 }
 
-// The transformation mode when scaling images
-const Qt::TransformationMode kTransformationMode = Qt::SmoothTransformation;
-
-// Resizes the image (preserving aspect ratio) to width.
-inline QImage resizeImageWidth(const QImage& image, int width) {
-    return image.scaledToWidth(width, kTransformationMode);
-}
-
 const bool sDebug = false;
 
 } // anonymous namespace
@@ -113,6 +105,12 @@ QPixmap CoverArtCache::requestCover(const CoverInfo& requestInfo,
     return QPixmap();
 }
 
+void CoverArtCache::setThumbnailCache(
+        std::shared_ptr<CoverArtThumbnailCache> pThumbnailCache) {
+    DEBUG_ASSERT(m_runningRequests.isEmpty());
+    m_pThumbnailCache = std::move(pThumbnailCache);
+}
+
 //static
 void CoverArtCache::requestCover(const Track& track,
                          const QObject* pRequestor) {
@@ -133,6 +131,21 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
                  << info << desiredWidth << signalWhenDone;
     }
 
+    FutureResult res;
+    res.pRequestor = pRequestor;
+    res.signalWhenDone = signalWhenDone;
+
+    // Scaled covers might have been stored persistently before. This
+    // avoids to extract and scale the original image again after it
+    // has been evicted from the QPixmapCache.
+    if (m_pThumbnailCache && desiredWidth > 0) {
+        QImage thumbnail = m_pThumbnailCache->loadThumbnail(info, desiredWidth);
+        if (!thumbnail.isNull()) {
+            res.cover = CoverArt(info, thumbnail, desiredWidth);
+            return res;
+        }
+    }
+
     QImage image = info.loadImage();
 
     // TODO(XXX) Should we re-hash here? If the cover file (or track metadata)
@@ -143,13 +156,14 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
     // Adjust the cover size according to the request or downsize the image for
     // efficiency.
     if (!image.isNull() && desiredWidth > 0) {
-        image = resizeImageWidth(image, desiredWidth);
+        if (m_pThumbnailCache) {
+            image = m_pThumbnailCache->createThumbnail(info, desiredWidth, image);
+        } else {
+            image = CoverArtThumbnailCache::scaleToWidth(image, desiredWidth);
+        }
     }
 
-    FutureResult res;
-    res.pRequestor = pRequestor;
     res.cover = CoverArt(info, image, desiredWidth);
-    res.signalWhenDone = signalWhenDone;
 
     return res;
 }
@@ -5,6 +5,8 @@
 #include <QPixmap>
 
 #include "library/coverart.h"
+#include "library/coverartthumbnailcache.h"
+#include "util/memory.h"
 #include "util/singleton.h"
 #include "track/track.h"
 
@@ -32,6 +34,17 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
     static void requestCover(const Track& track,
                              const QObject* pRequestor);
 
+    // Enables the persistent thumbnail cache for scaled covers. Must be
+    // invoked once before requesting the first cover.
+    void setThumbnailCache(
+            std::shared_ptr<CoverArtThumbnailCache> pThumbnailCache);
+
+    // The library scanner shares the thumbnail cache to keep the
+    // accounting of its size in one place.
+    const std::shared_ptr<CoverArtThumbnailCache>& getThumbnailCache() const {
+        return m_pThumbnailCache;
+    }
+
     // Guesses the cover art for the provided tracks by searching the tracks'
     // metadata and folders for image files. All I/O is done in a separate
     // thread.
@@ -75,6 +88,9 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
 
   private:
     QSet<QPair<const QObject*, quint16> > m_runningRequests;
+
+    // Accessed from worker threads, but immutable once set
+    std::shared_ptr<CoverArtThumbnailCache> m_pThumbnailCache;
 };
 
 #endif // COVERARTCACHE_H
@@ -0,0 +1,351 @@
+#include "library/coverartthumbnailcache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QSaveFile>
+#include <algorithm>
+
+#include "track/trackfile.h"
+#include "util/cache.h"
+#include "util/compatibility.h"
+#include "util/logger.h"
+
+namespace {
+
+mixxx::Logger kLogger("CoverArtThumbnailCache");
+
+const char* const kThumbnailFormat = "PNG";
+
+// Comma-separated list of the thumbnail widths that are prewarmed
+const ConfigKey kThumbnailWidthsConfigKey("[Library]", "CoverArtThumbnailWidths");
+
+// The cover column of the library has the default section size of
+// QHeaderView, i.e. 100 pixels, until it has been resized.
+const QString kDefaultThumbnailWidths = QStringLiteral("128");
+
+// The transformation mode when scaling images
+const Qt::TransformationMode kTransformationMode = Qt::SmoothTransformation;
+
+// The widths of the stored thumbnails in ascending order. Library rows
+// request covers with the width of the resizable cover column multiplied
+// by the device pixel ratio. Larger covers are displayed by the skin
+// widgets, which are not cached.
+const int kThumbnailWidths[] = {32, 48, 64, 96, 128, 192, 256};
+
+// The modification time of a thumbnail is used as the time of its
+// last use. It is only updated once in a while to avoid a write access
+// for each displayed cover.
+const qint64 kTouchIntervalSecs = 24 * 60 * 60;
+
+// Eviction deletes thumbnails until the cache has shrunk to this
+// fraction of its maximum size to avoid evicting on every store.
+const qint64 kEvictionTargetPercent = 75;
+
+bool isThumbnailWidth(int width) {
+    return std::find(std::begin(kThumbnailWidths),
+                   std::end(kThumbnailWidths),
+                   width) != std::end(kThumbnailWidths);
+}
+
+QString coverLocationForKey(const CoverInfo& coverInfo) {
+    switch (coverInfo.type) {
+    case CoverInfo::METADATA:
+        return coverInfo.trackLocation;
+    case CoverInfo::FILE:
+        if (coverInfo.trackLocation.isEmpty()) {
+            return coverInfo.coverLocation;
+        }
+        return QFileInfo(
+                TrackFile(coverInfo.trackLocation).directory(),
+                coverInfo.coverLocation).filePath();
+    default:
+        return QString();
+    }
+}
+
+QFileInfoList thumbnailFiles(const QDir& thumbnailDir) {
+    return thumbnailDir.entryInfoList(
+            QStringList{QStringLiteral("*.png")}, QDir::Files);
+}
+
+void touchFile(const QString& filePath) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (QFileInfo(filePath).lastModified().secsTo(now) < kTouchIntervalSecs) {
+        return;
+    }
+    // Append does not modify the contents of the file
+    QFile file(filePath);
+    if (file.open(QIODevice::Append)) {
+        file.setFileTime(now, QFileDevice::FileModificationTime);
+    }
+#else
+    // Without QFileDevice::setFileTime() the thumbnails are evicted in
+    // the order of their creation.
+    Q_UNUSED(filePath);
+#endif
+}
+
+} // anonymous namespace
+
+CoverArtThumbnailCache::CoverArtThumbnailCache(
+        const QString& cacheDir,
+        UserSettingsPointer pConfig,
+        qint64 maxCacheBytes)
+        : m_cacheDir(cacheDir),
+          m_pConfig(std::move(pConfig)),
+          m_maxCacheBytes(maxCacheBytes),
+          m_cacheBytes(0) {
+    if (m_pConfig) {
+        const QStringList widths = m_pConfig->getValue(
+                kThumbnailWidthsConfigKey, kDefaultThumbnailWidths)
+                .split(QChar(','), QString::SkipEmptyParts);
+        for (const auto& width : widths) {
+            const int thumbnailWidth = thumbnailWidthFor(width.toInt());
+            if (thumbnailWidth > 0 && !m_thumbnailWidths.contains(thumbnailWidth)) {
+                m_thumbnailWidths.append(thumbnailWidth);
+            }
+        }
+    }
+    const QStringList subDirs =
+            m_cacheDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    qint64 cacheBytes = 0;
+    for (const auto& subDir : subDirs) {
+        bool ok = false;
+        const int width = subDir.toInt(&ok);
+        if (!ok || width <= 0) {
+            continue;
+        }
+        QDir thumbnailDir(m_cacheDir.filePath(subDir));
+        if (!isThumbnailWidth(width)) {
+            // Left over from a version that stored thumbnails of
+            // arbitrary widths
+            kLogger.info()
+                    << "Deleting thumbnails of unsupported width"
+                    << width;
+            thumbnailDir.removeRecursively();
+            continue;
+        }
+        if (!m_thumbnailWidths.contains(width)) {
+            m_thumbnailWidths.append(width);
+        }
+        for (const auto& fileInfo : thumbnailFiles(thumbnailDir)) {
+            cacheBytes += fileInfo.size();
+        }
+    }
+    std::sort(m_thumbnailWidths.begin(), m_thumbnailWidths.end());
+    m_cacheBytes = cacheBytes;
+    if (cacheBytes > m_maxCacheBytes) {
+        evictThumbnails();
+    }
+}
+
+//static
+QString CoverArtThumbnailCache::defaultCacheDir(
+        const UserSettingsPointer& pConfig) {
+    return QDir(pConfig->getSettingsPath()).filePath("coverart_thumbnails");
+}
+
+//static
+int CoverArtThumbnailCache::thumbnailWidthFor(int width) {
+    if (width <= 0) {
+        return 0;
+    }
+    for (int thumbnailWidth : kThumbnailWidths) {
+        if (width <= thumbnailWidth) {
+            return thumbnailWidth;
+        }
+    }
+    return 0;
+}
+
+QList<int> CoverArtThumbnailCache::thumbnailWidths() const {
+    QMutexLocker locker(&m_thumbnailWidthsMutex);
+    return m_thumbnailWidths;
+}
+
+void CoverArtThumbnailCache::addThumbnailWidth(int thumbnailWidth) const {
+    QMutexLocker locker(&m_thumbnailWidthsMutex);
+    if (m_thumbnailWidths.contains(thumbnailWidth)) {
+        return;
+    }
+    m_thumbnailWidths.append(thumbnailWidth);
+    std::sort(m_thumbnailWidths.begin(), m_thumbnailWidths.end());
+    if (m_pConfig) {
+        QStringList widths;
+        for (int width : qAsConst(m_thumbnailWidths)) {
+            widths.append(QString::number(width));
+        }
+        m_pConfig->setValue(kThumbnailWidthsConfigKey, widths.join(QChar(',')));
+    }
+}
+
+//static
+QImage CoverArtThumbnailCache::scaleToWidth(const QImage& image, int width) {
+    return image.scaledToWidth(width, kTransformationMode);
+}
+
+QString CoverArtThumbnailCache::thumbnailFilePath(
+        const CoverInfo& coverInfo,
+        int thumbnailWidth) const {
+    const QString location = coverLocationForKey(coverInfo);
+    if (location.isEmpty() || thumbnailWidth <= 0) {
+        return QString();
+    }
+    const QFileInfo fileInfo(location);
+    if (!fileInfo.exists()) {
+        return QString();
+    }
+    QCryptographicHash locationHash(QCryptographicHash::Sha256);
+    locationHash.addData(location.toUtf8());
+    locationHash.addData(QByteArray::number(fileInfo.size()));
+    locationHash.addData(QByteArray::number(
+            fileInfo.lastModified().toMSecsSinceEpoch()));
+    const mixxx::cache_key_t locationKey =
+            mixxx::cacheKeyFromMessageDigest(locationHash.result());
+    const QString fileName = QString("%1_%2.png")
+            .arg(coverInfo.hash, 4, 16, QChar('0'))
+            .arg(locationKey, 16, 16, QChar('0'));
+    return m_cacheDir.filePath(
+            QString::number(thumbnailWidth) + QChar('/') + fileName);
+}
+
+QImage CoverArtThumbnailCache::loadThumbnail(
+        const CoverInfo& coverInfo,
+        int width) const {
+    const int thumbnailWidth = thumbnailWidthFor(width);
+    const QString filePath = thumbnailFilePath(coverInfo, thumbnailWidth);
+    if (filePath.isEmpty()) {
+        return QImage();
+    }
+    const QImage thumbnail(filePath, kThumbnailFormat);
+    if (thumbnail.isNull()) {
+        return thumbnail;
+    }
+    touchFile(filePath);
+    if (thumbnail.width() == width) {
+        return thumbnail;
+    }
+    return scaleToWidth(thumbnail, width);
+}
+
+QImage CoverArtThumbnailCache::createThumbnail(
+        const CoverInfo& coverInfo,
+        int width,
+        const QImage& coverImage) const {
+    if (coverImage.isNull() || width <= 0) {
+        return coverImage;
+    }
+    const int thumbnailWidth = thumbnailWidthFor(width);
+    const QString filePath = thumbnailFilePath(coverInfo, thumbnailWidth);
+    if (filePath.isEmpty()) {
+        return scaleToWidth(coverImage, width);
+    }
+    const QImage thumbnail = scaleToWidth(coverImage, thumbnailWidth);
+    if (storeThumbnail(filePath, thumbnailWidth, thumbnail)) {
+        addThumbnailWidth(thumbnailWidth);
+    }
+    if (thumbnailWidth == width) {
+        return thumbnail;
+    }
+    return scaleToWidth(thumbnail, width);
+}
+
+bool CoverArtThumbnailCache::storeThumbnail(
+        const QString& filePath,
+        int thumbnailWidth,
+        const QImage& thumbnail) const {
+    if (thumbnail.isNull()) {
+        return false;
+    }
+    if (!m_cacheDir.mkpath(QString::number(thumbnailWidth))) {
+        kLogger.warning()
+                << "Failed to create directory for thumbnails of width"
+                << thumbnailWidth;
+        return false;
+    }
+    // The file is written atomically to prevent that concurrent
+    // readers pick up a partially written thumbnail.
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) ||
+            !thumbnail.save(&file, kThumbnailFormat)) {
+        kLogger.warning()
+                << "Failed to store thumbnail"
+                << filePath;
+        return false;
+    }
+    const qint64 fileBytes = file.size();
+    // An existing thumbnail is replaced
+    const QFileInfo oldFileInfo(filePath);
+    const qint64 oldFileBytes = oldFileInfo.exists() ? oldFileInfo.size() : 0;
+    if (!file.commit()) {
+        kLogger.warning()
+                << "Failed to store thumbnail"
+                << filePath;
+        return false;
+    }
+    const qint64 addedBytes = fileBytes - oldFileBytes;
+    if (m_cacheBytes.fetch_add(addedBytes) + addedBytes > m_maxCacheBytes) {
+        evictThumbnails();
+    }
+    return true;
+}
+
+void CoverArtThumbnailCache::evictThumbnails() const {
+    // Another thread is already evicting
+    if (!m_evictionMutex.tryLock()) {
+        return;
+    }
+    QFileInfoList fileInfos;
+    const QStringList subDirs =
+            m_cacheDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const auto& subDir : subDirs) {
+        fileInfos += thumbnailFiles(QDir(m_cacheDir.filePath(subDir)));
+    }
+    qint64 cacheBytes = 0;
+    for (const auto& fileInfo : fileInfos) {
+        cacheBytes += fileInfo.size();
+    }
+    // Least recently used first
+    std::sort(fileInfos.begin(),
+            fileInfos.end(),
+            [](const QFileInfo& lhs, const QFileInfo& rhs) {
+                return lhs.lastModified() < rhs.lastModified();
+            });
+    const qint64 targetBytes = m_maxCacheBytes * kEvictionTargetPercent / 100;
+    int evictedCount = 0;
+    for (const auto& fileInfo : fileInfos) {
+        if (cacheBytes <= targetBytes) {
+            break;
+        }
+        if (QFile::remove(fileInfo.filePath())) {
+            cacheBytes -= fileInfo.size();
+            ++evictedCount;
+        }
+    }
+    m_cacheBytes = cacheBytes;
+    m_evictionMutex.unlock();
+    kLogger.info()
+            << "Evicted" << evictedCount
+            << "thumbnails, remaining cache size" << cacheBytes << "bytes";
+}
+
+void CoverArtThumbnailCache::prewarm(const CoverInfo& coverInfo) const {
+    if (coverInfo.type == CoverInfo::NONE) {
+        return;
+    }
+    QImage image;
+    for (int thumbnailWidth : thumbnailWidths()) {
+        const QString filePath = thumbnailFilePath(coverInfo, thumbnailWidth);
+        if (filePath.isEmpty() || QFileInfo::exists(filePath)) {
+            continue;
+        }
+        if (image.isNull()) {
+            image = coverInfo.loadImage();
+            if (image.isNull()) {
+                return;
+            }
+        }
+        storeThumbnail(filePath, thumbnailWidth, scaleToWidth(image, thumbnailWidth));
+    }
+}
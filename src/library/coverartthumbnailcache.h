@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QDir>
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+
+#include "library/coverart.h"
+#include "preferences/usersettings.h"
+
+// Persistent store for scaled cover art thumbnails that survives
+// restarts and evictions from the QPixmapCache.
+//
+// Thumbnails are only stored with a small, fixed set of widths in one
+// sub-directory per width. Requests for other widths are served by
+// scaling down the thumbnail with the next larger width, so resizing
+// the cover column in the library does not create new thumbnails.
+//
+// The file name is derived from the cover hash, the location of the
+// cover image, i.e. either the track file for embedded covers or the
+// image file in the track's folder, and the size and modification time
+// of this file. Including the location avoids serving the wrong cover
+// after a collision of the 16-bit cover hash. Including the size and
+// modification time avoids serving an outdated thumbnail after the
+// cover has been replaced without updating its hash in the database.
+//
+// The total size of the cache is limited. When exceeded, the least
+// recently used thumbnails are deleted.
+//
+// The widths that are requested by the library are stored in the
+// configuration. The library scanner creates thumbnails with these
+// widths in advance for all new tracks, even if no thumbnails have
+// been stored yet.
+//
+// All member functions are thread-safe and intended to be invoked
+// from worker threads.
+class CoverArtThumbnailCache {
+  public:
+    static constexpr qint64 kDefaultMaxCacheBytes = 100 * 1024 * 1024;
+
+    explicit CoverArtThumbnailCache(
+            const QString& cacheDir,
+            UserSettingsPointer pConfig = UserSettingsPointer(),
+            qint64 maxCacheBytes = kDefaultMaxCacheBytes);
+
+    // The default location of the cache within the settings folder.
+    static QString defaultCacheDir(const UserSettingsPointer& pConfig);
+
+    // The width of the thumbnail that is stored for the requested
+    // width or 0 if covers of this width are not stored at all.
+    static int thumbnailWidthFor(int width);
+
+    // Returns a null image if the thumbnail has not been stored yet.
+    QImage loadThumbnail(
+            const CoverInfo& coverInfo,
+            int width) const;
+
+    // Stores the thumbnail for the given width, if covers of this
+    // width are stored at all, and returns the cover image scaled to
+    // the requested width.
+    QImage createThumbnail(
+            const CoverInfo& coverInfo,
+            int width,
+            const QImage& coverImage) const;
+
+    // The widths of all thumbnails that have been stored or requested
+    // in ascending order.
+    QList<int> thumbnailWidths() const;
+
+    // Creates all missing thumbnails for the given cover with all known
+    // widths. The cover image is only loaded if at least one of the
+    // thumbnails is missing.
+    void prewarm(const CoverInfo& coverInfo) const;
+
+    // The total size of all thumbnails in bytes
+    qint64 cacheBytes() const {
+        return m_cacheBytes.load();
+    }
+
+    static QImage scaleToWidth(const QImage& image, int width);
+
+  private:
+    QString thumbnailFilePath(
+            const CoverInfo& coverInfo,
+            int thumbnailWidth) const;
+
+    // Remembers the width of a requested thumbnail for prewarm()
+    void addThumbnailWidth(int thumbnailWidth) const;
+
+    bool storeThumbnail(
+            const QString& filePath,
+            int thumbnailWidth,
+            const QImage& thumbnail) const;
+
+    // Deletes the least recently used thumbnails until the cache
+    // is well below its maximum size again.
+    void evictThumbnails() const;
+
+    const QDir m_cacheDir;
+    const UserSettingsPointer m_pConfig;
+    const qint64 m_maxCacheBytes;
+    mutable QMutex m_thumbnailWidthsMutex;
+    mutable QList<int> m_thumbnailWidths;
+    mutable std::atomic<qint64> m_cacheBytes;
+    mutable QMutex m_evictionMutex;
+};
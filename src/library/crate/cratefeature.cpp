@@ -769,11 +769,12 @@ void CrateFeature::slotExportTrackFiles() {
     pCrateTableModel->select();
 
     int rows = pCrateTableModel->rowCount();
-    QList<TrackPointer> trackpointers;
+    QModelIndexList indices;
+    indices.reserve(rows);
     for (int i = 0; i < rows; ++i) {
-        QModelIndex index = m_crateTableModel.index(i, 0);
-        trackpointers.push_back(m_crateTableModel.getTrack(index));
+        indices.append(pCrateTableModel->index(i, 0));
     }
+    const QList<TrackPointer> trackpointers = pCrateTableModel->getTracks(indices);
 
     TrackExportWizard track_export(nullptr, m_pConfig, trackpointers);
     track_export.exportTracks();
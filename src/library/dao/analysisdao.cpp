@@ -1,13 +1,18 @@
+#include <QSaveFile>
+#include <QSet>
 #include <QSqlQuery>
 #include <QSqlResult>
 #include <QSqlError>
 #include <QtDebug>
+#include <climits>
 
 #include "library/dao/analysisdao.h"
 #include "library/queryutil.h"
 #include "preferences/waveformsettings.h"
 #include "util/performancetimer.h"
 #include "waveform/waveform.h"
+#include "waveform/waveformblockfile.h"
+#include "waveform/waveformfactory.h"
 
 const QString AnalysisDao::s_analysisTableName = "track_analysis";
 
@@ -73,7 +78,9 @@ QList<AnalysisDao::AnalysisInfo> AnalysisDao::loadAnalysesFromQuery(TrackId trac
     const int versionColumn = queryRecord.indexOf("version");
     const int dataChecksumColumn = queryRecord.indexOf("data_checksum");
 
-    QDir analysisPath(getAnalysisStoragePath());
+    QList<AnalysisDao::AnalysisInfo> rows;
+    QList<int> checksums;
+    QSet<int> typesWithCurrentVersion;
     while (query->next()) {
         AnalysisDao::AnalysisInfo info;
         info.analysisId = query->value(idColumn).toInt();
@@ -81,21 +88,68 @@ QList<AnalysisDao::AnalysisInfo> AnalysisDao::loadAnalysesFromQuery(TrackId trac
         info.type = static_cast<AnalysisType>(query->value(typeColumn).toInt());
         info.description = query->value(descriptionColumn).toString();
         info.version = query->value(versionColumn).toString();
-        int checksum = query->value(dataChecksumColumn).toInt();
+        if (info.version == currentVersion(info.type)) {
+            typesWithCurrentVersion.insert(info.type);
+        }
+        rows.append(info);
+        checksums.append(query->value(dataChecksumColumn).toInt());
+    }
+
+    QDir analysisPath(getAnalysisStoragePath());
+    QList<int> legacyAnalyses;
+    for (int i = 0; i < rows.size(); ++i) {
+        AnalysisDao::AnalysisInfo info = rows[i];
+        const bool convertible = isConvertibleLegacyVersion(info.type, info.version);
+        if (convertible && typesWithCurrentVersion.contains(info.type)) {
+            // Only kept for older versions of Mixxx and has already been
+            // converted, no need to load the data
+            analyses.append(info);
+            continue;
+        }
+        const int checksum = checksums[i];
         QString dataPath = analysisPath.absoluteFilePath(
             QString::number(info.analysisId));
-        QByteArray compressedData = loadDataFromFile(dataPath);
-        int file_checksum = qChecksum(compressedData.constData(),
-                                      compressedData.length());
-        if (checksum != file_checksum) {
-            qDebug() << "WARNING: Corrupt analysis loaded from" << dataPath
-                     << "length" << compressedData.length();
-            continue;
+        QSharedPointer<QFile> pMappedFile;
+        QByteArray fileData = mapDataFromFile(dataPath, &pMappedFile);
+        if (WaveformBlockFile::isBlockFile(fileData)) {
+            // Only the header and the block index are verified here, the
+            // blocks are verified when they are decoded.
+            const WaveformBlockFile blockFile(fileData);
+            if (!blockFile.isValid() || checksum != blockFile.checksum()) {
+                qDebug() << "WARNING: Corrupt analysis loaded from" << dataPath
+                         << "length" << fileData.length();
+                continue;
+            }
+            info.data = fileData;
+            info.pMappedFile = pMappedFile;
+        } else {
+            int file_checksum = qChecksum(fileData.constData(),
+                                          fileData.length());
+            if (checksum != file_checksum) {
+                qDebug() << "WARNING: Corrupt analysis loaded from" << dataPath
+                         << "length" << fileData.length();
+                continue;
+            }
+            info.data = qUncompress(fileData);
+            if (convertible) {
+                legacyAnalyses.append(analyses.size());
+            }
         }
-        info.data = qUncompress(compressedData);
         bytes += info.data.length();
         analyses.append(info);
     }
+
+    // The analyses are loaded in the new format from now on. The data
+    // of the legacy analyses has been uncompressed already, so the
+    // conversion only costs the re-encoding once per track. The legacy
+    // analyses are kept untouched for older versions of Mixxx that
+    // share the same settings folder.
+    for (int index : legacyAnalyses) {
+        AnalysisInfo converted;
+        if (convertLegacyAnalysis(analyses[index], &converted)) {
+            analyses.append(converted);
+        }
+    }
     qDebug() << "AnalysisDAO fetched" << analyses.size() << "analyses,"
              << bytes << "bytes for track"
              << trackId << "in" << time.elapsed().debugMillisWithUnit();
@@ -114,9 +168,18 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
     PerformanceTimer time;
     time.start();
 
-    QByteArray compressedData = qCompress(info->data, kCompressionLevel);
-    int checksum = qChecksum(compressedData.constData(),
+    QByteArray compressedData;
+    int checksum;
+    if (WaveformBlockFile::isBlockFile(info->data)) {
+        // The blocks are compressed individually and only the header
+        // and the block index are covered by the checksum.
+        compressedData = info->data;
+        checksum = WaveformBlockFile(info->data).checksum();
+    } else {
+        compressedData = qCompress(info->data, kCompressionLevel);
+        checksum = qChecksum(compressedData.constData(),
                              compressedData.length());
+    }
 
     QSqlQuery query(m_db);
     if (info->analysisId == -1) {
@@ -174,6 +237,59 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
     return true;
 }
 
+//static
+QString AnalysisDao::currentVersion(AnalysisType type) {
+    switch (type) {
+    case TYPE_WAVEFORM:
+        return WaveformFactory::currentWaveformVersion();
+    case TYPE_WAVESUMMARY:
+        return WaveformFactory::currentWaveformSummaryVersion();
+    default:
+        return QString();
+    }
+}
+
+//static
+bool AnalysisDao::isConvertibleLegacyVersion(
+        AnalysisType type, const QString& version) {
+    // The current version contains the same data as version 5.0, only
+    // stored in the block file format.
+    switch (type) {
+    case TYPE_WAVEFORM:
+        return version == WAVEFORM_5_VERSION;
+    case TYPE_WAVESUMMARY:
+        return version == WAVEFORMSUMMARY_5_VERSION;
+    default:
+        return false;
+    }
+}
+
+bool AnalysisDao::convertLegacyAnalysis(
+        const AnalysisInfo& legacy,
+        AnalysisInfo* pConverted) {
+    const QByteArray blockFileData = WaveformBlockFile::convertLegacyFormat(legacy.data);
+    if (blockFileData.isEmpty()) {
+        return false;
+    }
+    AnalysisInfo converted;
+    converted.trackId = legacy.trackId;
+    converted.type = legacy.type;
+    converted.version = currentVersion(legacy.type);
+    if (legacy.type == TYPE_WAVEFORM) {
+        converted.description = WaveformFactory::currentWaveformDescription();
+    } else {
+        converted.description = WaveformFactory::currentWaveformSummaryDescription();
+    }
+    converted.data = blockFileData;
+    // Stored as a new analysis with its own data file
+    if (!saveAnalysis(&converted)) {
+        qDebug() << "WARNING: Failed to convert analysis" << legacy.analysisId;
+        return false;
+    }
+    *pConverted = converted;
+    return true;
+}
+
 bool AnalysisDao::deleteAnalysis(const int analysisId) {
     if (analysisId == -1) {
         return false;
@@ -251,15 +367,25 @@ QDir AnalysisDao::getAnalysisStoragePath() const {
     return dir.absolutePath().append("/");
 }
 
-QByteArray AnalysisDao::loadDataFromFile(const QString& filename) const {
-    QFile file(filename);
-    if (!file.exists()) {
+QByteArray AnalysisDao::mapDataFromFile(
+        const QString& fileName,
+        QSharedPointer<QFile>* ppMappedFile) const {
+    auto pFile = QSharedPointer<QFile>::create(fileName);
+    if (!pFile->open(QIODevice::ReadOnly)) {
         return QByteArray();
     }
-    if (!file.open(QIODevice::ReadOnly)) {
-        return QByteArray();
+    const qint64 size = pFile->size();
+    uchar* pData = nullptr;
+    if (size > 0 && size <= INT_MAX) {
+        pData = pFile->map(0, size);
+    }
+    if (!pData) {
+        // Not every file system supports memory mapping
+        return pFile->readAll();
     }
-    return file.readAll();
+    *ppMappedFile = pFile;
+    return QByteArray::fromRawData(
+            reinterpret_cast<const char*>(pData), static_cast<int>(size));
 }
 
 bool AnalysisDao::deleteFile(const QString& fileName) const {
@@ -268,40 +394,20 @@ bool AnalysisDao::deleteFile(const QString& fileName) const {
 }
 
 bool AnalysisDao::saveDataToFile(const QString& fileName, const QByteArray& data) const {
-    QFile file(fileName);
-
-    // If the file exists, do the right thing. Write to a temp file, unlink the
-    // existing file, and then move the temp file to the real file's name.
-    if (file.exists()) {
-        QString tempFileName = fileName + ".tmp";
-        QFile tempFile(tempFileName);
-        if (!tempFile.open(QIODevice::WriteOnly)) {
-            return false;
-        }
-        int bytesWritten = tempFile.write(data);
-        if (bytesWritten == -1 || bytesWritten != data.length()) {
-            return false;
-        }
-        tempFile.close();
-        if (!file.remove()) {
-            return false;
-        }
-        if (!tempFile.rename(fileName)) {
-            return false;
-        }
-        return true;
-    }
-
-    // If the file doesn't exist, just create a new file and write the data.
+    // The data is written to a temporary file with a unique name that
+    // replaces the existing file when committed. Concurrent writers of
+    // the same analysis, e.g. the analyzer and the waveform prefetcher,
+    // don't interfere and readers never see a partially written file.
+    QSaveFile file(fileName);
     if (!file.open(QIODevice::WriteOnly)) {
         return false;
     }
-    int bytesWritten = file.write(data);
-    if (bytesWritten == -1 || bytesWritten != data.length()) {
+    const qint64 bytesWritten = file.write(data);
+    if (bytesWritten != data.length()) {
+        file.cancelWriting();
         return false;
     }
-    file.close();
-    return true;
+    return file.commit();
 }
 
 void AnalysisDao::saveTrackAnalyses(
@@ -329,7 +435,7 @@ void AnalysisDao::saveTrackAnalyses(
     analysis.type = AnalysisDao::TYPE_WAVEFORM;
     analysis.description = pWaveform->getDescription();
     analysis.version = pWaveform->getVersion();
-    analysis.data = pWaveform->toByteArray();
+    analysis.data = WaveformBlockFile::encode(*pWaveform);
     bool success = saveAnalysis(&analysis);
     if (success) {
         pWaveform->setSaveState(Waveform::SaveState::Saved);
@@ -344,7 +450,7 @@ void AnalysisDao::saveTrackAnalyses(
     analysis.type = AnalysisDao::TYPE_WAVESUMMARY;
     analysis.description = pWaveSummary->getDescription();
     analysis.version = pWaveSummary->getVersion();
-    analysis.data = pWaveSummary->toByteArray();
+    analysis.data = WaveformBlockFile::encode(*pWaveSummary);
 
     success = saveAnalysis(&analysis);
     if (success) {
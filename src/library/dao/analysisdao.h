@@ -3,6 +3,8 @@
 
 #include <QObject>
 #include <QDir>
+#include <QFile>
+#include <QSharedPointer>
 #include <QSqlDatabase>
 
 #include "preferences/usersettings.h"
@@ -30,7 +32,12 @@ class AnalysisDao : public DAO {
         AnalysisType type;
         QString description;
         QString version;
+        // Empty for legacy analyses that have already been converted
+        // into the current version.
         QByteArray data;
+        // Keeps the memory mapping alive if data refers to a memory
+        // mapped file.
+        QSharedPointer<QFile> pMappedFile;
     };
 
     explicit AnalysisDao(UserSettingsPointer pConfig);
@@ -64,10 +71,17 @@ class AnalysisDao : public DAO {
 
   private:
     QDir getAnalysisStoragePath() const;
-    QByteArray loadDataFromFile(const QString& fileName) const;
+    QByteArray mapDataFromFile(
+            const QString& fileName,
+            QSharedPointer<QFile>* ppMappedFile) const;
     bool saveDataToFile(const QString& fileName, const QByteArray& data) const;
     bool deleteFile(const QString& filename) const;
     QList<AnalysisInfo> loadAnalysesFromQuery(TrackId trackId, QSqlQuery* query);
+    static QString currentVersion(AnalysisType type);
+    static bool isConvertibleLegacyVersion(AnalysisType type, const QString& version);
+    bool convertLegacyAnalysis(
+            const AnalysisInfo& legacy,
+            AnalysisInfo* pConverted);
 
     UserSettingsPointer m_pConfig;
     QSqlDatabase m_db;
@@ -290,6 +290,39 @@ void TrackDAO::saveTrack(Track* pTrack) {
     }
 }
 
+void TrackDAO::saveTracks(const QList<Track*>& tracks) {
+    QList<Track*> updatedTracks;
+    updatedTracks.reserve(tracks.size());
+    {
+        ScopedTimer t("TrackDAO::saveTracks");
+        SqlTransaction transaction(m_database);
+        for (Track* pTrack : tracks) {
+            DEBUG_ASSERT(pTrack);
+            // Only update the database if the track has already been added!
+            if (!pTrack->isDirty() || !pTrack->getId().isValid()) {
+                continue;
+            }
+            if (updateTrackWithinTransaction(pTrack)) {
+                updatedTracks.append(pTrack);
+            }
+        }
+        if (updatedTracks.isEmpty()) {
+            return;
+        }
+        if (!transaction.commit()) {
+            qWarning() << "TrackDAO: Failed to save"
+                    << updatedTracks.size()
+                    << "tracks";
+            return;
+        }
+    }
+    qDebug() << "TrackDAO: Saved" << updatedTracks.size() << "tracks";
+    for (Track* pTrack : updatedTracks) {
+        pTrack->markClean();
+        emit trackClean(pTrack->getId());
+    }
+}
+
 void TrackDAO::databaseTrackAdded(TrackPointer pTrack) {
     DEBUG_ASSERT(pTrack);
     emit dbTrackAdded(pTrack);
@@ -648,7 +681,10 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
     return trackId;
 }
 
-TrackPointer TrackDAO::addTracksAddFile(const TrackFile& trackFile, bool unremove) {
+TrackPointer TrackDAO::addTracksAddFile(
+        const TrackFile& trackFile,
+        bool unremove,
+        const mixxx::TrackRecord* pImportedTrackRecord) {
     // Check that track is a supported extension.
     // TODO(uklotzde): The following check can be skipped if
     // the track is already in the library. A refactoring is
@@ -679,9 +715,21 @@ TrackPointer TrackDAO::addTracksAddFile(const TrackFile& trackFile, bool unremov
     // Keep the GlobalTrackCache locked until the id of the Track
     // object is known and has been updated in the cache.
 
-    // Initially (re-)import the metadata for the newly created track
-    // from the file.
-    SoundSourceProxy(pTrack).updateTrackFromSource();
+    if (pImportedTrackRecord) {
+        // The file tags have already been parsed in advance into a
+        // temporary track that has been created from the same file.
+        pTrack->setType(pImportedTrackRecord->getFileType());
+        pTrack->importMetadata(
+                pImportedTrackRecord->getMetadata(),
+                pImportedTrackRecord->getMetadataSynchronized()
+                        ? trackFile.fileLastModified()
+                        : QDateTime());
+        pTrack->setCoverInfo(pImportedTrackRecord->getCoverInfo());
+    } else {
+        // Initially (re-)import the metadata for the newly created track
+        // from the file.
+        SoundSourceProxy(pTrack).updateTrackFromSource();
+    }
     if (!pTrack->isMetadataSynchronized()) {
         qWarning() << "TrackDAO::addTracksAddFile:"
                 << "Failed to parse track metadata from file"
@@ -1122,10 +1170,98 @@ struct ColumnPopulator {
     TrackPopulatorFn populator;
 };
 
-}  // namespace
-
 #define ARRAYLENGTH(x) (sizeof(x) / sizeof(*x))
 
+const ColumnPopulator kTrackColumns[] = {
+    // Location must be first, followed by the id.
+    { "track_locations.location", nullptr },
+    { "library.id", nullptr },
+    { "artist", setTrackArtist },
+    { "title", setTrackTitle },
+    { "album", setTrackAlbum },
+    { "album_artist", setTrackAlbumArtist },
+    { "year", setTrackYear },
+    { "genre", setTrackGenre },
+    { "composer", setTrackComposer },
+    { "grouping", setTrackGrouping },
+    { "tracknumber", setTrackNumber },
+    { "tracktotal", setTrackTotal },
+    { "filetype", setTrackFiletype },
+    { "rating", setTrackRating },
+    { "color", setTrackColor },
+    { "comment", setTrackComment },
+    { "url", setTrackUrl },
+    { "duration", setTrackDuration },
+    { "bitrate", setTrackBitrate },
+    { "samplerate", setTrackSampleRate },
+    { "cuepoint", setTrackCuePoint },
+    { "replaygain", setTrackReplayGainRatio },
+    { "replaygain_peak", setTrackReplayGainPeak },
+    { "channels", setTrackChannels },
+    { "timesplayed", setTrackTimesPlayed },
+    { "played", setTrackPlayed },
+    { "datetime_added", setTrackDateAdded },
+    { "header_parsed", setTrackMetadataSynchronized },
+
+    // Beat detection columns are handled by setTrackBeats. Do not change
+    // the ordering of these columns or put other columns in between them!
+    { "bpm", setTrackBeats },
+    { "beats_version", nullptr },
+    { "beats_sub_version", nullptr },
+    { "beats", nullptr },
+    { "bpm_lock", nullptr },
+
+    // Beat detection columns are handled by setTrackKey. Do not change the
+    // ordering of these columns or put other columns in between them!
+    { "key", setTrackKey },
+    { "keys_version", nullptr },
+    { "keys_sub_version", nullptr },
+    { "keys", nullptr },
+
+    // Cover art columns are handled by setTrackCoverInfo. Do not change the
+    // ordering of these columns or put other columns in between them!
+    { "coverart_source", setTrackCoverInfo },
+    { "coverart_type", nullptr },
+    { "coverart_location", nullptr },
+    { "coverart_hash", nullptr }
+};
+
+const int kTrackColumnsCount = ARRAYLENGTH(kTrackColumns);
+
+const int kTrackLocationColumn = 0;
+const int kTrackIdColumn = 1;
+
+// Limits the number of ids in a single "IN (...)" clause that
+// are loaded at once by TrackDAO::getTracksById(). SQLite can
+// handle much larger lists, but the cues of all tracks in a chunk
+// are loaded into memory at once.
+const int kMaxTrackIdsPerQuery = 500;
+
+QString trackColumnsStr() {
+    QString columnsStr;
+    int columnsSize = 0;
+    for (int i = 0; i < kTrackColumnsCount; ++i) {
+        columnsSize += qstrlen(kTrackColumns[i].name) + 1;
+    }
+    columnsStr.reserve(columnsSize);
+    for (int i = 0; i < kTrackColumnsCount; ++i) {
+        if (i > 0) {
+            columnsStr.append(QChar(','));
+        }
+        columnsStr.append(kTrackColumns[i].name);
+    }
+    return columnsStr;
+}
+
+QString selectTracksQuery(const QString& whereClause) {
+    return QString(
+            "SELECT %1 FROM Library "
+            "INNER JOIN track_locations ON library.location = track_locations.id "
+            "WHERE %2").arg(trackColumnsStr(), whereClause);
+}
+
+}  // namespace
+
 TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     if (!trackId.isValid()) {
         return TrackPointer();
@@ -1144,77 +1280,8 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     ScopedTimer t("TrackDAO::getTrackById");
     QSqlQuery query(m_database);
 
-    ColumnPopulator columns[] = {
-        // Location must be first.
-        { "track_locations.location", nullptr },
-        { "artist", setTrackArtist },
-        { "title", setTrackTitle },
-        { "album", setTrackAlbum },
-        { "album_artist", setTrackAlbumArtist },
-        { "year", setTrackYear },
-        { "genre", setTrackGenre },
-        { "composer", setTrackComposer },
-        { "grouping", setTrackGrouping },
-        { "tracknumber", setTrackNumber },
-        { "tracktotal", setTrackTotal },
-        { "filetype", setTrackFiletype },
-        { "rating", setTrackRating },
-        { "color", setTrackColor },
-        { "comment", setTrackComment },
-        { "url", setTrackUrl },
-        { "duration", setTrackDuration },
-        { "bitrate", setTrackBitrate },
-        { "samplerate", setTrackSampleRate },
-        { "cuepoint", setTrackCuePoint },
-        { "replaygain", setTrackReplayGainRatio },
-        { "replaygain_peak", setTrackReplayGainPeak },
-        { "channels", setTrackChannels },
-        { "timesplayed", setTrackTimesPlayed },
-        { "played", setTrackPlayed },
-        { "datetime_added", setTrackDateAdded },
-        { "header_parsed", setTrackMetadataSynchronized },
-
-        // Beat detection columns are handled by setTrackBeats. Do not change
-        // the ordering of these columns or put other columns in between them!
-        { "bpm", setTrackBeats },
-        { "beats_version", nullptr },
-        { "beats_sub_version", nullptr },
-        { "beats", nullptr },
-        { "bpm_lock", nullptr },
-
-        // Beat detection columns are handled by setTrackKey. Do not change the
-        // ordering of these columns or put other columns in between them!
-        { "key", setTrackKey },
-        { "keys_version", nullptr },
-        { "keys_sub_version", nullptr },
-        { "keys", nullptr },
-
-        // Cover art columns are handled by setTrackCoverInfo. Do not change the
-        // ordering of these columns or put other columns in between them!
-        { "coverart_source", setTrackCoverInfo },
-        { "coverart_type", nullptr },
-        { "coverart_location", nullptr },
-        { "coverart_hash", nullptr }
-    };
-
-    QString columnsStr;
-    int columnsSize = 0;
-    const int columnsCount = ARRAYLENGTH(columns);
-    for (int i = 0; i < columnsCount; ++i) {
-        columnsSize += qstrlen(columns[i].name) + 1;
-    }
-    columnsStr.reserve(columnsSize);
-    for (int i = 0; i < columnsCount; ++i) {
-        if (i > 0) {
-            columnsStr.append(QChar(','));
-        }
-        columnsStr.append(columns[i].name);
-    }
-
-    query.prepare(QString(
-            "SELECT %1 FROM Library "
-            "INNER JOIN track_locations ON library.location = track_locations.id "
-            "WHERE library.id = %2").arg(columnsStr, trackId.toString()));
+    query.prepare(selectTracksQuery(
+            QString("library.id = %1").arg(trackId.toString())));
 
     if (!query.exec()) {
         LOG_FAILED_QUERY(query)
@@ -1226,17 +1293,104 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         return TrackPointer();
     }
 
-    QSqlRecord queryRecord = query.record();
+    return initTrackFromRecord(
+            trackId,
+            query.record(),
+            m_cueDao.getCuesForTrack(trackId));
+}
+
+QList<TrackPointer> TrackDAO::getTracksById(
+        const QList<TrackId>& trackIds) const {
+    QHash<TrackId, TrackPointer> tracksById;
+    tracksById.reserve(trackIds.size());
+
+    // Look up all tracks that are already cached while locking the
+    // GlobalTrackCache only once.
+    QList<TrackId> missingTrackIds;
+    {
+        GlobalTrackCacheLocker cacheLocker;
+        for (const auto& trackId : trackIds) {
+            if (!trackId.isValid() || tracksById.contains(trackId)) {
+                continue;
+            }
+            TrackPointer pTrack = cacheLocker.lookupTrackById(trackId);
+            if (pTrack) {
+                tracksById.insert(trackId, pTrack);
+            } else {
+                // Placeholder to skip duplicate ids
+                tracksById.insert(trackId, TrackPointer());
+                missingTrackIds.append(trackId);
+            }
+        }
+    }
+
+    if (!missingTrackIds.isEmpty()) {
+        ScopedTimer t("TrackDAO::getTracksById");
+        for (int offset = 0;
+                offset < missingTrackIds.size();
+                offset += kMaxTrackIdsPerQuery) {
+            const QList<TrackId> chunk =
+                    missingTrackIds.mid(offset, kMaxTrackIdsPerQuery);
+            QStringList idList;
+            idList.reserve(chunk.size());
+            for (const auto& trackId : chunk) {
+                idList << trackId.toString();
+            }
+
+            QSqlQuery query(m_database);
+            query.setForwardOnly(true);
+            query.prepare(selectTracksQuery(
+                    QString("library.id IN (%1)").arg(idList.join(','))));
+            if (!query.exec()) {
+                LOG_FAILED_QUERY(query)
+                        << "getTracksById:"
+                        << chunk.size()
+                        << "tracks";
+                continue;
+            }
+
+            const QHash<TrackId, QList<CuePointer>> cuesByTrackId =
+                    m_cueDao.getCuesForTracks(chunk);
+            while (query.next()) {
+                const QSqlRecord queryRecord = query.record();
+                const TrackId trackId(queryRecord.value(kTrackIdColumn));
+                tracksById.insert(
+                        trackId,
+                        initTrackFromRecord(
+                                trackId,
+                                queryRecord,
+                                cuesByTrackId.value(trackId)));
+            }
+        }
+    }
+
+    QList<TrackPointer> tracks;
+    tracks.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        TrackPointer pTrack = tracksById.value(trackId);
+        if (pTrack) {
+            tracks.append(std::move(pTrack));
+        } else if (trackId.isValid()) {
+            qDebug() << "Track with id =" << trackId << "not found";
+        }
+    }
+    return tracks;
+}
+
+TrackPointer TrackDAO::initTrackFromRecord(
+        TrackId trackId,
+        const QSqlRecord& queryRecord,
+        const QList<CuePointer>& cues) const {
     int recordCount = queryRecord.count();
-    VERIFY_OR_DEBUG_ASSERT(recordCount == columnsCount) {
-        recordCount = math_min(recordCount, columnsCount);
+    VERIFY_OR_DEBUG_ASSERT(recordCount == kTrackColumnsCount) {
+        recordCount = math_min(recordCount, kTrackColumnsCount);
     }
 
-    // Location is the first column.
-    const QString trackLocation(queryRecord.value(0).toString());
+    const QString trackLocation(
+            queryRecord.value(kTrackLocationColumn).toString());
 
     GlobalTrackCacheResolver cacheResolver(TrackFile(trackLocation), trackId);
-    pTrack = cacheResolver.getTrack();
+    TrackPointer pTrack = cacheResolver.getTrack();
     VERIFY_OR_DEBUG_ASSERT(pTrack) {
         // Just to be safe, but this should never happen!!
         return pTrack;
@@ -1266,7 +1420,7 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     // For every column run its populator to fill the track in with the data.
     bool shouldDirty = false;
     for (int i = 0; i < recordCount; ++i) {
-        TrackPopulatorFn populator = columns[i].populator;
+        TrackPopulatorFn populator = kTrackColumns[i].populator;
         if (populator != nullptr) {
             // If any populator says the track should be dirty then we dirty it.
             if ((*populator)(queryRecord, i, pTrack)) {
@@ -1276,7 +1430,7 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     }
 
     // Populate track cues from the cues table.
-    pTrack->setCuePoints(m_cueDao.getCuesForTrack(trackId));
+    pTrack->setCuePoints(cues);
 
     // Normally we will set the track as clean but sometimes when loading from
     // the database we need to perform upkeep that ought to be written back to
@@ -1365,6 +1519,22 @@ TrackPointer TrackDAO::getTrackByRef(
 
 // Saves a track's info back to the database
 bool TrackDAO::updateTrack(Track* pTrack) {
+    SqlTransaction transaction(m_database);
+    // PerformanceTimer time;
+    // time.start();
+    if (!updateTrackWithinTransaction(pTrack)) {
+        return false;
+    }
+    transaction.commit();
+
+    //qDebug() << "Update track in database took: " << time.elapsed().formatMillisWithUnit();
+    //time.start();
+    pTrack->markClean();
+    //qDebug() << "Dirtying track took: " << time.elapsed().formatMillisWithUnit();
+    return true;
+}
+
+bool TrackDAO::updateTrackWithinTransaction(Track* pTrack) {
     const TrackId trackId = pTrack->getId();
     DEBUG_ASSERT(trackId.isValid());
 
@@ -1373,10 +1543,6 @@ bool TrackDAO::updateTrack(Track* pTrack) {
             << trackId
             << pTrack->getFileInfo();
 
-    SqlTransaction transaction(m_database);
-    // PerformanceTimer time;
-    // time.start();
-
     QSqlQuery query(m_database);
 
     // Update everything but "location", since that's what we identify the track by.
@@ -1443,12 +1609,6 @@ bool TrackDAO::updateTrack(Track* pTrack) {
             pTrack->getWaveformSummary());
     m_cueDao.saveTrackCues(
             trackId, pTrack->getCuePoints());
-    transaction.commit();
-
-    //qDebug() << "Update track in database took: " << time.elapsed().formatMillisWithUnit();
-    //time.start();
-    pTrack->markClean();
-    //qDebug() << "Dirtying track took: " << time.elapsed().formatMillisWithUnit();
     return true;
 }
 
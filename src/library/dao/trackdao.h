@@ -6,6 +6,7 @@
 #include <QSet>
 #include <QList>
 #include <QSqlDatabase>
+#include <QSqlRecord>
 #include <QString>
 
 #include "preferences/usersettings.h"
@@ -71,6 +72,8 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
 
     // Only used by friend class TrackCollection, but public for testing!
     void saveTrack(Track* pTrack);
+    // Saves all dirty tracks within a single database transaction.
+    void saveTracks(const QList<Track*>& tracks);
 
   signals:
     void trackDirty(TrackId trackId) const;
@@ -96,6 +99,17 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
             const QString& location) const;
     TrackPointer getTrackById(
             TrackId trackId) const;
+    // Loads multiple tracks with a single query per table instead of
+    // a query per track. The tracks are returned in the order of the
+    // given ids, missing tracks are skipped.
+    QList<TrackPointer> getTracksById(
+            const QList<TrackId>& trackIds) const;
+    // Populates the track that corresponds to a row of the library
+    // table and registers it in the GlobalTrackCache.
+    TrackPointer initTrackFromRecord(
+            TrackId trackId,
+            const QSqlRecord& queryRecord,
+            const QList<CuePointer>& cues) const;
 
     // Loads a track from the database (by id if available, otherwise by location)
     // or adds it if not found in case the location is known. The (optional) out
@@ -110,12 +124,18 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     TrackId addTracksAddTrack(
             const TrackPointer& pTrack,
             bool unremove);
+    // The track's metadata is either imported from the file or, if
+    // available, taken from a track record that has been parsed from
+    // the file in advance, i.e. by the worker tasks of LibraryScanner.
     TrackPointer addTracksAddFile(
             const TrackFile& trackFile,
-            bool unremove);
+            bool unremove,
+            const mixxx::TrackRecord* pImportedTrackRecord = nullptr);
     void addTracksFinish(bool rollback = false);
 
     bool updateTrack(Track* pTrack);
+    // Requires an active transaction and leaves the track dirty
+    bool updateTrackWithinTransaction(Track* pTrack);
 
     void hideAllTracks(const QDir& rootDir);
 
@@ -47,6 +47,18 @@ TrackPointer ProxyTrackModel::getTrack(const QModelIndex& index) const {
     return m_pTrackModel ? m_pTrackModel->getTrack(indexSource) : TrackPointer();
 }
 
+QList<TrackPointer> ProxyTrackModel::getTracks(const QModelIndexList& indices) const {
+    if (!m_pTrackModel) {
+        return QList<TrackPointer>();
+    }
+    QModelIndexList indicesSource;
+    indicesSource.reserve(indices.size());
+    for (const QModelIndex& index : indices) {
+        indicesSource.append(mapToSource(index));
+    }
+    return m_pTrackModel->getTracks(indicesSource);
+}
+
 QString ProxyTrackModel::getTrackLocation(const QModelIndex& index) const {
     QModelIndex indexSource = mapToSource(index);
     return m_pTrackModel ? m_pTrackModel->getTrackLocation(indexSource) : QString();
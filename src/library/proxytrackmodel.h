@@ -25,6 +25,7 @@ class ProxyTrackModel : public QSortFilterProxyModel, public TrackModel {
     // Inherited from TrackModel
     CapabilitiesFlags getCapabilities() const final;
     TrackPointer getTrack(const QModelIndex& index) const final;
+    QList<TrackPointer> getTracks(const QModelIndexList& indices) const final;
     QString getTrackLocation(const QModelIndex& index) const final;
     TrackId getTrackId(const QModelIndex& index) const final;
     const QLinkedList<int> getTrackRows(TrackId trackId) const final;
@@ -1,6 +1,7 @@
 #include "library/scanner/importfilestask.h"
 
 #include "library/scanner/libraryscanner.h"
+#include "sources/soundsourceproxy.h"
 #include "track/trackfile.h"
 #include "util/timer.h"
 
@@ -30,7 +31,8 @@ void ImportFilesTask::run() {
             return;
         }
 
-        const QString trackLocation(TrackFile(fileInfo).location());
+        const TrackFile trackFile(fileInfo);
+        const QString trackLocation(trackFile.location());
         //qDebug() << "ImportFilesTask::run" << trackLocation;
 
         // If the file does not exist in the database then add it. If it
@@ -41,6 +43,10 @@ void ImportFilesTask::run() {
             // If the track is in the database, mark it as existing. This code gets
             // executed when other files in the same directory have changed (the
             // directory hash has changed).
+            // Modified files are not re-imported here. The library does not
+            // store when the tags of a track have been parsed and re-importing
+            // might overwrite metadata that has been edited in Mixxx. Users
+            // re-import tags explicitly from the track context menu.
             emit trackExists(trackLocation);
         } else {
             if (!fileInfo.exists()) {
@@ -50,7 +56,27 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << trackLocation;
 
-            emit addNewTrack(trackLocation);
+            // Parse the file tags here on the worker thread without locking
+            // the global track cache. Only the database writes are funneled
+            // through the scanner thread which drains all pending tracks at
+            // once and locks the cache while adding each track.
+            mixxx::TrackRecord trackRecord;
+            if (!SoundSourceProxy::importTrackRecord(trackFile, &trackRecord)) {
+                continue;
+            }
+            // Create the cover art thumbnails in advance to avoid
+            // loading and scaling the cover when displaying the
+            // library for the first time.
+            const CoverArtThumbnailCache* pThumbnailCache =
+                    m_scannerGlobal->thumbnailCache();
+            if (pThumbnailCache) {
+                pThumbnailCache->prewarm(
+                        CoverInfo(trackRecord.getCoverInfo(), trackLocation));
+            }
+            if (m_scannerGlobal->addImportedTrack(
+                        ImportedTrack(trackLocation, std::move(trackRecord)))) {
+                emit newTracksImported();
+            }
         }
     }
     // Insert or update the hash in the database.
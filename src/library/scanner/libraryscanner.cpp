@@ -5,8 +5,10 @@
 #include "library/scanner/libraryscannerdlg.h"
 #include "library/scanner/scannertask.h"
 #include "library/queryutil.h"
+#include "library/coverartcache.h"
 #include "library/coverartutils.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/trace.h"
 #include "util/file.h"
 #include "util/timer.h"
@@ -18,8 +20,7 @@
 
 namespace {
 
-// TODO(rryan) make configurable
-const int kScannerThreadPoolSize = 1;
+const ConfigKey kConfigKeyScannerThreadCount("[Library]", "ScannerThreadCount");
 
 mixxx::Logger kLogger("LibraryScanner");
 
@@ -36,6 +37,14 @@ int execCleanupQuery(FwdSqlQuery& query) {
     return query.numRowsAffected();
 }
 
+std::shared_ptr<const CoverArtThumbnailCache> sharedThumbnailCache() {
+    const CoverArtCache* pCoverArtCache = CoverArtCache::instance();
+    if (pCoverArtCache == nullptr) {
+        return nullptr;
+    }
+    return pCoverArtCache->getThumbnailCache();
+}
+
 } // anonymous namespace
 
 LibraryScanner::LibraryScanner(
@@ -47,7 +56,8 @@ LibraryScanner::LibraryScanner(
                   m_analysisDao, m_libraryHashDao,
                   pConfig),
           m_stateSema(1), // only one transaction is possible at a time
-          m_state(IDLE) {
+          m_state(IDLE),
+          m_pThumbnailCache(sharedThumbnailCache()) {
     // Move LibraryScanner to its own thread so that our signals/slots will
     // queue to our event loop.
     moveToThread(this);
@@ -56,7 +66,17 @@ LibraryScanner::LibraryScanner(
     const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
     setObjectName(QString("LibraryScanner %1").arg(instanceId));
 
-    m_pool.setMaxThreadCount(kScannerThreadPoolSize);
+    // Directory traversal and parsing of file tags is done by the worker
+    // tasks in parallel. All database writes are funneled through the
+    // scanner thread.
+    const int threadCount = pConfig->getValue(
+            kConfigKeyScannerThreadCount,
+            QThread::idealThreadCount());
+    m_pool.setMaxThreadCount(math_max(1, threadCount));
+    kLogger.debug()
+            << "Using"
+            << m_pool.maxThreadCount()
+            << "worker thread(s)";
 
     // Listen to signals from our public methods (invoked by other threads) and
     // connect them to our slots to run the command on the scanner thread.
@@ -66,7 +86,7 @@ LibraryScanner::LibraryScanner(
     connect(this,
             &LibraryScanner::progressLoading,
             m_pProgressDlg.data(),
-            &LibraryScannerDlg::slotUpdate);
+            &LibraryScannerDlg::slotUpdateTrack);
     connect(this,
             &LibraryScanner::progressHashing,
             m_pProgressDlg.data(),
@@ -178,7 +198,8 @@ void LibraryScanner::slotStartScan() {
 
     m_scannerGlobal = ScannerGlobalPointer(
             new ScannerGlobal(trackLocations, directoryHashes, extensionFilter,
-                              coverExtensionFilter, directoryBlacklist));
+                              coverExtensionFilter, directoryBlacklist,
+                              m_pThumbnailCache));
 
     m_scannerGlobal->startTimer();
 
@@ -364,6 +385,10 @@ void LibraryScanner::slotFinishUnhashedScan() {
         return;
     }
 
+    // Add all remaining tracks that have been parsed by the worker
+    // tasks but have not been drained from the queue yet.
+    slotAddImportedTracks();
+
     bool bScanFinishedCleanly = m_scannerGlobal->scanFinishedCleanly();
 
     if (bScanFinishedCleanly) {
@@ -388,16 +413,22 @@ void LibraryScanner::slotFinishUnhashedScan() {
     }
 
     // TODO(XXX) doesn't take into account verifyRemainingTracks.
+    const mixxx::Duration elapsed = m_scannerGlobal->timerElapsed();
+    const int numImportedTracks = m_scannerGlobal->numImportedTracks();
     qDebug("Scan took: %s. "
            "%d unchanged directories. "
            "%d changed/added directories. "
            "%d tracks verified from changed/added directories. "
-           "%d new tracks.",
-           m_scannerGlobal->timerElapsed().formatNanosWithUnit().toLocal8Bit().constData(),
+           "%d new tracks. "
+           "%.1f new tracks/s.",
+           elapsed.formatNanosWithUnit().toLocal8Bit().constData(),
            m_scannerGlobal->verifiedDirectories().size(),
            m_scannerGlobal->numScannedDirectories(),
            m_scannerGlobal->verifiedTracks().size(),
-           m_scannerGlobal->addedTracks().size());
+           m_scannerGlobal->addedTracks().size(),
+           elapsed.toDoubleSeconds() > 0
+                   ? numImportedTracks / elapsed.toDoubleSeconds()
+                   : 0.0);
 
     m_scannerGlobal.clear();
     changeScannerState(FINISHED);
@@ -476,9 +507,9 @@ void LibraryScanner::queueTask(ScannerTask* pTask) {
             this,
             &LibraryScanner::slotTrackExists);
     connect(pTask,
-            &ScannerTask::addNewTrack,
+            &ScannerTask::newTracksImported,
             this,
-            &LibraryScanner::slotAddNewTrack);
+            &LibraryScanner::slotAddImportedTracks);
 
     // Progress signals.
     // Pass directly to the main thread
@@ -531,19 +562,34 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
     }
 }
 
-void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
-    //kLogger.debug() << "slotAddNewTrack" << trackPath;
-    ScopedTimer timer("LibraryScanner::addNewTrack");
+void LibraryScanner::slotAddImportedTracks() {
+    ScopedTimer timer("LibraryScanner::slotAddImportedTracks");
+    if (!m_scannerGlobal) {
+        return;
+    }
+    // Drain all tracks that have been parsed by the worker tasks so
+    // far and add them within the scanner's pending transaction.
+    const QList<ImportedTrack> importedTracks =
+            m_scannerGlobal->takeImportedTracks();
+    for (const auto& importedTrack : importedTracks) {
+        addImportedTrack(importedTrack);
+    }
+}
+
+void LibraryScanner::addImportedTrack(const ImportedTrack& importedTrack) {
+    //kLogger.debug() << "addImportedTrack" << importedTrack.location();
+    const QString& trackPath = importedTrack.location();
     // For statistics tracking and to detect moved tracks
-    TrackPointer pTrack(m_trackDao.addTracksAddFile(trackPath, false));
+    TrackPointer pTrack(m_trackDao.addTracksAddFile(
+            trackPath,
+            false,
+            &importedTrack.trackRecord()));
     if (pTrack) {
         // The track's actual location might differ from the
         // given trackPath
         const QString trackLocation(pTrack->getLocation());
         // Acknowledge successful track addition
-        if (m_scannerGlobal) {
-            m_scannerGlobal->trackAdded(trackLocation);
-        }
+        m_scannerGlobal->trackAdded(trackLocation);
         // Signal the main instance of TrackDAO, that there is
         // a new track in the database.
         emit trackAdded(pTrack);
@@ -552,9 +598,7 @@ void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
         // Acknowledge failed track addition
         // TODO(XXX): Is it really intended to acknowledge a failed
         // track addition with a trackAdded() signal??
-        if (m_scannerGlobal) {
-            m_scannerGlobal->trackAdded(trackPath);
-        }
+        m_scannerGlobal->trackAdded(trackPath);
         kLogger.warning()
                 << "Failed to add track to library:"
                 << trackPath;
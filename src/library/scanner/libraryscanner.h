@@ -70,7 +70,7 @@ class LibraryScanner : public QThread {
                                    bool newDirectory, mixxx::cache_key_t hash);
     void slotDirectoryUnchanged(const QString& directoryPath);
     void slotTrackExists(const QString& trackPath);
-    void slotAddNewTrack(const QString& trackPath);
+    void slotAddImportedTracks();
 
   private:
     enum ScannerState {
@@ -96,6 +96,8 @@ class LibraryScanner : public QThread {
 
     void cleanUpScan();
 
+    void addImportedTrack(const ImportedTrack& importedTrack);
+
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
 
     // The pool of threads used for worker tasks.
@@ -119,6 +121,9 @@ class LibraryScanner : public QThread {
     // this is accessed main and LibraryScanner thread
     volatile ScannerState m_state;
 
+    // Shared with CoverArtCache
+    const std::shared_ptr<const CoverArtThumbnailCache> m_pThumbnailCache;
+
     QStringList m_libraryRootDirs;
     QScopedPointer<LibraryScannerDlg> m_pProgressDlg;
 };
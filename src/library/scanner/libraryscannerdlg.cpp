@@ -25,7 +25,8 @@
 
 LibraryScannerDlg::LibraryScannerDlg(QWidget* parent, Qt::WindowFlags f)
         : QWidget(parent, f),
-          m_bCancelled(false) {
+          m_bCancelled(false),
+          m_numTracksLoaded(0) {
     setWindowIcon(QIcon(":/images/mixxx_icon.svg"));
 
     QVBoxLayout* pLayout = new QVBoxLayout(this);
@@ -66,6 +67,24 @@ void LibraryScannerDlg::slotUpdate(QString path) {
     }
 }
 
+void LibraryScannerDlg::slotUpdateTrack(QString path) {
+    ++m_numTracksLoaded;
+    if (!m_bCancelled && m_timer.elapsed() > mixxx::Duration::fromSeconds(2)) {
+       setVisible(true);
+    }
+
+    if (isVisible()) {
+        const double elapsedSeconds = m_timer.elapsed().toDoubleSeconds();
+        const double tracksPerSecond =
+                elapsedSeconds > 0 ? m_numTracksLoaded / elapsedSeconds : 0;
+        QString status = QString("%1%2 (%3)")
+                .arg(tr("Scanning: "))
+                .arg(path)
+                .arg(tr("%1 tracks/s").arg(tracksPerSecond, 0, 'f', 1));
+        emit progress(status);
+    }
+}
+
 void LibraryScannerDlg::slotUpdateCover(QString path) {
     //qDebug() << "LibraryScannerDlg slotUpdate" << m_timer.elapsed() << path;
     if (!m_bCancelled && m_timer.elapsed() > mixxx::Duration::fromSeconds(2)) {
@@ -89,6 +108,7 @@ void LibraryScannerDlg::slotCancel() {
 
 void LibraryScannerDlg::slotScanStarted() {
     m_bCancelled = false;
+    m_numTracksLoaded = 0;
     m_timer.start();
 }
 
@@ -33,6 +33,7 @@ class LibraryScannerDlg : public QWidget {
 
   public slots:
     void slotUpdate(QString path);
+    void slotUpdateTrack(QString path);
     void slotUpdateCover(QString path);
     void slotCancel();
     void slotScanFinished();
@@ -45,6 +46,7 @@ class LibraryScannerDlg : public QWidget {
   private:
     PerformanceTimer m_timer;
     bool m_bCancelled;
+    int m_numTracksLoaded;
 };
 
 #endif
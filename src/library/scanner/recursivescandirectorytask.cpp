@@ -1,4 +1,5 @@
 #include <QCryptographicHash>
+#include <QDateTime>
 #include <QDirIterator>
 
 #include "library/scanner/recursivescandirectorytask.h"
@@ -57,6 +58,15 @@ void RecursiveScanDirectoryTask::run() {
             const QString& fileName = currentFileInfo.fileName();
             if (supportedExtensionsRegex.indexIn(fileName) != -1) {
                 hasher.addData(currentFile.toUtf8());
+                // Also hash the size and modification time of each file.
+                // Otherwise modified files would go unnoticed until some
+                // other file in the same directory is added or removed.
+                const qint64 fileStat[2] = {
+                        currentFileInfo.size(),
+                        currentFileInfo.lastModified().toMSecsSinceEpoch()};
+                hasher.addData(
+                        reinterpret_cast<const char*>(fileStat),
+                        sizeof(fileStat));
                 filesToImport.append(currentFileInfo);
             } else if (supportedCoverExtensionsRegex.indexIn(fileName) != -1) {
                 possibleCovers.append(currentFileInfo);
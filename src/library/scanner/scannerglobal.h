@@ -8,7 +8,10 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QSharedPointer>
+#include <memory>
 
+#include "library/coverartthumbnailcache.h"
+#include "track/trackrecord.h"
 #include "util/cache.h"
 #include "util/task.h"
 #include "util/performancetimer.h"
@@ -35,22 +38,49 @@ class DirInfo {
 };
 
 
+// A new track file whose tags have already been parsed by
+// a worker task and that is waiting to be added to the library.
+class ImportedTrack {
+  public:
+    ImportedTrack(const QString& location,
+                  mixxx::TrackRecord trackRecord)
+          : m_location(location),
+            m_trackRecord(std::move(trackRecord)) {
+    }
+
+    const QString& location() const {
+        return m_location;
+    }
+
+    const mixxx::TrackRecord& trackRecord() const {
+        return m_trackRecord;
+    }
+
+  private:
+    QString m_location;
+    mixxx::TrackRecord m_trackRecord;
+};
+
+
 class ScannerGlobal {
   public:
     ScannerGlobal(const QSet<QString>& trackLocations,
                   const QHash<QString, mixxx::cache_key_t>& directoryHashes,
                   const QRegExp& supportedExtensionsMatcher,
                   const QRegExp& supportedCoverExtensionsMatcher,
-                  const QStringList& directoriesBlacklist)
+                  const QStringList& directoriesBlacklist,
+                  std::shared_ptr<const CoverArtThumbnailCache> pThumbnailCache)
             : m_trackLocations(trackLocations),
               m_directoryHashes(directoryHashes),
               m_supportedExtensionsMatcher(supportedExtensionsMatcher),
               m_supportedCoverExtensionsMatcher(supportedCoverExtensionsMatcher),
               m_directoriesBlacklist(directoriesBlacklist),
+              m_pThumbnailCache(std::move(pThumbnailCache)),
               // Unless marked un-clean, we assume it will finish cleanly.
               m_scanFinishedCleanly(true),
               m_shouldCancel(false),
-              m_numScannedDirectories(0) {
+              m_numScannedDirectories(0),
+              m_numImportedTracks(0) {
     }
 
     TaskWatcher& getTaskWatcher() {
@@ -114,6 +144,12 @@ class ScannerGlobal {
         return m_supportedCoverExtensionsMatcher.indexIn(fileName) != -1;
     }
 
+    // Used for prewarming the thumbnails of new tracks. Returns nullptr
+    // if thumbnails are not cached.
+    const CoverArtThumbnailCache* thumbnailCache() const {
+        return m_pThumbnailCache.get();
+    }
+
     inline bool shouldCancel() const {
         return m_shouldCancel;
     }
@@ -166,6 +202,30 @@ class ScannerGlobal {
         m_addedTracks << trackLocation;
     }
 
+    // Enqueues a track that has been parsed by a worker task. Returns
+    // true if the queue was empty before, i.e. if the caller needs to
+    // notify the scanner thread that new tracks are available.
+    bool addImportedTrack(ImportedTrack importedTrack) {
+        QMutexLocker locker(&m_importedTracksMutex);
+        m_importedTracks.append(std::move(importedTrack));
+        return m_importedTracks.size() == 1;
+    }
+
+    // Dequeues all pending tracks at once. Invoked by the scanner
+    // thread that adds them to the database in a single batch.
+    QList<ImportedTrack> takeImportedTracks() {
+        QMutexLocker locker(&m_importedTracksMutex);
+        QList<ImportedTrack> importedTracks;
+        importedTracks.swap(m_importedTracks);
+        m_numImportedTracks += importedTracks.size();
+        return importedTracks;
+    }
+
+    int numImportedTracks() const {
+        QMutexLocker locker(&m_importedTracksMutex);
+        return m_numImportedTracks;
+    }
+
     int numScannedDirectories() const {
         return m_numScannedDirectories;
     }
@@ -203,6 +263,14 @@ class ScannerGlobal {
     // this has never been investigated.
     QStringList m_directoriesBlacklist;
 
+    const std::shared_ptr<const CoverArtThumbnailCache> m_pThumbnailCache;
+
+    // New tracks that have been parsed by worker tasks and are
+    // waiting to be added to the database by the scanner thread.
+    mutable QMutex m_importedTracksMutex;
+    QList<ImportedTrack> m_importedTracks;
+    int m_numImportedTracks;
+
     // The list of directories verified by the scan.
     QStringList m_verifiedDirectories;
 
@@ -25,7 +25,8 @@ class ScannerTask : public QObject, public QRunnable {
                                    bool newDirectory, mixxx::cache_key_t hash);
     void directoryUnchanged(const QString& directoryPath);
     void trackExists(const QString& filePath);
-    void addNewTrack(const QString& filePath);
+    // New tracks have been enqueued in ScannerGlobal
+    void newTracksImported();
 
     // Feedback to GUI
     void progressLoading(const QString& fileName);
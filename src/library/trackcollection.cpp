@@ -487,11 +487,22 @@ void TrackCollection::saveTrack(Track* pTrack) {
     m_trackDao.saveTrack(pTrack);
 }
 
+void TrackCollection::saveTracks(const QList<Track*>& tracks) {
+    DEBUG_ASSERT(QApplication::instance()->thread() == QThread::currentThread());
+
+    m_trackDao.saveTracks(tracks);
+}
+
 TrackPointer TrackCollection::getTrackById(
         TrackId trackId) const {
     return m_trackDao.getTrackById(trackId);
 }
 
+QList<TrackPointer> TrackCollection::getTracksById(
+        const QList<TrackId>& trackIds) const {
+    return m_trackDao.getTracksById(trackIds);
+}
+
 TrackPointer TrackCollection::getTrackByRef(
         const TrackRef& trackRef) const {
     return m_trackDao.getTrackByRef(trackRef);
@@ -84,6 +84,8 @@ class TrackCollection : public QObject,
 
     TrackPointer getTrackById(
             TrackId trackId) const;
+    QList<TrackPointer> getTracksById(
+            const QList<TrackId>& trackIds) const;
 
     TrackPointer getTrackByRef(
             const TrackRef& trackRef) const;
@@ -131,6 +133,7 @@ class TrackCollection : public QObject,
     void relocateDirectory(QString oldDir, QString newDir);
 
     void saveTrack(Track* pTrack);
+    void saveTracks(const QList<Track*>& tracks);
 
     QSqlDatabase m_database;
 
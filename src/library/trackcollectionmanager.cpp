@@ -209,6 +209,41 @@ void TrackCollectionManager::saveTrack(
             << "in internal collection";
     m_pInternalCollection->saveTrack(pTrack);
 
+    saveTrackInExternalCollections(pTrack, trackDirty);
+}
+
+int TrackCollectionManager::saveTracks(const QList<TrackPointer>& tracks) {
+    QList<Track*> dirtyTracks;
+    dirtyTracks.reserve(tracks.size());
+    for (const auto& pTrack : tracks) {
+        VERIFY_OR_DEBUG_ASSERT(pTrack) {
+            continue;
+        }
+        if (!pTrack->isDirty()) {
+            continue;
+        }
+        exportTrackMetadata(pTrack.get(), TrackMetadataExportMode::Deferred);
+        dirtyTracks.append(pTrack.get());
+    }
+    if (dirtyTracks.isEmpty()) {
+        return 0;
+    }
+
+    kLogger.debug()
+            << "Saving"
+            << dirtyTracks.size()
+            << "tracks in internal collection";
+    m_pInternalCollection->saveTracks(dirtyTracks);
+
+    for (Track* pTrack : dirtyTracks) {
+        saveTrackInExternalCollections(pTrack, true);
+    }
+    return dirtyTracks.size();
+}
+
+void TrackCollectionManager::saveTrackInExternalCollections(
+        Track* pTrack,
+        bool trackDirty) {
     if (m_externalCollections.isEmpty()) {
         return;
     }
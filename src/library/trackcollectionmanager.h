@@ -65,6 +65,10 @@ class TrackCollectionManager: public QObject,
     // Returns true if the track was dirty and has been saved, otherwise
     // false.
     bool saveTrack(const TrackPointer& pTrack);
+    // Saves all dirty tracks in the internal database within a single
+    // transaction and in external collections. Returns the number of
+    // tracks that were dirty.
+    int saveTracks(const QList<TrackPointer>& tracks);
 
   signals:
     void libraryScanStarted();
@@ -93,6 +97,9 @@ class TrackCollectionManager: public QObject,
     void exportTrackMetadata(
             Track* pTrack,
             TrackMetadataExportMode mode) const;
+    void saveTrackInExternalCollections(
+            Track* pTrack,
+            bool trackDirty);
 
     const UserSettingsPointer m_pConfig;
 
@@ -90,6 +90,21 @@ class TrackModel {
     // set.
     virtual TrackPointer getTrack(const QModelIndex& index) const = 0;
 
+    // Deserialize and return the tracks at the given indices. Rows
+    // without a valid track are skipped. Models that are backed by a
+    // database should override this to load all tracks at once.
+    virtual QList<TrackPointer> getTracks(const QModelIndexList& indices) const {
+        QList<TrackPointer> tracks;
+        tracks.reserve(indices.size());
+        for (const QModelIndex& index : indices) {
+            TrackPointer pTrack = getTrack(index);
+            if (pTrack) {
+                tracks.append(std::move(pTrack));
+            }
+        }
+        return tracks;
+    }
+
     // Gets the on-disk location of the track at the given location
     // with Qt separator "/".
     // Use QDir::toNativeSeparators() before displaying this to a user.
@@ -136,11 +136,18 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
     connect(m_pTrackAnalysisScheduler.get(), &TrackAnalysisScheduler::finished,
             this, &PlayerManager::onTrackAnalysisFinished);
 
+    DEBUG_ASSERT(!m_pWaveformPrefetcher);
+    m_pWaveformPrefetcher = std::make_unique<WaveformPrefetcher>(
+            m_pConfig,
+            pLibrary->dbConnectionPool());
+
     // Connect the player to the analyzer queue so that loaded tracks are
     // analyzed.
     foreach(Deck* pDeck, m_decks) {
         connect(pDeck, SIGNAL(newTrackLoaded(TrackPointer)),
                 this, SLOT(slotAnalyzeTrack(TrackPointer)));
+        connect(pDeck, SIGNAL(loadingTrack(TrackPointer, TrackPointer)),
+                this, SLOT(slotPrefetchWaveforms(TrackPointer)));
     }
 
     // Connect the player to the analyzer queue so that loaded tracks are
@@ -148,6 +155,8 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
     foreach(Sampler* pSampler, m_samplers) {
         connect(pSampler, SIGNAL(newTrackLoaded(TrackPointer)),
                 this, SLOT(slotAnalyzeTrack(TrackPointer)));
+        connect(pSampler, SIGNAL(loadingTrack(TrackPointer, TrackPointer)),
+                this, SLOT(slotPrefetchWaveforms(TrackPointer)));
     }
 
     // Connect the player to the analyzer queue so that loaded tracks are
@@ -155,6 +164,8 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
     foreach(PreviewDeck* pPreviewDeck, m_preview_decks) {
         connect(pPreviewDeck, SIGNAL(newTrackLoaded(TrackPointer)),
                 this, SLOT(slotAnalyzeTrack(TrackPointer)));
+        connect(pPreviewDeck, SIGNAL(loadingTrack(TrackPointer, TrackPointer)),
+                this, SLOT(slotPrefetchWaveforms(TrackPointer)));
     }
 }
 
@@ -380,6 +391,8 @@ void PlayerManager::addDeckInner() {
     if (m_pTrackAnalysisScheduler) {
         connect(pDeck, SIGNAL(newTrackLoaded(TrackPointer)),
                 this, SLOT(slotAnalyzeTrack(TrackPointer)));
+        connect(pDeck, SIGNAL(loadingTrack(TrackPointer, TrackPointer)),
+                this, SLOT(slotPrefetchWaveforms(TrackPointer)));
     }
 
     m_players[group] = pDeck;
@@ -441,6 +454,8 @@ void PlayerManager::addSamplerInner() {
     if (m_pTrackAnalysisScheduler) {
         connect(pSampler, SIGNAL(newTrackLoaded(TrackPointer)),
                 this, SLOT(slotAnalyzeTrack(TrackPointer)));
+        connect(pSampler, SIGNAL(loadingTrack(TrackPointer, TrackPointer)),
+                this, SLOT(slotPrefetchWaveforms(TrackPointer)));
     }
 
     m_players[group] = pSampler;
@@ -467,6 +482,8 @@ void PlayerManager::addPreviewDeckInner() {
     if (m_pTrackAnalysisScheduler) {
         connect(pPreviewDeck, SIGNAL(newTrackLoaded(TrackPointer)),
                 this, SLOT(slotAnalyzeTrack(TrackPointer)));
+        connect(pPreviewDeck, SIGNAL(loadingTrack(TrackPointer, TrackPointer)),
+                this, SLOT(slotPrefetchWaveforms(TrackPointer)));
     }
 
     m_players[group] = pPreviewDeck;
@@ -680,6 +697,12 @@ void PlayerManager::slotAnalyzeTrack(TrackPointer track) {
     }
 }
 
+void PlayerManager::slotPrefetchWaveforms(TrackPointer track) {
+    if (m_pWaveformPrefetcher) {
+        m_pWaveformPrefetcher->prefetch(std::move(track));
+    }
+}
+
 void PlayerManager::onTrackAnalysisProgress(TrackId trackId, AnalyzerProgress analyzerProgress) {
     emit trackAnalyzerProgress(trackId, analyzerProgress);
 }
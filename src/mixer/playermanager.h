@@ -4,6 +4,8 @@
 #ifndef MIXER_PLAYERMANAGER_H
 #define MIXER_PLAYERMANAGER_H
 
+#include <memory>
+
 #include <QObject>
 #include <QList>
 #include <QMap>
@@ -14,6 +16,7 @@
 #include "track/track.h"
 #include "util/parented_ptr.h"
 #include "util/performancetimer.h"
+#include "waveform/waveformprefetcher.h"
 
 class Auxiliary;
 class BaseTrackPlayer;
@@ -206,6 +209,7 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
 
   private slots:
     void slotAnalyzeTrack(TrackPointer track);
+    void slotPrefetchWaveforms(TrackPointer track);
 
     void onTrackAnalysisProgress(TrackId trackId, AnalyzerProgress analyzerProgress);
     void onTrackAnalysisFinished();
@@ -269,6 +273,7 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
     parented_ptr<ControlProxy> m_pAutoDjEnabled;
 
     TrackAnalysisScheduler::Pointer m_pTrackAnalysisScheduler;
+    std::unique_ptr<WaveformPrefetcher> m_pWaveformPrefetcher;
 
     QList<Deck*> m_decks;
     QList<Sampler*> m_samplers;
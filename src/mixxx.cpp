@@ -345,7 +345,10 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     delete pModplugPrefs; // not needed anymore
 #endif
 
-    CoverArtCache::createInstance();
+    CoverArtCache::createInstance()->setThumbnailCache(
+            std::make_shared<CoverArtThumbnailCache>(
+                    CoverArtThumbnailCache::defaultCacheDir(pConfig),
+                    pConfig));
 
     launchProgress(30);
 
@@ -615,6 +618,11 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
         }
     }
 
+    connect(m_pSoundManager,
+            &SoundManager::deviceError,
+            this,
+            &MixxxMainWindow::slotSoundDeviceError);
+
     connect(&PlayerInfo::instance(),
             &PlayerInfo::currentPlayingTrackChanged,
             this,
@@ -1007,6 +1015,20 @@ QDialog::DialogCode MixxxMainWindow::soundDeviceErrorMsgDlg(
     return soundDeviceErrorDlg(title, text, retryClicked);
 }
 
+void MixxxMainWindow::slotSoundDeviceError(SoundDeviceError err) {
+    bool retryClicked;
+    do {
+        retryClicked = false;
+        if (soundDeviceErrorMsgDlg(err, &retryClicked) != QDialog::Accepted) {
+            close();
+            return;
+        }
+        if (retryClicked) {
+            err = m_pSoundManager->setupDevices();
+        }
+    } while (retryClicked && err != SOUNDDEVICE_ERROR_OK);
+}
+
 QDialog::DialogCode MixxxMainWindow::noOutputDlg(bool* continueClicked) {
     QMessageBox msgBox;
     msgBox.setIcon(QMessageBox::Warning);
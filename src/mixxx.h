@@ -102,6 +102,9 @@ class MixxxMainWindow : public QMainWindow {
     void slotNoMicrophoneInputConfigured();
     void slotNoDeckPassthroughInputConfigured();
     void slotNoVinylControlInputConfigured();
+    // Offer to retry or reconfigure after a sound device has failed
+    // while running.
+    void slotSoundDeviceError(SoundDeviceError err);
 
   signals:
     void newSkinLoaded();
@@ -32,6 +32,7 @@ const char* kChannels = "Channels";
 const char* kCustomArtist = "CustomArtist";
 const char* kCustomTitle = "CustomTitle";
 const char* kEnableMetadata = "EnableMetadata";
+const char* kDropOldestOnOverflow = "DropOldestOnOverflow";
 const char* kEnableReconnect = "EnableReconnect";
 const char* kEnabled = "Enabled";
 const char* kFormat = "Format";
@@ -42,6 +43,7 @@ const char* kMaximumRetries = "MaximumRetries";
 const char* kMetadataCharset = "MetadataCharset";
 const char* kMetadataFormat = "MetadataFormat";
 const char* kMountPoint = "Mountpoint";
+const char* kNetworkBacklog = "NetworkBacklog";
 const char* kNoDelayFirstReconnect = "NoDelayFirstReconnect";
 const char* kOggDynamicUpdate = "OggDynamicUpdate";
 const char* kPassword = "Password";
@@ -65,12 +67,15 @@ const char* kKeychainPrefix = "Mixxx - ";
 
 const double kDefaultBitrate = 128;
 const int kDefaultChannels = 2;
+const bool kDefaultDropOldestOnOverflow = false;
 const bool kDefaultEnableMetadata = false;
 const bool kDefaultEnableReconnect = true;
 const bool kDefaultLimitReconnects = true;
 const int kDefaultMaximumRetries = 10;
 // No tr() here, see https://bugs.launchpad.net/mixxx/+bug/1419500
 const QString kDefaultMetadataFormat("$artist - $title");
+// Seconds of the encoded stream
+const double kDefaultNetworkBacklog = 10.0;
 const bool kDefaultNoDelayFirstReconnect = true;
 const bool kDefaultOggDynamicupdate = false;
 double kDefaultReconnectFirstDelay = 0.0;
@@ -145,6 +150,8 @@ bool BroadcastProfile::valuesEquals(BroadcastProfilePtr other) {
             && getMaximumRetries() == other->getMaximumRetries()
             && getNoDelayFirstReconnect() == other->getNoDelayFirstReconnect()
             && getReconnectFirstDelay() == other->getReconnectFirstDelay()
+            && getNetworkBacklog() == other->getNetworkBacklog()
+            && getDropOldestOnOverflow() == other->getDropOldestOnOverflow()
             && getFormat() == other->getFormat()
             && getBitrate() == other->getBitrate()
             && getChannels() == other->getChannels()
@@ -195,6 +202,9 @@ void BroadcastProfile::copyValuesTo(BroadcastProfilePtr other) {
     other->setNoDelayFirstReconnect(this->getNoDelayFirstReconnect());
     other->setReconnectFirstDelay(this->getReconnectFirstDelay());
 
+    other->setNetworkBacklog(this->getNetworkBacklog());
+    other->setDropOldestOnOverflow(this->getDropOldestOnOverflow());
+
     other->setFormat(this->getFormat());
     other->setBitrate(this->getBitrate());
     other->setChannels(this->getChannels());
@@ -257,6 +267,9 @@ void BroadcastProfile::adoptDefaultValues() {
     m_noDelayFirstReconnect = kDefaultNoDelayFirstReconnect;
     m_reconnectFirstDelay = kDefaultReconnectFirstDelay;
     m_maximumRetries = kDefaultMaximumRetries;
+
+    m_networkBacklog = kDefaultNetworkBacklog;
+    m_dropOldestOnOverflow = kDefaultDropOldestOnOverflow;
 }
 
 bool BroadcastProfile::loadValues(const QString& filename) {
@@ -311,6 +324,13 @@ bool BroadcastProfile::loadValues(const QString& filename) {
     m_reconnectFirstDelay =
             XmlParse::selectNodeDouble(doc, kReconnectFirstDelay);
 
+    // Not present in files of previous versions
+    if (!XmlParse::selectNode(doc, kNetworkBacklog).isNull()) {
+        m_networkBacklog = XmlParse::selectNodeDouble(doc, kNetworkBacklog);
+    }
+    m_dropOldestOnOverflow =
+            (bool)XmlParse::selectNodeInt(doc, kDropOldestOnOverflow);
+
     m_mountpoint = XmlParse::selectNodeQString(doc, kMountPoint);
     m_streamName = XmlParse::selectNodeQString(doc, kStreamName);
     m_streamDesc = XmlParse::selectNodeQString(doc, kStreamDesc);
@@ -373,6 +393,11 @@ bool BroadcastProfile::save(const QString& filename) {
     XmlParse::addElement(doc, docRoot, kReconnectFirstDelay,
                          QString::number(m_reconnectFirstDelay));
 
+    XmlParse::addElement(doc, docRoot, kNetworkBacklog,
+                         QString::number(m_networkBacklog));
+    XmlParse::addElement(doc, docRoot, kDropOldestOnOverflow,
+                         QString::number((int)m_dropOldestOnOverflow));
+
     XmlParse::addElement(doc, docRoot, kMountPoint, m_mountpoint);
     XmlParse::addElement(doc, docRoot, kStreamName, m_streamName);
     XmlParse::addElement(doc, docRoot, kStreamDesc, m_streamDesc);
@@ -630,6 +655,22 @@ void BroadcastProfile::setReconnectFirstDelay(double value) {
     m_reconnectFirstDelay = value;
 }
 
+double BroadcastProfile::getNetworkBacklog() const {
+    return m_networkBacklog;
+}
+
+void BroadcastProfile::setNetworkBacklog(double value) {
+    m_networkBacklog = value;
+}
+
+bool BroadcastProfile::getDropOldestOnOverflow() const {
+    return m_dropOldestOnOverflow;
+}
+
+void BroadcastProfile::setDropOldestOnOverflow(bool value) {
+    m_dropOldestOnOverflow = value;
+}
+
 QString BroadcastProfile::getMountpoint() const {
     return m_mountpoint;
 }
@@ -84,6 +84,15 @@ class BroadcastProfile : public QObject {
     double getReconnectFirstDelay() const;
     void setReconnectFirstDelay(double value);
 
+    // The encoded stream that is buffered for a slow server, in seconds
+    double getNetworkBacklog() const;
+    void setNetworkBacklog(double value);
+
+    // Whether to drop the oldest buffered data instead of reconnecting when
+    // the backlog is full
+    bool getDropOldestOnOverflow() const;
+    void setDropOldestOnOverflow(bool value);
+
     QString getFormat() const;
     void setFormat(const QString& value);
 
@@ -175,6 +184,8 @@ class BroadcastProfile : public QObject {
     int m_maximumRetries;
     bool m_noDelayFirstReconnect;
     double m_reconnectFirstDelay;
+    double m_networkBacklog;
+    bool m_dropOldestOnOverflow;
 
     QString m_mountpoint;
     QString m_streamName;
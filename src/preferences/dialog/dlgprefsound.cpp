@@ -435,7 +435,8 @@ void DlgPrefSound::apiChanged(int index) {
     // JACK sets its own buffer size and sample rate that Mixxx cannot change.
     // TODO(Be): Get the buffer size from JACK and update audioBufferComboBox.
     // PortAudio does not have a way to get the buffer size from JACK as of July 2017.
-    if (m_config.getAPI() == MIXXX_PORTAUDIO_JACK_STRING) {
+    if (m_config.getAPI() == MIXXX_PORTAUDIO_JACK_STRING ||
+            m_config.getAPI() == MIXXX_JACK_STRING) {
         sampleRateComboBox->setEnabled(false);
         latencyLabel->setEnabled(false);
         audioBufferComboBox->setEnabled(false);
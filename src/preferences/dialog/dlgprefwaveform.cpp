@@ -74,8 +74,8 @@ DlgPrefWaveform::DlgPrefWaveform(QWidget* pParent, MixxxMainWindow* pMixxx,
             this, SLOT(slotSetVisualGainHigh(double)));
     connect(normalizeOverviewCheckBox, SIGNAL(toggled(bool)),
             this, SLOT(slotSetNormalizeOverview(bool)));
-    connect(factory, SIGNAL(waveformMeasured(float,int)),
-            this, SLOT(slotWaveformMeasured(float,int)));
+    connect(factory, SIGNAL(waveformMeasured(float,int,int,int)),
+            this, SLOT(slotWaveformMeasured(float,int,int,int)));
     connect(waveformOverviewComboBox, SIGNAL(currentIndexChanged(int)),
             this, SLOT(slotSetWaveformOverviewType(int)));
     connect(clearCachedWaveforms, SIGNAL(clicked()),
@@ -232,10 +232,14 @@ void DlgPrefWaveform::slotSetNormalizeOverview(bool normalize) {
     WaveformWidgetFactory::instance()->setOverviewNormalized(normalize);
 }
 
-void DlgPrefWaveform::slotWaveformMeasured(float frameRate, int droppedFrames) {
+void DlgPrefWaveform::slotWaveformMeasured(float frameRate, int droppedFrames,
+        int renderedWaveforms, int skippedWaveforms) {
     frameRateAverage->setText(
             QString::number((double)frameRate, 'f', 2) + " : " +
-            tr("dropped frames") + " " + QString::number(droppedFrames));
+            tr("dropped frames") + " " + QString::number(droppedFrames) + " : " +
+            tr("rendered/skipped waveforms") + " " +
+            QString::number(renderedWaveforms) + "/" +
+            QString::number(skippedWaveforms));
 }
 
 void DlgPrefWaveform::slotClearCachedWaveforms() {
@@ -4,9 +4,13 @@
 #include "skin/legacyskinparser.h"
 
 #include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
 #include <QGridLayout>
 #include <QLabel>
 #include <QMutexLocker>
+#include <QRegularExpression>
+#include <QSet>
 #include <QSplitter>
 #include <QStackedWidget>
 #include <QVBoxLayout>
@@ -25,6 +29,7 @@
 #include "controllers/controllermanager.h"
 
 #include "skin/colorschemeparser.h"
+#include "skin/skincache.h"
 #include "skin/skincontext.h"
 #include "skin/launchimage.h"
 
@@ -93,6 +98,66 @@ QMutex LegacySkinParser::s_safeStringMutex;
 
 static bool sDebug = false;
 
+// Collects all image files that are referenced by the given skin XML file
+// and by the templates it instantiates, recursively. Templates that the
+// skin never instantiates are skipped. Paths that are composed from
+// variables can't be resolved and are loaded on demand when the
+// corresponding widget is created.
+static void collectImageReferences(
+        const QString& xmlPath,
+        const SkinContext& context,
+        QSet<QString>* pVisitedXmlPaths,
+        QSet<QString>* pSourceIds) {
+    static const QRegularExpression kCommentRegex(
+            QStringLiteral("<!--.*?-->"),
+            QRegularExpression::DotMatchesEverythingOption);
+    static const QRegularExpression kTemplateRegex(
+            QStringLiteral("<Template\\b[^>]*\\bsrc\\s*=\\s*[\"']([^\"']+)[\"']"));
+    static const QRegularExpression kImagePathRegex(
+            QStringLiteral("[^<>\"'\\s]+\\.(?:svg|png|jpg)\\b"),
+            QRegularExpression::CaseInsensitiveOption);
+    const QString absoluteXmlPath = QFileInfo(xmlPath).absoluteFilePath();
+    if (pVisitedXmlPaths->contains(absoluteXmlPath)) {
+        return;
+    }
+    pVisitedXmlPaths->insert(absoluteXmlPath);
+    QFile file(absoluteXmlPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return;
+    }
+    QString content = QString::fromUtf8(file.readAll());
+    content.remove(kCommentRegex);
+
+    auto imageMatches = kImagePathRegex.globalMatch(content);
+    while (imageMatches.hasNext()) {
+        const QString sourceId = context.makeSkinPath(imageMatches.next().captured());
+        if (!pSourceIds->contains(sourceId) && QFileInfo::exists(sourceId)) {
+            pSourceIds->insert(sourceId);
+        }
+    }
+
+    auto templateMatches = kTemplateRegex.globalMatch(content);
+    while (templateMatches.hasNext()) {
+        collectImageReferences(
+                context.makeSkinPath(templateMatches.next().captured(1)),
+                context,
+                pVisitedXmlPaths,
+                pSourceIds);
+    }
+}
+
+static QStringList collectImageReferences(
+        const QString& skinPath, const SkinContext& context) {
+    QSet<QString> visitedXmlPaths;
+    QSet<QString> sourceIds;
+    collectImageReferences(
+            QDir(skinPath).filePath("skin.xml"),
+            context,
+            &visitedXmlPaths,
+            &sourceIds);
+    return sourceIds.values();
+}
+
 ControlObject* controlFromConfigKey(const ConfigKey& key, bool bPersist,
                                     bool* pCreated) {
     if (key.isEmpty()) {
@@ -380,6 +445,20 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
 
     ColorSchemeParser::setupLegacyColorSchemes(skinDocument, m_pConfig, &m_style, m_pContext.get());
 
+    // The pre-rasterized images depend on the selected color scheme
+    auto pSkinCache = QSharedPointer<SkinCache>::create(
+            SkinCache::defaultCacheDir(m_pConfig),
+            skinPath,
+            m_pConfig->getValueString(ConfigKey("[Config]", "Scheme")),
+            m_pContext->getScaleFactor());
+    pSkinCache->load();
+    WPixmapStore::setSkinCache(pSkinCache);
+
+    // Rasterize all images in parallel while the widgets are created
+    WPixmapStore::prefetchImages(
+            collectImageReferences(skinPath, *m_pContext),
+            m_pContext->getScaleFactor());
+
     // don't parent till here so the first opengl waveform doesn't screw
     // up --bkgood
     // I'm disregarding this return value because I want to return the
@@ -388,6 +467,10 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
     m_pParent = pParent;
     QList<QWidget*> widgets = parseNode(skinDocument);
 
+    WPixmapStore::clearPrefetchedImages();
+    // Store all images that have been rasterized for the first time
+    pSkinCache->save();
+
     if (widgets.empty()) {
         SKIN_WARNING(skinDocument, *m_pContext) << "Skin produced no widgets!";
         return NULL;
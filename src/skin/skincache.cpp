@@ -0,0 +1,207 @@
+#include "skin/skincache.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "proto/skin.pb.h"
+#include "util/logger.h"
+#include "util/timer.h"
+
+namespace {
+
+mixxx::Logger kLogger("SkinCache");
+
+const char* const kImageFormat = "PNG";
+
+// The relative paths of all files within the skin folder including
+// sub-folders in a defined order.
+QStringList skinFilePaths(const QString& skinPath) {
+    const QDir skinDir(skinPath);
+    QStringList filePaths;
+    QDirIterator it(skinPath, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        filePaths.append(skinDir.relativeFilePath(it.next()));
+    }
+    // The order of the directory iterator is not defined
+    filePaths.sort();
+    return filePaths;
+}
+
+// Hashes the relative paths, sizes and modification times of all files
+// within the skin folder. This only needs the file system metadata.
+QByteArray stampSkinFiles(const QString& skinPath) {
+    const QDir skinDir(skinPath);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const auto& filePath : skinFilePaths(skinPath)) {
+        const QFileInfo fileInfo(skinDir.filePath(filePath));
+        hash.addData(filePath.toUtf8());
+        hash.addData(QByteArray::number(fileInfo.size()));
+        hash.addData(QByteArray::number(
+                fileInfo.lastModified().toMSecsSinceEpoch()));
+    }
+    return hash.result();
+}
+
+// Hashes the relative paths and contents of all files within the skin
+// folder.
+QByteArray hashSkinFiles(const QString& skinPath) {
+    ScopedTimer timer("SkinCache::hashSkinFiles");
+    const QDir skinDir(skinPath);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const auto& filePath : skinFilePaths(skinPath)) {
+        hash.addData(filePath.toUtf8());
+        QFile file(skinDir.filePath(filePath));
+        if (file.open(QIODevice::ReadOnly)) {
+            hash.addData(&file);
+        }
+    }
+    return hash.result();
+}
+
+} // anonymous namespace
+
+SkinCache::SkinCache(
+        const QString& cacheDir,
+        const QString& skinPath,
+        const QString& colorScheme,
+        double scaleFactor)
+        : m_filePath(QDir(cacheDir).filePath(
+                  QFileInfo(skinPath).fileName() + ".pb")),
+          m_colorScheme(colorScheme),
+          m_scaleFactor(scaleFactor),
+          m_skinPath(skinPath),
+          m_fileStamp(stampSkinFiles(skinPath)),
+          m_dirty(false) {
+}
+
+//static
+QString SkinCache::defaultCacheDir(const UserSettingsPointer& pConfig) {
+    return QDir(pConfig->getSettingsPath()).filePath("skin_cache");
+}
+
+bool SkinCache::load() {
+    ScopedTimer timer("SkinCache::load");
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray data = file.readAll();
+    mixxx::skin::CompiledSkin compiledSkin;
+    if (!compiledSkin.ParseFromArray(data.constData(), data.size())) {
+        kLogger.warning() << "Failed to parse" << m_filePath;
+        return false;
+    }
+    if (QString::fromStdString(compiledSkin.color_scheme()) != m_colorScheme ||
+            compiledSkin.scale_factor() != m_scaleFactor) {
+        kLogger.info() << "Discarding outdated cache" << m_filePath;
+        return false;
+    }
+    const QByteArray cachedSkinHash =
+            QByteArray::fromStdString(compiledSkin.skin_hash());
+    // Reading all skin files is only needed if any of them might
+    // have been modified
+    const bool stampMatches =
+            QByteArray::fromStdString(compiledSkin.file_stamp()) == m_fileStamp;
+    const QByteArray skinHash =
+            stampMatches ? cachedSkinHash : hashSkinFiles(m_skinPath);
+
+    QMutexLocker locker(&m_mutex);
+    m_skinHash = skinHash;
+    if (skinHash != cachedSkinHash) {
+        kLogger.info() << "Discarding outdated cache" << m_filePath;
+        return false;
+    }
+    m_images.clear();
+    m_images.reserve(compiledSkin.pixmap_size());
+    for (const auto& pixmap : compiledSkin.pixmap()) {
+        m_images.insert(
+                QString::fromStdString(pixmap.key()),
+                QByteArray::fromStdString(pixmap.png()));
+    }
+    // Store the new file stamp if only the modification times changed
+    m_dirty = !stampMatches;
+    kLogger.info()
+            << "Loaded" << m_images.size()
+            << "pre-rasterized images from" << m_filePath;
+    return true;
+}
+
+bool SkinCache::save() {
+    mixxx::skin::CompiledSkin compiledSkin;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_dirty) {
+            return true;
+        }
+        if (m_skinHash.isEmpty()) {
+            // No cache file has been loaded before
+            m_skinHash = hashSkinFiles(m_skinPath);
+        }
+        compiledSkin.set_skin_hash(m_skinHash.toStdString());
+        compiledSkin.set_file_stamp(m_fileStamp.toStdString());
+        compiledSkin.set_color_scheme(m_colorScheme.toStdString());
+        compiledSkin.set_scale_factor(m_scaleFactor);
+        for (auto it = m_images.constBegin(); it != m_images.constEnd(); ++it) {
+            auto* pPixmap = compiledSkin.add_pixmap();
+            pPixmap->set_key(it.key().toStdString());
+            pPixmap->set_png(it.value().toStdString());
+        }
+        m_dirty = false;
+    }
+
+    const std::string data = compiledSkin.SerializeAsString();
+    if (!QDir().mkpath(QFileInfo(m_filePath).absolutePath())) {
+        kLogger.warning() << "Failed to create directory for" << m_filePath;
+        return false;
+    }
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly) ||
+            file.write(data.data(), data.size()) != static_cast<qint64>(data.size()) ||
+            !file.commit()) {
+        kLogger.warning() << "Failed to write" << m_filePath;
+        return false;
+    }
+    return true;
+}
+
+bool SkinCache::contains(const QString& key) const {
+    QMutexLocker locker(&m_mutex);
+    return m_images.contains(key);
+}
+
+QImage SkinCache::image(const QString& key) const {
+    QByteArray png;
+    {
+        QMutexLocker locker(&m_mutex);
+        png = m_images.value(key);
+    }
+    if (png.isEmpty()) {
+        return QImage();
+    }
+    return QImage::fromData(png, kImageFormat);
+}
+
+void SkinCache::insertImage(const QString& key, const QImage& image) {
+    if (image.isNull()) {
+        return;
+    }
+    QByteArray png;
+    QBuffer buffer(&png);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, kImageFormat)) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    m_images.insert(key, png);
+    m_dirty = true;
+}
+
+QList<QString> SkinCache::keys() const {
+    QMutexLocker locker(&m_mutex);
+    return m_images.keys();
+}
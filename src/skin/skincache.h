@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+
+#include "preferences/usersettings.h"
+
+// On-disk cache of pre-rasterized SVG images of a skin that is stored as
+// a CompiledSkin message from skin.proto.
+//
+// All entries are only valid for the exact same skin files, color scheme
+// and scale factor. The cache is discarded as a whole if any of these
+// differ, i.e. each skin has at most one cache file. The contents of the
+// skin files are only read and compared if the paths, sizes or
+// modification times of the files have changed.
+//
+// Lookups and insertions are thread-safe.
+class SkinCache {
+  public:
+    SkinCache(
+            const QString& cacheDir,
+            const QString& skinPath,
+            const QString& colorScheme,
+            double scaleFactor);
+
+    // The default location of the cache within the settings folder.
+    static QString defaultCacheDir(const UserSettingsPointer& pConfig);
+
+    // Reads the cache file. Returns false if no cache exists or if it
+    // doesn't match the skin files, color scheme or scale factor.
+    bool load();
+    // Writes the cache file if entries have been added since loading.
+    bool save();
+
+    bool contains(const QString& key) const;
+    // Returns a null image if no entry exists for the given key.
+    QImage image(const QString& key) const;
+    void insertImage(const QString& key, const QImage& image);
+
+    // The keys of all images that are contained in the cache.
+    QList<QString> keys() const;
+
+  private:
+    const QString m_filePath;
+    const QString m_colorScheme;
+    const double m_scaleFactor;
+    const QString m_skinPath;
+    const QByteArray m_fileStamp;
+
+    mutable QMutex m_mutex;
+    // Hash over the contents of the skin files, computed on demand
+    QByteArray m_skinHash;
+    // PNG encoded images, decoded on demand.
+    QHash<QString, QByteArray> m_images;
+    bool m_dirty;
+};
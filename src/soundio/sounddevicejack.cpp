@@ -0,0 +1,637 @@
+#include "soundio/sounddevicejack.h"
+
+#include <float.h>
+
+#include <QtDebug>
+#include <type_traits>
+
+#include "control/controlobject.h"
+#include "control/controlproxy.h"
+#include "soundio/soundmanager.h"
+#include "soundio/soundmanagerutil.h"
+#include "util/denormalsarezero.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/sample.h"
+#include "util/timer.h"
+#include "util/trace.h"
+#include "util/version.h"
+#include "waveform/visualplayposition.h"
+
+namespace {
+
+static_assert(std::is_same<CSAMPLE, jack_default_audio_sample_t>::value,
+        "The engine buffers are written to the JACK port buffers directly");
+
+// Allows to connect other clients even if the server has fewer physical
+// ports, e.g. with the dummy driver
+const int kMinChannels = 2;
+
+const mixxx::Logger kLogger("SoundDeviceJack");
+
+int countPhysicalPorts(jack_client_t* pClient, unsigned long flags) {
+    const char** ports = jack_get_ports(pClient,
+            nullptr,
+            JACK_DEFAULT_AUDIO_TYPE,
+            JackPortIsPhysical | flags);
+    int count = 0;
+    if (ports) {
+        while (ports[count]) {
+            ++count;
+        }
+        jack_free(ports);
+    }
+    return count;
+}
+
+CSAMPLE* portBuffer(jack_port_t* pPort, jack_nframes_t nframes) {
+    return static_cast<CSAMPLE*>(jack_port_get_buffer(pPort, nframes));
+}
+
+} // anonymous namespace
+
+// static
+bool SoundDeviceJack::queryServer(ServerInfo* pInfo) {
+    const QByteArray clientName = Version::applicationName().toLocal8Bit();
+    jack_status_t status;
+    jack_client_t* pClient = jack_client_open(
+            clientName.constData(), JackNoStartServer, &status);
+    if (!pClient) {
+        kLogger.debug() << "No JACK server running, status" << status;
+        return false;
+    }
+    pInfo->sampleRate = jack_get_sample_rate(pClient);
+    pInfo->framesPerBuffer = jack_get_buffer_size(pClient);
+    // The physical playback ports are inputs of the server
+    pInfo->numOutputChannels = math_max(kMinChannels,
+            countPhysicalPorts(pClient, JackPortIsInput));
+    pInfo->numInputChannels = math_max(kMinChannels,
+            countPhysicalPorts(pClient, JackPortIsOutput));
+    jack_client_close(pClient);
+    return true;
+}
+
+SoundDeviceJack::SoundDeviceJack(UserSettingsPointer config,
+        SoundManager* sm,
+        const ServerInfo& serverInfo)
+        : SoundDevice(config, sm),
+          m_serverInfo(serverInfo),
+          m_serverFramesPerBuffer(serverInfo.framesPerBuffer),
+          m_pClient(nullptr),
+          m_isClkRefDevice(false),
+          m_periodFrames(0),
+          m_pFifoBuffer(nullptr),
+          m_bSetThreadPriority(false),
+          m_serverShutdown(false),
+          m_playbackLatencyFrames(0),
+          m_framesSinceAudioLatencyUsageUpdate(0) {
+    // Setting parent class members:
+    m_hostAPI = MIXXX_JACK_STRING;
+    m_dSampleRate = serverInfo.sampleRate;
+    m_deviceId.name = kJackDeviceInternalName;
+    m_strDisplayName = QObject::tr("JACK server");
+    m_iNumOutputChannels = serverInfo.numOutputChannels;
+    m_iNumInputChannels = serverInfo.numInputChannels;
+
+    m_pMasterAudioLatencyUsage = std::make_unique<ControlProxy>("[Master]",
+            "audio_latency_usage");
+}
+
+SoundDeviceJack::~SoundDeviceJack() {
+    if (isOpen()) {
+        close();
+    }
+}
+
+SoundDeviceError SoundDeviceJack::open(bool isClkRefDevice, int syncBuffers) {
+    kLogger.debug() << "open:" << m_deviceId;
+    m_lastError.clear();
+
+    const QByteArray clientName = Version::applicationName().toLocal8Bit();
+    jack_status_t status;
+    m_pClient = jack_client_open(
+            clientName.constData(), JackNoStartServer, &status);
+    if (!m_pClient) {
+        m_lastError = QObject::tr("Could not connect to the JACK server");
+        kLogger.warning() << "Failed to open a client, status" << status;
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+    m_serverShutdown = false;
+
+    const double serverSampleRate = jack_get_sample_rate(m_pClient);
+    if (serverSampleRate != m_dSampleRate) {
+        kLogger.warning() << "Using the sample rate of the JACK server"
+                          << serverSampleRate << "Hz instead of"
+                          << m_dSampleRate << "Hz";
+        m_dSampleRate = serverSampleRate;
+    }
+    const jack_nframes_t periodFrames = jack_get_buffer_size(m_pClient);
+    m_serverFramesPerBuffer = periodFrames;
+    m_periodFrames = periodFrames;
+    m_isClkRefDevice = isClkRefDevice;
+    if (m_isClkRefDevice && static_cast<SINT>(periodFrames) != m_framesPerBuffer) {
+        // The period size has been changed since the devices were queried.
+        // All other devices exchange chunks of m_framesPerBuffer with the
+        // engine, which runs with the period size as clock reference.
+        m_lastError = QObject::tr(
+                "The JACK server now runs with %1 frames per period. "
+                "Please apply the sound hardware preferences again.")
+                              .arg(periodFrames);
+        kLogger.warning() << "Buffer size" << m_framesPerBuffer
+                          << "does not match the JACK period" << periodFrames;
+        jack_client_close(m_pClient);
+        m_pClient = nullptr;
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+
+    if (!registerPorts()) {
+        m_lastError = QObject::tr("Could not register the JACK ports");
+        jack_client_close(m_pClient);
+        m_pClient = nullptr;
+        m_outputPorts.clear();
+        m_inputPorts.clear();
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+
+    if (!m_isClkRefDevice) {
+        // Exchange samples with the clock reference device. Like
+        // SoundDevicePortAudio, syncBuffers chunks are kept to absorb jitter.
+        const int fifoFrames = math_max<int>(periodFrames, m_framesPerBuffer) *
+                (math_max(syncBuffers, 1) + 1);
+        if (!m_outputPorts.isEmpty()) {
+            m_outputFifo = std::make_unique<FIFO<CSAMPLE>>(
+                    m_outputPorts.size() * fifoFrames);
+        }
+        if (!m_inputPorts.isEmpty()) {
+            m_inputFifo = std::make_unique<FIFO<CSAMPLE>>(
+                    m_inputPorts.size() * fifoFrames);
+        }
+        m_pFifoBuffer = SampleUtil::alloc(
+                math_max(m_outputPorts.size(), m_inputPorts.size()) *
+                periodFrames);
+    }
+
+    jack_set_process_callback(m_pClient, processCallback, this);
+    jack_set_buffer_size_callback(m_pClient, bufferSizeCallback, this);
+    jack_set_xrun_callback(m_pClient, xrunCallback, this);
+    jack_set_latency_callback(m_pClient, latencyCallback, this);
+    jack_on_info_shutdown(m_pClient, shutdownCallback, this);
+
+    m_bSetThreadPriority = false;
+    m_clkRefTimer.start();
+    if (jack_activate(m_pClient)) {
+        m_lastError = QObject::tr("Could not activate the JACK client");
+        kLogger.warning() << "Failed to activate the client";
+        close();
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+
+    connectPhysicalPorts();
+    updatePlaybackLatency();
+
+    const mixxx::Duration bufferTime =
+            mixxx::Duration::fromSeconds(periodFrames / m_dSampleRate);
+    const double latencyMSec = (periodFrames + m_playbackLatencyFrames) /
+            m_dSampleRate * 1000;
+    kLogger.info() << "Opened JACK client with" << m_dSampleRate << "Hz,"
+                   << periodFrames << "frames per period, latency"
+                   << latencyMSec << "ms";
+    if (m_isClkRefDevice) {
+        // Update the samplerate and latency ControlObjects, which allow the
+        // waveform view to properly correct for the latency.
+        ControlObject::set(ConfigKey("[Master]", "latency"), latencyMSec);
+        ControlObject::set(ConfigKey("[Master]", "samplerate"), m_dSampleRate);
+        ControlObject::set(ConfigKey("[Master]", "audio_buffer_size"),
+                bufferTime.toDoubleMillis());
+    }
+    return SOUNDDEVICE_ERROR_OK;
+}
+
+bool SoundDeviceJack::isOpen() const {
+    return m_pClient != nullptr;
+}
+
+SoundDeviceError SoundDeviceJack::close() {
+    kLogger.debug() << "close:" << m_deviceId;
+    jack_client_t* pClient = m_pClient;
+    if (!pClient) {
+        return SOUNDDEVICE_ERROR_OK;
+    }
+    // Waits until the process callback has returned
+    if (!m_serverShutdown) {
+        jack_deactivate(pClient);
+    }
+    jack_client_close(pClient);
+    m_pClient = nullptr;
+
+    m_outputPorts.clear();
+    m_inputPorts.clear();
+    m_unusedOutputPorts.clear();
+    m_outputFifo.reset();
+    m_inputFifo.reset();
+    if (m_pFifoBuffer) {
+        SampleUtil::free(m_pFifoBuffer);
+        m_pFifoBuffer = nullptr;
+    }
+    return SOUNDDEVICE_ERROR_OK;
+}
+
+QString SoundDeviceJack::getError() const {
+    return m_lastError;
+}
+
+bool SoundDeviceJack::registerPorts() {
+    // Only the channels up to the highest one in use get a port
+    int numOutputPorts = 0;
+    for (const auto& out : qAsConst(m_audioOutputs)) {
+        const ChannelGroup channels = out.getChannelGroup();
+        numOutputPorts = math_max(numOutputPorts,
+                static_cast<int>(channels.getChannelBase() +
+                        channels.getChannelCount()));
+    }
+    int numInputPorts = 0;
+    for (const auto& in : qAsConst(m_audioInputs)) {
+        const ChannelGroup channels = in.getChannelGroup();
+        numInputPorts = math_max(numInputPorts,
+                static_cast<int>(channels.getChannelBase() +
+                        channels.getChannelCount()));
+    }
+
+    for (int i = 0; i < numOutputPorts; ++i) {
+        const QByteArray portName = QString("out_%1").arg(i + 1).toLatin1();
+        jack_port_t* pPort = jack_port_register(m_pClient,
+                portName.constData(),
+                JACK_DEFAULT_AUDIO_TYPE,
+                JackPortIsOutput,
+                0);
+        if (!pPort) {
+            kLogger.warning() << "Failed to register port" << portName;
+            return false;
+        }
+        m_outputPorts.append(pPort);
+        m_unusedOutputPorts.append(i);
+    }
+    for (const auto& out : qAsConst(m_audioOutputs)) {
+        const ChannelGroup channels = out.getChannelGroup();
+        for (unsigned int i = 0; i < channels.getChannelCount(); ++i) {
+            m_unusedOutputPorts.removeOne(channels.getChannelBase() + i);
+        }
+    }
+
+    for (int i = 0; i < numInputPorts; ++i) {
+        const QByteArray portName = QString("in_%1").arg(i + 1).toLatin1();
+        jack_port_t* pPort = jack_port_register(m_pClient,
+                portName.constData(),
+                JACK_DEFAULT_AUDIO_TYPE,
+                JackPortIsInput,
+                0);
+        if (!pPort) {
+            kLogger.warning() << "Failed to register port" << portName;
+            return false;
+        }
+        m_inputPorts.append(pPort);
+    }
+    return true;
+}
+
+void SoundDeviceJack::connectPhysicalPorts() {
+    // Connect in order like PortAudio, e.g. out_1 to system:playback_1
+    const char** playbackPorts = jack_get_ports(m_pClient,
+            nullptr,
+            JACK_DEFAULT_AUDIO_TYPE,
+            JackPortIsPhysical | JackPortIsInput);
+    if (playbackPorts) {
+        for (int i = 0; i < m_outputPorts.size() && playbackPorts[i]; ++i) {
+            jack_connect(m_pClient,
+                    jack_port_name(m_outputPorts[i]),
+                    playbackPorts[i]);
+        }
+        jack_free(playbackPorts);
+    }
+    const char** capturePorts = jack_get_ports(m_pClient,
+            nullptr,
+            JACK_DEFAULT_AUDIO_TYPE,
+            JackPortIsPhysical | JackPortIsOutput);
+    if (capturePorts) {
+        for (int i = 0; i < m_inputPorts.size() && capturePorts[i]; ++i) {
+            jack_connect(m_pClient,
+                    capturePorts[i],
+                    jack_port_name(m_inputPorts[i]));
+        }
+        jack_free(capturePorts);
+    }
+}
+
+void SoundDeviceJack::updatePlaybackLatency() {
+    jack_nframes_t latencyFrames = 0;
+    for (jack_port_t* pPort : qAsConst(m_outputPorts)) {
+        jack_latency_range_t range;
+        jack_port_get_latency_range(pPort, JackPlaybackLatency, &range);
+        latencyFrames = math_max(latencyFrames, range.max);
+    }
+    m_playbackLatencyFrames = latencyFrames;
+}
+
+// static
+int SoundDeviceJack::processCallback(jack_nframes_t nframes, void* pArg) {
+    auto* pDevice = static_cast<SoundDeviceJack*>(pArg);
+    if (nframes != pDevice->m_periodFrames) {
+        // The buffer size of the server has been changed. Play silence until
+        // the device is reopened, see bufferSizeCallback().
+        pDevice->m_pSoundManager->underflowHappened(30);
+        for (jack_port_t* pPort : qAsConst(pDevice->m_outputPorts)) {
+            SampleUtil::clear(portBuffer(pPort, nframes), nframes);
+        }
+        return 0;
+    }
+    if (pDevice->m_isClkRefDevice) {
+        pDevice->callbackProcessClkRef(nframes);
+    } else {
+        pDevice->callbackProcess(nframes);
+    }
+    return 0;
+}
+
+// static
+int SoundDeviceJack::bufferSizeCallback(jack_nframes_t nframes, void* pArg) {
+    // Called from a non-realtime thread of the client before the process
+    // callback is invoked with the new period size
+    auto* pDevice = static_cast<SoundDeviceJack*>(pArg);
+    pDevice->m_serverFramesPerBuffer = nframes;
+    if (nframes != pDevice->m_periodFrames) {
+        kLogger.info() << "The JACK server changed the period size from"
+                       << pDevice->m_periodFrames << "to" << nframes
+                       << "frames, reopening the sound devices";
+        // The engine and all other devices exchange chunks of the period
+        // size of the clock reference device
+        pDevice->m_pSoundManager->requestReopenDevices();
+    }
+    return 0;
+}
+
+// static
+int SoundDeviceJack::xrunCallback(void* pArg) {
+    auto* pDevice = static_cast<SoundDeviceJack*>(pArg);
+    pDevice->m_pSoundManager->underflowHappened(25);
+    return 0;
+}
+
+// static
+void SoundDeviceJack::latencyCallback(
+        jack_latency_callback_mode_t mode, void* pArg) {
+    if (mode == JackPlaybackLatency) {
+        auto* pDevice = static_cast<SoundDeviceJack*>(pArg);
+        pDevice->updatePlaybackLatency();
+    }
+}
+
+// static
+void SoundDeviceJack::shutdownCallback(
+        jack_status_t code, const char* reason, void* pArg) {
+    // The client must not be used anymore, except for closing it
+    auto* pDevice = static_cast<SoundDeviceJack*>(pArg);
+    pDevice->m_serverShutdown = true;
+    // Reported like an error when opening the device. The SoundManager
+    // reads the error after it has received the request in its own thread.
+    pDevice->m_lastError = QObject::tr("The JACK server has been shut down: %1")
+                                   .arg(reason ? QString::fromLocal8Bit(reason)
+                                               : QString::number(code));
+    pDevice->m_pSoundManager->requestDeviceError(pDevice);
+}
+
+void SoundDeviceJack::callbackProcess(jack_nframes_t nframes) {
+    Trace trace("SoundDeviceJack::callbackProcess %1", m_deviceId.debugName());
+    if (m_outputFifo) {
+        writeOutputPortsFromFifo(nframes);
+    }
+    if (m_inputFifo) {
+        readInputPortsToFifo(nframes);
+    }
+}
+
+void SoundDeviceJack::callbackProcessClkRef(jack_nframes_t nframes) {
+    // This must be the very first call, to measure an exact value
+    updateCallbackEntryToDacTime();
+
+    Trace trace("SoundDeviceJack::callbackProcessClkRef %1",
+            m_deviceId.debugName());
+
+    // The JACK process thread already runs with realtime priority
+    if (!m_bSetThreadPriority) {
+        m_bSetThreadPriority = true;
+#ifdef __SSE__
+        // This disables the denormals calculations, to avoid a
+        // performance penalty of ~20
+        // https://bugs.launchpad.net/mixxx/+bug/1404401
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+#endif
+        // verify if flush to zero or denormals to zero works
+        // test passes if one of the two flag is set.
+        volatile double doubleMin = DBL_MIN; // the smallest normalized double
+        VERIFY_OR_DEBUG_ASSERT(doubleMin / 2 == 0.0) {
+            qWarning() << "Denormals to zero mode is not working. EQs and effects may suffer high CPU load";
+        }
+    }
+
+    m_pSoundManager->processUnderflowHappened();
+
+    //Note: Input is processed first so that any ControlObject changes made in
+    //      response to input are processed as soon as possible (that is, when
+    //      m_pSoundManager->requestBuffer() is called below.)
+    if (!m_inputPorts.isEmpty()) {
+        ScopedTimer t("SoundDeviceJack::callbackProcess input %1",
+                m_deviceId.debugName());
+        readInputPorts(nframes);
+        m_pSoundManager->pushInputBuffers(m_audioInputs, nframes);
+    }
+
+    m_pSoundManager->readProcess();
+
+    {
+        ScopedTimer t("SoundDeviceJack::callbackProcess prepare %1",
+                m_deviceId.debugName());
+        m_pSoundManager->onDeviceOutputCallback(nframes);
+    }
+
+    if (!m_outputPorts.isEmpty()) {
+        ScopedTimer t("SoundDeviceJack::callbackProcess output %1",
+                m_deviceId.debugName());
+        writeOutputPorts(nframes);
+    }
+
+    m_pSoundManager->writeProcess();
+
+    updateAudioLatencyUsage(nframes);
+}
+
+void SoundDeviceJack::writeOutputPorts(jack_nframes_t nframes) {
+    // The engine buffers are always stereo
+    for (const auto& out : qAsConst(m_audioOutputs)) {
+        const ChannelGroup channels = out.getChannelGroup();
+        const int channelBase = channels.getChannelBase();
+        if (channels.getChannelCount() == 1) {
+            SampleUtil::mixStereoToMonoClampBuffer(
+                    portBuffer(m_outputPorts[channelBase], nframes),
+                    out.getBuffer(),
+                    nframes);
+        } else {
+            SampleUtil::deinterleaveClampBuffer(
+                    portBuffer(m_outputPorts[channelBase], nframes),
+                    portBuffer(m_outputPorts[channelBase + 1], nframes),
+                    out.getBuffer(),
+                    nframes);
+        }
+    }
+    for (int port : qAsConst(m_unusedOutputPorts)) {
+        SampleUtil::clear(portBuffer(m_outputPorts[port], nframes), nframes);
+    }
+}
+
+void SoundDeviceJack::readInputPorts(jack_nframes_t nframes) {
+    // The engine buffers are always stereo
+    for (const auto& in : qAsConst(m_audioInputs)) {
+        const ChannelGroup channels = in.getChannelGroup();
+        const int channelBase = channels.getChannelBase();
+        if (channels.getChannelCount() == 1) {
+            SampleUtil::copyMonoToDualMono(in.getBuffer(),
+                    portBuffer(m_inputPorts[channelBase], nframes),
+                    nframes);
+        } else {
+            SampleUtil::interleaveBuffer(in.getBuffer(),
+                    portBuffer(m_inputPorts[channelBase], nframes),
+                    portBuffer(m_inputPorts[channelBase + 1], nframes),
+                    nframes);
+        }
+    }
+}
+
+void SoundDeviceJack::writeOutputPortsFromFifo(jack_nframes_t nframes) {
+    const int numPorts = m_outputPorts.size();
+    const int framesRead = m_outputFifo->read(m_pFifoBuffer, nframes * numPorts) /
+            numPorts;
+    if (framesRead < static_cast<int>(nframes)) {
+        m_pSoundManager->underflowHappened(26);
+    }
+    if (numPorts == 2) {
+        SampleUtil::deinterleaveBuffer(portBuffer(m_outputPorts[0], nframes),
+                portBuffer(m_outputPorts[1], nframes),
+                m_pFifoBuffer,
+                framesRead);
+    } else {
+        for (int port = 0; port < numPorts; ++port) {
+            CSAMPLE* pPortBuffer = portBuffer(m_outputPorts[port], nframes);
+            for (int frame = 0; frame < framesRead; ++frame) {
+                pPortBuffer[frame] = m_pFifoBuffer[frame * numPorts + port];
+            }
+        }
+    }
+    for (int port = 0; port < numPorts; ++port) {
+        SampleUtil::clear(portBuffer(m_outputPorts[port], nframes) + framesRead,
+                nframes - framesRead);
+    }
+}
+
+void SoundDeviceJack::readInputPortsToFifo(jack_nframes_t nframes) {
+    const int numPorts = m_inputPorts.size();
+    if (numPorts == 2) {
+        SampleUtil::interleaveBuffer(m_pFifoBuffer,
+                portBuffer(m_inputPorts[0], nframes),
+                portBuffer(m_inputPorts[1], nframes),
+                nframes);
+    } else {
+        for (int port = 0; port < numPorts; ++port) {
+            const CSAMPLE* pPortBuffer = portBuffer(m_inputPorts[port], nframes);
+            for (jack_nframes_t frame = 0; frame < nframes; ++frame) {
+                m_pFifoBuffer[frame * numPorts + port] = pPortBuffer[frame];
+            }
+        }
+    }
+    const int samples = nframes * numPorts;
+    if (m_inputFifo->write(m_pFifoBuffer, samples) < samples) {
+        m_pSoundManager->underflowHappened(27);
+    }
+}
+
+void SoundDeviceJack::writeProcess() {
+    if (!m_outputFifo) {
+        return;
+    }
+    const int numPorts = m_outputPorts.size();
+    const int outChunkSize = m_framesPerBuffer * numPorts;
+    int writeCount = outChunkSize;
+    if (m_outputFifo->writeAvailable() < outChunkSize) {
+        writeCount = m_outputFifo->writeAvailable() / numPorts * numPorts;
+        m_pSoundManager->underflowHappened(28);
+    }
+    if (writeCount <= 0) {
+        return;
+    }
+    CSAMPLE* dataPtr1;
+    ring_buffer_size_t size1;
+    CSAMPLE* dataPtr2;
+    ring_buffer_size_t size2;
+    // We use size1 and size2, so we can ignore the return value
+    (void)m_outputFifo->aquireWriteRegions(writeCount,
+            &dataPtr1, &size1, &dataPtr2, &size2);
+    composeOutputBuffer(dataPtr1, size1 / numPorts, 0, numPorts);
+    if (size2 > 0) {
+        composeOutputBuffer(dataPtr2, size2 / numPorts, size1 / numPorts, numPorts);
+    }
+    m_outputFifo->releaseWriteRegions(writeCount);
+}
+
+void SoundDeviceJack::readProcess() {
+    if (!m_inputFifo) {
+        return;
+    }
+    const int numPorts = m_inputPorts.size();
+    const int inChunkSize = m_framesPerBuffer * numPorts;
+    int readCount = inChunkSize;
+    if (m_inputFifo->readAvailable() < inChunkSize) {
+        readCount = m_inputFifo->readAvailable() / numPorts * numPorts;
+        m_pSoundManager->underflowHappened(29);
+    }
+    if (readCount > 0) {
+        CSAMPLE* dataPtr1;
+        ring_buffer_size_t size1;
+        CSAMPLE* dataPtr2;
+        ring_buffer_size_t size2;
+        // We use size1 and size2, so we can ignore the return value
+        (void)m_inputFifo->aquireReadRegions(readCount,
+                &dataPtr1, &size1, &dataPtr2, &size2);
+        composeInputBuffer(dataPtr1, size1 / numPorts, 0, numPorts);
+        if (size2 > 0) {
+            composeInputBuffer(dataPtr2, size2 / numPorts, size1 / numPorts, numPorts);
+        }
+        m_inputFifo->releaseReadRegions(readCount);
+    }
+    if (readCount < inChunkSize) {
+        // Fill remaining buffers with zeros
+        clearInputBuffer((inChunkSize - readCount) / numPorts, readCount / numPorts);
+    }
+    m_pSoundManager->pushInputBuffers(m_audioInputs, m_framesPerBuffer);
+}
+
+void SoundDeviceJack::updateCallbackEntryToDacTime() {
+    m_clkRefTimer.start();
+    // Unlike PortAudio, JACK reports the latency of the ports reliably
+    const double callbackEntrytoDacSecs =
+            (m_framesPerBuffer + m_playbackLatencyFrames) / m_dSampleRate;
+    VisualPlayPosition::setCallbackEntryToDacSecs(callbackEntrytoDacSecs, m_clkRefTimer);
+}
+
+void SoundDeviceJack::updateAudioLatencyUsage(jack_nframes_t nframes) {
+    m_framesSinceAudioLatencyUsageUpdate += nframes;
+    if (m_framesSinceAudioLatencyUsageUpdate
+            > (m_dSampleRate / CPU_USAGE_UPDATE_RATE)) {
+        double secInAudioCb = m_timeInAudioCallback.toDoubleSeconds();
+        m_pMasterAudioLatencyUsage->set(
+                secInAudioCb
+                        / (m_framesSinceAudioLatencyUsageUpdate / m_dSampleRate));
+        m_timeInAudioCallback = mixxx::Duration::fromSeconds(0);
+        m_framesSinceAudioLatencyUsageUpdate = 0;
+    }
+    // measure time in Audio callback at the very last
+    m_timeInAudioCallback += m_clkRefTimer.elapsed();
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <jack/jack.h>
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+#include "soundio/sounddevice.h"
+#include "util/duration.h"
+#include "util/fifo.h"
+#include "util/performancetimer.h"
+
+#define CPU_USAGE_UPDATE_RATE 30 // in 1/s, fits to display frame rate
+
+class ControlProxy;
+class SoundManager;
+
+const QString kJackDeviceInternalName = "JACK";
+
+// A sound device that connects directly to a JACK server instead of going
+// through PortAudio's JACK host API.
+//
+// As clock reference, the JACK process callback drives the engine with the
+// period size of the server and the engine output is deinterleaved directly
+// into the JACK port buffers. Otherwise the samples are exchanged with the
+// clock reference device through FIFOs.
+//
+// The sample rate and the buffer size are given by the JACK server. When the
+// server changes its period size while running, e.g. PipeWire adapting its
+// quantum to other clients, all devices are reopened by the SoundManager.
+// The ports are connected to the physical ports of the server, which can be
+// changed with any JACK patchbay.
+class SoundDeviceJack : public SoundDevice {
+  public:
+    struct ServerInfo {
+        ServerInfo()
+                : sampleRate(0),
+                  framesPerBuffer(0),
+                  numOutputChannels(0),
+                  numInputChannels(0) {
+        }
+        unsigned int sampleRate;
+        unsigned int framesPerBuffer;
+        int numOutputChannels;
+        int numInputChannels;
+    };
+
+    // Returns false if no JACK server is running. Never starts a server.
+    static bool queryServer(ServerInfo* pInfo);
+
+    SoundDeviceJack(UserSettingsPointer config,
+            SoundManager* sm,
+            const ServerInfo& serverInfo);
+    ~SoundDeviceJack() override;
+
+    SoundDeviceError open(bool isClkRefDevice, int syncBuffers) override;
+    bool isOpen() const override;
+    SoundDeviceError close() override;
+    void readProcess() override;
+    void writeProcess() override;
+    QString getError() const override;
+
+    unsigned int getDefaultSampleRate() const override {
+        return m_serverInfo.sampleRate;
+    }
+
+    // The period size of the server when it was queried or when it has been
+    // changed while the device was open
+    unsigned int getServerFramesPerBuffer() const {
+        return m_serverFramesPerBuffer.load();
+    }
+
+  private:
+    static int processCallback(jack_nframes_t nframes, void* pArg);
+    static int bufferSizeCallback(jack_nframes_t nframes, void* pArg);
+    static int xrunCallback(void* pArg);
+    static void latencyCallback(jack_latency_callback_mode_t mode, void* pArg);
+    static void shutdownCallback(jack_status_t code, const char* reason, void* pArg);
+
+    void callbackProcess(jack_nframes_t nframes);
+    void callbackProcessClkRef(jack_nframes_t nframes);
+
+    bool registerPorts();
+    void connectPhysicalPorts();
+    void updatePlaybackLatency();
+
+    // Deinterleaves the configured outputs into the port buffers
+    void writeOutputPorts(jack_nframes_t nframes);
+    // Interleaves the port buffers into the configured inputs
+    void readInputPorts(jack_nframes_t nframes);
+    void writeOutputPortsFromFifo(jack_nframes_t nframes);
+    void readInputPortsToFifo(jack_nframes_t nframes);
+
+    void updateCallbackEntryToDacTime();
+    void updateAudioLatencyUsage(jack_nframes_t nframes);
+
+    const ServerInfo m_serverInfo;
+    std::atomic<unsigned int> m_serverFramesPerBuffer;
+
+    jack_client_t* m_pClient;
+    bool m_isClkRefDevice;
+    jack_nframes_t m_periodFrames;
+    QVector<jack_port_t*> m_outputPorts;
+    QVector<jack_port_t*> m_inputPorts;
+    // Output ports between the configured outputs, which play silence
+    QVector<int> m_unusedOutputPorts;
+    // Interleaved samples exchanged with the clock reference device
+    std::unique_ptr<FIFO<CSAMPLE>> m_outputFifo;
+    std::unique_ptr<FIFO<CSAMPLE>> m_inputFifo;
+    CSAMPLE* m_pFifoBuffer;
+
+    QString m_lastError;
+    bool m_bSetThreadPriority;
+    std::atomic<bool> m_serverShutdown;
+    std::atomic<jack_nframes_t> m_playbackLatencyFrames;
+    std::unique_ptr<ControlProxy> m_pMasterAudioLatencyUsage;
+    mixxx::Duration m_timeInAudioCallback;
+    int m_framesSinceAudioLatencyUsageUpdate;
+    PerformanceTimer m_clkRefTimer;
+};
@@ -29,6 +29,9 @@
 #include "engine/sidechain/enginenetworkstream.h"
 #include "engine/sidechain/enginesidechain.h"
 #include "soundio/sounddevice.h"
+#ifdef __JACK__
+#include "soundio/sounddevicejack.h"
+#endif
 #include "soundio/sounddevicenetwork.h"
 #include "soundio/sounddevicenotfound.h"
 #include "soundio/sounddeviceportaudio.h"
@@ -67,6 +70,8 @@ SoundManager::SoundManager(UserSettingsPointer pConfig,
           m_config(this),
           m_pErrorDevice(NULL),
           m_underflowHappened(0),
+          m_reopenRequested(0),
+          m_pFailedDevice(nullptr),
           m_underflowUpdateCount(0) {
     // TODO(xxx) some of these ControlObject are not needed by soundmanager, or are unused here.
     // It is possible to take them out?
@@ -158,6 +163,15 @@ QList<QString> SoundManager::getHostAPIList() const {
         }
     }
 
+#ifdef __JACK__
+    for (const auto& pDevice : m_devices) {
+        if (pDevice->getHostAPI() == MIXXX_JACK_STRING) {
+            apiList.push_back(MIXXX_JACK_STRING);
+            break;
+        }
+    }
+#endif
+
     return apiList;
 }
 
@@ -241,6 +255,16 @@ QList<unsigned int> SoundManager::getSampleRates(QString api) const {
         samplerates.append(m_jackSampleRate);
         return samplerates;
     }
+    if (api == MIXXX_JACK_STRING) {
+        // The JACK server dictates the sample rate
+        QList<unsigned int> samplerates;
+        for (const auto& pDevice : m_devices) {
+            if (pDevice->getHostAPI() == MIXXX_JACK_STRING) {
+                samplerates.append(pDevice->getDefaultSampleRate());
+            }
+        }
+        return samplerates;
+    }
     return m_samplerates;
 }
 
@@ -251,6 +275,9 @@ QList<unsigned int> SoundManager::getSampleRates() const {
 void SoundManager::queryDevices() {
     //qDebug() << "SoundManager::queryDevices()";
     queryDevicesPortaudio();
+#ifdef __JACK__
+    queryDevicesJack();
+#endif
     queryDevicesMixxx();
 
     // now tell the prefs that we updated the device list -- bkgood
@@ -324,6 +351,18 @@ void SoundManager::queryDevicesPortaudio() {
     }
 }
 
+#ifdef __JACK__
+void SoundManager::queryDevicesJack() {
+    SoundDeviceJack::ServerInfo serverInfo;
+    if (!SoundDeviceJack::queryServer(&serverInfo)) {
+        return;
+    }
+    auto currentDevice = SoundDevicePointer(new SoundDeviceJack(
+            m_pConfig, this, serverInfo));
+    m_devices.append(currentDevice);
+}
+#endif
+
 void SoundManager::queryDevicesMixxx() {
     auto currentDevice = SoundDevicePointer(new SoundDeviceNetwork(
             m_pConfig, this, m_pNetworkStream));
@@ -370,6 +409,19 @@ SoundDeviceError SoundManager::setupDevices() {
     // all found devices are removed below
     QSet<SoundDeviceId> devicesNotFound = m_config.getDevices();
 
+    unsigned int framesPerBuffer = m_config.getFramesPerBuffer();
+#ifdef __JACK__
+    if (m_config.getAPI() == MIXXX_JACK_STRING) {
+        // The JACK server dictates the buffer size
+        for (const auto& pDevice : qAsConst(m_devices)) {
+            const auto pJackDevice = qSharedPointerDynamicCast<SoundDeviceJack>(pDevice);
+            if (pJackDevice) {
+                framesPerBuffer = pJackDevice->getServerFramesPerBuffer();
+            }
+        }
+    }
+#endif
+
     // pair is isInput, isOutput
     QVector<DeviceMode> toOpen;
     bool haveOutput = false;
@@ -452,7 +504,7 @@ SoundDeviceError SoundManager::setupDevices() {
 
         if (mode.isInput || mode.isOutput) {
             pDevice->setSampleRate(m_config.getSampleRate());
-            pDevice->setFramesPerBuffer(m_config.getFramesPerBuffer());
+            pDevice->setFramesPerBuffer(framesPerBuffer);
             toOpen.append(mode);
         }
     }
@@ -519,6 +571,54 @@ closeAndError:
     return err;
 }
 
+void SoundManager::requestReopenDevices() {
+    // Coalesce the requests of all devices
+    if (m_reopenRequested.testAndSetOrdered(0, 1)) {
+        QMetaObject::invokeMethod(this, "slotReopenDevices", Qt::QueuedConnection);
+    }
+}
+
+void SoundManager::slotReopenDevices() {
+    m_reopenRequested = 0;
+    qDebug() << "SoundManager: Reopening the sound devices";
+    const bool sleepAfterClosing = false;
+    closeDevices(sleepAfterClosing);
+    SoundDeviceError err = setupDevices();
+    if (err != SOUNDDEVICE_ERROR_OK) {
+        qWarning() << "SoundManager: Failed to reopen the sound devices";
+        emit deviceError(err);
+    }
+}
+
+void SoundManager::requestDeviceError(SoundDevice* pDevice) {
+    // The first error is reported
+    if (m_pFailedDevice.testAndSetOrdered(nullptr, pDevice)) {
+        QMetaObject::invokeMethod(this, "slotProcessDeviceError", Qt::QueuedConnection);
+    }
+}
+
+void SoundManager::slotProcessDeviceError() {
+    SoundDevice* pFailedDevice = m_pFailedDevice.fetchAndStoreOrdered(nullptr);
+    // The device may have been deleted, so only its address is compared
+    SoundDevicePointer pErrorDevice;
+    for (const auto& pDevice : qAsConst(m_devices)) {
+        if (pDevice.data() == pFailedDevice) {
+            pErrorDevice = pDevice;
+            break;
+        }
+    }
+    if (!pErrorDevice || !pErrorDevice->isOpen()) {
+        // The devices have been closed or queried again in the meantime
+        return;
+    }
+    qWarning() << "SoundManager:" << pErrorDevice->getDisplayName()
+               << "failed:" << pErrorDevice->getError();
+    const bool sleepAfterClosing = false;
+    closeDevices(sleepAfterClosing);
+    m_pErrorDevice = pErrorDevice;
+    emit deviceError(SOUNDDEVICE_ERROR_ERR);
+}
+
 SoundDevicePointer SoundManager::getErrorDevice() const {
     return m_pErrorDevice;
 }
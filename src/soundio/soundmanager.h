@@ -48,6 +48,8 @@ class SoundDeviceNotFound;
 #define MIXXX_PORTAUDIO_ASIO_STRING "ASIO"
 #define MIXXX_PORTAUDIO_DIRECTSOUND_STRING "Windows DirectSound"
 #define MIXXX_PORTAUDIO_COREAUDIO_STRING "Core Audio"
+// Not a PortAudio host API, see SoundDeviceJack
+#define MIXXX_JACK_STRING "JACK (native)"
 
 #define SOUNDMANAGER_DISCONNECTED 0
 #define SOUNDMANAGER_CONNECTING 1
@@ -70,6 +72,9 @@ class SoundManager : public QObject {
     void clearAndQueryDevices();
     void queryDevices();
     void queryDevicesPortaudio();
+#ifdef __JACK__
+    void queryDevicesJack();
+#endif
     void queryDevicesMixxx();
 
     // Opens all the devices chosen by the user in the preferences dialog, and
@@ -90,7 +95,8 @@ class SoundManager : public QObject {
     // Convenience overload for SoundManager::getSampleRates(QString)
     QList<unsigned int> getSampleRates() const;
 
-    // Get a list of host APIs supported by PortAudio.
+    // Get a list of host APIs supported by PortAudio and the native JACK
+    // API if a JACK server is running.
     QList<QString> getHostAPIList() const;
     SoundManagerConfig getConfig() const;
     SoundDeviceError setConfig(SoundManagerConfig config);
@@ -127,11 +133,28 @@ class SoundManager : public QObject {
 
     void processUnderflowHappened();
 
+    // Called by a SoundDevice from any thread if it needs to be reopened,
+    // e.g. because the JACK server has changed its period size. The devices
+    // are reopened in the thread of the SoundManager.
+    void requestReopenDevices();
+
+    // Called by a SoundDevice from any thread if it has failed while it was
+    // running, e.g. because the JACK server has been shut down. All devices
+    // are closed in the thread of the SoundManager and deviceError() is
+    // emitted with pDevice as the error device.
+    void requestDeviceError(SoundDevice* pDevice);
+
   signals:
     void devicesUpdated(); // emitted when pointers to SoundDevices go stale
     void devicesSetup(); // emitted when the sound devices have been set up
     void outputRegistered(AudioOutput output, AudioSource *src);
     void inputRegistered(AudioInput input, AudioDestination *dest);
+    // emitted when the devices have been closed after an error at runtime
+    void deviceError(SoundDeviceError err);
+
+  private slots:
+    void slotReopenDevices();
+    void slotProcessDeviceError();
 
   private:
     // Closes all the devices and empties the list of devices we have.
@@ -163,6 +186,8 @@ class SoundManager : public QObject {
     QSharedPointer<EngineNetworkStream> m_pNetworkStream;
 
     QAtomicInt m_underflowHappened;
+    QAtomicInt m_reopenRequested;
+    QAtomicPointer<SoundDevice> m_pFailedDevice;
     int m_underflowUpdateCount;
     ControlProxy* m_pMasterAudioLatencyOverloadCount;
     ControlProxy* m_pMasterAudioLatencyOverload;
@@ -51,6 +51,20 @@ namespace {
 
 const mixxx::Logger kLogger("SoundSourceProxy");
 
+bool parseMissingArtistTitleFromFileName(
+        mixxx::TrackMetadata* pTrackMetadata,
+        const TrackFile& trackFile) {
+    const bool splitArtistTitle =
+            pTrackMetadata->getTrackInfo().getArtist().trimmed().isEmpty();
+    kLogger.info()
+            << "Parsing missing"
+            << (splitArtistTitle ? "artist/title" : "title")
+            << "from file name:"
+            << trackFile;
+    return pTrackMetadata->refTrackInfo().parseArtistTitleFromFileName(
+            trackFile.fileName(), splitArtistTitle);
+}
+
 } // anonymous namespace
 
 // static
@@ -195,6 +209,65 @@ TrackPointer SoundSourceProxy::importTemporaryTrack(
     return pTrack;
 }
 
+//static
+bool SoundSourceProxy::importTrackRecord(
+        const TrackFile& trackFile,
+        mixxx::TrackRecord* pTrackRecord) {
+    DEBUG_ASSERT(pTrackRecord);
+    // Only the lookup needs to lock the cache. Files of cached tracks
+    // might get written while reading them and are parsed into a
+    // temporary track while the cache is locked instead.
+    const auto trackRef = TrackRef::fromFileInfo(trackFile);
+    TrackPointer pCachedTrack = GlobalTrackCacheLocker().lookupTrackByRef(trackRef);
+    if (pCachedTrack) {
+        // Release the reference before locking the cache again
+        pCachedTrack.reset();
+        importTemporaryTrack(trackFile)->readTrackRecord(pTrackRecord);
+        return true;
+    }
+
+    const SoundSourceProxy proxy(trackFile.toUrl());
+    if (!proxy.m_pSoundSource) {
+        kLogger.warning()
+                << "Unable to import track record from unsupported file type"
+                << trackFile.location();
+        return false;
+    }
+    pTrackRecord->setFileType(proxy.m_pSoundSource->getType());
+
+    // The file is new and there are no existing values in the library
+    // that need to be preserved. Both metadata and the embedded cover
+    // art are imported in full.
+    mixxx::TrackMetadata trackMetadata;
+    QImage coverImg;
+    auto metadataImported =
+            proxy.m_pSoundSource->importTrackMetadataAndCoverImage(
+                    &trackMetadata, &coverImg);
+    if (metadataImported.first == mixxx::MetadataSource::ImportResult::Failed) {
+        kLogger.warning()
+                << "Failed to import track metadata and embedded cover art"
+                << "from file"
+                << trackFile.location();
+    }
+    if (metadataImported.first != mixxx::MetadataSource::ImportResult::Succeeded &&
+            trackMetadata.getTrackInfo().getTitle().trimmed().isEmpty() &&
+            parseMissingArtistTitleFromFileName(&trackMetadata, trackFile) &&
+            metadataImported.second.isNull()) {
+        metadataImported.second = trackFile.fileLastModified();
+    }
+
+    auto coverInfo =
+            CoverInfoGuesser().guessCoverInfo(
+                    trackFile,
+                    trackMetadata.getAlbumInfo().getTitle(),
+                    coverImg);
+    DEBUG_ASSERT(coverInfo.source == CoverInfo::GUESSED);
+    pTrackRecord->setMetadata(std::move(trackMetadata));
+    pTrackRecord->setMetadataSynchronized(!metadataImported.second.isNull());
+    pTrackRecord->setCoverInfo(std::move(coverInfo));
+    return true;
+}
+
 //static
 QImage SoundSourceProxy::importTemporaryCoverImage(
         TrackFile trackFile,
@@ -387,15 +460,8 @@ void SoundSourceProxy::updateTrackFromSource(
             // splitArtistTitle = false here and compile their custom version!
             // It is not worth extending the settings and injecting them into
             // SoundSourceProxy for just a few people.
-            const bool splitArtistTitle =
-                    trackMetadata.getTrackInfo().getArtist().trimmed().isEmpty();
             const auto trackFile = m_pTrack->getFileInfo();
-            kLogger.info()
-                    << "Parsing missing"
-                    << (splitArtistTitle ? "artist/title" : "title")
-                    << "from file name:"
-                    << trackFile;
-            if (trackMetadata.refTrackInfo().parseArtistTitleFromFileName(trackFile.fileName(), splitArtistTitle) &&
+            if (parseMissingArtistTitleFromFileName(&trackMetadata, trackFile) &&
                     metadataImported.second.isNull()) {
                 // Since this is also some kind of metadata import, we mark the
                 // track's metadata as synchronized with the time stamp of the file.
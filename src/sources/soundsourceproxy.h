@@ -34,6 +34,14 @@ class SoundSourceProxy {
     static TrackPointer importTemporaryTrack(
             TrackFile trackFile,
             SecurityTokenPointer pSecurityToken = SecurityTokenPointer());
+    // Parses the file type, metadata, and cover art of a file that is
+    // not yet stored in the library into a track record. The global
+    // track cache is only locked if the file is referenced by a cached
+    // track that might export its metadata into the file concurrently.
+    // Returns false if the file type is not supported.
+    static bool importTrackRecord(
+            const TrackFile& trackFile,
+            mixxx::TrackRecord* pTrackRecord);
     static QImage importTemporaryCoverImage(
             TrackFile trackFile,
             SecurityTokenPointer pSecurityToken = SecurityTokenPointer());
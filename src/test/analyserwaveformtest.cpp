@@ -105,4 +105,56 @@ TEST_F(AnalyzerWaveformTest, wrongTotalSamples) {
         EXPECT_FLOAT_EQ(canaryBigBuf[i], CANARY_FLOAT);
     }
 }
+
+// The maxima that are composed from the pyramid must be identical to
+// the maxima of all data points within the range.
+TEST_F(AnalyzerWaveformTest, maxima) {
+    // An amplitude that increases over time with some variation
+    // between channels and blocks.
+    for (int i = 0; i < BIGBUF_SIZE; i++) {
+        bigbuf[i] = static_cast<CSAMPLE>(((i * 7919) % 1013) / 1013.0) *
+                static_cast<CSAMPLE>(i) / BIGBUF_SIZE;
+    }
+    aw.initialize(tio, tio->getSampleRate(), BIGBUF_SIZE);
+    // Process the samples in multiple chunks for an incremental
+    // update of the pyramid.
+    const int blockSize = 2 * 4096;
+    for (int i = 0; i < BIGBUF_SIZE; i += blockSize) {
+        aw.processSamples(&bigbuf[i], blockSize);
+    }
+    aw.storeResults(tio);
+    aw.cleanup();
+
+    ConstWaveformPointer pWaveform = tio->getWaveform();
+    ASSERT_FALSE(pWaveform.isNull());
+    const int frameCount = pWaveform->getDataSize() / ChannelCount;
+    ASSERT_GT(frameCount, 0);
+    const WaveformData* data = pWaveform->data();
+
+    const int ranges[][2] = {
+            {0, 1},
+            {0, frameCount},
+            {1, frameCount - 1},
+            {3, 17},
+            {frameCount / 3, frameCount / 2 + 5},
+            {frameCount - 7, frameCount + 100},
+            {-5, 9},
+            {10, 10},
+    };
+    for (const auto& range : ranges) {
+        WaveformData maxima[ChannelCount];
+        pWaveform->getMaxima(range[0], range[1], maxima);
+        WaveformData expected[ChannelCount] = {WaveformData(0), WaveformData(0)};
+        for (int frame = std::max(range[0], 0);
+                frame < std::min(range[1], frameCount);
+                ++frame) {
+            for (int channel = 0; channel < ChannelCount; ++channel) {
+                expected[channel] = maxOfWaveformData(
+                        expected[channel], data[frame * ChannelCount + channel]);
+            }
+        }
+        EXPECT_EQ(expected[Left].m_i, maxima[Left].m_i);
+        EXPECT_EQ(expected[Right].m_i, maxima[Right].m_i);
+    }
+}
 } // namespace
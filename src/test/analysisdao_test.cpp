@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QSqlQuery>
+#include <QStringBuilder>
+#include <climits>
+
+#include "library/dao/analysisdao.h"
+#include "library/trackcollection.h"
+#include "test/librarytest.h"
+#include "track/track.h"
+#include "waveform/waveform.h"
+#include "waveform/waveformblockfile.h"
+#include "waveform/waveformfactory.h"
+
+namespace {
+
+const QString kTrackLocationTest(QDir::currentPath() %
+        "/src/test/id3-test-data/cover-test-png.mp3");
+
+class AnalysisDaoTest : public LibraryTest {
+  protected:
+    AnalysisDaoTest()
+            : m_pWaveform(new Waveform(44100, 10 * 44100 * 2, 441, -1)) {
+        WaveformData* pData = m_pWaveform->data();
+        for (int i = 0; i < m_pWaveform->getDataSize(); ++i) {
+            pData[i].filtered.low = static_cast<unsigned char>((i * 7919) % 251);
+            pData[i].filtered.mid = static_cast<unsigned char>((i / 3) % 256);
+            pData[i].filtered.high = static_cast<unsigned char>((i * 31) % 97);
+            pData[i].filtered.all = static_cast<unsigned char>(i % 256);
+        }
+        m_pWaveform->setCompletion(m_pWaveform->getDataSize());
+    }
+
+    AnalysisDao& analysisDao() {
+        return internalCollection()->getAnalysisDAO();
+    }
+
+    TrackId addTrackToCollection(const QString& trackLocation) {
+        TrackPointer pTrack = internalCollection()->getOrAddTrack(
+                TrackRef::fromFileInfo(trackLocation));
+        return pTrack ? pTrack->getId() : TrackId();
+    }
+
+    QString analysisFilePath(int analysisId) const {
+        return QDir(config()->getSettingsPath()).filePath(
+                QString("analysis/%1").arg(analysisId));
+    }
+
+    QByteArray readAnalysisFile(int analysisId) const {
+        QFile file(analysisFilePath(analysisId));
+        if (!file.open(QIODevice::ReadOnly)) {
+            return QByteArray();
+        }
+        return file.readAll();
+    }
+
+    WaveformPointer m_pWaveform;
+};
+
+// A waveform that has been stored by Mixxx 2.2 as version 5.0 in the
+// legacy protobuf format is converted into a new row with version 6.0
+// and a block file when it is loaded for the first time.
+TEST_F(AnalysisDaoTest, convertLegacyWaveform) {
+    const TrackId trackId = addTrackToCollection(kTrackLocationTest);
+    ASSERT_TRUE(trackId.isValid());
+
+    AnalysisDao::AnalysisInfo legacy;
+    legacy.trackId = trackId;
+    legacy.type = AnalysisDao::TYPE_WAVEFORM;
+    legacy.description = WAVEFORM_5_DESCRIPTION;
+    legacy.version = WAVEFORM_5_VERSION;
+    legacy.data = m_pWaveform->toByteArray();
+    ASSERT_TRUE(analysisDao().saveAnalysis(&legacy));
+    ASSERT_FALSE(WaveformBlockFile::isBlockFile(
+            readAnalysisFile(legacy.analysisId)));
+
+    QList<AnalysisDao::AnalysisInfo> analyses =
+            analysisDao().getAnalysesForTrackByType(trackId, AnalysisDao::TYPE_WAVEFORM);
+    ASSERT_EQ(2, analyses.size());
+    const AnalysisDao::AnalysisInfo& loadedLegacy = analyses[0];
+    EXPECT_EQ(legacy.analysisId, loadedLegacy.analysisId);
+    EXPECT_QSTRING_EQ(WAVEFORM_5_VERSION, loadedLegacy.version);
+    const AnalysisDao::AnalysisInfo& converted = analyses[1];
+    EXPECT_NE(legacy.analysisId, converted.analysisId);
+    EXPECT_QSTRING_EQ(WaveformFactory::currentWaveformVersion(), converted.version);
+
+    // The converted file contains the same data in the block file format
+    const QByteArray convertedData = readAnalysisFile(converted.analysisId);
+    ASSERT_TRUE(WaveformBlockFile::isBlockFile(convertedData));
+    const WaveformBlockFile blockFile(convertedData);
+    ASSERT_TRUE(blockFile.isValid());
+    Waveform waveform(blockFile, 0);
+    waveform.decodeBlocks(INT_MAX);
+    ASSERT_EQ(m_pWaveform->getDataSize(), waveform.getDataSize());
+    for (int i = 0; i < waveform.getDataSize(); ++i) {
+        ASSERT_EQ(m_pWaveform->get(i).m_i, waveform.get(i).m_i) << "data element " << i;
+    }
+
+    // The new row refers to the converted file and the legacy row is
+    // kept for older versions of Mixxx
+    QSqlQuery query(dbConnection());
+    query.prepare(QString(
+            "SELECT id, version, description, data_checksum FROM %1 "
+            "WHERE track_id=:trackId AND type=:type ORDER BY id")
+            .arg(AnalysisDao::s_analysisTableName));
+    query.bindValue(":trackId", trackId.toVariant());
+    query.bindValue(":type", AnalysisDao::TYPE_WAVEFORM);
+    ASSERT_TRUE(query.exec());
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(legacy.analysisId, query.value(0).toInt());
+    EXPECT_QSTRING_EQ(WAVEFORM_5_VERSION, query.value(1).toString());
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(converted.analysisId, query.value(0).toInt());
+    EXPECT_QSTRING_EQ(WaveformFactory::currentWaveformVersion(), query.value(1).toString());
+    EXPECT_QSTRING_EQ(WaveformFactory::currentWaveformDescription(), query.value(2).toString());
+    EXPECT_EQ(blockFile.checksum(), query.value(3).toInt());
+    EXPECT_FALSE(query.next());
+
+    // The conversion is only done once
+    analyses = analysisDao().getAnalysesForTrackByType(trackId, AnalysisDao::TYPE_WAVEFORM);
+    ASSERT_EQ(2, analyses.size());
+    EXPECT_TRUE(analyses[0].data.isEmpty());
+    EXPECT_TRUE(WaveformBlockFile::isBlockFile(analyses[1].data));
+}
+
+} // namespace
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <QByteArray>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "util/asyncfilewriter.h"
+
+namespace {
+
+class AsyncFileWriterTest : public testing::Test {
+  protected:
+    QString filePath(const QString& fileName) const {
+        return m_tempDir.filePath(fileName);
+    }
+
+    static QByteArray readFile(const QString& fileName) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return QByteArray();
+        }
+        return file.readAll();
+    }
+
+    static void write(AsyncFileWriter* pWriter, const QByteArray& data) {
+        pWriter->write(data.constData(), data.size());
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(AsyncFileWriterTest, writeAndClose) {
+    // A small buffer to write in several chunks
+    AsyncFileWriter writer(4);
+    ASSERT_TRUE(writer.open(filePath("test.bin")));
+    EXPECT_TRUE(writer.isOpen());
+
+    write(&writer, "0123");
+    write(&writer, "456789");
+    EXPECT_EQ(10, writer.pos());
+    EXPECT_EQ(10, writer.size());
+
+    writer.close();
+    EXPECT_FALSE(writer.isOpen());
+    writer.waitForPendingWrites();
+    EXPECT_EQ(QByteArray("0123456789"), readFile(filePath("test.bin")));
+    EXPECT_EQ(10, writer.stats().bytesWritten);
+    EXPECT_FALSE(writer.hasError());
+}
+
+TEST_F(AsyncFileWriterTest, rewriteHeader) {
+    AsyncFileWriter writer;
+    ASSERT_TRUE(writer.open(filePath("test.wav")));
+    write(&writer, "HEAD");
+    write(&writer, "samples");
+
+    // Like libsndfile when updating the header on close
+    writer.seek(0);
+    EXPECT_EQ(0, writer.pos());
+    write(&writer, "head");
+    EXPECT_EQ(4, writer.pos());
+    EXPECT_EQ(11, writer.size());
+    writer.seek(writer.size());
+    write(&writer, "!");
+
+    writer.waitForPendingWrites();
+    EXPECT_EQ(QByteArray("headsamples!"), readFile(filePath("test.wav")));
+    writer.close();
+}
+
+TEST_F(AsyncFileWriterTest, openNextFile) {
+    AsyncFileWriter writer;
+    ASSERT_TRUE(writer.open(filePath("first.bin")));
+    write(&writer, "first");
+    // Closes the first file in the background
+    ASSERT_TRUE(writer.open(filePath("second.bin")));
+    EXPECT_EQ(0, writer.pos());
+    EXPECT_EQ(0, writer.size());
+    write(&writer, "second");
+    writer.close();
+
+    writer.waitForPendingWrites();
+    EXPECT_EQ(QByteArray("first"), readFile(filePath("first.bin")));
+    EXPECT_EQ(QByteArray("second"), readFile(filePath("second.bin")));
+}
+
+TEST_F(AsyncFileWriterTest, openFails) {
+    AsyncFileWriter writer;
+    EXPECT_FALSE(writer.open(filePath("missing/test.bin")));
+    EXPECT_FALSE(writer.isOpen());
+    EXPECT_FALSE(writer.hasError());
+}
+
+} // namespace
@@ -142,6 +142,14 @@ TEST(BroadcastProfileTest, SetGetValues) {
     profile.setReconnectFirstDelay(reconnectFirstDelay);
     ASSERT_EQ(profile.getReconnectFirstDelay(), reconnectFirstDelay);
 
+    double networkBacklog = 2.5;
+    profile.setNetworkBacklog(networkBacklog);
+    ASSERT_EQ(profile.getNetworkBacklog(), networkBacklog);
+
+    bool dropOldestOnOverflow = true;
+    profile.setDropOldestOnOverflow(dropOldestOnOverflow);
+    ASSERT_EQ(profile.getDropOldestOnOverflow(), dropOldestOnOverflow);
+
     QString format("Ogg Vorbis");
     profile.setFormat(format);
     ASSERT_TRUE(profile.getFormat() == format);
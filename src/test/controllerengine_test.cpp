@@ -1,3 +1,5 @@
+#include <benchmark/benchmark.h>
+
 #include <QtDebug>
 #include <QThread>
 
@@ -35,6 +37,18 @@ class ControllerEngineTest : public MixxxTest {
                                         QScriptValueList());
     }
 
+    // Executes a code string like the one of a legacy timer callback
+    bool executeCode(const QString& code) {
+        return executeCode(cEngine, code);
+    }
+
+  public:
+    // Also used by the benchmarks
+    static bool executeCode(ControllerEngine* pEngine, const QString& code) {
+        return pEngine->internalExecute(QScriptValue(), code);
+    }
+
+  protected:
     ControllerEngine *cEngine;
     QScriptEngine *pScriptEngine;
 };
@@ -202,6 +216,105 @@ TEST_F(ControllerEngineTest, reset) {
     EXPECT_DOUBLE_EQ(0.0, co->get());
 }
 
+TEST_F(ControllerEngineTest, getControl) {
+    auto co = std::make_unique<ControlPotmeter>(ConfigKey("[Test]", "co"),
+                                                -10.0, 10.0);
+    EXPECT_TRUE(execute("function() { handle = engine.getControl('[Test]', 'co'); }"));
+    EXPECT_EQ(QString("[Test]"), pScriptEngine->evaluate("handle.group").toString());
+    EXPECT_EQ(QString("co"), pScriptEngine->evaluate("handle.name").toString());
+
+    EXPECT_TRUE(execute("function() { handle.set(5.0); }"));
+    EXPECT_DOUBLE_EQ(5.0, co->get());
+    co->set(-5.0);
+    EXPECT_DOUBLE_EQ(-5.0, pScriptEngine->evaluate("handle.get()").toNumber());
+    EXPECT_DOUBLE_EQ(0.25, pScriptEngine->evaluate("handle.getParameter()").toNumber());
+
+    EXPECT_TRUE(execute("function() { handle.setParameter(1.0); }"));
+    EXPECT_DOUBLE_EQ(10.0, co->get());
+    EXPECT_TRUE(execute("function() { handle.reset(); }"));
+    EXPECT_DOUBLE_EQ(0.0, co->get());
+}
+
+TEST_F(ControllerEngineTest, getControl_InvalidControl) {
+    EXPECT_TRUE(pScriptEngine->evaluate(
+            "engine.getControl('[Nothing]', 'nothing')").isUndefined());
+}
+
+TEST_F(ControllerEngineTest, getControl_IgnoresNaN) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    co->set(10.0);
+    EXPECT_TRUE(execute("function() {"
+                        "  var handle = engine.getControl('[Test]', 'co');"
+                        "  handle.set(NaN);"
+                        "  handle.setParameter(NaN); }"));
+    EXPECT_DOUBLE_EQ(10.0, co->get());
+}
+
+TEST_F(ControllerEngineTest, getControl_SharesControlWithEngine) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    EXPECT_TRUE(execute("function() {"
+                        "  engine.getControl('[Test]', 'co').set(1.0);"
+                        "  engine.setValue('[Test]', 'co',"
+                        "      engine.getControl('[Test]', 'co').get() + 1.0); }"));
+    EXPECT_DOUBLE_EQ(2.0, co->get());
+}
+
+TEST_F(ControllerEngineTest, getControl_softTakeover) {
+    auto co = std::make_unique<ControlPotmeter>(ConfigKey("[Test]", "co"),
+                                                -10.0, 10.0);
+    co->setParameter(0.0);
+    EXPECT_TRUE(execute("function() {"
+                        "  handle = engine.getControl('[Test]', 'co');"
+                        "  engine.softTakeover('[Test]', 'co', true);"
+                        "  handle.setParameter(1.0); }"));
+    // The first set after enabling is always ignored.
+    EXPECT_DOUBLE_EQ(-10.0, co->get());
+
+    // Advance time to 2x the threshold.
+    mixxx::Time::setTestElapsedTime(SoftTakeover::TestAccess::getTimeThreshold() * 2);
+
+    // Change the control internally (putting it out of sync with the
+    // ControllerEngine).
+    co->setParameter(0.5);
+
+    // Ignore the change since it occurred after the threshold and is too large.
+    EXPECT_TRUE(execute("function() { handle.set(-10.0); }"));
+    EXPECT_DOUBLE_EQ(0.0, co->get());
+}
+
+TEST_F(ControllerEngineTest, getControl_OutlivesShutdown) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    EXPECT_TRUE(execute("function() { handle = engine.getControl('[Test]', 'co'); }"));
+    QScriptValue handle = pScriptEngine->globalObject().property("handle");
+    QScriptValue set = handle.property("set");
+    // Deletes the ControlObjectScript that is referenced by the handle
+    cEngine->gracefulShutdown();
+    set.call(handle, QScriptValueList() << 1.0);
+    EXPECT_DOUBLE_EQ(0.0, co->get());
+}
+
+TEST_F(ControllerEngineTest, executeCode_Repeatedly) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    const QString code =
+            "engine.setValue('[Test]', 'co', engine.getValue('[Test]', 'co') + 1);";
+    // The result is not a function
+    EXPECT_FALSE(executeCode(code));
+    // The compiled code is reused
+    EXPECT_FALSE(executeCode(code));
+    EXPECT_DOUBLE_EQ(2.0, co->get());
+}
+
+TEST_F(ControllerEngineTest, executeCode_Function) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    EXPECT_TRUE(executeCode("(function () { engine.setValue('[Test]', 'co', 3.0); })"));
+    EXPECT_DOUBLE_EQ(3.0, co->get());
+}
+
+TEST_F(ControllerEngineTest, executeCode_SyntaxError) {
+    EXPECT_FALSE(executeCode("engine.setValue('[Test]', 'co', "));
+    EXPECT_FALSE(executeCode("engine.setValue('[Test]', 'co', "));
+}
+
 TEST_F(ControllerEngineTest, log) {
     EXPECT_TRUE(execute("function() { engine.log('Test that logging works.'); }"));
 }
@@ -639,3 +752,162 @@ TEST_F(ControllerEngineTest, colorProxy) {
         EXPECT_EQ(jsColor2.property("id").toInt32(), color->m_iId);
     }
 }
+
+namespace {
+
+// Compares the access to controls by group and name with control handles
+// in the byte array callback of a controller, e.g. a HID jog wheel that
+// updates several controls per report.
+const int kControlAccessesPerCallback = 100;
+
+void runControlAccessBenchmark(benchmark::State& state,
+                               const QString& setupCode,
+                               const QString& callbackCode) {
+    ControlPotmeter co(ConfigKey("[Test]", "co"), -10.0, 10.0);
+    ControllerEngine engine(nullptr);
+    engine.setPopups(false);
+    // Runs once like the init function of a controller script
+    engine.execute(engine.wrapFunctionCode(
+                           QString("function (data, length) { %1 }").arg(setupCode), 2),
+            QByteArray(), mixxx::Duration());
+    QScriptValue callback = engine.wrapFunctionCode(
+            QString("function (data, length) {"
+                    "  for (var i = 0; i < %1; ++i) { %2 }"
+                    "}").arg(QString::number(kControlAccessesPerCallback), callbackCode),
+            2);
+    const QByteArray report(64, '\0');
+    while (state.KeepRunning()) {
+        engine.execute(callback, report, mixxx::Duration());
+    }
+    state.SetItemsProcessed(state.iterations() * kControlAccessesPerCallback);
+    engine.gracefulShutdown();
+}
+
+void BM_ControllerEngine_GetSetValue(benchmark::State& state) {
+    runControlAccessBenchmark(state, "",
+            "engine.setValue('[Test]', 'co', engine.getValue('[Test]', 'co') + 0.001);");
+}
+BENCHMARK(BM_ControllerEngine_GetSetValue);
+
+void BM_ControllerEngine_ControlHandleGetSet(benchmark::State& state) {
+    runControlAccessBenchmark(state, "co = engine.getControl('[Test]', 'co');",
+            "co.set(co.get() + 0.001);");
+}
+BENCHMARK(BM_ControllerEngine_ControlHandleGetSet);
+
+void BM_ControllerEngine_GetSetParameter(benchmark::State& state) {
+    runControlAccessBenchmark(state, "",
+            "engine.setParameter('[Test]', 'co', 1.0 - engine.getParameter('[Test]', 'co'));");
+}
+BENCHMARK(BM_ControllerEngine_GetSetParameter);
+
+void BM_ControllerEngine_ControlHandleGetSetParameter(benchmark::State& state) {
+    runControlAccessBenchmark(state, "co = engine.getControl('[Test]', 'co');",
+            "co.setParameter(1.0 - co.getParameter());");
+}
+BENCHMARK(BM_ControllerEngine_ControlHandleGetSetParameter);
+
+// Benchmarks for the callbacks that are invoked for every message of a
+// controller. The script is evaluated once like a mapping script file.
+class CallbackBenchmarkEngine {
+  public:
+    explicit CallbackBenchmarkEngine(const QString& script)
+            : m_co(ConfigKey("[Test]", "co"), -10.0, 10.0),
+              m_engine(nullptr) {
+        m_engine.setPopups(false);
+        m_engine.execute(m_engine.wrapFunctionCode(
+                                 QString("function () { %1 }").arg(script), 0),
+                QByteArray(), mixxx::Duration());
+    }
+
+    ~CallbackBenchmarkEngine() {
+        m_engine.gracefulShutdown();
+    }
+
+    ControllerEngine* engine() {
+        return &m_engine;
+    }
+
+  private:
+    ControlPotmeter m_co;
+    ControllerEngine m_engine;
+};
+
+// A MIDI input mapping with a script function, e.g. a jog wheel
+void BM_ControllerEngine_MidiCallback(benchmark::State& state) {
+    CallbackBenchmarkEngine engine(
+            "MyController = {};"
+            "MyController.jog = function (channel, control, value, status, group) {"
+            "  var delta = value - 0x40;"
+            "  engine.setValue(group, 'co', engine.getValue(group, 'co') + delta / 64);"
+            "};");
+    QScriptValue callback = engine.engine()->wrapFunctionCode("MyController.jog", 5);
+    unsigned char value = 0;
+    while (state.KeepRunning()) {
+        engine.engine()->execute(callback, 0, 0x10, 0x3F + (value++ & 0x01), 0xB0,
+                "[Test]", mixxx::Duration());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ControllerEngine_MidiCallback);
+
+// The incomingData function of a HID mapping that parses a report
+void BM_ControllerEngine_HidReportCallback(benchmark::State& state) {
+    CallbackBenchmarkEngine engine(
+            "MyController = { last: [] };"
+            "MyController.incomingData = function (data, length) {"
+            "  for (var i = 0; i < length; ++i) {"
+            "    if (data[i] !== this.last[i]) {"
+            "      this.last[i] = data[i];"
+            "      engine.setValue('[Test]', 'co', data[i] / 25.5);"
+            "    }"
+            "  }"
+            "};");
+    QScriptValue callback = engine.engine()->wrapFunctionCode(
+            "MyController.incomingData", 2);
+    QByteArray report(state.range_x(), '\0');
+    int count = 0;
+    while (state.KeepRunning()) {
+        // A few bytes change from report to report
+        report[count % report.size()] = static_cast<char>(count & 0xFF);
+        ++count;
+        engine.engine()->execute(callback, report, mixxx::Duration());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * report.size());
+}
+BENCHMARK(BM_ControllerEngine_HidReportCallback)->Arg(16)->Arg(64);
+
+// A connection that updates an LED when a control changes
+void BM_ControllerEngine_ConnectionCallback(benchmark::State& state) {
+    CallbackBenchmarkEngine engine(
+            "MyController = { led: 0 };"
+            "MyController.connection = engine.makeConnection('[Test]', 'co',"
+            "  function (value, group, control) {"
+            "    MyController.led = value > 0 ? 0x7F : 0x00;"
+            "  });");
+    QScriptValue callback = engine.engine()->wrapFunctionCode(
+            "function () { MyController.connection.trigger(); }", 0);
+    while (state.KeepRunning()) {
+        engine.engine()->execute(callback, QByteArray(), mixxx::Duration());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ControllerEngine_ConnectionCallback);
+
+// A timer with a code string instead of a function, which is still common
+// in older mappings
+void BM_ControllerEngine_TimerCodeCallback(benchmark::State& state) {
+    CallbackBenchmarkEngine engine(
+            "MyController = { blink: false };"
+            "MyController.toggleBlink = function () {"
+            "  MyController.blink = !MyController.blink;"
+            "};");
+    while (state.KeepRunning()) {
+        ControllerEngineTest::executeCode(engine.engine(), "MyController.toggleBlink()");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ControllerEngine_TimerCodeCallback);
+
+} // namespace
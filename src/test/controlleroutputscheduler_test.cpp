@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <QVector>
+
+#include "controllers/controlleroutputscheduler.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+class ControllerOutputSchedulerTest : public MixxxTest {
+  protected:
+    ControllerOutputSchedulerTest()
+            : m_scheduler([this](const ControllerOutputScheduler::Batch& batch) {
+                  m_batches.append(batch);
+              }) {
+    }
+
+    // Runs the event loop until all scheduled messages have been written
+    void processOutput() {
+        for (int i = 0; i < 1000 && m_scheduler.pendingMessages() > 0; ++i) {
+            application()->processEvents();
+        }
+    }
+
+    static QByteArray message(char value) {
+        return QByteArray(1, value);
+    }
+
+    ControllerOutputScheduler m_scheduler;
+    QVector<ControllerOutputScheduler::Batch> m_batches;
+};
+
+TEST_F(ControllerOutputSchedulerTest, lastValueWins) {
+    m_scheduler.schedule(1, message(1));
+    m_scheduler.schedule(2, message(2));
+    m_scheduler.schedule(1, message(3));
+    EXPECT_EQ(2, m_scheduler.pendingMessages());
+    m_scheduler.flushAll();
+
+    ASSERT_EQ(1, m_batches.size());
+    ASSERT_EQ(2, m_batches[0].size());
+    // The replaced message moves to the end
+    EXPECT_EQ(2, m_batches[0][0].key);
+    EXPECT_EQ(message(2), m_batches[0][0].data);
+    EXPECT_EQ(1, m_batches[0][1].key);
+    EXPECT_EQ(message(3), m_batches[0][1].data);
+    EXPECT_EQ(2, m_scheduler.stats().sent);
+    EXPECT_EQ(1, m_scheduler.stats().coalesced);
+}
+
+TEST_F(ControllerOutputSchedulerTest, replacedMessageFollowsLaterMessages) {
+    // An LED update, a SysEx message that switches the mode of the
+    // device and another update of the LED, which must be written after
+    // the mode has been switched
+    m_scheduler.schedule(1, message(1));
+    m_scheduler.schedule(ControllerOutputScheduler::kNoCoalescing, message(2));
+    m_scheduler.schedule(1, message(3));
+    EXPECT_EQ(2, m_scheduler.pendingMessages());
+    m_scheduler.flushAll();
+
+    ASSERT_EQ(1, m_batches.size());
+    ASSERT_EQ(2, m_batches[0].size());
+    EXPECT_EQ(message(2), m_batches[0][0].data);
+    EXPECT_EQ(message(3), m_batches[0][1].data);
+}
+
+TEST_F(ControllerOutputSchedulerTest, replacingDoesNotGrowQueue) {
+    for (int i = 0; i < 3 * ControllerOutputScheduler::kMaxPendingMessages; ++i) {
+        m_scheduler.schedule(1, message(static_cast<char>(i % 128)));
+        m_scheduler.schedule(2, message(static_cast<char>(i % 128)));
+    }
+    EXPECT_EQ(2, m_scheduler.pendingMessages());
+    EXPECT_EQ(0, m_scheduler.stats().dropped);
+    m_scheduler.flushAll();
+
+    ASSERT_EQ(1, m_batches.size());
+    ASSERT_EQ(2, m_batches[0].size());
+    EXPECT_EQ(1, m_batches[0][0].key);
+    EXPECT_EQ(2, m_batches[0][1].key);
+}
+
+TEST_F(ControllerOutputSchedulerTest, noCoalescing) {
+    m_scheduler.schedule(ControllerOutputScheduler::kNoCoalescing, message(1));
+    m_scheduler.schedule(ControllerOutputScheduler::kNoCoalescing, message(2));
+    m_scheduler.flushAll();
+
+    ASSERT_EQ(1, m_batches.size());
+    ASSERT_EQ(2, m_batches[0].size());
+    EXPECT_EQ(message(1), m_batches[0][0].data);
+    EXPECT_EQ(message(2), m_batches[0][1].data);
+    EXPECT_EQ(0, m_scheduler.stats().coalesced);
+}
+
+TEST_F(ControllerOutputSchedulerTest, writtenByEventLoop) {
+    m_scheduler.schedule(1, message(1));
+    EXPECT_TRUE(m_batches.isEmpty());
+    processOutput();
+    ASSERT_EQ(1, m_batches.size());
+    EXPECT_EQ(message(1), m_batches[0][0].data);
+}
+
+TEST_F(ControllerOutputSchedulerTest, rateLimit) {
+    m_scheduler.setFlushInterval(0);
+    m_scheduler.setMaxMessagesPerBatch(2);
+    for (char i = 0; i < 5; ++i) {
+        m_scheduler.schedule(i, message(i));
+    }
+    processOutput();
+
+    ASSERT_EQ(3, m_batches.size());
+    EXPECT_EQ(2, m_batches[0].size());
+    EXPECT_EQ(2, m_batches[1].size());
+    EXPECT_EQ(1, m_batches[2].size());
+    EXPECT_EQ(message(4), m_batches[2][0].data);
+    EXPECT_EQ(3, m_scheduler.stats().batches);
+}
+
+TEST_F(ControllerOutputSchedulerTest, coalescingAfterPartialBatch) {
+    // Only the first message is written without delay
+    m_scheduler.setFlushInterval(1000);
+    m_scheduler.setMaxMessagesPerBatch(1);
+    m_scheduler.schedule(1, message(1));
+    m_scheduler.schedule(2, message(2));
+    m_scheduler.schedule(3, message(3));
+    application()->processEvents();
+    ASSERT_EQ(1, m_batches.size());
+
+    // The pending messages are still found by their key
+    m_scheduler.schedule(3, message(4));
+    EXPECT_EQ(2, m_scheduler.pendingMessages());
+    m_scheduler.flushAll();
+    ASSERT_EQ(2, m_batches.size());
+    ASSERT_EQ(2, m_batches[1].size());
+    EXPECT_EQ(message(2), m_batches[1][0].data);
+    EXPECT_EQ(message(4), m_batches[1][1].data);
+}
+
+TEST_F(ControllerOutputSchedulerTest, dropsWhenFull) {
+    for (int i = 0; i < ControllerOutputScheduler::kMaxPendingMessages + 10; ++i) {
+        m_scheduler.schedule(ControllerOutputScheduler::kNoCoalescing, message(0));
+    }
+    EXPECT_EQ(ControllerOutputScheduler::kMaxPendingMessages,
+            m_scheduler.pendingMessages());
+    EXPECT_EQ(10, m_scheduler.stats().dropped);
+    m_scheduler.flushAll();
+    EXPECT_EQ(ControllerOutputScheduler::kMaxPendingMessages,
+            m_scheduler.stats().sent);
+}
+
+} // namespace
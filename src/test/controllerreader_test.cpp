@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QList>
+#include <QMutex>
+#include <QQueue>
+#include <QWaitCondition>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "controllers/controllerreader.h"
+#include "util/math.h"
+#include "util/time.h"
+
+namespace {
+
+// A virtual loopback device. The packets that are written by the test
+// are read by the reader thread as if they were sent by a controller.
+// The output that is written by the reader thread is recorded.
+class LoopbackReader : public ControllerReader {
+  public:
+    LoopbackReader()
+            : ControllerReader(true),
+              m_readCount(0),
+              m_accessCount(0),
+              m_concurrentAccessCount(0) {
+    }
+
+    void sendInput(const QByteArray& packet) {
+        QMutexLocker locker(&m_mutex);
+        m_packets.enqueue(packet);
+        m_dataAvailable.wakeOne();
+    }
+
+    // Waits until the given number of packets has been written
+    bool waitForOutput(int count) {
+        QMutexLocker locker(&m_outputMutex);
+        while (m_output.size() < count) {
+            if (!m_outputWritten.wait(&m_outputMutex, 5000)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    QList<QByteArray> output() {
+        QMutexLocker locker(&m_outputMutex);
+        return m_output;
+    }
+
+    QList<QThread*> outputThreads() {
+        QMutexLocker locker(&m_outputMutex);
+        return m_outputThreads;
+    }
+
+    int readCount() const {
+        return m_readCount.load();
+    }
+
+    // The number of reads and writes that have overlapped
+    int concurrentAccessCount() const {
+        return m_concurrentAccessCount.load();
+    }
+
+  protected:
+    int read(unsigned char* pData, int maxSize, int timeoutMillis) override {
+        const DeviceAccess access(this);
+        m_readCount.fetchAndAddRelaxed(1);
+        QMutexLocker locker(&m_mutex);
+        if (m_packets.isEmpty()) {
+            m_dataAvailable.wait(&m_mutex, timeoutMillis);
+        }
+        if (m_packets.isEmpty()) {
+            return 0;
+        }
+        const QByteArray packet = m_packets.dequeue();
+        const int size = math_min(packet.size(), maxSize);
+        std::memcpy(pData, packet.constData(), size);
+        return size;
+    }
+
+    void write(const QByteArray& packet) override {
+        const DeviceAccess access(this);
+        QMutexLocker locker(&m_outputMutex);
+        m_output.append(packet);
+        m_outputThreads.append(QThread::currentThread());
+        m_outputWritten.wakeAll();
+    }
+
+  private:
+    // Detects concurrent access like a device API that is not
+    // thread-safe
+    class DeviceAccess {
+      public:
+        explicit DeviceAccess(LoopbackReader* pReader)
+                : m_pReader(pReader) {
+            if (m_pReader->m_accessCount.fetchAndAddOrdered(1) != 0) {
+                m_pReader->m_concurrentAccessCount.fetchAndAddOrdered(1);
+            }
+        }
+        ~DeviceAccess() {
+            m_pReader->m_accessCount.fetchAndAddOrdered(-1);
+        }
+
+      private:
+        LoopbackReader* const m_pReader;
+    };
+
+    QMutex m_mutex;
+    QWaitCondition m_dataAvailable;
+    QQueue<QByteArray> m_packets;
+
+    QMutex m_outputMutex;
+    QWaitCondition m_outputWritten;
+    QList<QByteArray> m_output;
+    QList<QThread*> m_outputThreads;
+
+    QAtomicInt m_readCount;
+    QAtomicInt m_accessCount;
+    QAtomicInt m_concurrentAccessCount;
+};
+
+class FailingReader : public ControllerReader {
+  protected:
+    int read(unsigned char*, int, int) override {
+        return -1;
+    }
+};
+
+class ControllerReaderTest : public testing::Test {
+  protected:
+    struct Packet {
+        QByteArray data;
+        mixxx::Duration timestamp;
+        mixxx::Duration receiveTime;
+    };
+
+    ControllerReaderTest() {
+        qRegisterMetaType<mixxx::Duration>("mixxx::Duration");
+        // Delivered to the test thread like to the controller thread
+        QObject::connect(&m_reader, &ControllerReader::incomingData, &m_receiver,
+                [this](QByteArray data, mixxx::Duration timestamp) {
+                    m_packets.push_back(Packet{data, timestamp, mixxx::Time::elapsed()});
+                });
+        m_reader.setObjectName("LoopbackReader");
+        m_reader.start(QThread::HighPriority);
+    }
+
+    ~ControllerReaderTest() override {
+        m_reader.stop();
+        m_reader.wait();
+    }
+
+    // Processes the events of the test thread until the given number of
+    // packets has been received
+    bool waitForPackets(int count) {
+        PerformanceTimer timer;
+        timer.start();
+        while (static_cast<int>(m_packets.size()) < count) {
+            if (timer.elapsed() > mixxx::Duration::fromSeconds(5)) {
+                return false;
+            }
+            QCoreApplication::processEvents();
+        }
+        return true;
+    }
+
+    LoopbackReader m_reader;
+    QObject m_receiver;
+    std::vector<Packet> m_packets;
+};
+
+TEST_F(ControllerReaderTest, deliversTimestampedPacketsInOrder) {
+    const mixxx::Duration writeTime = mixxx::Time::elapsed();
+    m_reader.sendInput(QByteArray("\x90\x3C\x7F"));
+    m_reader.sendInput(QByteArray("\x80\x3C\x00", 3));
+    m_reader.sendInput(QByteArray("\xB0\x10\x41"));
+    ASSERT_TRUE(waitForPackets(3));
+
+    EXPECT_EQ(QByteArray("\x90\x3C\x7F"), m_packets[0].data);
+    EXPECT_EQ(QByteArray("\x80\x3C\x00", 3), m_packets[1].data);
+    EXPECT_EQ(QByteArray("\xB0\x10\x41"), m_packets[2].data);
+    for (const Packet& packet : m_packets) {
+        EXPECT_GE(packet.timestamp, writeTime);
+        EXPECT_LE(packet.timestamp, packet.receiveTime);
+    }
+    EXPECT_LE(m_packets[0].timestamp, m_packets[1].timestamp);
+    EXPECT_LE(m_packets[1].timestamp, m_packets[2].timestamp);
+}
+
+// Measures the time from sending a message on the loopback device until it
+// is received by the thread that processes the input
+TEST_F(ControllerReaderTest, latency) {
+    const int kMessages = 200;
+    std::vector<mixxx::Duration> latencies;
+    for (int i = 0; i < kMessages; ++i) {
+        const mixxx::Duration writeTime = mixxx::Time::elapsed();
+        m_reader.sendInput(QByteArray(1, static_cast<char>(i % 128)));
+        ASSERT_TRUE(waitForPackets(i + 1));
+        latencies.push_back(m_packets.back().receiveTime - writeTime);
+        // Let the reader go back to sleep like between the messages of a
+        // jog wheel
+        QThread::usleep(1000);
+    }
+    std::sort(latencies.begin(), latencies.end());
+    // The reader is woken up by the input instead of polling for it
+    EXPECT_LT(latencies[kMessages / 2], mixxx::Duration::fromMillis(2));
+}
+
+// Output that is queued in response to input is written before the
+// pending read times out
+TEST_F(ControllerReaderTest, outputLatencyWhileActive) {
+    const int kMessages = 20;
+    std::vector<mixxx::Duration> latencies;
+    for (int i = 0; i < kMessages; ++i) {
+        m_reader.sendInput(QByteArray(1, static_cast<char>(i)));
+        ASSERT_TRUE(waitForPackets(i + 1));
+        const mixxx::Duration queueTime = mixxx::Time::elapsed();
+        m_reader.queueOutput(QList<QByteArray>{QByteArray(1, static_cast<char>(i))});
+        ASSERT_TRUE(m_reader.waitForOutput(i + 1));
+        latencies.push_back(mixxx::Time::elapsed() - queueTime);
+    }
+    std::sort(latencies.begin(), latencies.end());
+    EXPECT_LT(latencies[kMessages / 2],
+            mixxx::Duration::fromMillis(ControllerReader::kReadTimeoutMillis / 2));
+}
+
+TEST_F(ControllerReaderTest, idleReaderSleeps) {
+    const int readCountBefore = m_reader.readCount();
+    QThread::msleep(5 * ControllerReader::kReadTimeoutMillis);
+    // Only woken up by the timeouts
+    EXPECT_LE(m_reader.readCount() - readCountBefore, 5 + 1);
+}
+
+TEST_F(ControllerReaderTest, writesOutputInReaderThread) {
+    const int kPackets = 100;
+    for (int i = 0; i < kPackets; ++i) {
+        // Input and output interleave like while a controller is used
+        m_reader.sendInput(QByteArray(1, static_cast<char>(i)));
+        m_reader.queueOutput(QList<QByteArray>{
+                QByteArray(1, static_cast<char>(i)),
+                QByteArray(1, static_cast<char>(i + kPackets))});
+    }
+    ASSERT_TRUE(waitForPackets(kPackets));
+    ASSERT_TRUE(m_reader.waitForOutput(2 * kPackets));
+
+    const QList<QByteArray> output = m_reader.output();
+    ASSERT_EQ(2 * kPackets, output.size());
+    for (int i = 0; i < kPackets; ++i) {
+        EXPECT_EQ(QByteArray(1, static_cast<char>(i)), output[2 * i]);
+        EXPECT_EQ(QByteArray(1, static_cast<char>(i + kPackets)), output[2 * i + 1]);
+    }
+    for (QThread* pThread : m_reader.outputThreads()) {
+        EXPECT_EQ(&m_reader, pThread);
+    }
+    EXPECT_EQ(0, m_reader.concurrentAccessCount());
+}
+
+TEST_F(ControllerReaderTest, writesQueuedOutputBeforeStopping) {
+    m_reader.queueOutput(QList<QByteArray>{QByteArray("\xF0\x7E\xF7")});
+    m_reader.stop();
+    ASSERT_TRUE(m_reader.wait(5000));
+    EXPECT_EQ(QList<QByteArray>{QByteArray("\xF0\x7E\xF7")}, m_reader.output());
+}
+
+TEST(ControllerReaderFailureTest, failingDeviceStopsReader) {
+    FailingReader reader;
+    reader.start();
+    EXPECT_TRUE(reader.wait(5000));
+}
+
+} // namespace
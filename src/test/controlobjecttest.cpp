@@ -2,6 +2,8 @@
 #include <QtDebug>
 
 #include "control/controlobject.h"
+#include "control/controlproxy.h"
+#include "control/controlupdatecoalescer.h"
 #include "util/memory.h"
 #include "test/mixxxtest.h"
 
@@ -84,4 +86,86 @@ TEST_F(ControlObjectTest, Persistence_ValidValue) {
     EXPECT_DOUBLE_EQ(5.0, co.get());
 }
 
+TEST_F(ControlObjectTest, CoalescedUpdates) {
+    ControlUpdateCoalescer::setEnabled(true);
+    QObject receiver;
+    ControlProxy proxy(ck1);
+    QList<double> values;
+    EXPECT_TRUE(proxy.connectValueChangedCoalesced(
+            &receiver, [&values](double value) { values.append(value); }));
+    ControlUpdateCoalescer::setEnabled(false);
+
+    const quint64 savedEvents = ControlUpdateCoalescer::savedEventCount();
+    co1->set(1.0);
+    co1->set(2.0);
+    co1->set(3.0);
+    application()->processEvents();
+    EXPECT_TRUE(values.isEmpty());
+
+    // Only the latest value is delivered once
+    EXPECT_EQ(1, ControlUpdateCoalescer::drain());
+    ASSERT_EQ(1, values.size());
+    EXPECT_DOUBLE_EQ(3.0, values.first());
+    EXPECT_EQ(savedEvents + 2, ControlUpdateCoalescer::savedEventCount());
+
+    // Nothing changed since the last frame
+    EXPECT_EQ(0, ControlUpdateCoalescer::drain());
+    EXPECT_EQ(1, values.size());
+
+    // Changes of other controls are not delivered
+    co2->set(4.0);
+    EXPECT_EQ(0, ControlUpdateCoalescer::drain());
+    EXPECT_EQ(1, values.size());
+}
+
+TEST_F(ControlObjectTest, CoalescedUpdatesAreNotEchoed) {
+    ControlUpdateCoalescer::setEnabled(true);
+    QObject receiver;
+    ControlProxy proxy(ck1);
+    QList<double> values;
+    EXPECT_TRUE(proxy.connectValueChangedCoalesced(
+            &receiver, [&values](double value) { values.append(value); }));
+    ControlProxy otherProxy(ck1);
+    QList<double> otherValues;
+    EXPECT_TRUE(otherProxy.connectValueChangedCoalesced(
+            &receiver, [&otherValues](double value) { otherValues.append(value); }));
+    ControlUpdateCoalescer::setEnabled(false);
+
+    // The setter does not receive its own change
+    proxy.set(1.0);
+    ControlUpdateCoalescer::drain();
+    EXPECT_TRUE(values.isEmpty());
+    ASSERT_EQ(1, otherValues.size());
+    EXPECT_DOUBLE_EQ(1.0, otherValues.last());
+
+    // Unless the value has been changed by someone else afterwards
+    proxy.set(2.0);
+    co1->set(3.0);
+    ControlUpdateCoalescer::drain();
+    ASSERT_EQ(1, values.size());
+    EXPECT_DOUBLE_EQ(3.0, values.last());
+    ASSERT_EQ(2, otherValues.size());
+    EXPECT_DOUBLE_EQ(3.0, otherValues.last());
+}
+
+TEST_F(ControlObjectTest, CoalescedUpdatesFollowKey) {
+    ControlUpdateCoalescer::setEnabled(true);
+    QObject receiver;
+    ControlProxy proxy(ck1);
+    QList<double> values;
+    EXPECT_TRUE(proxy.connectValueChangedCoalesced(
+            &receiver, [&values](double value) { values.append(value); }));
+    proxy.initialize(ck2);
+    ControlUpdateCoalescer::setEnabled(false);
+
+    co1->set(1.0);
+    ControlUpdateCoalescer::drain();
+    EXPECT_TRUE(values.isEmpty());
+
+    co2->set(2.0);
+    ControlUpdateCoalescer::drain();
+    ASSERT_EQ(1, values.size());
+    EXPECT_DOUBLE_EQ(2.0, values.first());
+}
+
 }
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <QFileInfo>
+#include <QTemporaryDir>
 
 #include "library/coverartcache.h"
 #include "library/coverartutils.h"
@@ -76,3 +77,159 @@ TEST_F(CoverArtCacheTest, loadCover) {
     loadCoverFromFile(kTrackLocationTest, kCoverFileTest, kCoverLocationTest); //relative
     loadCoverFromFile(QString(), kCoverLocationTest, kCoverLocationTest); //absolute
 }
+
+TEST_F(CoverArtCacheTest, thumbnailCacheRoundtrip) {
+    QTemporaryDir cacheDir;
+    ASSERT_TRUE(cacheDir.isValid());
+
+    CoverInfo info;
+    info.type = CoverInfo::FILE;
+    info.source = CoverInfo::GUESSED;
+    info.coverLocation = kCoverFileTest;
+    info.trackLocation = kTrackLocationTest;
+    info.hash = 4321; // fake cover hash
+
+    const int width = 50;
+    const int thumbnailWidth = CoverArtThumbnailCache::thumbnailWidthFor(width);
+    EXPECT_EQ(64, thumbnailWidth);
+    {
+        CoverArtThumbnailCache thumbnailCache(cacheDir.path());
+        EXPECT_TRUE(thumbnailCache.thumbnailWidths().isEmpty());
+        EXPECT_TRUE(thumbnailCache.loadThumbnail(info, width).isNull());
+
+        const QImage thumbnail = thumbnailCache.createThumbnail(
+                info, width, QImage(kCoverLocationTest));
+        ASSERT_FALSE(thumbnail.isNull());
+        EXPECT_EQ(width, thumbnail.width());
+        EXPECT_EQ(thumbnail.size(),
+                thumbnailCache.loadThumbnail(info, width).size());
+        // Other widths are served from the same thumbnail
+        EXPECT_EQ(60, thumbnailCache.loadThumbnail(info, 60).width());
+        EXPECT_GT(thumbnailCache.cacheBytes(), 0);
+    }
+
+    // A new instance picks up the width of the stored thumbnail
+    // and prewarms covers with a different hash
+    CoverArtThumbnailCache thumbnailCache(cacheDir.path());
+    EXPECT_EQ(QList<int>{thumbnailWidth}, thumbnailCache.thumbnailWidths());
+    CoverInfo otherInfo = info;
+    otherInfo.hash = 1234; // fake cover hash
+    EXPECT_TRUE(thumbnailCache.loadThumbnail(otherInfo, width).isNull());
+    thumbnailCache.prewarm(otherInfo);
+    EXPECT_FALSE(thumbnailCache.loadThumbnail(otherInfo, width).isNull());
+}
+
+TEST_F(CoverArtCacheTest, thumbnailCachePrewarmsConfiguredWidths) {
+    QTemporaryDir cacheDir;
+    ASSERT_TRUE(cacheDir.isValid());
+
+    CoverInfo info;
+    info.type = CoverInfo::FILE;
+    info.source = CoverInfo::GUESSED;
+    info.coverLocation = kCoverFileTest;
+    info.trackLocation = kTrackLocationTest;
+    info.hash = 4321; // fake cover hash
+
+    // No thumbnails have been stored yet
+    CoverArtThumbnailCache thumbnailCache(cacheDir.path(), config());
+    EXPECT_EQ(QList<int>{128}, thumbnailCache.thumbnailWidths());
+    thumbnailCache.prewarm(info);
+    EXPECT_FALSE(thumbnailCache.loadThumbnail(info, 128).isNull());
+
+    // Requested widths are stored in the configuration
+    thumbnailCache.createThumbnail(info, 50, QImage(kCoverLocationTest));
+    EXPECT_EQ((QList<int>{64, 128}), thumbnailCache.thumbnailWidths());
+    EXPECT_QSTRING_EQ("64,128", config()->getValueString(
+            ConfigKey("[Library]", "CoverArtThumbnailWidths")));
+}
+
+TEST_F(CoverArtCacheTest, thumbnailCacheReplacesThumbnail) {
+    QTemporaryDir cacheDir;
+    ASSERT_TRUE(cacheDir.isValid());
+
+    CoverInfo info;
+    info.type = CoverInfo::FILE;
+    info.source = CoverInfo::GUESSED;
+    info.coverLocation = kCoverFileTest;
+    info.trackLocation = kTrackLocationTest;
+    info.hash = 4321; // fake cover hash
+    const QImage cover(kCoverLocationTest);
+
+    CoverArtThumbnailCache thumbnailCache(cacheDir.path());
+    thumbnailCache.createThumbnail(info, 64, cover);
+    const qint64 thumbnailBytes = thumbnailCache.cacheBytes();
+    ASSERT_GT(thumbnailBytes, 0);
+    // Overwriting the thumbnail does not count its size twice
+    thumbnailCache.createThumbnail(info, 64, cover);
+    EXPECT_EQ(thumbnailBytes, thumbnailCache.cacheBytes());
+}
+
+TEST_F(CoverArtCacheTest, thumbnailCacheIgnoresUnsupportedWidths) {
+    QTemporaryDir cacheDir;
+    ASSERT_TRUE(cacheDir.isValid());
+    ASSERT_TRUE(QDir(cacheDir.path()).mkpath("57"));
+
+    CoverArtThumbnailCache thumbnailCache(cacheDir.path());
+    EXPECT_TRUE(thumbnailCache.thumbnailWidths().isEmpty());
+    EXPECT_FALSE(QDir(cacheDir.path()).exists("57"));
+    // Too large to be stored
+    EXPECT_EQ(0, CoverArtThumbnailCache::thumbnailWidthFor(1000));
+}
+
+TEST_F(CoverArtCacheTest, thumbnailCacheDetectsReplacedCover) {
+    QTemporaryDir cacheDir;
+    ASSERT_TRUE(cacheDir.isValid());
+    QTemporaryDir coverDir;
+    ASSERT_TRUE(coverDir.isValid());
+    const QString coverLocation = coverDir.filePath("cover.png");
+    QImage cover(QImage(kCoverLocationTest));
+    ASSERT_TRUE(cover.save(coverLocation));
+
+    CoverInfo info;
+    info.type = CoverInfo::FILE;
+    info.source = CoverInfo::GUESSED;
+    info.coverLocation = coverLocation;
+    info.hash = 4321; // fake cover hash, not updated when replaced
+
+    CoverArtThumbnailCache thumbnailCache(cacheDir.path());
+    thumbnailCache.createThumbnail(info, 64, cover);
+    EXPECT_FALSE(thumbnailCache.loadThumbnail(info, 64).isNull());
+
+    // Replace the cover with an image of a different size
+    ASSERT_TRUE(cover.scaledToWidth(cover.width() / 2).save(coverLocation));
+    EXPECT_TRUE(thumbnailCache.loadThumbnail(info, 64).isNull());
+}
+
+TEST_F(CoverArtCacheTest, thumbnailCacheEvictsWhenFull) {
+    QTemporaryDir cacheDir;
+    ASSERT_TRUE(cacheDir.isValid());
+
+    CoverInfo info;
+    info.type = CoverInfo::FILE;
+    info.source = CoverInfo::GUESSED;
+    info.coverLocation = kCoverFileTest;
+    info.trackLocation = kTrackLocationTest;
+    info.hash = 4321; // fake cover hash
+    const QImage cover(kCoverLocationTest);
+
+    qint64 thumbnailBytes;
+    {
+        CoverArtThumbnailCache thumbnailCache(cacheDir.path());
+        thumbnailCache.createThumbnail(info, 256, cover);
+        thumbnailBytes = thumbnailCache.cacheBytes();
+        ASSERT_GT(thumbnailBytes, 0);
+    }
+
+    // Only a single thumbnail fits into the cache
+    CoverArtThumbnailCache thumbnailCache(
+            cacheDir.path(), UserSettingsPointer(), thumbnailBytes * 4 / 3);
+    EXPECT_EQ(thumbnailBytes, thumbnailCache.cacheBytes());
+    CoverInfo otherInfo = info;
+    otherInfo.hash = 1234; // fake cover hash
+    thumbnailCache.createThumbnail(otherInfo, 256, cover);
+    EXPECT_LE(thumbnailCache.cacheBytes(), thumbnailBytes * 4 / 3);
+    const int remaining =
+            (thumbnailCache.loadThumbnail(info, 256).isNull() ? 0 : 1) +
+            (thumbnailCache.loadThumbnail(otherInfo, 256).isNull() ? 0 : 1);
+    EXPECT_EQ(1, remaining);
+}
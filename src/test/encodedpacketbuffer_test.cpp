@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <QByteArray>
+
+#include "engine/sidechain/encodedpacketbuffer.h"
+
+namespace {
+
+// Stands in for the connection to a streaming server
+class TestServer {
+  public:
+    TestServer()
+            : m_failing(false) {
+    }
+
+    EncodedPacketBuffer::Sender sender() {
+        return [this](const QByteArray& packet) {
+            if (m_failing) {
+                return false;
+            }
+            m_received.append(packet);
+            return true;
+        };
+    }
+
+    bool m_failing;
+    QByteArray m_received;
+};
+
+class EncodedPacketBufferTest : public testing::Test {
+  protected:
+    static QByteArray packet(char value, int size) {
+        return QByteArray(size, value);
+    }
+
+    static EncodedPacketBuffer::AppendResult append(
+            EncodedPacketBuffer* pBuffer, const QByteArray& packet) {
+        return pBuffer->append(nullptr,
+                0,
+                reinterpret_cast<const unsigned char*>(packet.constData()),
+                packet.size());
+    }
+
+    TestServer m_server;
+};
+
+TEST_F(EncodedPacketBufferTest, headerAndBodyAreOnePacket) {
+    EncodedPacketBuffer buffer(100, EncodedPacketBuffer::OverflowPolicy::Reject);
+    const QByteArray header = packet('h', 2);
+    const QByteArray body = packet('b', 3);
+    EXPECT_EQ(EncodedPacketBuffer::AppendResult::Appended,
+            buffer.append(reinterpret_cast<const unsigned char*>(header.constData()),
+                    header.size(),
+                    reinterpret_cast<const unsigned char*>(body.constData()),
+                    body.size()));
+    EXPECT_EQ(5, buffer.backlogBytes());
+
+    EXPECT_EQ(5, buffer.send(m_server.sender(), 100));
+    EXPECT_EQ(QByteArray("hhbbb"), m_server.m_received);
+    EXPECT_TRUE(buffer.isEmpty());
+    EXPECT_EQ(5, buffer.stats().bytesSent);
+}
+
+TEST_F(EncodedPacketBufferTest, sendIsLimited) {
+    EncodedPacketBuffer buffer(100, EncodedPacketBuffer::OverflowPolicy::Reject);
+    append(&buffer, packet('a', 10));
+    append(&buffer, packet('b', 10));
+    append(&buffer, packet('c', 10));
+
+    // Whole packets are sent until the limit is reached
+    EXPECT_EQ(20, buffer.send(m_server.sender(), 15));
+    EXPECT_EQ(10, buffer.backlogBytes());
+    EXPECT_EQ(10, buffer.send(m_server.sender(), 15));
+    EXPECT_EQ(packet('a', 10) + packet('b', 10) + packet('c', 10),
+            m_server.m_received);
+}
+
+TEST_F(EncodedPacketBufferTest, failedPacketIsKept) {
+    EncodedPacketBuffer buffer(100, EncodedPacketBuffer::OverflowPolicy::Reject);
+    append(&buffer, packet('a', 10));
+    m_server.m_failing = true;
+    EXPECT_EQ(0, buffer.send(m_server.sender(), 100));
+    EXPECT_EQ(10, buffer.backlogBytes());
+
+    m_server.m_failing = false;
+    EXPECT_EQ(10, buffer.send(m_server.sender(), 100));
+    EXPECT_EQ(packet('a', 10), m_server.m_received);
+}
+
+TEST_F(EncodedPacketBufferTest, stalledServerRejects) {
+    EncodedPacketBuffer buffer(25, EncodedPacketBuffer::OverflowPolicy::Reject);
+    EXPECT_EQ(EncodedPacketBuffer::AppendResult::Appended,
+            append(&buffer, packet('a', 10)));
+    EXPECT_EQ(EncodedPacketBuffer::AppendResult::Appended,
+            append(&buffer, packet('b', 10)));
+    // The caller reconnects
+    EXPECT_EQ(EncodedPacketBuffer::AppendResult::Rejected,
+            append(&buffer, packet('c', 10)));
+    EXPECT_EQ(20, buffer.backlogBytes());
+    EXPECT_EQ(20, buffer.stats().maxBacklogBytes);
+}
+
+TEST_F(EncodedPacketBufferTest, stalledServerDropsOldest) {
+    EncodedPacketBuffer buffer(25, EncodedPacketBuffer::OverflowPolicy::DropOldest);
+    append(&buffer, packet('a', 10));
+    append(&buffer, packet('b', 10));
+    EXPECT_EQ(EncodedPacketBuffer::AppendResult::DroppedOldest,
+            append(&buffer, packet('c', 10)));
+    EXPECT_EQ(20, buffer.backlogBytes());
+    EXPECT_EQ(10, buffer.stats().bytesDropped);
+    EXPECT_EQ(1, buffer.stats().packetsDropped);
+
+    // The server recovers and receives the newest data
+    EXPECT_EQ(20, buffer.send(m_server.sender(), 100));
+    EXPECT_EQ(packet('b', 10) + packet('c', 10), m_server.m_received);
+}
+
+TEST_F(EncodedPacketBufferTest, senderClearsBuffer) {
+    EncodedPacketBuffer buffer(100, EncodedPacketBuffer::OverflowPolicy::Reject);
+    append(&buffer, packet('a', 10));
+    append(&buffer, packet('b', 10));
+    // Like a reconnect while sending
+    const auto reconnectingSender = [&buffer](const QByteArray&) {
+        buffer.clear();
+        return true;
+    };
+    EXPECT_EQ(0, buffer.send(reconnectingSender, 100));
+    EXPECT_TRUE(buffer.isEmpty());
+    EXPECT_EQ(0, buffer.backlogBytes());
+}
+
+} // namespace
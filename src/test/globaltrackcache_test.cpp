@@ -2,10 +2,13 @@
 #include <QtDebug>
 
 #include <atomic>
+#include <memory>
+#include <vector>
 
 #include "test/mixxxtest.h"
 
 #include "track/globaltrackcache.h"
+#include "util/performancetimer.h"
 
 
 namespace {
@@ -66,6 +69,40 @@ class TrackTitleThread: public QThread {
     std::atomic<bool> m_stop;
 };
 
+class TrackResolverThread: public QThread {
+  public:
+    TrackResolverThread(
+            int numIterations,
+            TrackId trackId,
+            QString trackLocation)
+        : m_numIterations(numIterations),
+          m_trackId(trackId),
+          m_trackLocation(trackLocation) {
+    }
+
+    void run() override {
+        for (int i = 0; i < m_numIterations; ++i) {
+            if (i % 2) {
+                // Each resolver uses a fresh file info, i.e. the
+                // canonical location needs to be obtained again
+                const auto track = GlobalTrackCacheResolver(
+                        TrackFile(m_trackLocation)).getTrack();
+                ASSERT_TRUE(static_cast<bool>(track));
+                ASSERT_EQ(m_trackId, track->getId());
+            } else {
+                const auto track =
+                        GlobalTrackCacheLocker().lookupTrackById(m_trackId);
+                ASSERT_TRUE(static_cast<bool>(track));
+            }
+        }
+    }
+
+  private:
+    const int m_numIterations;
+    const TrackId m_trackId;
+    const QString m_trackLocation;
+};
+
 void deleteTrack(Track* pTrack) {
     // Delete track objects directly in unit tests with
     // no main event loop
@@ -216,3 +253,58 @@ TEST_F(GlobalTrackCacheTest, evictWhileMoving) {
 
     EXPECT_TRUE(GlobalTrackCacheLocker().isEmpty());
 }
+
+TEST_F(GlobalTrackCacheTest, concurrentResolveContention) {
+    ASSERT_TRUE(GlobalTrackCacheLocker().isEmpty());
+
+    // Keep both tracks alive to measure lookups and not evictions
+    const TrackId trackId1(1);
+    TrackPointer track1;
+    {
+        GlobalTrackCacheResolver resolver(kTestFile);
+        track1 = resolver.getTrack();
+        resolver.initTrackIdAndUnlockCache(trackId1);
+    }
+    const TrackId trackId2(2);
+    TrackPointer track2;
+    {
+        GlobalTrackCacheResolver resolver(kTestFile2);
+        track2 = resolver.getTrack();
+        resolver.initTrackIdAndUnlockCache(trackId2);
+    }
+
+    const int kNumThreads = 16;
+    const int kNumIterationsPerThread = 10000;
+    std::vector<std::unique_ptr<TrackResolverThread>> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.push_back(std::make_unique<TrackResolverThread>(
+                kNumIterationsPerThread,
+                (i % 2) ? trackId2 : trackId1,
+                (i % 2) ? kTestFile2.location() : kTestFile.location()));
+    }
+
+    PerformanceTimer timer;
+    timer.start();
+    for (const auto& pThread : threads) {
+        pThread->start();
+    }
+    for (const auto& pThread : threads) {
+        while (!pThread->wait(1)) {
+            // Evicted references are released on the main thread
+            QCoreApplication::processEvents();
+        }
+    }
+    const auto elapsed = timer.elapsed();
+    qDebug() << "Resolved"
+             << kNumThreads * kNumIterationsPerThread
+             << "tracks with"
+             << kNumThreads
+             << "threads in"
+             << elapsed.formatMillisWithUnit();
+
+    track1.reset();
+    track2.reset();
+    while (!GlobalTrackCacheLocker().isEmpty()) {
+        QCoreApplication::processEvents();
+    }
+}
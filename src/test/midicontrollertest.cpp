@@ -17,9 +17,9 @@ class MockMidiController : public MidiController {
 
     MOCK_METHOD0(open, int());
     MOCK_METHOD0(close, int());
-    MOCK_METHOD3(sendShortMsg, void(unsigned char status,
-                                    unsigned char byte1,
-                                    unsigned char byte2));
+    MOCK_METHOD3(writeShortMsg, void(unsigned char status,
+                                     unsigned char byte1,
+                                     unsigned char byte2));
     MOCK_METHOD1(send, void(QByteArray data));
     MOCK_CONST_METHOD0(isPolling, bool());
 };
@@ -44,10 +44,38 @@ class MidiControllerTest : public MixxxTest {
         m_pController->receive(status, control, value, mixxx::Time::elapsed());
     }
 
+    void writeOutput(const ControllerOutputScheduler::Batch& batch) {
+        m_pController->writeOutput(batch);
+    }
+
     MidiControllerPreset m_preset;
     QScopedPointer<MockMidiController> m_pController;
 };
 
+TEST_F(MidiControllerTest, WriteOutput_ShortMessages) {
+    ControllerOutputScheduler::Batch batch;
+    // Note on
+    batch.append({ControllerOutputScheduler::kNoCoalescing,
+            QByteArray("\x90\x3C\x7F", 3)});
+    // Program change with a single data byte
+    batch.append({ControllerOutputScheduler::kNoCoalescing,
+            QByteArray("\xC1\x05", 2)});
+    EXPECT_CALL(*m_pController, writeShortMsg(0x90, 0x3C, 0x7F));
+    EXPECT_CALL(*m_pController, writeShortMsg(0xC1, 0x05, 0x00));
+    EXPECT_CALL(*m_pController, send(testing::_)).Times(0);
+    writeOutput(batch);
+}
+
+TEST_F(MidiControllerTest, WriteOutput_SysEx) {
+    const QByteArray sysex("\xF0\x7E\x7F\x06\x01\xF7", 6);
+    ControllerOutputScheduler::Batch batch;
+    batch.append({ControllerOutputScheduler::kNoCoalescing, sysex});
+    EXPECT_CALL(*m_pController, send(sysex));
+    EXPECT_CALL(*m_pController, writeShortMsg(testing::_, testing::_, testing::_))
+            .Times(0);
+    writeOutput(batch);
+}
+
 TEST_F(MidiControllerTest, ReceiveMessage_PushButtonCO_PushOnOff) {
     // Most MIDI controller send push-buttons as (NOTE_ON, 0x7F) for press and
     // (NOTE_OFF, 0x00) for release.
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <QVector>
+
+#include "util/multireaderfifo.h"
+
+namespace {
+
+// Writes consecutive numbers in chunks of varying sizes, some of them
+// larger than the FIFO
+class NumberWriterThread : public QThread {
+  public:
+    NumberWriterThread(MultiReaderFifo<qint64>* pFifo, qint64 count)
+            : m_pFifo(pFifo),
+              m_count(count) {
+    }
+
+    void run() override {
+        const int maxChunkSize = 2 * m_pFifo->size() + 1;
+        QVector<qint64> chunk(maxChunkSize);
+        qint64 next = 0;
+        int chunkSize = 1;
+        while (next < m_count) {
+            const int count = static_cast<int>(
+                    math_min<qint64>(chunkSize, m_count - next));
+            for (int i = 0; i < count; ++i) {
+                chunk[i] = next++;
+            }
+            m_pFifo->write(chunk.constData(), count);
+            chunkSize = chunkSize % maxChunkSize + 1;
+        }
+    }
+
+  private:
+    MultiReaderFifo<qint64>* const m_pFifo;
+    const qint64 m_count;
+};
+
+class MultiReaderFifoTest : public testing::Test {
+  protected:
+    MultiReaderFifoTest()
+            : m_fifo(8) {
+    }
+
+    void write(int first, int count) {
+        QVector<int> data;
+        for (int i = 0; i < count; ++i) {
+            data.append(first + i);
+        }
+        m_fifo.write(data.constData(), data.size());
+    }
+
+    static QVector<int> read(MultiReaderFifo<int>::Reader* pReader, int count) {
+        QVector<int> data(count);
+        data.resize(pReader->read(data.data(), count));
+        return data;
+    }
+
+    MultiReaderFifo<int> m_fifo;
+};
+
+TEST_F(MultiReaderFifoTest, readersAreIndependent) {
+    auto pReader1 = m_fifo.createReader();
+    auto pReader2 = m_fifo.createReader();
+    write(0, 4);
+    EXPECT_EQ(4, pReader1->readAvailable());
+    EXPECT_EQ(QVector<int>({0, 1, 2}), read(pReader1.get(), 3));
+    EXPECT_EQ(1, pReader1->readAvailable());
+    EXPECT_EQ(4, pReader2->readAvailable());
+
+    write(4, 2);
+    EXPECT_EQ(QVector<int>({3, 4, 5}), read(pReader1.get(), 8));
+    EXPECT_EQ(QVector<int>({0, 1, 2, 3, 4, 5}), read(pReader2.get(), 8));
+    EXPECT_EQ(0, pReader1->overflowCount());
+    EXPECT_EQ(0, pReader2->overflowCount());
+}
+
+TEST_F(MultiReaderFifoTest, readerStartsAtCurrentPosition) {
+    write(0, 3);
+    auto pReader = m_fifo.createReader();
+    EXPECT_EQ(0, pReader->readAvailable());
+    write(3, 2);
+    EXPECT_EQ(QVector<int>({3, 4}), read(pReader.get(), 8));
+}
+
+TEST_F(MultiReaderFifoTest, wrapAround) {
+    auto pReader = m_fifo.createReader();
+    for (int i = 0; i < 5; ++i) {
+        write(i * 3, 3);
+        EXPECT_EQ(QVector<int>({i * 3, i * 3 + 1, i * 3 + 2}),
+                read(pReader.get(), 8));
+    }
+    EXPECT_EQ(0, pReader->overflowCount());
+}
+
+TEST_F(MultiReaderFifoTest, slowReaderOverflows) {
+    auto pSlowReader = m_fifo.createReader();
+    auto pReader = m_fifo.createReader();
+    write(0, 6);
+    EXPECT_EQ(6, read(pReader.get(), 8).size());
+    // The writer never waits, the oldest items are overwritten
+    write(6, 6);
+    EXPECT_EQ(QVector<int>({6, 7, 8, 9, 10, 11}), read(pReader.get(), 8));
+    EXPECT_EQ(0, pReader->overflowCount());
+
+    EXPECT_EQ(8, pSlowReader->readAvailable());
+    EXPECT_EQ(QVector<int>({4, 5, 6, 7, 8, 9, 10, 11}), read(pSlowReader.get(), 8));
+    EXPECT_EQ(1, pSlowReader->overflowCount());
+    EXPECT_EQ(4, pSlowReader->itemsLost());
+
+    pSlowReader->resetOverflowCount();
+    EXPECT_EQ(0, pSlowReader->overflowCount());
+    EXPECT_EQ(0, pSlowReader->itemsLost());
+}
+
+TEST_F(MultiReaderFifoTest, writeMoreThanSize) {
+    auto pReader = m_fifo.createReader();
+    write(0, 10);
+    EXPECT_EQ(QVector<int>({2, 3, 4, 5, 6, 7, 8, 9}), read(pReader.get(), 10));
+    EXPECT_EQ(2, pReader->itemsLost());
+}
+
+TEST_F(MultiReaderFifoTest, flush) {
+    auto pReader = m_fifo.createReader();
+    write(0, 4);
+    pReader->flush();
+    EXPECT_EQ(0, pReader->readAvailable());
+    write(4, 1);
+    EXPECT_EQ(QVector<int>({4}), read(pReader.get(), 8));
+}
+
+TEST(MultiReaderFifoConcurrencyTest, concurrentReadsAreConsistent) {
+    const qint64 kCount = 1000000;
+    MultiReaderFifo<qint64> fifo(64);
+    auto pReader = fifo.createReader();
+    NumberWriterThread writer(&fifo, kCount);
+    writer.start();
+    QVector<qint64> data(fifo.size());
+    qint64 expected = 0;
+    bool consistent = true;
+    while (consistent && expected < kCount) {
+        const qint64 itemsLost = pReader->itemsLost();
+        const int count = pReader->read(data.data(), data.size());
+        if (count == 0) {
+            if (writer.isFinished() && pReader->readAvailable() == 0) {
+                break;
+            }
+            continue;
+        }
+        // Only the items that have been counted as lost are skipped
+        expected += pReader->itemsLost() - itemsLost;
+        for (int i = 0; i < count; ++i) {
+            if (data[i] != expected) {
+                ADD_FAILURE() << "Read " << data[i] << " instead of " << expected;
+                consistent = false;
+                break;
+            }
+            ++expected;
+        }
+    }
+    writer.wait();
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(kCount, expected);
+}
+
+} // namespace
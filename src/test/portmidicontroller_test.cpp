@@ -25,14 +25,23 @@ class MockPortMidiController : public PortMidiController {
     ~MockPortMidiController() override {
     }
 
-    void sendShortMsg(unsigned char status, unsigned char byte1, unsigned char byte2) override {
+    void sendShortMsg(unsigned char status, unsigned char byte1, unsigned char byte2) {
         PortMidiController::sendShortMsg(status, byte1, byte2);
     }
 
+    void writeShortMsg(unsigned char status, unsigned char byte1, unsigned char byte2) override {
+        PortMidiController::writeShortMsg(status, byte1, byte2);
+    }
+
     void sendSysexMsg(QList<int> data, unsigned int length) {
         PortMidiController::sendSysexMsg(data, length);
     }
 
+    // Writes the scheduled output without waiting for the next batch
+    void flushOutput() {
+        outputScheduler()->flushAll();
+    }
+
     MOCK_METHOD4(receive, void(unsigned char, unsigned char, unsigned char,
                                mixxx::Duration));
     MOCK_METHOD2(receive, void(const QByteArray, mixxx::Duration));
@@ -163,9 +172,53 @@ TEST_F(PortMidiControllerTest, WriteShort) {
             .InSequence(output)
             .WillOnce(Return(pmNoError));
 
-    m_pController->sendShortMsg(0x90, 0x3C, 0x40);
-    m_pController->sendShortMsg(0xFF, 0xFF, 0xFF);
-    m_pController->sendShortMsg(0x80, 0x3C, 0x40);
+    m_pController->writeShortMsg(0x90, 0x3C, 0x40);
+    m_pController->writeShortMsg(0xFF, 0xFF, 0xFF);
+    m_pController->writeShortMsg(0x80, 0x3C, 0x40);
+};
+
+TEST_F(PortMidiControllerTest, SendShort_Coalesced) {
+    Sequence output;
+    EXPECT_CALL(*m_mockOutput, isOpen())
+            .WillRepeatedly(Return(true));
+    // Note on and off of the same note replace each other
+    EXPECT_CALL(*m_mockOutput, writeShort(0x003C80))
+            .InSequence(output)
+            .WillOnce(Return(pmNoError));
+    EXPECT_CALL(*m_mockOutput, writeShort(0x7F01B0))
+            .InSequence(output)
+            .WillOnce(Return(pmNoError));
+    EXPECT_CALL(*m_mockOutput, writeShort(0x0002C0))
+            .InSequence(output)
+            .WillOnce(Return(pmNoError));
+    EXPECT_CALL(*m_mockOutput, writeShort(0x0003C0))
+            .InSequence(output)
+            .WillOnce(Return(pmNoError));
+
+    m_pController->sendShortMsg(0x90, 0x3C, 0x7F);
+    m_pController->sendShortMsg(0xB0, 0x01, 0x00);
+    m_pController->sendShortMsg(0x80, 0x3C, 0x00);
+    m_pController->sendShortMsg(0xB0, 0x01, 0x7F);
+    // Program changes are never dropped
+    m_pController->sendShortMsg(0xC0, 0x02, 0x00);
+    m_pController->sendShortMsg(0xC0, 0x03, 0x00);
+    m_pController->flushOutput();
+
+    EXPECT_EQ(4, m_pController->getOutputStats().sent);
+    EXPECT_EQ(2, m_pController->getOutputStats().coalesced);
+};
+
+TEST_F(PortMidiControllerTest, SendShort_WrittenByEventLoop) {
+    EXPECT_CALL(*m_mockOutput, isOpen())
+            .WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mockOutput, writeShort(0x7F3C90))
+            .WillOnce(Return(pmNoError));
+
+    m_pController->sendShortMsg(0x90, 0x3C, 0x7F);
+    // The first message after an idle period is written without delay
+    application()->processEvents();
+    EXPECT_EQ(0, m_pController->getOutputStats().dropped);
+    EXPECT_EQ(1, m_pController->getOutputStats().batches);
 };
 
 TEST_F(PortMidiControllerTest, WriteSysex) {
@@ -179,6 +232,7 @@ TEST_F(PortMidiControllerTest, WriteSysex) {
     EXPECT_CALL(*m_mockOutput, writeSysEx(ByteArrayEquals(sysex)))
             .WillOnce(Return(pmNoError));
     m_pController->sendSysexMsg(sysex, sysex.length());
+    m_pController->flushOutput();
 };
 
 TEST_F(PortMidiControllerTest, WriteSysex_Malformed) {
@@ -191,6 +245,7 @@ TEST_F(PortMidiControllerTest, WriteSysex_Malformed) {
     EXPECT_CALL(*m_mockOutput, writeSysEx(_))
             .Times(0);
     m_pController->sendSysexMsg(sysex, sysex.length());
+    m_pController->flushOutput();
 };
 
 TEST_F(PortMidiControllerTest, Poll_Read_NoInput) {
@@ -388,6 +388,25 @@ TEST_F(SampleUtilTest, deinterleaveBuffer) {
     }
 }
 
+TEST_F(SampleUtilTest, deinterleaveClampBuffer) {
+    const CSAMPLE src[] = {0.5f, -0.5f, 2.0f, -2.0f};
+    CSAMPLE dest1[2];
+    CSAMPLE dest2[2];
+    SampleUtil::deinterleaveClampBuffer(dest1, dest2, src, 2);
+    EXPECT_FLOAT_EQ(0.5f, dest1[0]);
+    EXPECT_FLOAT_EQ(-0.5f, dest2[0]);
+    EXPECT_FLOAT_EQ(CSAMPLE_PEAK, dest1[1]);
+    EXPECT_FLOAT_EQ(-CSAMPLE_PEAK, dest2[1]);
+}
+
+TEST_F(SampleUtilTest, mixStereoToMonoClampBuffer) {
+    const CSAMPLE src[] = {0.5f, -0.25f, 2.0f, 2.0f};
+    CSAMPLE dest[2];
+    SampleUtil::mixStereoToMonoClampBuffer(dest, src, 2);
+    EXPECT_FLOAT_EQ(0.125f, dest[0]);
+    EXPECT_FLOAT_EQ(CSAMPLE_PEAK, dest[1]);
+}
+
 TEST_F(SampleUtilTest, reverse) {
     if (buffers.size() > 0 && sizes[0] > 10) {
         CSAMPLE* buffer = buffers[1];
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include "engine/scratchtickqueue.h"
+
+namespace {
+
+// 1000 intervals per second at normal speed
+const double kDx = 0.001;
+// Converges faster than the defaults, like the values used by mappings
+const double kAlpha = 1.0 / 8;
+const double kBeta = kAlpha / 32;
+
+class ScratchTickIntegratorTest : public testing::Test {
+  protected:
+    static mixxx::Duration micros(qint64 micros) {
+        return mixxx::Duration::fromMicros(micros);
+    }
+
+    int enable(mixxx::Duration timestamp, double velocity = 0.0) {
+        ScratchTickEvent event;
+        event.type = ScratchTickEvent::Type::Enable;
+        event.session = m_queue.beginSession();
+        event.timestamp = timestamp;
+        event.interval = 0;
+        event.dx = kDx;
+        event.velocity = velocity;
+        event.alpha = kAlpha;
+        event.beta = kBeta;
+        EXPECT_TRUE(m_queue.write(event));
+        return event.session;
+    }
+
+    bool tick(mixxx::Duration timestamp, int interval = 1) {
+        ScratchTickEvent event;
+        event.type = ScratchTickEvent::Type::Tick;
+        event.session = 0;
+        event.timestamp = timestamp;
+        event.interval = interval;
+        event.dx = 0.0;
+        event.velocity = 0.0;
+        event.alpha = 0.0;
+        event.beta = 0.0;
+        return m_queue.write(event);
+    }
+
+    // Sends a tick every millisecond from start until end, like a jog wheel
+    // that is turned at normal speed. Each tick is sent right before the
+    // callback that follows it.
+    double scratchAtNormalSpeed(ScratchTickIntegrator* pIntegrator,
+            const std::vector<qint64>& callbackMicros) {
+        qint64 nextTickMicros = 0;
+        double rate = 0.0;
+        for (qint64 callback : callbackMicros) {
+            for (; nextTickMicros < callback; nextTickMicros += 1000) {
+                EXPECT_TRUE(tick(micros(nextTickMicros)));
+            }
+            EXPECT_TRUE(pIntegrator->process(&m_queue, micros(callback), &rate));
+        }
+        return rate;
+    }
+
+    ScratchTickQueue m_queue;
+};
+
+TEST_F(ScratchTickIntegratorTest, disabledByDefault) {
+    ScratchTickIntegrator integrator;
+    EXPECT_TRUE(tick(micros(0)));
+    double rate = 42.0;
+    EXPECT_FALSE(integrator.process(&m_queue, micros(10000), &rate));
+    EXPECT_FALSE(integrator.isEnabled());
+}
+
+TEST_F(ScratchTickIntegratorTest, convergesToNormalSpeed) {
+    ScratchTickIntegrator integrator;
+    enable(micros(0));
+    std::vector<qint64> callbacks;
+    // 256 frame buffers at 44.1 kHz
+    for (qint64 t = 5805; t < 3000000; t += 5805) {
+        callbacks.push_back(t);
+    }
+    const double rate = scratchAtNormalSpeed(&integrator, callbacks);
+    EXPECT_NEAR(1.0, rate, 0.05);
+}
+
+TEST_F(ScratchTickIntegratorTest, independentOfCallbackJitter) {
+    std::vector<qint64> regular;
+    std::vector<qint64> jittered;
+    for (qint64 t = 5000; t <= 500000; t += 5000) {
+        regular.push_back(t);
+        // Late and early callbacks, except for the last two that span the
+        // same window
+        const qint64 jitter = (t % 3 == 0) ? 2300 : ((t % 3 == 1) ? -1700 : 0);
+        jittered.push_back(t < 495000 ? t + jitter : t);
+    }
+
+    ScratchTickIntegrator regularIntegrator;
+    enable(micros(0));
+    const double regularRate = scratchAtNormalSpeed(&regularIntegrator, regular);
+
+    ScratchTickIntegrator jitteredIntegrator;
+    enable(micros(0));
+    const double jitteredRate = scratchAtNormalSpeed(&jitteredIntegrator, jittered);
+
+    EXPECT_DOUBLE_EQ(regularRate, jitteredRate);
+}
+
+TEST_F(ScratchTickIntegratorTest, stoppedWheelSlowsDown) {
+    ScratchTickIntegrator integrator;
+    enable(micros(0), 1.0);
+    double rate = 0.0;
+    // No ticks
+    for (qint64 t = 10000; t <= 1000000; t += 10000) {
+        EXPECT_TRUE(integrator.process(&m_queue, micros(t), &rate));
+    }
+    EXPECT_LT(rate, 0.1);
+}
+
+TEST_F(ScratchTickIntegratorTest, ticksAreNotDueBeforeTheirTime) {
+    ScratchTickIntegrator integrator;
+    enable(micros(0));
+    double rate = 0.0;
+    // A tick in the future of the callback stays pending
+    EXPECT_TRUE(tick(micros(20000), 100));
+    EXPECT_TRUE(integrator.process(&m_queue, micros(10000), &rate));
+    EXPECT_DOUBLE_EQ(0.0, rate);
+    EXPECT_TRUE(integrator.process(&m_queue, micros(30000), &rate));
+    EXPECT_GT(rate, 0.0);
+}
+
+TEST_F(ScratchTickIntegratorTest, disable) {
+    ScratchTickIntegrator integrator;
+    const int session = enable(micros(0), 1.0);
+    double rate = 0.0;
+    EXPECT_TRUE(integrator.process(&m_queue, micros(10000), &rate));
+    m_queue.requestDisable(session, micros(15000));
+    double acknowledgedRate = 0.0;
+    EXPECT_FALSE(m_queue.isDisableAcknowledged(session, &acknowledgedRate));
+    // Integrates the steps before the request
+    EXPECT_TRUE(integrator.process(&m_queue, micros(20000), &rate));
+    EXPECT_FALSE(integrator.isEnabled());
+    EXPECT_GT(rate, 0.0);
+    // The controller continues from the last rate
+    EXPECT_TRUE(m_queue.isDisableAcknowledged(session, &acknowledgedRate));
+    EXPECT_DOUBLE_EQ(rate, acknowledgedRate);
+    // Ticks after disabling are ignored
+    EXPECT_TRUE(tick(micros(25000)));
+    EXPECT_FALSE(integrator.process(&m_queue, micros(30000), &rate));
+}
+
+TEST_F(ScratchTickIntegratorTest, disableWhenQueueIsFull) {
+    ScratchTickIntegrator integrator;
+    const int session = enable(micros(0), 1.0);
+    double rate = 0.0;
+    EXPECT_TRUE(integrator.process(&m_queue, micros(1000), &rate));
+    // The engine has stalled and the wheel is still turned
+    qint64 t = 1000;
+    while (tick(micros(t))) {
+        t += 100;
+    }
+    m_queue.requestDisable(session, micros(t));
+    EXPECT_TRUE(integrator.process(&m_queue, micros(t + 1000), &rate));
+    EXPECT_FALSE(integrator.isEnabled());
+    double acknowledgedRate = 0.0;
+    EXPECT_TRUE(m_queue.isDisableAcknowledged(session, &acknowledgedRate));
+    EXPECT_DOUBLE_EQ(rate, acknowledgedRate);
+}
+
+TEST_F(ScratchTickIntegratorTest, disableBeforeEnableHasBeenRead) {
+    ScratchTickIntegrator integrator;
+    const int session = enable(micros(0), 0.5);
+    m_queue.requestDisable(session, micros(1000));
+    double rate = 0.0;
+    EXPECT_FALSE(integrator.process(&m_queue, micros(10000), &rate));
+    EXPECT_FALSE(integrator.isEnabled());
+    // Continues from the initial velocity
+    double acknowledgedRate = 0.0;
+    EXPECT_TRUE(m_queue.isDisableAcknowledged(session, &acknowledgedRate));
+    EXPECT_DOUBLE_EQ(0.5, acknowledgedRate);
+
+    // The next session is not affected
+    enable(micros(20000), 1.0);
+    EXPECT_TRUE(integrator.process(&m_queue, micros(30000), &rate));
+    EXPECT_TRUE(integrator.isEnabled());
+}
+
+TEST_F(ScratchTickIntegratorTest, consumedWhileTheEngineReads) {
+    ScratchTickIntegrator integrator;
+    EXPECT_FALSE(m_queue.isConsumed(micros(0)));
+    double rate = 0.0;
+    integrator.process(&m_queue, micros(10000), &rate);
+    EXPECT_TRUE(m_queue.isConsumed(micros(20000)));
+    // The engine has stopped reading
+    EXPECT_FALSE(m_queue.isConsumed(
+            micros(10000) + ScratchTickQueue::kMaxReadInterval));
+}
+
+TEST_F(ScratchTickIntegratorTest, catchUpIsBounded) {
+    ScratchTickIntegrator integrator;
+    enable(micros(0), 1.0);
+    double rate = 0.0;
+    // The engine has not run for 10 seconds
+    EXPECT_TRUE(integrator.process(&m_queue, micros(10000000), &rate));
+    EXPECT_TRUE(integrator.isEnabled());
+}
+
+} // namespace
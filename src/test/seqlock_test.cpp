@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <QThread>
+
+#include "util/seqlock.h"
+
+namespace {
+
+struct Triple {
+    qint64 a;
+    qint64 b;
+    qint64 c;
+};
+
+class TripleWriterThread : public QThread {
+  public:
+    TripleWriterThread(SeqLockValue<Triple>* pValue, int iterations)
+            : m_pValue(pValue),
+              m_iterations(iterations) {
+    }
+
+    void run() override {
+        for (qint64 i = 1; i <= m_iterations; ++i) {
+            m_pValue->setValue(Triple{i, 2 * i, 3 * i});
+        }
+    }
+
+  private:
+    SeqLockValue<Triple>* m_pValue;
+    const int m_iterations;
+};
+
+TEST(SeqLockValueTest, getLatestValue) {
+    SeqLockValue<Triple> value;
+    EXPECT_EQ(0, value.getValue().a);
+    value.setValue(Triple{1, 2, 3});
+    value.setValue(Triple{4, 5, 6});
+    const Triple triple = value.getValue();
+    EXPECT_EQ(4, triple.a);
+    EXPECT_EQ(5, triple.b);
+    EXPECT_EQ(6, triple.c);
+}
+
+TEST(SeqLockValueTest, concurrentReadsAreConsistent) {
+    const int kIterations = 1000000;
+    SeqLockValue<Triple> value;
+    TripleWriterThread writer(&value, kIterations);
+    writer.start();
+    qint64 previous = 0;
+    while (previous < kIterations) {
+        const Triple triple = value.getValue();
+        // Stop at the first failure, the writer must be joined before
+        // the test returns.
+        if (triple.b != 2 * triple.a || triple.c != 3 * triple.a) {
+            ADD_FAILURE() << "Inconsistent value " << triple.a << ", "
+                          << triple.b << ", " << triple.c;
+            break;
+        }
+        // Values never go back in time
+        if (triple.a < previous) {
+            ADD_FAILURE() << "Value " << triple.a
+                          << " read after " << previous;
+            break;
+        }
+        previous = triple.a;
+    }
+    writer.wait();
+}
+
+} // namespace
@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+
+#include <QByteArray>
+
+#include "encoder/sharedencoderpool.h"
+#include "recording/defs_recording.h"
+
+namespace {
+
+class TestEncoderSettings : public EncoderSettings {
+  public:
+    TestEncoderSettings(const QString& format, int quality)
+            : m_format(format),
+              m_quality(quality) {
+    }
+
+    int getQuality() const override {
+        return m_quality;
+    }
+    QString getFormat() const override {
+        return m_format;
+    }
+
+  private:
+    const QString m_format;
+    const int m_quality;
+};
+
+// Writes one byte with the number of samples of every buffer
+class TestEncoder : public Encoder {
+  public:
+    TestEncoder(EncoderCallback* pCallback, int* pEncodedBuffers)
+            : m_pCallback(pCallback),
+              m_pEncodedBuffers(pEncodedBuffers) {
+    }
+
+    int initEncoder(int samplerate, QString errorMessage) override {
+        Q_UNUSED(samplerate);
+        Q_UNUSED(errorMessage);
+        return 0;
+    }
+    void encodeBuffer(const CSAMPLE* samples, const int size) override {
+        Q_UNUSED(samples);
+        ++(*m_pEncodedBuffers);
+        const unsigned char data = static_cast<unsigned char>(size);
+        m_pCallback->write(nullptr, &data, 0, 1);
+    }
+    void updateMetaData(const QString& artist,
+            const QString& title,
+            const QString& album) override {
+        Q_UNUSED(artist);
+        Q_UNUSED(title);
+        Q_UNUSED(album);
+    }
+    void flush() override {
+    }
+    void setEncoderSettings(const EncoderSettings& settings) override {
+        Q_UNUSED(settings);
+    }
+
+  private:
+    EncoderCallback* const m_pCallback;
+    int* const m_pEncodedBuffers;
+};
+
+class TestEncoderCallback : public EncoderCallback {
+  public:
+    void write(const unsigned char* header,
+            const unsigned char* body,
+            int headerLen,
+            int bodyLen) override {
+        m_data.append(reinterpret_cast<const char*>(header), headerLen);
+        m_data.append(reinterpret_cast<const char*>(body), bodyLen);
+    }
+    int tell() override {
+        return -1;
+    }
+    void seek(int pos) override {
+        Q_UNUSED(pos);
+    }
+    int filelen() override {
+        return 0;
+    }
+
+    QByteArray m_data;
+};
+
+class SharedEncoderPoolTest : public testing::Test {
+  protected:
+    SharedEncoderPoolTest()
+            : m_createdEncoders(0),
+              m_encodedBuffers(0),
+              m_pool([this](EncoderSettingsPointer pSettings,
+                             EncoderCallback* pCallback) {
+                  Q_UNUSED(pSettings);
+                  ++m_createdEncoders;
+                  return std::make_shared<TestEncoder>(pCallback, &m_encodedBuffers);
+              }) {
+    }
+
+    EncoderPointer createEncoder(const QString& format,
+            int bitrate,
+            EncoderCallback* pCallback,
+            int sampleRate = 44100) {
+        EncoderPointer pEncoder = m_pool.createEncoder(
+                std::make_shared<TestEncoderSettings>(format, bitrate),
+                pCallback);
+        EXPECT_EQ(0, pEncoder->initEncoder(sampleRate, QString()));
+        return pEncoder;
+    }
+
+    int m_createdEncoders;
+    int m_encodedBuffers;
+    SharedEncoderPool m_pool;
+    CSAMPLE m_samples[64] = {};
+};
+
+TEST_F(SharedEncoderPoolTest, sameSettingsAreEncodedOnce) {
+    TestEncoderCallback callback1;
+    TestEncoderCallback callback2;
+    EncoderPointer pEncoder1 = createEncoder(ENCODING_MP3, 128, &callback1);
+    EncoderPointer pEncoder2 = createEncoder(ENCODING_MP3, 128, &callback2);
+    EXPECT_EQ(1, m_createdEncoders);
+    EXPECT_EQ(1, m_pool.sharedEncoderCount());
+
+    // Both connections receive the same samples in their own thread
+    pEncoder1->encodeBuffer(m_samples, 10);
+    pEncoder2->encodeBuffer(m_samples, 10);
+    pEncoder1->encodeBuffer(m_samples, 20);
+    pEncoder2->encodeBuffer(m_samples, 20);
+
+    EXPECT_EQ(2, m_encodedBuffers);
+    const QByteArray expected("\x0a\x14");
+    EXPECT_EQ(expected, callback1.m_data);
+    EXPECT_EQ(expected, callback2.m_data);
+}
+
+TEST_F(SharedEncoderPoolTest, differentSettingsAreNotShared) {
+    TestEncoderCallback callback1;
+    TestEncoderCallback callback2;
+    TestEncoderCallback callback3;
+    EncoderPointer pEncoder1 = createEncoder(ENCODING_MP3, 128, &callback1);
+    EncoderPointer pEncoder2 = createEncoder(ENCODING_MP3, 192, &callback2);
+    EncoderPointer pEncoder3 = createEncoder(ENCODING_MP3, 128, &callback3, 48000);
+    EXPECT_EQ(3, m_createdEncoders);
+    EXPECT_EQ(3, m_pool.sharedEncoderCount());
+
+    pEncoder1->encodeBuffer(m_samples, 10);
+    pEncoder2->encodeBuffer(m_samples, 10);
+    pEncoder3->encodeBuffer(m_samples, 10);
+    EXPECT_EQ(3, m_encodedBuffers);
+    EXPECT_EQ(1, callback1.m_data.size());
+    EXPECT_EQ(1, callback2.m_data.size());
+    EXPECT_EQ(1, callback3.m_data.size());
+}
+
+TEST_F(SharedEncoderPoolTest, oggIsNotShared) {
+    TestEncoderCallback callback1;
+    TestEncoderCallback callback2;
+    EncoderPointer pEncoder1 = createEncoder(ENCODING_OGG, 128, &callback1);
+    EncoderPointer pEncoder2 = createEncoder(ENCODING_OGG, 128, &callback2);
+    EXPECT_EQ(2, m_createdEncoders);
+    EXPECT_EQ(0, m_pool.sharedEncoderCount());
+
+    pEncoder1->encodeBuffer(m_samples, 10);
+    pEncoder2->encodeBuffer(m_samples, 10);
+    EXPECT_EQ(2, m_encodedBuffers);
+}
+
+TEST_F(SharedEncoderPoolTest, nextSubscriberTakesOver) {
+    TestEncoderCallback callback1;
+    TestEncoderCallback callback2;
+    EncoderPointer pEncoder1 = createEncoder(ENCODING_MP3, 128, &callback1);
+    EncoderPointer pEncoder2 = createEncoder(ENCODING_MP3, 128, &callback2);
+    pEncoder1->encodeBuffer(m_samples, 10);
+    pEncoder2->encodeBuffer(m_samples, 10);
+
+    // The leader disconnects
+    pEncoder1.reset();
+    pEncoder2->encodeBuffer(m_samples, 20);
+    EXPECT_EQ(2, m_encodedBuffers);
+    EXPECT_EQ(QByteArray("\x0a\x14"), callback2.m_data);
+    EXPECT_EQ(1, m_pool.sharedEncoderCount());
+
+    // The shared encoder is released with the last subscriber
+    pEncoder2.reset();
+    EXPECT_EQ(0, m_pool.sharedEncoderCount());
+    EncoderPointer pEncoder3 = createEncoder(ENCODING_MP3, 128, &callback1);
+    EXPECT_EQ(2, m_createdEncoders);
+}
+
+TEST_F(SharedEncoderPoolTest, disconnectedLeaderDoesNotStarveFollower) {
+    TestEncoderCallback callback1;
+    TestEncoderCallback callback2;
+    // The first connection subscribes, but never connects to its server and
+    // therefore never receives samples
+    EncoderPointer pEncoder1 = createEncoder(ENCODING_MP3, 128, &callback1);
+    EncoderPointer pEncoder2 = createEncoder(ENCODING_MP3, 128, &callback2);
+
+    pEncoder2->encodeBuffer(m_samples, 10);
+    pEncoder2->encodeBuffer(m_samples, 20);
+    pEncoder2->encodeBuffer(m_samples, 30);
+    EXPECT_EQ(3, m_encodedBuffers);
+    EXPECT_EQ(QByteArray("\x0a\x14\x1e"), callback2.m_data);
+
+    // The first connection connects late and does not feed twice
+    pEncoder1->encodeBuffer(m_samples, 40);
+    pEncoder2->encodeBuffer(m_samples, 40);
+    EXPECT_EQ(4, m_encodedBuffers);
+    EXPECT_EQ(QByteArray("\x0a\x14\x1e\x28"), callback2.m_data);
+}
+
+TEST_F(SharedEncoderPoolTest, followerTakesOverFromDisconnectedFeeder) {
+    TestEncoderCallback callback1;
+    TestEncoderCallback callback2;
+    EncoderPointer pEncoder1 = createEncoder(ENCODING_MP3, 128, &callback1);
+    EncoderPointer pEncoder2 = createEncoder(ENCODING_MP3, 128, &callback2);
+    pEncoder1->encodeBuffer(m_samples, 10);
+    pEncoder2->encodeBuffer(m_samples, 10);
+    EXPECT_EQ(1, m_encodedBuffers);
+
+    // The feeder loses its connection, but stays subscribed while it
+    // reconnects
+    int buffers = 0;
+    while (m_encodedBuffers == 1 && buffers < 10) {
+        pEncoder2->encodeBuffer(m_samples, 20);
+        ++buffers;
+    }
+    EXPECT_EQ(2, m_encodedBuffers);
+    // Only a few buffers are lost
+    EXPECT_LT(buffers, 10);
+    pEncoder2->encodeBuffer(m_samples, 30);
+    EXPECT_EQ(3, m_encodedBuffers);
+    EXPECT_EQ(QByteArray("\x0a\x14\x1e"), callback2.m_data);
+}
+
+TEST_F(SharedEncoderPoolTest, stalledSubscriberDropsOldData) {
+    TestEncoderCallback callback1;
+    TestEncoderCallback callback2;
+    EncoderPointer pEncoder1 = createEncoder(ENCODING_MP3, 128, &callback1);
+    EncoderPointer pEncoder2 = createEncoder(ENCODING_MP3, 128, &callback2);
+    // The second connection does not process its samples
+    for (int i = 0; i < SharedEncoderPool::kMaxQueuedBytes + 10; ++i) {
+        pEncoder1->encodeBuffer(m_samples, 1);
+    }
+    EXPECT_EQ(SharedEncoderPool::kMaxQueuedBytes + 10, callback1.m_data.size());
+
+    pEncoder2->flush();
+    EXPECT_EQ(SharedEncoderPool::kMaxQueuedBytes, callback2.m_data.size());
+}
+
+} // namespace
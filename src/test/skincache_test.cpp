@@ -0,0 +1,82 @@
+#include <QDateTime>
+#include <QFile>
+#include <QImage>
+
+#include "skin/skincache.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+class SkinCacheTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(getTestDataDir().mkpath("skins/TestSkin"));
+        m_skinPath = getTestDataDir().filePath("skins/TestSkin");
+        m_cacheDir = getTestDataDir().filePath("skin_cache");
+        writeSkinFile("<skin></skin>");
+
+        m_image = QImage(4, 2, QImage::Format_ARGB32);
+        m_image.fill(qRgba(10, 20, 30, 40));
+    }
+
+    void writeSkinFile(const QByteArray& content) {
+        QFile file(QDir(m_skinPath).filePath("skin.xml"));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(content);
+    }
+
+    QString m_skinPath;
+    QString m_cacheDir;
+    QImage m_image;
+};
+
+TEST_F(SkinCacheTest, saveAndLoad) {
+    SkinCache cache(m_cacheDir, m_skinPath, "Scheme", 1.0);
+    EXPECT_FALSE(cache.load());
+    EXPECT_TRUE(cache.image("image.svg").isNull());
+    cache.insertImage("image.svg", m_image);
+    EXPECT_TRUE(cache.save());
+
+    SkinCache reloadedCache(m_cacheDir, m_skinPath, "Scheme", 1.0);
+    ASSERT_TRUE(reloadedCache.load());
+    const QImage image = reloadedCache.image("image.svg");
+    ASSERT_FALSE(image.isNull());
+    EXPECT_EQ(m_image.size(), image.size());
+    EXPECT_EQ(m_image.pixel(1, 1), image.pixel(1, 1));
+    EXPECT_TRUE(reloadedCache.image("other.svg").isNull());
+}
+
+TEST_F(SkinCacheTest, discardOutdated) {
+    SkinCache cache(m_cacheDir, m_skinPath, "Scheme", 1.0);
+    cache.insertImage("image.svg", m_image);
+    EXPECT_TRUE(cache.save());
+
+    EXPECT_FALSE(SkinCache(m_cacheDir, m_skinPath, "OtherScheme", 1.0).load());
+    EXPECT_FALSE(SkinCache(m_cacheDir, m_skinPath, "Scheme", 2.0).load());
+
+    writeSkinFile("<skin><modified/></skin>");
+    EXPECT_FALSE(SkinCache(m_cacheDir, m_skinPath, "Scheme", 1.0).load());
+}
+
+TEST_F(SkinCacheTest, keepWhenOnlyTouched) {
+    SkinCache cache(m_cacheDir, m_skinPath, "Scheme", 1.0);
+    cache.insertImage("image.svg", m_image);
+    EXPECT_TRUE(cache.save());
+
+    // Same contents, but a different modification time
+    QFile skinFile(QDir(m_skinPath).filePath("skin.xml"));
+    ASSERT_TRUE(skinFile.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(skinFile.setFileTime(
+            QDateTime::currentDateTime().addDays(-1),
+            QFileDevice::FileModificationTime));
+    skinFile.close();
+
+    SkinCache touchedCache(m_cacheDir, m_skinPath, "Scheme", 1.0);
+    ASSERT_TRUE(touchedCache.load());
+    EXPECT_FALSE(touchedCache.image("image.svg").isNull());
+    // Stores the new modification time
+    EXPECT_TRUE(touchedCache.save());
+    EXPECT_TRUE(SkinCache(m_cacheDir, m_skinPath, "Scheme", 1.0).load());
+}
+
+} // namespace
@@ -55,3 +55,50 @@ TEST_F(TrackDAOTest, detectMovedTracks) {
     QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
     EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
 }
+
+TEST_F(TrackDAOTest, getAndSaveMultipleTracks) {
+    TrackDAO& trackDAO = internalCollection()->getTrackDAO();
+
+    QList<TrackId> trackIds;
+    for (int i = 0; i < 3; ++i) {
+        TrackFile trackFile(
+                QDir(QDir::tempPath()),
+                QString("file%1.mp3").arg(i));
+        TrackPointer pTrack = Track::newTemporary(trackFile);
+        pTrack->setDuration(100 + i);
+        trackIds.append(internalCollection()->addTrack(pTrack, false));
+        ASSERT_TRUE(trackIds.last().isValid());
+    }
+
+    // The order of the ids is preserved, duplicates are resolved
+    // to the same track and invalid ids are skipped.
+    QList<TrackPointer> tracks = internalCollection()->getTracksById(
+            {trackIds[2], TrackId(), trackIds[0], trackIds[1], trackIds[2]});
+    ASSERT_EQ(4, tracks.size());
+    EXPECT_EQ(trackIds[2], tracks[0]->getId());
+    EXPECT_EQ(trackIds[0], tracks[1]->getId());
+    EXPECT_EQ(trackIds[1], tracks[2]->getId());
+    EXPECT_EQ(tracks[0], tracks[3]);
+    EXPECT_EQ(100, tracks[1]->getDuration());
+
+    QList<Track*> plainTracks;
+    for (int i = 0; i < 3; ++i) {
+        tracks[i]->setRating(i + 1);
+        ASSERT_TRUE(tracks[i]->isDirty());
+        plainTracks.append(tracks[i].get());
+    }
+    trackDAO.saveTracks(plainTracks);
+    for (const auto& pTrack : tracks) {
+        EXPECT_FALSE(pTrack->isDirty());
+    }
+
+    // Reload all tracks from the database
+    tracks.clear();
+    plainTracks.clear();
+    tracks = internalCollection()->getTracksById(trackIds);
+    ASSERT_EQ(3, tracks.size());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(trackIds[i], tracks[i]->getId());
+        EXPECT_EQ(i + 1, tracks[i]->getRating());
+    }
+}
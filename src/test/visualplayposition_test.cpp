@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "util/math.h"
+#include "waveform/visualplayposition.h"
+
+namespace {
+
+// 4096 frames per buffer at 44.1 kHz
+const int kBufferMicros = 92880;
+const int kLatencyMicros = 2 * kBufferMicros;
+// 144 Hz
+const int kVSyncMicros = 6944;
+// The time between the callback entry and the snapshot being visible
+const int kProcessingMicros = 500;
+// The track position that is played per buffer
+const double kPositionStep = 0.001;
+const double kPositionPerMicro = kPositionStep / kBufferMicros;
+
+// Feeds synthetic audio callback timings into the predictor and
+// displays the predicted play positions at a fixed refresh rate.
+class VisualPlayPositionPredictorTest : public testing::Test {
+  protected:
+    struct Result {
+        // The RMS deviation of the displayed advance per frame from the
+        // ideal advance, in µs of playback time
+        double jitterMicros;
+        // The maximum deviation of the displayed position from the
+        // position that is actually played, in µs of playback time
+        double maxErrorMicros;
+    };
+
+    VisualPlayPositionPredictorTest()
+            : m_random(1) {
+    }
+
+    // Uniformly distributed in [-maxValue, maxValue]
+    int random(int maxValue) {
+        m_random = m_random * 1103515245 + 12345;
+        if (maxValue == 0) {
+            return 0;
+        }
+        return static_cast<int>((m_random >> 8) % (2 * maxValue + 1)) - maxValue;
+    }
+
+    // The callback entries are delayed by up to callbackJitterMicros and
+    // the reported time from the callback entry to the DAC is off by up
+    // to latencyErrorMicros. If usePredictor is false, the raw
+    // extrapolated positions are displayed.
+    Result simulate(int frames, int callbackJitterMicros,
+            int latencyErrorMicros, bool usePredictor) {
+        VisualPlayPositionPredictor predictor;
+        double sumOfSquares = 0;
+        double maxErrorMicros = 0;
+        double previousPosition = 0;
+        int buffer = 0;
+        qint64 entryMicros = 0;
+        int entryToDacMicros = kLatencyMicros;
+        qint64 nextEntryMicros = kBufferMicros;
+        for (int frame = 0; frame < frames; ++frame) {
+            const qint64 vSyncMicros = kLatencyMicros +
+                    static_cast<qint64>(frame) * kVSyncMicros;
+            // The latest snapshot of the engine
+            while (nextEntryMicros + kProcessingMicros <= vSyncMicros) {
+                ++buffer;
+                entryMicros = nextEntryMicros;
+                const qint64 dacMicros =
+                        static_cast<qint64>(buffer) * kBufferMicros + kLatencyMicros;
+                entryToDacMicros = static_cast<int>(dacMicros - entryMicros) +
+                        random(latencyErrorMicros);
+                nextEntryMicros = static_cast<qint64>(buffer + 1) * kBufferMicros +
+                        callbackJitterMicros / 2 + random(callbackJitterMicros / 2);
+            }
+            const double enginePosition = buffer * kPositionStep;
+            const qint64 offset = vSyncMicros - entryMicros - entryToDacMicros;
+            const double rawPosition = enginePosition + kPositionPerMicro * offset;
+            const double position = usePredictor
+                    ? predictor.predict(vSyncMicros, rawPosition, kPositionPerMicro)
+                    : rawPosition;
+
+            const double truePosition = (vSyncMicros - kLatencyMicros) * kPositionPerMicro;
+            maxErrorMicros = math_max(maxErrorMicros,
+                    fabs(position - truePosition) / kPositionPerMicro);
+            if (frame > 0) {
+                const double deviationMicros =
+                        (position - previousPosition) / kPositionPerMicro -
+                        kVSyncMicros;
+                sumOfSquares += deviationMicros * deviationMicros;
+            }
+            previousPosition = position;
+        }
+        const Result result = {
+                sqrt(sumOfSquares / (frames - 1)),
+                maxErrorMicros};
+        return result;
+    }
+
+    quint32 m_random;
+};
+
+TEST_F(VisualPlayPositionPredictorTest, exactTimestamps) {
+    const Result raw = simulate(2000, 0, 0, false);
+    const Result predicted = simulate(2000, 0, 0, true);
+    EXPECT_LT(raw.jitterMicros, 1.0);
+    EXPECT_LT(predicted.jitterMicros, 1.0);
+    EXPECT_LT(predicted.maxErrorMicros, 1.0);
+}
+
+TEST_F(VisualPlayPositionPredictorTest, callbackJitterIsCompensated) {
+    // Exact reported latencies compensate the callback jitter
+    const Result predicted = simulate(2000, 5000, 0, true);
+    EXPECT_LT(predicted.jitterMicros, 1.0);
+    EXPECT_LT(predicted.maxErrorMicros, 1.0);
+}
+
+TEST_F(VisualPlayPositionPredictorTest, latencyErrorsAreSmoothed) {
+    const Result raw = simulate(2000, 5000, 2000, false);
+    const Result predicted = simulate(2000, 5000, 2000, true);
+    EXPECT_LT(predicted.jitterMicros, raw.jitterMicros / 2);
+    // Never further behind or ahead than the raw extrapolation
+    EXPECT_LE(predicted.maxErrorMicros, raw.maxErrorMicros);
+}
+
+TEST_F(VisualPlayPositionPredictorTest, sameFrame) {
+    VisualPlayPositionPredictor predictor;
+    const double position = predictor.predict(1000, 0.5, kPositionPerMicro);
+    EXPECT_EQ(position, predictor.predict(1000, 0.6, kPositionPerMicro));
+    EXPECT_EQ(position, predictor.predict(1001, 0.5, kPositionPerMicro));
+}
+
+TEST_F(VisualPlayPositionPredictorTest, seekIsAppliedImmediately) {
+    VisualPlayPositionPredictor predictor;
+    predictor.predict(0, 0.1, kPositionPerMicro);
+    predictor.predict(kVSyncMicros, 0.1 + kVSyncMicros * kPositionPerMicro, kPositionPerMicro);
+    EXPECT_EQ(0.5, predictor.predict(2 * kVSyncMicros, 0.5, kPositionPerMicro));
+    // Also while paused
+    EXPECT_EQ(0.5, predictor.predict(3 * kVSyncMicros, 0.5, 0.0));
+    EXPECT_EQ(0.25, predictor.predict(4 * kVSyncMicros, 0.25, 0.0));
+}
+
+} // namespace
@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QtDebug>
+#include <climits>
+
+#include "waveform/waveform.h"
+#include "waveform/waveformblockfile.h"
+
+namespace {
+
+const int kSampleRate = 44100;
+const int kVisualSampleRate = 441;
+
+WaveformPointer createWaveform(int seconds) {
+    WaveformPointer pWaveform(new Waveform(
+            kSampleRate, seconds * kSampleRate * 2, kVisualSampleRate, -1));
+    WaveformData* pData = pWaveform->data();
+    for (int i = 0; i < pWaveform->getDataSize(); ++i) {
+        pData[i].filtered.low = static_cast<unsigned char>((i * 7919) % 251);
+        pData[i].filtered.mid = static_cast<unsigned char>((i / 3) % 256);
+        pData[i].filtered.high = static_cast<unsigned char>((i * 31) % 97);
+        pData[i].filtered.all = static_cast<unsigned char>(i % 256);
+    }
+    pWaveform->setCompletion(pWaveform->getDataSize());
+    return pWaveform;
+}
+
+class WaveformBlockFileTest : public testing::Test {
+  protected:
+    WaveformBlockFileTest()
+            : m_pWaveform(createWaveform(60)) {
+    }
+
+    // Verifies the data elements [start, end) and expects all other
+    // elements to be silent
+    void expectDecoded(const Waveform& waveform, int start, int end) {
+        ASSERT_EQ(m_pWaveform->getDataSize(), waveform.getDataSize());
+        for (int i = 0; i < waveform.getDataSize(); ++i) {
+            const int expected = (i >= start && i < end) ? m_pWaveform->get(i).m_i : 0;
+            ASSERT_EQ(expected, waveform.get(i).m_i) << "data element " << i;
+        }
+    }
+
+    WaveformPointer m_pWaveform;
+};
+
+TEST_F(WaveformBlockFileTest, header) {
+    const QByteArray data = WaveformBlockFile::encode(*m_pWaveform, 1000);
+    ASSERT_TRUE(WaveformBlockFile::isBlockFile(data));
+    const WaveformBlockFile blockFile(data);
+    ASSERT_TRUE(blockFile.isValid());
+    EXPECT_EQ(m_pWaveform->getVisualSampleRate(), blockFile.visualSampleRate());
+    EXPECT_EQ(m_pWaveform->getAudioVisualRatio(), blockFile.audioVisualRatio());
+    EXPECT_EQ(m_pWaveform->getDataSize(), blockFile.dataSize());
+    EXPECT_EQ(1000, blockFile.blockSize());
+    EXPECT_EQ((m_pWaveform->getDataSize() + 999) / 1000, blockFile.blockCount());
+}
+
+TEST_F(WaveformBlockFileTest, decodeAll) {
+    const WaveformBlockFile blockFile(WaveformBlockFile::encode(*m_pWaveform, 1000));
+    Waveform waveform(blockFile, 0);
+    EXPECT_EQ(0, waveform.getCompletion());
+    EXPECT_FALSE(waveform.decodeBlocks(INT_MAX));
+    EXPECT_EQ(waveform.getDataSize(), waveform.getCompletion());
+    expectDecoded(waveform, 0, waveform.getDataSize());
+}
+
+TEST_F(WaveformBlockFileTest, priorityBlockFirst) {
+    const WaveformBlockFile blockFile(WaveformBlockFile::encode(*m_pWaveform, 1000));
+    Waveform waveform(blockFile, 5500);
+    EXPECT_TRUE(waveform.decodeBlocks(1));
+    EXPECT_EQ(1000, waveform.getCompletion());
+    expectDecoded(waveform, 5000, 6000);
+
+    // The following neighbour is decoded next
+    EXPECT_TRUE(waveform.decodeBlocks(1));
+    expectDecoded(waveform, 5000, 7000);
+
+    // The maxima include the decoded blocks
+    WaveformData maxima[ChannelCount];
+    WaveformData expected[ChannelCount];
+    waveform.getMaxima(0, waveform.getDataSize() / 2, maxima);
+    m_pWaveform->getMaxima(2500, 3500, expected);
+    EXPECT_EQ(expected[Left].m_i, maxima[Left].m_i);
+    EXPECT_EQ(expected[Right].m_i, maxima[Right].m_i);
+}
+
+TEST_F(WaveformBlockFileTest, convertLegacyFormat) {
+    const QByteArray data = WaveformBlockFile::convertLegacyFormat(
+            m_pWaveform->toByteArray());
+    const WaveformBlockFile blockFile(data);
+    ASSERT_TRUE(blockFile.isValid());
+    Waveform waveform(blockFile, 0);
+    waveform.decodeBlocks(INT_MAX);
+    expectDecoded(waveform, 0, waveform.getDataSize());
+
+    EXPECT_TRUE(WaveformBlockFile::convertLegacyFormat(QByteArray("corrupt")).isEmpty());
+}
+
+TEST_F(WaveformBlockFileTest, corruptBlockRemainsSilent) {
+    QByteArray data = WaveformBlockFile::encode(*m_pWaveform, 1000);
+    // The last block is stored at the end
+    data[data.size() - 1] = static_cast<char>(data[data.size() - 1] ^ 0xFF);
+    const WaveformBlockFile blockFile(data);
+    ASSERT_TRUE(blockFile.isValid());
+    Waveform waveform(blockFile, 0);
+    waveform.decodeBlocks(INT_MAX);
+    EXPECT_EQ(waveform.getDataSize(), waveform.getCompletion());
+    const int lastBlock = blockFile.blockCount() - 1;
+    expectDecoded(waveform, 0, blockFile.blockStart(lastBlock));
+}
+
+TEST_F(WaveformBlockFileTest, corruptHeader) {
+    const QByteArray data = WaveformBlockFile::encode(*m_pWaveform, 1000);
+    // The block index is incomplete
+    EXPECT_FALSE(WaveformBlockFile(data.left(40)).isValid());
+    EXPECT_FALSE(WaveformBlockFile(m_pWaveform->toByteArray()).isValid());
+}
+
+// The load time of a waveform with the given length in minutes in the
+// legacy format, i.e. a compressed protobuf message
+static void BM_LoadLegacyWaveform(benchmark::State& state) {
+    const QByteArray fileData = qCompress(
+            createWaveform(state.range_x() * 60)->toByteArray());
+    while (state.KeepRunning()) {
+        Waveform waveform(qUncompress(fileData));
+        benchmark::DoNotOptimize(waveform.getCompletion());
+    }
+}
+BENCHMARK(BM_LoadLegacyWaveform)->Range(4, 128);
+
+// The load time until the waveform around the play position is available
+static void BM_LoadWaveformBlockFilePriority(benchmark::State& state) {
+    const QByteArray fileData = WaveformBlockFile::encode(
+            *createWaveform(state.range_x() * 60));
+    while (state.KeepRunning()) {
+        Waveform waveform(WaveformBlockFile(fileData), 0);
+        waveform.decodeBlocks(1);
+        benchmark::DoNotOptimize(waveform.getCompletion());
+    }
+}
+BENCHMARK(BM_LoadWaveformBlockFilePriority)->Range(4, 128);
+
+// The load time until the whole waveform has been decoded
+static void BM_LoadWaveformBlockFile(benchmark::State& state) {
+    const QByteArray fileData = WaveformBlockFile::encode(
+            *createWaveform(state.range_x() * 60));
+    while (state.KeepRunning()) {
+        Waveform waveform(WaveformBlockFile(fileData), 0);
+        waveform.decodeBlocks(INT_MAX);
+        benchmark::DoNotOptimize(waveform.getCompletion());
+    }
+}
+BENCHMARK(BM_LoadWaveformBlockFile)->Range(4, 128);
+
+} // namespace
@@ -0,0 +1,587 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QColor>
+#include <QDomDocument>
+#include <QImage>
+#include <QPainter>
+#include <QtDebug>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "preferences/usersettings.h"
+#include "skin/skincontext.h"
+#include "test/mixxxtest.h"
+#include "track/beatgrid.h"
+#include "track/track.h"
+#include "util/assert.h"
+#include "util/math.h"
+#include "waveform/renderers/qtwaveformrendererfilteredsignal.h"
+#include "waveform/renderers/qtwaveformrenderersimplesignal.h"
+#include "waveform/renderers/waveformrenderbackground.h"
+#include "waveform/renderers/waveformrenderbeat.h"
+#include "waveform/renderers/waveformrendererendoftrack.h"
+#include "waveform/renderers/waveformrendererfilteredsignal.h"
+#include "waveform/renderers/waveformrendererhsv.h"
+#include "waveform/renderers/waveformrendererpreroll.h"
+#include "waveform/renderers/waveformrendererrgb.h"
+#include "waveform/renderers/waveformrendererrgbscanline.h"
+#include "waveform/renderers/waveformrendermark.h"
+#include "waveform/renderers/waveformrendermarkrange.h"
+#include "waveform/renderers/waveformwidgetrenderer.h"
+#include "waveform/waveform.h"
+#include "waveform/waveformwidgetfactory.h"
+
+namespace {
+
+const char* kGroup = "[Channel1]";
+const int kSampleRate = 44100;
+const int kVisualSampleRate = 441;
+const int kTrackSeconds = 300;
+const int kTrackSamples = kTrackSeconds * kSampleRate * 2;
+const double kBpm = 128.0;
+// The position of the cue point and of an 8 beat loop
+const double kLoopStartSeconds = 1.0;
+
+// The relevant parts of a deck's <Visual> node in a skin
+const char* kSkinNode =
+        "<Visual>"
+        "<BgColor>#000000</BgColor>"
+        "<SignalColor>#2A8CE0</SignalColor>"
+        "<SignalLowColor>#E0502A</SignalLowColor>"
+        "<SignalMidColor>#2AE050</SignalMidColor>"
+        "<SignalHighColor>#502AE0</SignalHighColor>"
+        "<AxesColor>#FFFFFF</AxesColor>"
+        "<PlayPosColor>#FF0000</PlayPosColor>"
+        "<BeatColor>#CCCCCC</BeatColor>"
+        "<MarkRange>"
+        "<StartControl>loop_start_position</StartControl>"
+        "<EndControl>loop_end_position</EndControl>"
+        "<EnabledControl>loop_enabled</EnabledControl>"
+        "<Color>#00FF00</Color>"
+        "<DisabledColor>#FFFFFF</DisabledColor>"
+        "</MarkRange>"
+        "<Mark>"
+        "<Control>cue_point</Control>"
+        "<Text>CUE</Text>"
+        "<Align>top|right</Align>"
+        "<Color>#FF0000</Color>"
+        "<TextColor>#FFFFFF</TextColor>"
+        "</Mark>"
+        "</Visual>";
+
+// Fills the visual frame of a synthetic waveform
+typedef void (*FillVisualFrame)(int frame, WaveformData* pFrame);
+
+// A synthetic waveform that resembles four-on-the-floor music, i.e. a
+// strong low band on every beat with mid and high content in between
+void fillBeatFrame(int frame, WaveformData* pFrame) {
+    const double visualFramesPerBeat = kVisualSampleRate * 60.0 / kBpm;
+    const double beatPhase = fmod(frame / visualFramesPerBeat, 1.0);
+    for (int channel = 0; channel < 2; ++channel) {
+        const int i = frame * 2 + channel;
+        const int low = static_cast<int>(255 * exp(-6.0 * beatPhase));
+        const int mid = 60 + static_cast<int>(40 * sin(i * 0.05));
+        const int high = 30 + (i * 7919) % 50;
+        pFrame[channel].filtered.low = static_cast<unsigned char>(low);
+        pFrame[channel].filtered.mid = static_cast<unsigned char>(mid);
+        pFrame[channel].filtered.high = static_cast<unsigned char>(high);
+        pFrame[channel].filtered.all = static_cast<unsigned char>(
+                math_min(255, (low + mid + high) / 2));
+    }
+}
+
+// The sections of the synthetic waveform that is used for verifying the
+// signal renderers. Each section spans kSectionFrames visual frames,
+// the remainder of the track is silent.
+enum Section {
+    kSilence,
+    kFullLow,
+    kHalfLow,
+    kFullHigh,
+    kSectionCount
+};
+const int kSectionFrames = 40;
+
+void fillSectionFrame(int frame, WaveformData* pFrame) {
+    const int section = frame / kSectionFrames;
+    unsigned char low = 0;
+    unsigned char high = 0;
+    switch (section) {
+    case kFullLow:
+        low = 255;
+        break;
+    case kHalfLow:
+        low = 128;
+        break;
+    case kFullHigh:
+        high = 255;
+        break;
+    default:
+        break;
+    }
+    for (int channel = 0; channel < 2; ++channel) {
+        pFrame[channel].filtered.low = low;
+        pFrame[channel].filtered.mid = 0;
+        pFrame[channel].filtered.high = high;
+        pFrame[channel].filtered.all = low + high;
+    }
+}
+
+TrackPointer createTrack(FillVisualFrame fillVisualFrame = fillBeatFrame) {
+    TrackPointer pTrack(Track::newTemporary());
+    pTrack->setSampleRate(kSampleRate);
+    pTrack->setChannels(2);
+    pTrack->setDuration(static_cast<double>(kTrackSeconds));
+
+    WaveformPointer pWaveform(new Waveform(
+            kSampleRate, kTrackSamples, kVisualSampleRate, -1));
+    WaveformData* pData = pWaveform->data();
+    // The data elements are interleaved stereo
+    for (int frame = 0; frame < pWaveform->getDataSize() / 2; ++frame) {
+        fillVisualFrame(frame, &pData[frame * 2]);
+    }
+    pWaveform->setCompletion(pWaveform->getDataSize());
+    pTrack->setWaveform(pWaveform);
+
+    auto pGrid = std::make_unique<BeatGrid>(*pTrack, kSampleRate);
+    pGrid->setBpm(kBpm);
+    pTrack->setBeats(BeatsPointer(pGrid.release()));
+    return pTrack;
+}
+
+// The signal renderers and WaveformRendererEndOfTrack access the
+// WaveformWidgetFactory singleton. It is destroyed again so that its
+// state does not leak into other tests.
+class ScopedWaveformWidgetFactory {
+  public:
+    ScopedWaveformWidgetFactory() {
+        WaveformWidgetFactory::createInstance();
+    }
+    ~ScopedWaveformWidgetFactory() {
+        WaveformWidgetFactory::destroy();
+    }
+};
+
+// Renders a deck with a synthetic track offscreen like the waveform
+// widgets do, but without a VSyncThread and without an engine.
+class OffscreenWaveform {
+  public:
+    explicit OffscreenWaveform(UserSettingsPointer pConfig)
+            : m_pConfig(pConfig),
+              m_renderer(kGroup) {
+        addControl("[Master]", "audio_buffer_size", 23.2);
+        addControl(kGroup, "track_samples", kTrackSamples);
+        addControl(kGroup, "rate_ratio", 1.0);
+        addControl(kGroup, "total_gain", 0.5);
+        addControl(kGroup, "filterWaveformEnable", 1.0);
+        addControl(kGroup, "filterLow", 1.0);
+        addControl(kGroup, "filterMid", 1.0);
+        addControl(kGroup, "filterHigh", 1.0);
+        addControl(kGroup, "filterLowKill", 0.0);
+        addControl(kGroup, "filterMidKill", 0.0);
+        addControl(kGroup, "filterHighKill", 0.0);
+        // Blinks during the whole benchmark
+        addControl(kGroup, "end_of_track", 1.0);
+        addControl(kGroup, "time_remaining", 10.0);
+        const double loopStart = kLoopStartSeconds * kSampleRate * 2;
+        addControl(kGroup, "cue_point", loopStart);
+        addControl(kGroup, "loop_start_position", loopStart);
+        addControl(kGroup, "loop_end_position",
+                loopStart + 8 * 60.0 / kBpm * kSampleRate * 2);
+        addControl(kGroup, "loop_enabled", 1.0);
+    }
+
+    template<class T_Renderer>
+    void addRenderer() {
+        m_renderer.addRenderer<T_Renderer>();
+    }
+
+    // Must be invoked after all renderers have been added
+    void init(int length, int breadth, double zoom,
+            TrackPointer pTrack = createTrack()) {
+        VERIFY_OR_DEBUG_ASSERT(m_renderer.init()) {
+            return;
+        }
+        QDomDocument document;
+        document.setContent(QString(kSkinNode));
+        SkinContext context(m_pConfig, QString());
+        m_renderer.setup(document.documentElement(), context);
+        m_renderer.resize(length, breadth, 1.0f);
+        m_renderer.setZoom(zoom);
+        m_renderer.setDisplayBeatGridAlpha(90);
+        m_renderer.setTrack(pTrack);
+        m_image = QImage(length, breadth, QImage::Format_ARGB32_Premultiplied);
+        m_image.fill(Qt::transparent);
+    }
+
+    // Renders the frame at the given play position in seconds
+    void render(double playPositionSeconds) {
+        m_renderer.prepareFrame(playPositionSeconds / kTrackSeconds);
+        QPainter painter(&m_image);
+        m_renderer.draw(&painter, nullptr);
+        m_renderer.setFrameRendered();
+    }
+
+    const QImage& image() const {
+        return m_image;
+    }
+
+  private:
+    void addControl(const char* group, const char* item, double value) {
+        auto pControl = std::make_unique<ControlObject>(ConfigKey(group, item));
+        pControl->set(value);
+        m_controls.push_back(std::move(pControl));
+    }
+
+    // Must outlive the renderer
+    ScopedWaveformWidgetFactory m_factory;
+    UserSettingsPointer m_pConfig;
+    // Must outlive the renderer and its proxies
+    std::vector<std::unique_ptr<ControlObject>> m_controls;
+    WaveformWidgetRenderer m_renderer;
+    QImage m_image;
+};
+
+// The number of pixels that differ from the transparent initial image
+int countPaintedPixels(const QImage& image) {
+    int count = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        const QRgb* pLine = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            if (qAlpha(pLine[x]) != 0) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+// The number of painted pixels in the column x
+int countPaintedPixelsInColumn(const QImage& image, int x) {
+    int count = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        if (qAlpha(image.pixel(x, y)) != 0) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+// The number of painted pixels in the columns [firstX, lastX]
+int countPaintedPixelsInColumns(const QImage& image, int firstX, int lastX) {
+    int count = 0;
+    for (int x = math_max(firstX, 0); x <= math_min(lastX, image.width() - 1); ++x) {
+        count += countPaintedPixelsInColumn(image, x);
+    }
+    return count;
+}
+
+const int kLength = 400;
+const int kBreadth = 100;
+// The signal renderers paint at most the axis and the outline of an
+// empty polygon if the waveform is silent
+const int kMaxAxisPixels = 3;
+// The tolerance for positions and heights in pixels, which accounts for
+// rounding the play position and for antialiasing
+const int kTolerance = 2;
+
+// The column of a position in the track in seconds if the play position
+// is displayed in the center of the widget
+int columnOf(double positionSeconds, double playPositionSeconds, double zoom) {
+    return static_cast<int>(kLength / 2 +
+            (positionSeconds - playPositionSeconds) * kVisualSampleRate / zoom);
+}
+
+class WaveformRendererTest : public MixxxTest {
+  protected:
+    // Renders the synthetic sections without zoom, i.e. one visual frame
+    // per pixel at the original tempo, with the start of the track at the
+    // play marker. A lower rate displays fewer frames per pixel.
+    template<class T_Renderer>
+    QImage renderSections(double rateRatio = 1.0) {
+        OffscreenWaveform waveform(config());
+        waveform.addRenderer<T_Renderer>();
+        waveform.init(kLength, kBreadth, 1.0, createTrack(fillSectionFrame));
+        ControlObject::set(ConfigKey(kGroup, "rate_ratio"), rateRatio);
+        waveform.render(0.0);
+        return waveform.image();
+    }
+
+    // The column in the middle of a section rendered by renderSections()
+    static int columnOfSection(Section section) {
+        return kLength / 2 + section * kSectionFrames + kSectionFrames / 2;
+    }
+
+    static int sectionHeight(const QImage& image, Section section) {
+        return countPaintedPixelsInColumn(image, columnOfSection(section));
+    }
+
+    static QRgb sectionColor(const QImage& image, Section section) {
+        // Above the axis in the center
+        return image.pixel(columnOfSection(section), kBreadth / 2 - 10);
+    }
+
+    template<class T_Renderer>
+    void expectAmplitudesOfSections(const char* rendererName) {
+        SCOPED_TRACE(rendererName);
+        const QImage image = renderSections<T_Renderer>();
+        // Before the start of the track
+        EXPECT_LE(countPaintedPixelsInColumn(image, kLength / 4), kMaxAxisPixels);
+        EXPECT_LE(sectionHeight(image, kSilence), kMaxAxisPixels);
+        EXPECT_GT(sectionHeight(image, kHalfLow), kMaxAxisPixels);
+        EXPECT_GT(sectionHeight(image, kFullLow), sectionHeight(image, kHalfLow));
+        EXPECT_GT(sectionHeight(image, kFullHigh), kMaxAxisPixels);
+        // The remainder of the track after the sections is silent
+        EXPECT_LE(countPaintedPixelsInColumn(image, columnOfSection(kSectionCount)),
+                kMaxAxisPixels);
+    }
+
+    // Less than one visual frame per pixel must not leave gaps
+    template<class T_Renderer>
+    void expectContinuousSectionsBelowOneFramePerPixel(const char* rendererName) {
+        SCOPED_TRACE(rendererName);
+        // Two pixels per visual frame
+        const double rateRatio = 0.5;
+        const QImage image = renderSections<T_Renderer>(rateRatio);
+        const double pixelsPerFrame = 1.0 / rateRatio;
+        const int firstX = kLength / 2 +
+                static_cast<int>(kFullLow * kSectionFrames * pixelsPerFrame);
+        const int lastX = kLength / 2 +
+                static_cast<int>(kHalfLow * kSectionFrames * pixelsPerFrame);
+        ASSERT_LT(lastX, kLength);
+        // The columns at the boundaries of the section are not checked
+        for (int x = firstX + kTolerance; x < lastX - kTolerance; ++x) {
+            EXPECT_GT(countPaintedPixelsInColumn(image, x), kMaxAxisPixels)
+                    << "column " << x;
+        }
+    }
+
+    // Renders the decorations of the synthetic track with the default
+    // zoom, so the preroll, the cue point and the loop are visible.
+    template<class T_Renderer>
+    QImage renderDecoration() {
+        OffscreenWaveform waveform(config());
+        waveform.addRenderer<T_Renderer>();
+        waveform.init(kLength, kBreadth, kZoom);
+        waveform.render(kPlayPositionSeconds);
+        return waveform.image();
+    }
+
+    static int columnOfDecoration(double positionSeconds) {
+        return columnOf(positionSeconds, kPlayPositionSeconds, kZoom);
+    }
+
+    static constexpr double kZoom = WaveformWidgetRenderer::s_waveformDefaultZoom;
+    static constexpr double kPlayPositionSeconds = kLoopStartSeconds / 2;
+};
+
+TEST_F(WaveformRendererTest, signalRenderersPaintAmplitudes) {
+    expectAmplitudesOfSections<WaveformRendererFilteredSignal>(
+            "WaveformRendererFilteredSignal");
+    expectAmplitudesOfSections<WaveformRendererHSV>(
+            "WaveformRendererHSV");
+    expectAmplitudesOfSections<WaveformRendererRGB>(
+            "WaveformRendererRGB");
+    expectAmplitudesOfSections<WaveformRendererRGBScanline>(
+            "WaveformRendererRGBScanline");
+    expectAmplitudesOfSections<QtWaveformRendererFilteredSignal>(
+            "QtWaveformRendererFilteredSignal");
+    expectAmplitudesOfSections<QtWaveformRendererSimpleSignal>(
+            "QtWaveformRendererSimpleSignal");
+}
+
+TEST_F(WaveformRendererTest, signalRenderersPaintBelowOneFramePerPixel) {
+    expectContinuousSectionsBelowOneFramePerPixel<WaveformRendererFilteredSignal>(
+            "WaveformRendererFilteredSignal");
+    expectContinuousSectionsBelowOneFramePerPixel<WaveformRendererHSV>(
+            "WaveformRendererHSV");
+    expectContinuousSectionsBelowOneFramePerPixel<WaveformRendererRGB>(
+            "WaveformRendererRGB");
+    expectContinuousSectionsBelowOneFramePerPixel<WaveformRendererRGBScanline>(
+            "WaveformRendererRGBScanline");
+}
+
+TEST_F(WaveformRendererTest, filteredSignalRendererPaintsBands) {
+    const QImage image = renderSections<WaveformRendererFilteredSignal>();
+    // Each band spans the breadth for the maximum amplitude
+    EXPECT_NEAR(sectionHeight(image, kFullLow), kBreadth, kTolerance);
+    EXPECT_NEAR(sectionHeight(image, kHalfLow), kBreadth * 128 / 255, kTolerance);
+    EXPECT_NEAR(sectionHeight(image, kFullHigh), kBreadth, kTolerance);
+    EXPECT_EQ(QColor("#E0502A").rgb(), sectionColor(image, kFullLow));
+    EXPECT_EQ(QColor("#E0502A").rgb(), sectionColor(image, kHalfLow));
+    EXPECT_EQ(QColor("#502AE0").rgb(), sectionColor(image, kFullHigh));
+}
+
+TEST_F(WaveformRendererTest, hsvRendererPaintsAmplitude) {
+    const QImage image = renderSections<WaveformRendererHSV>();
+    EXPECT_NEAR(sectionHeight(image, kFullLow), kBreadth, kTolerance);
+    EXPECT_NEAR(sectionHeight(image, kHalfLow), kBreadth * 128 / 255, kTolerance);
+    EXPECT_NEAR(sectionHeight(image, kFullHigh), kBreadth, kTolerance);
+}
+
+TEST_F(WaveformRendererTest, rgbRenderersPaintBands) {
+    // The amplitude is normalized to the amplitude of all bands at
+    // their maximum
+    const double fullHeight = kBreadth / sqrt(3.0);
+    for (const QImage& image : {
+                 renderSections<WaveformRendererRGB>(),
+                 renderSections<WaveformRendererRGBScanline>()}) {
+        EXPECT_NEAR(sectionHeight(image, kFullLow), fullHeight, kTolerance);
+        EXPECT_NEAR(sectionHeight(image, kHalfLow), fullHeight * 128 / 255, kTolerance);
+        EXPECT_NEAR(sectionHeight(image, kFullHigh), fullHeight, kTolerance);
+        // The skin does not define RGB colors, the defaults are used
+        EXPECT_EQ(qRgb(255, 0, 0), sectionColor(image, kFullLow));
+        EXPECT_EQ(qRgb(255, 0, 0), sectionColor(image, kHalfLow));
+        EXPECT_EQ(qRgb(0, 0, 255), sectionColor(image, kFullHigh));
+    }
+}
+
+TEST_F(WaveformRendererTest, rgbScanlineRendererMatchesRgbRenderer) {
+    // One visual frame per pixel, the QPainter renderer draws with a pen
+    // that is one pixel wide
+    const QImage expected = renderSections<WaveformRendererRGB>();
+    const QImage actual = renderSections<WaveformRendererRGBScanline>();
+    ASSERT_EQ(expected.size(), actual.size());
+    int differentPixels = 0;
+    for (int y = 0; y < expected.height(); ++y) {
+        for (int x = 0; x < expected.width(); ++x) {
+            if (expected.pixel(x, y) != actual.pixel(x, y)) {
+                ++differentPixels;
+            }
+        }
+    }
+    EXPECT_EQ(0, differentPixels);
+}
+
+TEST_F(WaveformRendererTest, backgroundRendererFills) {
+    const QImage image = renderDecoration<WaveformRenderBackground>();
+    EXPECT_EQ(kLength * kBreadth, countPaintedPixels(image));
+    EXPECT_EQ(qRgb(0, 0, 0), image.pixel(0, 0));
+    EXPECT_EQ(qRgb(0, 0, 0), image.pixel(kLength - 1, kBreadth - 1));
+}
+
+TEST_F(WaveformRendererTest, beatRendererPaintsBeats) {
+    const QImage image = renderDecoration<WaveformRenderBeat>();
+    const double beatSeconds = 60.0 / kBpm;
+    for (int beat = 0; beat < 4; ++beat) {
+        SCOPED_TRACE(beat);
+        const int x = columnOfDecoration(beat * beatSeconds);
+        EXPECT_GT(countPaintedPixelsInColumns(image, x - kTolerance, x + kTolerance), 0);
+        // Nothing is painted between the beats
+        const int xBetween = columnOfDecoration((beat + 0.5) * beatSeconds);
+        EXPECT_EQ(0, countPaintedPixelsInColumns(
+                image, xBetween - kTolerance, xBetween + kTolerance));
+    }
+}
+
+TEST_F(WaveformRendererTest, prerollRendererPaintsBeforeTrackStart) {
+    const QImage image = renderDecoration<WaveformRendererPreroll>();
+    const int trackStartX = columnOfDecoration(0.0);
+    EXPECT_GT(countPaintedPixelsInColumns(image, 0, trackStartX), 0);
+    EXPECT_EQ(0, countPaintedPixelsInColumns(
+            image, trackStartX + kTolerance, kLength - 1));
+}
+
+TEST_F(WaveformRendererTest, markRangeRendererPaintsLoop) {
+    const QImage image = renderDecoration<WaveformRenderMarkRange>();
+    const int loopStartX = columnOfDecoration(kLoopStartSeconds);
+    EXPECT_EQ(0, countPaintedPixelsInColumns(image, 0, loopStartX - kTolerance));
+    // The loop ends beyond the right border
+    for (int x = loopStartX + kTolerance; x < kLength; ++x) {
+        ASSERT_EQ(kBreadth, countPaintedPixelsInColumn(image, x)) << x;
+    }
+    // The color of an enabled loop
+    const QRgb pixel = image.pixel(kLength - 1, kBreadth / 2);
+    EXPECT_GT(qGreen(pixel), qRed(pixel));
+    EXPECT_GT(qGreen(pixel), qBlue(pixel));
+}
+
+TEST_F(WaveformRendererTest, markRendererPaintsCuePoint) {
+    const QImage image = renderDecoration<WaveformRenderMark>();
+    const int cueX = columnOfDecoration(kLoopStartSeconds);
+    // The line of the mark spans the breadth and the label is aligned
+    // to its right
+    EXPECT_GE(countPaintedPixelsInColumns(image, cueX - kTolerance, cueX + kTolerance),
+            kBreadth);
+    EXPECT_EQ(0, countPaintedPixelsInColumns(image, 0, cueX - 2 * kTolerance));
+}
+
+TEST_F(WaveformRendererTest, endOfTrackRendererPaintsRightHalf) {
+    {
+        OffscreenWaveform waveform(config());
+        waveform.addRenderer<WaveformRendererEndOfTrack>();
+        waveform.init(kLength, kBreadth, kZoom);
+        ControlObject::set(ConfigKey(kGroup, "end_of_track"), 0.0);
+        waveform.render(kPlayPositionSeconds);
+        EXPECT_EQ(0, countPaintedPixels(waveform.image()));
+    }
+    // The intensity of the warning blinks, but the left half inside of
+    // the border is never painted
+    const QImage image = renderDecoration<WaveformRendererEndOfTrack>();
+    const int border = 4;
+    const QImage leftHalf = image.copy(
+            border, border, kLength / 2 - 2 * border, kBreadth - 2 * border);
+    EXPECT_EQ(0, countPaintedPixels(leftHalf));
+}
+
+// The length of the benchmarked widgets in pixels and the zoom factor.
+// The breadth is proportional to the length.
+void benchmarkSizesAndZooms(benchmark::internal::Benchmark* pBenchmark) {
+    for (int length : {400, 1000, 2000}) {
+        for (int zoom : {1, 3, 10}) {
+            pBenchmark->ArgPair(length, zoom);
+        }
+    }
+}
+
+// Renders one frame per iteration offscreen, i.e. the reported time is
+// the time per frame. The play position advances by 1/60 s per frame like
+// during playback so that renderers cannot reuse the previous frame. It
+// wraps around after 3 s, so the preroll, the cue point and the loop are
+// visible most of the time.
+template<class T_Renderer>
+static void BM_WaveformRenderer(benchmark::State& state) {
+    const int length = state.range_x();
+    const int breadth = length * 3 / 20;
+    UserSettingsPointer pConfig(new UserSettings(QString()));
+    OffscreenWaveform waveform(pConfig);
+    waveform.addRenderer<T_Renderer>();
+    waveform.init(length, breadth, state.range_y());
+    double playPositionSeconds = 0.0;
+    while (state.KeepRunning()) {
+        waveform.render(playPositionSeconds);
+        playPositionSeconds += 1.0 / 60;
+        if (playPositionSeconds > 3 * kLoopStartSeconds) {
+            playPositionSeconds = 0.0;
+        }
+    }
+}
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, WaveformRenderBackground)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, WaveformRendererEndOfTrack)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, WaveformRendererPreroll)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, WaveformRenderMarkRange)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, WaveformRendererFilteredSignal)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, WaveformRendererHSV)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, WaveformRendererRGB)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, WaveformRendererRGBScanline)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, QtWaveformRendererFilteredSignal)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, QtWaveformRendererSimpleSignal)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, WaveformRenderBeat)
+        ->Apply(benchmarkSizesAndZooms);
+BENCHMARK_TEMPLATE(BM_WaveformRenderer, WaveformRenderMark)
+        ->Apply(benchmarkSizesAndZooms);
+
+} // namespace
@@ -0,0 +1,155 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QImage>
+#include <QPainter>
+#include <QPen>
+#include <QtDebug>
+
+#include "waveform/renderers/waveformscanlinerasterizer.h"
+
+namespace {
+
+const QRgb kRed = qRgb(255, 0, 0);
+const QRgb kGreen = qRgb(0, 255, 0);
+
+class WaveformScanlineRasterizerTest : public testing::Test {
+  protected:
+    WaveformScanlineRasterizer m_rasterizer;
+};
+
+TEST_F(WaveformScanlineRasterizerTest, emptyColumnsAreTransparent) {
+    m_rasterizer.reset(4, 3);
+    const QImage& image = m_rasterizer.rasterize();
+    ASSERT_EQ(4, image.width());
+    ASSERT_EQ(3, image.height());
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            EXPECT_EQ(0u, image.pixel(x, y));
+        }
+    }
+}
+
+TEST_F(WaveformScanlineRasterizerTest, spanCoverage) {
+    m_rasterizer.reset(3, 6);
+    m_rasterizer.setColumn(0, 1, 4, kRed);
+    // Reversed order
+    m_rasterizer.setColumn(1, 5, 2, kGreen);
+    // Exceeds the image in both directions
+    m_rasterizer.setColumn(2, -10, 10, kRed);
+    const QImage& image = m_rasterizer.rasterize();
+    for (int y = 0; y < image.height(); ++y) {
+        EXPECT_EQ((y >= 1 && y < 4) ? kRed : 0u, image.pixel(0, y));
+        EXPECT_EQ((y >= 2 && y < 5) ? kGreen : 0u, image.pixel(1, y));
+        EXPECT_EQ(kRed, image.pixel(2, y));
+    }
+}
+
+TEST_F(WaveformScanlineRasterizerTest, resetClearsColumns) {
+    m_rasterizer.reset(2, 2);
+    m_rasterizer.setColumn(0, 0, 2, kRed);
+    m_rasterizer.rasterize();
+    m_rasterizer.reset(2, 2);
+    const QImage& image = m_rasterizer.rasterize();
+    EXPECT_EQ(0u, image.pixel(0, 0));
+    EXPECT_EQ(0u, image.pixel(0, 1));
+}
+
+TEST_F(WaveformScanlineRasterizerTest, matchesDrawLine) {
+    const int length = 64;
+    const int breadth = 40;
+    m_rasterizer.reset(length, breadth);
+
+    // Drawn like WaveformRendererRGB with one line per column
+    QImage expected(length, breadth, QImage::Format_ARGB32_Premultiplied);
+    expected.fill(Qt::transparent);
+    QPainter painter(&expected);
+    painter.setRenderHints(QPainter::Antialiasing, false);
+    QPen pen;
+    pen.setCapStyle(Qt::FlatCap);
+    pen.setWidthF(1.0);
+    for (int x = 0; x < length; ++x) {
+        // Spans in both directions, empty spans and spans that exceed
+        // the image
+        const int y1 = (x * 7) % (breadth + 10) - 5;
+        const int y2 = (x * 13) % (breadth + 10) - 5;
+        const QRgb rgb = qRgb((x * 37) % 256, (x * 59) % 256, 255 - x);
+        m_rasterizer.setColumn(x, y1, y2, rgb);
+        pen.setColor(QColor(rgb));
+        painter.setPen(pen);
+        painter.drawLine(x, y1, x, y2);
+    }
+    painter.end();
+
+    QImage actual(length, breadth, QImage::Format_ARGB32_Premultiplied);
+    actual.fill(Qt::transparent);
+    QPainter(&actual).drawImage(0, 0, m_rasterizer.rasterize());
+
+    for (int y = 0; y < breadth; ++y) {
+        for (int x = 0; x < length; ++x) {
+            EXPECT_EQ(expected.pixel(x, y), actual.pixel(x, y))
+                    << "pixel " << x << "," << y;
+        }
+    }
+}
+
+// The extent and color of column x in frame i of the benchmarks
+void benchmarkColumn(int frame, int x, int breadth,
+        int* pY1, int* pY2, QRgb* pColor) {
+    const int halfBreadth = breadth / 2;
+    const int amplitude = ((x + frame) * 7919) % halfBreadth;
+    *pY1 = halfBreadth - amplitude;
+    *pY2 = halfBreadth + amplitude / 2;
+    *pColor = qRgb(amplitude % 256, (x * 3) % 256, (frame * 5) % 256);
+}
+
+const int kBenchmarkBreadth = 150;
+
+// Renders one frame per iteration with the given length offscreen
+static void BM_WaveformScanlineRasterizer(benchmark::State& state) {
+    const int length = state.range_x();
+    WaveformScanlineRasterizer rasterizer;
+    QImage target(length, kBenchmarkBreadth, QImage::Format_ARGB32_Premultiplied);
+    int frame = 0;
+    while (state.KeepRunning()) {
+        rasterizer.reset(length, kBenchmarkBreadth);
+        for (int x = 0; x < length; ++x) {
+            int y1, y2;
+            QRgb color;
+            benchmarkColumn(frame, x, kBenchmarkBreadth, &y1, &y2, &color);
+            rasterizer.setColumn(x, y1, y2, color);
+        }
+        QPainter painter(&target);
+        painter.drawImage(0, 0, rasterizer.rasterize());
+        ++frame;
+    }
+}
+BENCHMARK(BM_WaveformScanlineRasterizer)->Range(256, 4096);
+
+// The same frames drawn like WaveformRendererRGB with one line per column
+static void BM_WaveformDrawLine(benchmark::State& state) {
+    const int length = state.range_x();
+    QImage target(length, kBenchmarkBreadth, QImage::Format_ARGB32_Premultiplied);
+    QPen pen;
+    pen.setCapStyle(Qt::FlatCap);
+    pen.setWidthF(1.0);
+    QColor color;
+    int frame = 0;
+    while (state.KeepRunning()) {
+        QPainter painter(&target);
+        painter.setRenderHints(QPainter::Antialiasing, false);
+        for (int x = 0; x < length; ++x) {
+            int y1, y2;
+            QRgb rgb;
+            benchmarkColumn(frame, x, kBenchmarkBreadth, &y1, &y2, &rgb);
+            color.setRgb(rgb);
+            pen.setColor(color);
+            painter.setPen(pen);
+            painter.drawLine(x, y1, x, y2);
+        }
+        ++frame;
+    }
+}
+BENCHMARK(BM_WaveformDrawLine)->Range(256, 4096);
+
+} // namespace
@@ -148,18 +148,29 @@ TrackPointer GlobalTrackCacheLocker::lookupTrackByRef(
 GlobalTrackCacheResolver::GlobalTrackCacheResolver(
         TrackFile fileInfo,
         SecurityTokenPointer pSecurityToken)
-        : m_lookupResult(GlobalTrackCacheLookupResult::NONE) {
-    DEBUG_ASSERT(m_pInstance);
-    m_pInstance->resolve(this, std::move(fileInfo), TrackId(), std::move(pSecurityToken));
+        : GlobalTrackCacheResolver(
+                  fileInfo,
+                  TrackRef::fromFileInfo(fileInfo),
+                  std::move(pSecurityToken)) {
 }
 
 GlobalTrackCacheResolver::GlobalTrackCacheResolver(
         TrackFile fileInfo,
         TrackId trackId,
         SecurityTokenPointer pSecurityToken)
+        : GlobalTrackCacheResolver(
+                  fileInfo,
+                  TrackRef::fromFileInfo(fileInfo, std::move(trackId)),
+                  std::move(pSecurityToken)) {
+}
+
+GlobalTrackCacheResolver::GlobalTrackCacheResolver(
+        const TrackFile& fileInfo,
+        TrackRef trackRef,
+        SecurityTokenPointer pSecurityToken)
         : m_lookupResult(GlobalTrackCacheLookupResult::NONE) {
     DEBUG_ASSERT(m_pInstance);
-    m_pInstance->resolve(this, std::move(fileInfo), std::move(trackId), std::move(pSecurityToken));
+    m_pInstance->resolve(this, fileInfo, std::move(trackRef), std::move(pSecurityToken));
 }
 
 void GlobalTrackCacheResolver::initLookupResult(
@@ -288,7 +299,8 @@ GlobalTrackCache::GlobalTrackCache(
     : m_mutex(QMutex::Recursive),
       m_pSaver(pSaver),
       m_deleteTrackFn(deleteTrackFn),
-      m_tracksById(kUnorderedCollectionMinCapacity, DbId::hash_fun) {
+      m_tracksById(kUnorderedCollectionMinCapacity, DbId::hash_fun),
+      m_tracksByCanonicalLocation(kUnorderedCollectionMinCapacity) {
     DEBUG_ASSERT(m_pSaver);
     qRegisterMetaType<GlobalTrackCacheEntryPointer>("GlobalTrackCacheEntryPointer");
 }
@@ -303,7 +315,8 @@ void GlobalTrackCache::relocateTracks(
         kLogger.debug()
                 << "Relocating tracks";
     }
-    TracksByCanonicalLocation relocatedTracksByCanonicalLocation;
+    TracksByCanonicalLocation relocatedTracksByCanonicalLocation(
+            m_tracksByCanonicalLocation.bucket_count());
     for (auto&&
             i = m_tracksByCanonicalLocation.begin();
             i != m_tracksByCanonicalLocation.end();
@@ -503,36 +516,19 @@ TrackPointer GlobalTrackCache::revive(
 void GlobalTrackCache::resolve(
         GlobalTrackCacheResolver* /*in/out*/ pCacheResolver,
         TrackFile /*in*/ fileInfo,
-        TrackId trackId,
+        TrackRef trackRef,
         SecurityTokenPointer pSecurityToken) {
     DEBUG_ASSERT(pCacheResolver);
+    // The canonical location of the TrackRef has been obtained by the
+    // caller before locking the cache. This requires access to the file
+    // system and might block, which would stall all other threads if
+    // the cache was locked in the meantime.
+    const TrackId trackId = trackRef.getId();
     // Primary lookup by id (if available)
-    if (trackId.isValid()) {
-        if (debugLogEnabled()) {
-            kLogger.debug()
-                    << "Resolving track by id"
-                    << trackId;
-        }
-        auto strongPtr = lookupById(trackId);
-        if (strongPtr) {
-            if (debugLogEnabled()) {
-                kLogger.debug()
-                        << "Cache hit - found track by id"
-                        << trackId
-                        << strongPtr.get();
-            }
-            TrackRef trackRef = createTrackRef(*strongPtr);
-            pCacheResolver->initLookupResult(
-                    GlobalTrackCacheLookupResult::HIT,
-                    std::move(strongPtr),
-                    std::move(trackRef));
-            return;
-        }
+    if (resolveById(pCacheResolver, trackId)) {
+        return;
     }
     // Secondary lookup by canonical location
-    // The TrackRef is constructed now after the lookup by ID failed to
-    // avoid calculating the canonical file path if it is not needed.
-    TrackRef trackRef = TrackRef::fromFileInfo(fileInfo, trackId);
     if (trackRef.hasCanonicalLocation()) {
         if (debugLogEnabled()) {
             kLogger.debug()
@@ -573,7 +569,7 @@ void GlobalTrackCache::resolve(
             new Track(
                     std::move(fileInfo),
                     std::move(pSecurityToken),
-                    std::move(trackId)),
+                    trackId),
             GlobalTrackCacheEntry::TrackDeleter(m_deleteTrackFn));
 
     auto cacheEntryPtr = std::make_shared<GlobalTrackCacheEntry>(
@@ -620,6 +616,35 @@ void GlobalTrackCache::resolve(
             std::move(trackRef));
 }
 
+bool GlobalTrackCache::resolveById(
+        GlobalTrackCacheResolver* /*in/out*/ pCacheResolver,
+        const TrackId& trackId) {
+    if (!trackId.isValid()) {
+        return false;
+    }
+    if (debugLogEnabled()) {
+        kLogger.debug()
+                << "Resolving track by id"
+                << trackId;
+    }
+    auto strongPtr = lookupById(trackId);
+    if (!strongPtr) {
+        return false;
+    }
+    if (debugLogEnabled()) {
+        kLogger.debug()
+                << "Cache hit - found track by id"
+                << trackId
+                << strongPtr.get();
+    }
+    TrackRef trackRef = createTrackRef(*strongPtr);
+    pCacheResolver->initLookupResult(
+            GlobalTrackCacheLookupResult::HIT,
+            std::move(strongPtr),
+            std::move(trackRef));
+    return true;
+}
+
 TrackRef GlobalTrackCache::initTrackId(
         const TrackPointer& strongPtr,
         TrackRef trackRef,
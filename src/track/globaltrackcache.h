@@ -1,7 +1,6 @@
 #pragma once
 
 
-#include <map>
 #include <unordered_map>
 
 #include "track/track.h"
@@ -160,6 +159,12 @@ public:
 private:
     friend class GlobalTrackCache;
     GlobalTrackCacheResolver();
+    // The TrackRef with the canonical location must be created before
+    // the cache is locked by the base class constructor
+    GlobalTrackCacheResolver(
+                const TrackFile& fileInfo,
+                TrackRef trackRef,
+                SecurityTokenPointer pSecurityToken);
 
     void initLookupResult(
             GlobalTrackCacheLookupResult lookupResult,
@@ -226,9 +231,14 @@ private:
     void resolve(
             GlobalTrackCacheResolver* /*in/out*/ pCacheResolver,
             TrackFile /*in*/ fileInfo,
-            TrackId /*in*/ trackId,
+            TrackRef /*in*/ trackRef,
             SecurityTokenPointer /*in*/ pSecurityToken);
 
+    // Returns true on a cache hit
+    bool resolveById(
+            GlobalTrackCacheResolver* /*in/out*/ pCacheResolver,
+            const TrackId& trackId);
+
     TrackRef initTrackId(
             const TrackPointer& strongPtr,
             TrackRef trackRef,
@@ -257,6 +267,11 @@ private:
     TracksById m_tracksById;
 
     // This caches the unsaved Tracks by location
-    typedef std::map<QString, GlobalTrackCacheEntryPointer> TracksByCanonicalLocation;
+    struct CanonicalLocationHash {
+        std::size_t operator()(const QString& canonicalLocation) const {
+            return qHash(canonicalLocation);
+        }
+    };
+    typedef std::unordered_map<QString, GlobalTrackCacheEntryPointer, CanonicalLocationHash> TracksByCanonicalLocation;
     TracksByCanonicalLocation m_tracksByCanonicalLocation;
 };
@@ -0,0 +1,230 @@
+#include "util/asyncfilewriter.h"
+
+#include <QMutexLocker>
+
+#include "util/assert.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/performancetimer.h"
+
+namespace {
+
+const mixxx::Logger kLogger("AsyncFileWriter");
+
+} // anonymous namespace
+
+AsyncFileWriter::AsyncFileWriter(int bufferSize)
+        : m_bufferSize(bufferSize),
+          m_bufferPos(0),
+          m_pos(0),
+          m_size(0),
+          m_pendingRequests(0),
+          m_pendingBytes(0),
+          m_stop(false) {
+    DEBUG_ASSERT(bufferSize > 0);
+    m_buffer.reserve(m_bufferSize);
+    start(QThread::LowPriority);
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+    if (isOpen()) {
+        close();
+    }
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stop = true;
+        m_requestAvailable.wakeAll();
+    }
+    wait();
+}
+
+bool AsyncFileWriter::open(const QString& fileName) {
+    if (isOpen()) {
+        close();
+    }
+    // Unbuffered, the buffering is done here
+    auto pFile = std::make_shared<QFile>(fileName);
+    if (!pFile->open(QIODevice::WriteOnly | QIODevice::Unbuffered)) {
+        kLogger.warning() << "Failed to open" << fileName << pFile->errorString();
+        return false;
+    }
+    m_pFile = std::move(pFile);
+    m_bufferPos = 0;
+    m_pos = 0;
+    m_size = 0;
+    return true;
+}
+
+void AsyncFileWriter::close() {
+    VERIFY_OR_DEBUG_ASSERT(isOpen()) {
+        return;
+    }
+    submitBuffer();
+    Request request;
+    request.pFile = std::move(m_pFile);
+    request.pos = 0;
+    submit(std::move(request));
+    m_bufferPos = 0;
+    m_pos = 0;
+    m_size = 0;
+}
+
+void AsyncFileWriter::write(const char* data, int size) {
+    VERIFY_OR_DEBUG_ASSERT(isOpen()) {
+        return;
+    }
+    if (size <= 0) {
+        return;
+    }
+    if (m_bufferPos + m_buffer.size() != m_pos) {
+        // The encoder has seeked, e.g. for updating the header
+        submitBuffer();
+        m_bufferPos = m_pos;
+    }
+    m_buffer.append(data, size);
+    m_pos += size;
+    m_size = math_max(m_size, m_pos);
+    if (m_buffer.size() >= m_bufferSize) {
+        submitBuffer();
+        m_bufferPos = m_pos;
+    }
+}
+
+void AsyncFileWriter::seek(qint64 pos) {
+    VERIFY_OR_DEBUG_ASSERT(pos >= 0) {
+        return;
+    }
+    m_pos = pos;
+}
+
+void AsyncFileWriter::waitForPendingWrites() {
+    submitBuffer();
+    m_bufferPos = m_pos;
+    QMutexLocker locker(&m_mutex);
+    while (m_pendingRequests > 0) {
+        m_requestDone.wait(&m_mutex);
+    }
+}
+
+bool AsyncFileWriter::hasError() const {
+    QMutexLocker locker(&m_mutex);
+    return m_pFile && m_pFile == m_pFailedFile;
+}
+
+AsyncFileWriter::Stats AsyncFileWriter::stats() const {
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+void AsyncFileWriter::resetStats() {
+    QMutexLocker locker(&m_mutex);
+    m_stats = Stats();
+}
+
+void AsyncFileWriter::submitBuffer() {
+    if (m_buffer.isEmpty()) {
+        return;
+    }
+    Request request;
+    request.pFile = m_pFile;
+    request.pos = m_bufferPos;
+    request.data = m_buffer;
+    // The writer thread now owns the filled buffer, continue with a new one
+    m_buffer = QByteArray();
+    m_buffer.reserve(m_bufferSize);
+    submit(std::move(request));
+}
+
+void AsyncFileWriter::submit(Request request) {
+    QMutexLocker locker(&m_mutex);
+    if (m_pendingRequests > 0 &&
+            m_pendingBytes + request.data.size() > kMaxPendingBytes) {
+        // The storage is slower than the data is produced
+        ++m_stats.stalls;
+        while (m_pendingRequests > 0 &&
+                m_pendingBytes + request.data.size() > kMaxPendingBytes) {
+            m_requestDone.wait(&m_mutex);
+        }
+    }
+    m_pendingBytes += request.data.size();
+    ++m_pendingRequests;
+    m_requests.enqueue(std::move(request));
+    m_requestAvailable.wakeAll();
+}
+
+void AsyncFileWriter::run() {
+    QThread::currentThread()->setObjectName("AsyncFileWriter");
+
+    QMutexLocker locker(&m_mutex);
+    while (true) {
+        while (m_requests.isEmpty() && !m_stop) {
+            m_requestAvailable.wait(&m_mutex);
+        }
+        if (m_requests.isEmpty()) {
+            // Stopped and all requests are done
+            break;
+        }
+        const Request request = m_requests.dequeue();
+        const bool failed = request.pFile == m_pFailedFile;
+        locker.unlock();
+
+        PerformanceTimer timer;
+        timer.start();
+        bool success = true;
+        if (!failed || request.data.isEmpty()) {
+            success = processRequest(request);
+        }
+        const mixxx::Duration latency = timer.elapsed();
+
+        locker.relock();
+        if (!success) {
+            m_pFailedFile = request.pFile;
+        }
+        if (!failed && !request.data.isEmpty()) {
+            m_stats.bytesWritten += request.data.size();
+            ++m_stats.writes;
+            m_stats.totalWriteLatency += latency;
+            m_stats.maxWriteLatency = math_max(m_stats.maxWriteLatency, latency);
+        }
+        if (request.data.isEmpty() && request.pFile == m_pFailedFile) {
+            // The file is closed, nobody can ask for its error anymore
+            m_pFailedFile.reset();
+        }
+        m_pendingBytes -= request.data.size();
+        --m_pendingRequests;
+        m_requestDone.wakeAll();
+    }
+}
+
+bool AsyncFileWriter::processRequest(const Request& request) {
+    QFile* pFile = request.pFile.get();
+    if (request.data.isEmpty()) {
+        pFile->close();
+        return true;
+    }
+    if (pFile->pos() != request.pos && !pFile->seek(request.pos)) {
+        kLogger.warning() << "Failed to seek in" << pFile->fileName()
+                          << pFile->errorString();
+        return false;
+    }
+    if (pFile->write(request.data) != request.data.size()) {
+        kLogger.warning() << "Failed to write to" << pFile->fileName()
+                          << pFile->errorString();
+        return false;
+    }
+    return true;
+}
+
+QDebug operator<<(QDebug dbg, const AsyncFileWriter::Stats& stats) {
+    dbg << "wrote" << stats.bytesWritten << "bytes in" << stats.writes
+        << "writes,";
+    if (stats.writes > 0) {
+        dbg << "average latency"
+            << mixxx::Duration::fromNanos(
+                       stats.totalWriteLatency.toIntegerNanos() / stats.writes)
+                       .formatMillisWithUnit()
+            << "max latency" << stats.maxWriteLatency.formatMillisWithUnit()
+            << ",";
+    }
+    return dbg << stats.stalls << "stalls";
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDebug>
+#include <QFile>
+#include <QMutex>
+#include <QQueue>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+#include <memory>
+
+#include "util/duration.h"
+
+// Writes a file in a dedicated thread, so slow storage like SD cards or
+// network drives never blocks the writing thread.
+//
+// The data is collected in a large buffer that is handed over to the writer
+// thread when it is full, while the next buffer is filled. The position and
+// size of the file are tracked by the caller, so seek() and tell() like the
+// encoders use them for updating the file header don't wait for the writer
+// thread either.
+//
+// Files are opened in the calling thread to report errors immediately.
+// Closing a file, which flushes it, is done in the writer thread, so
+// switching to the next file doesn't wait for the previous one.
+//
+// All functions except stats() must be called from the same thread.
+class AsyncFileWriter : public QThread {
+    Q_OBJECT
+  public:
+    static constexpr int kDefaultBufferSize = 1 << 20;
+    // write() waits if the writer thread falls behind by more than this
+    static constexpr int kMaxPendingBytes = 64 << 20;
+
+    struct Stats {
+        Stats()
+                : bytesWritten(0),
+                  writes(0),
+                  stalls(0) {
+        }
+        qint64 bytesWritten;
+        int writes;
+        mixxx::Duration totalWriteLatency;
+        mixxx::Duration maxWriteLatency;
+        // The number of times the caller had to wait for the writer thread
+        int stalls;
+    };
+
+    explicit AsyncFileWriter(int bufferSize = kDefaultBufferSize);
+    // Waits until all data has been written
+    ~AsyncFileWriter() override;
+
+    // Opens a new file for writing and closes the previous one
+    bool open(const QString& fileName);
+    // Writes the remaining data and closes the file without waiting
+    void close();
+    bool isOpen() const {
+        return static_cast<bool>(m_pFile);
+    }
+
+    void write(const char* data, int size);
+    qint64 pos() const {
+        return m_pos;
+    }
+    void seek(qint64 pos);
+    qint64 size() const {
+        return m_size;
+    }
+
+    // Waits until all data has been written
+    void waitForPendingWrites();
+
+    // Returns true if writing to the current file has failed
+    bool hasError() const;
+
+    // Thread-safe
+    Stats stats() const;
+    void resetStats();
+
+  protected:
+    void run() override;
+
+  private:
+    struct Request {
+        std::shared_ptr<QFile> pFile;
+        // Write at this position, or close the file if data is empty
+        qint64 pos;
+        QByteArray data;
+    };
+
+    void submitBuffer();
+    void submit(Request request);
+    // Returns false if writing has failed
+    bool processRequest(const Request& request);
+
+    const int m_bufferSize;
+
+    // Owned by the calling thread
+    std::shared_ptr<QFile> m_pFile;
+    QByteArray m_buffer;
+    qint64 m_bufferPos;
+    qint64 m_pos;
+    qint64 m_size;
+
+    // Shared with the writer thread
+    mutable QMutex m_mutex;
+    QWaitCondition m_requestAvailable;
+    QWaitCondition m_requestDone;
+    QQueue<Request> m_requests;
+    // Queued requests and the one being processed
+    int m_pendingRequests;
+    qint64 m_pendingBytes;
+    bool m_stop;
+    std::shared_ptr<QFile> m_pFailedFile;
+    Stats m_stats;
+};
+
+QDebug operator<<(QDebug dbg, const AsyncFileWriter::Stats& stats);
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <QtGlobal>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "util/assert.h"
+#include "util/class.h"
+#include "util/math.h"
+
+// A ring buffer with a single writer and any number of readers, each with
+// its own read position.
+//
+// Unlike FIFO the writer is never blocked by a slow reader and every item is
+// written only once, no matter how many readers there are. Items that a
+// reader has not read before they are overwritten are lost for this reader
+// only, which is counted as an overflow of the reader.
+//
+// The writer announces the range it is about to overwrite before copying
+// the items and publishes them afterwards, similar to SeqLockValue. A reader
+// checks the announced range after copying and discards the items that
+// might have been overwritten during the copy.
+template<typename DataType>
+class MultiReaderFifo {
+    static_assert(std::is_trivially_copyable<DataType>::value,
+            "The items are copied while they might be modified concurrently");
+
+  public:
+    // Must be used from a single thread at a time. The FIFO must outlive
+    // its readers.
+    class Reader {
+      public:
+        int readAvailable() const {
+            const qint64 available =
+                    m_pFifo->m_writeEnd.load(std::memory_order_acquire) -
+                    m_readPos;
+            return static_cast<int>(math_min<qint64>(available, m_pFifo->m_size));
+        }
+
+        // Copies up to count of the oldest unread items and returns the
+        // number of items copied.
+        int read(DataType* pData, int count) {
+            const qint64 writeEnd = m_pFifo->m_writeEnd.load(std::memory_order_acquire);
+            skipOverwritten(writeEnd);
+            const int readCount = static_cast<int>(
+                    math_min<qint64>(writeEnd - m_readPos, count));
+            if (readCount <= 0) {
+                return 0;
+            }
+            m_pFifo->copyOut(pData, m_readPos, readCount);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // Drop what the writer has started to overwrite meanwhile
+            const qint64 writeBegin = m_pFifo->m_writeBegin.load(std::memory_order_relaxed);
+            const qint64 torn = math_min<qint64>(
+                    writeBegin - m_pFifo->m_size - m_readPos, readCount);
+            m_readPos += readCount;
+            if (torn <= 0) {
+                return readCount;
+            }
+            countOverflow(torn);
+            const int validCount = readCount - static_cast<int>(torn);
+            std::memmove(pData, pData + torn, sizeof(DataType) * validCount);
+            return validCount;
+        }
+
+        // Skips all unread items, e.g. after a pause
+        void flush() {
+            m_readPos = m_pFifo->m_writeEnd.load(std::memory_order_acquire);
+        }
+
+        // The number of times items were lost for this reader
+        int overflowCount() const {
+            return m_overflowCount;
+        }
+        qint64 itemsLost() const {
+            return m_itemsLost;
+        }
+        void resetOverflowCount() {
+            m_overflowCount = 0;
+            m_itemsLost = 0;
+        }
+
+      private:
+        friend class MultiReaderFifo;
+
+        explicit Reader(const MultiReaderFifo* pFifo)
+                : m_pFifo(pFifo),
+                  m_readPos(pFifo->m_writeEnd.load(std::memory_order_acquire)),
+                  m_overflowCount(0),
+                  m_itemsLost(0) {
+        }
+
+        void skipOverwritten(qint64 writeEnd) {
+            const qint64 lost = writeEnd - m_pFifo->m_size - m_readPos;
+            if (lost > 0) {
+                m_readPos += lost;
+                countOverflow(lost);
+            }
+        }
+
+        void countOverflow(qint64 lost) {
+            ++m_overflowCount;
+            m_itemsLost += lost;
+        }
+
+        const MultiReaderFifo* const m_pFifo;
+        qint64 m_readPos;
+        int m_overflowCount;
+        qint64 m_itemsLost;
+    };
+
+    // The size is rounded up to the next power of 2
+    explicit MultiReaderFifo(int size)
+            : m_size(roundUpToPowerOf2(size)),
+              m_data(new DataType[m_size]),
+              m_writeBegin(0),
+              m_writeEnd(0) {
+        DEBUG_ASSERT(m_size > 0);
+    }
+
+    int size() const {
+        return m_size;
+    }
+
+    // Must only be invoked from a single thread at a time. Never waits. Only
+    // the last size() items are kept if count exceeds the size.
+    void write(const DataType* pData, int count) {
+        if (count <= 0) {
+            return;
+        }
+        const qint64 writeEnd = m_writeEnd.load(std::memory_order_relaxed) + count;
+        if (count > m_size) {
+            pData += count - m_size;
+            count = m_size;
+        }
+        const qint64 writePos = writeEnd - count;
+        // The readers must not see the new end before the items have
+        // been copied
+        m_writeBegin.store(writeEnd, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        const int offset = static_cast<int>(writePos & (m_size - 1));
+        const int count1 = math_min(count, m_size - offset);
+        std::memcpy(&m_data[offset], pData, sizeof(DataType) * count1);
+        std::memcpy(&m_data[0], pData + count1, sizeof(DataType) * (count - count1));
+        m_writeEnd.store(writeEnd, std::memory_order_release);
+    }
+
+    // Returns a reader that starts with the items written after this call
+    std::unique_ptr<Reader> createReader() const {
+        return std::unique_ptr<Reader>(new Reader(this));
+    }
+
+  private:
+    void copyOut(DataType* pData, qint64 readPos, int count) const {
+        const int offset = static_cast<int>(readPos & (m_size - 1));
+        const int count1 = math_min(count, m_size - offset);
+        std::memcpy(pData, &m_data[offset], sizeof(DataType) * count1);
+        std::memcpy(pData + count1, &m_data[0], sizeof(DataType) * (count - count1));
+    }
+
+    const int m_size;
+    const std::unique_ptr<DataType[]> m_data;
+    // The total number of items written when the current write is done
+    std::atomic<qint64> m_writeBegin;
+    // The total number of items written and visible to the readers
+    std::atomic<qint64> m_writeEnd;
+
+    DISALLOW_COPY_AND_ASSIGN(MultiReaderFifo);
+};
@@ -445,6 +445,30 @@ void SampleUtil::deinterleaveBuffer(CSAMPLE* M_RESTRICT pDest1,
     }
 }
 
+// static
+void SampleUtil::deinterleaveClampBuffer(CSAMPLE* M_RESTRICT pDest1,
+        CSAMPLE* M_RESTRICT pDest2,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numFrames) {
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numFrames; ++i) {
+        pDest1[i] = clampSample(pSrc[i * 2]);
+        pDest2[i] = clampSample(pSrc[i * 2 + 1]);
+    }
+}
+
+// static
+void SampleUtil::mixStereoToMonoClampBuffer(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        SINT numFrames) {
+    const CSAMPLE_GAIN mixScale = CSAMPLE_GAIN_ONE
+            / (CSAMPLE_GAIN_ONE + CSAMPLE_GAIN_ONE);
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numFrames; ++i) {
+        pDest[i] = clampSample((pSrc[i * 2] + pSrc[i * 2 + 1]) * mixScale);
+    }
+}
+
 // static
 void SampleUtil::linearCrossfadeBuffers(CSAMPLE* pDest,
         const CSAMPLE* pSrcFadeOut, const CSAMPLE* pSrcFadeIn,
@@ -223,6 +223,16 @@ class SampleUtil {
     static void deinterleaveBuffer(CSAMPLE* pDest1, CSAMPLE* pDest2,
             const CSAMPLE* pSrc, SINT numSamples);
 
+    // Same as deinterleaveBuffer, but limits the values in pDest1 and pDest2
+    // to the valid range of CSAMPLE.
+    static void deinterleaveClampBuffer(CSAMPLE* pDest1, CSAMPLE* pDest2,
+            const CSAMPLE* pSrc, SINT numFrames);
+
+    // Mixes the stereo samples in pSrc down to the mono buffer pDest,
+    // limiting the values in pDest to the valid range of CSAMPLE.
+    static void mixStereoToMonoClampBuffer(CSAMPLE* pDest, const CSAMPLE* pSrc,
+            SINT numFrames);
+
     // Crossfade two buffers together and put the result in pDest.  All the
     // buffers must be the same length.  pDest may be an alias of the source
     // buffers.  It is preferable to use the copyWithRamping functions, but
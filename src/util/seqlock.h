@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QtGlobal>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+// A value with a single writer and any number of readers that is
+// protected by a sequence lock.
+//
+// The writer never waits. It increments the sequence number before and
+// after modifying the value, so the sequence number is odd while a write
+// is in progress. Readers copy the value and retry until they observe
+// the same even sequence number before and after the copy. Unlike
+// ControlValueAtomic a reader always gets the most recent value and
+// never an older one from the ring.
+template<typename T>
+class SeqLockValue {
+    static_assert(std::is_trivially_copyable<T>::value,
+            "The value is copied while it might be modified concurrently");
+
+  public:
+    SeqLockValue()
+            : m_value(),
+              m_sequence(0) {
+    }
+
+    // Must only be invoked from a single thread at a time.
+    void setValue(const T& value) {
+        const quint32 sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&m_value, &value, sizeof(T));
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    T getValue() const {
+        T value;
+        quint32 sequenceBefore;
+        quint32 sequenceAfter;
+        do {
+            sequenceBefore = m_sequence.load(std::memory_order_acquire);
+            std::memcpy(&value, &m_value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            sequenceAfter = m_sequence.load(std::memory_order_relaxed);
+        } while ((sequenceBefore & 1) || sequenceBefore != sequenceAfter);
+        return value;
+    }
+
+  private:
+    T m_value;
+    std::atomic<quint32> m_sequence;
+};
@@ -23,6 +23,7 @@ class Singleton {
     static void destroy() {
         if (m_instance) {
             delete m_instance;
+            m_instance = nullptr;
         }
     }
 
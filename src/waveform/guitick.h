@@ -10,9 +10,11 @@
 
 // A helper class that manages the "guiTickTime" COs, that drive updates of the
 // GUI from the VsyncThread at the user's configured FPS (possibly downsampled).
+// It also delivers the coalesced control updates to widgets once per frame.
 class GuiTick {
   public:
     GuiTick();
+    ~GuiTick();
     void process();
 
   private:
@@ -12,6 +12,10 @@ class QtVSyncTestRenderer : public WaveformRendererSignalBase {
 
     virtual void onSetup(const QDomNode &node);
     virtual void draw(QPainter* painter, QPaintEvent* event);
+    // The test pattern changes with every frame
+    bool needsRedraw() const override {
+        return true;
+    }
   private:
     int m_drawcount;
 };
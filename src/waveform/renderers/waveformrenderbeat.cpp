@@ -13,7 +13,8 @@
 #include "util/painterscope.h"
 
 WaveformRenderBeat::WaveformRenderBeat(WaveformWidgetRenderer* waveformWidgetRenderer)
-        : WaveformRendererAbstract(waveformWidgetRenderer) {
+        : WaveformRendererAbstract(waveformWidgetRenderer),
+          m_bBeatsChanged(true) {
     m_beats.resize(128);
 }
 
@@ -25,7 +26,32 @@ void WaveformRenderBeat::setup(const QDomNode& node, const SkinContext& context)
     m_beatColor = WSkinColor::getCorrectColor(m_beatColor).toRgb();
 }
 
+void WaveformRenderBeat::onSetTrack() {
+    m_bBeatsChanged = true;
+
+    if (m_loadedTrack) {
+        disconnect(m_loadedTrack.get(),
+                &Track::beatsUpdated,
+                this,
+                &WaveformRenderBeat::slotBeatsUpdated);
+    }
+
+    m_loadedTrack = m_waveformRenderer->getTrackInfo();
+    if (!m_loadedTrack) {
+        return;
+    }
+    connect(m_loadedTrack.get(),
+            &Track::beatsUpdated,
+            this,
+            &WaveformRenderBeat::slotBeatsUpdated);
+}
+
+void WaveformRenderBeat::slotBeatsUpdated() {
+    m_bBeatsChanged = true;
+}
+
 void WaveformRenderBeat::draw(QPainter* painter, QPaintEvent* /*event*/) {
+    m_bBeatsChanged = false;
     TrackPointer trackInfo = m_waveformRenderer->getTrackInfo();
 
     if (!trackInfo)
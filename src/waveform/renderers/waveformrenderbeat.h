@@ -2,12 +2,15 @@
 #define WAVEFORMRENDERBEAT_H
 
 #include <QColor>
+#include <QObject>
 
 #include "skin/skincontext.h"
+#include "track/track.h"
 #include "util/class.h"
 #include "waveform/renderers/waveformrendererabstract.h"
 
-class WaveformRenderBeat : public WaveformRendererAbstract {
+class WaveformRenderBeat : public QObject, public WaveformRendererAbstract {
+    Q_OBJECT
   public:
     explicit WaveformRenderBeat(WaveformWidgetRenderer* waveformWidgetRenderer);
     virtual ~WaveformRenderBeat();
@@ -15,9 +18,19 @@ class WaveformRenderBeat : public WaveformRendererAbstract {
     virtual void setup(const QDomNode& node, const SkinContext& context);
     virtual void draw(QPainter* painter, QPaintEvent* event);
 
+    void onSetTrack() override;
+    bool needsRedraw() const override {
+        return m_bBeatsChanged;
+    }
+
+  private slots:
+    void slotBeatsUpdated();
+
   private:
     QColor m_beatColor;
     QVector<QLineF> m_beats;
+    bool m_bBeatsChanged;
+    TrackPointer m_loadedTrack;
 
     DISALLOW_COPY_AND_ASSIGN(WaveformRenderBeat);
 };
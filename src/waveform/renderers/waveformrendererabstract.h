@@ -22,6 +22,13 @@ class WaveformRendererAbstract {
     virtual void onResize() {}
     virtual void onSetTrack() {}
 
+    // Returns true if the next frame of this renderer differs from the
+    // previously drawn one, even though play position, zoom and track data
+    // are unchanged. Frames without any changes are not rendered at all.
+    virtual bool needsRedraw() const {
+        return false;
+    }
+
   protected:
     bool isDirty() const {
         return m_dirty;
@@ -24,7 +24,8 @@ WaveformRendererEndOfTrack::WaveformRendererEndOfTrack(
         WaveformWidgetRenderer* waveformWidgetRenderer)
     : WaveformRendererAbstract(waveformWidgetRenderer),
       m_pEndOfTrackControl(nullptr),
-      m_pTimeRemainingControl(nullptr) {
+      m_pTimeRemainingControl(nullptr),
+      m_bBlinking(false) {
 }
 
 WaveformRendererEndOfTrack::~WaveformRendererEndOfTrack() {
@@ -57,9 +58,16 @@ void WaveformRendererEndOfTrack::onResize() {
     generateBackRects();
 }
 
+bool WaveformRendererEndOfTrack::needsRedraw() const {
+    // Redraw continuously while blinking and once more to remove the
+    // blinking after the warning has been reset.
+    return m_bBlinking || m_pEndOfTrackControl->toBool();
+}
+
 void WaveformRendererEndOfTrack::draw(QPainter* painter,
                                       QPaintEvent* /*event*/) {
-    if (!m_pEndOfTrackControl->toBool()) {
+    m_bBlinking = m_pEndOfTrackControl->toBool();
+    if (!m_bBlinking) {
         return;
     }
 
@@ -25,6 +25,7 @@ class WaveformRendererEndOfTrack : public WaveformRendererAbstract {
     virtual void setup(const QDomNode& node, const SkinContext& context);
     virtual void onResize();
     virtual void draw(QPainter* painter, QPaintEvent* event);
+    bool needsRedraw() const override;
 
   private:
     void generateBackRects();
@@ -34,6 +35,7 @@ class WaveformRendererEndOfTrack : public WaveformRendererAbstract {
 
     QColor m_color;
     PerformanceTimer m_timer;
+    bool m_bBlinking;
 
     QVector<QRect> m_backRects;
     QPen m_pen;
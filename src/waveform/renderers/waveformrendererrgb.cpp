@@ -111,32 +111,21 @@ void WaveformRendererRGB::draw(QPainter* painter,
         visualFrameStart = math_clamp(visualFrameStart, 0, lastVisualFrame);
         visualFrameStop = math_clamp(visualFrameStop, 0, lastVisualFrame);
 
-        int visualIndexStart = visualFrameStart * 2;
-        int visualIndexStop  = visualFrameStop * 2;
-
-        unsigned char maxLow  = 0;
-        unsigned char maxMid  = 0;
-        unsigned char maxHigh = 0;
-        float maxAll = 0.;
-        float maxAllNext = 0.;
-
-        for (int i = visualIndexStart;
-             i >= 0 && i + 1 < dataSize && i + 1 <= visualIndexStop; i += 2) {
-            const WaveformData& waveformData = data[i];
-            const WaveformData& waveformDataNext = data[i + 1];
-
-            maxLow  = math_max3(maxLow,  waveformData.filtered.low,  waveformDataNext.filtered.low);
-            maxMid  = math_max3(maxMid,  waveformData.filtered.mid,  waveformDataNext.filtered.mid);
-            maxHigh = math_max3(maxHigh, waveformData.filtered.high, waveformDataNext.filtered.high);
-            float all = pow(waveformData.filtered.low * lowGain, 2) +
-                pow(waveformData.filtered.mid * midGain, 2) +
-                pow(waveformData.filtered.high * highGain, 2);
-            maxAll = math_max(maxAll, all);
-            float allNext = pow(waveformDataNext.filtered.low * lowGain, 2) +
-                pow(waveformDataNext.filtered.mid * midGain, 2) +
-                pow(waveformDataNext.filtered.high * highGain, 2);
-            maxAllNext = math_max(maxAllNext, allNext);
-        }
+        // Including visualFrameStop
+        WaveformData maxima[ChannelCount];
+        waveform->getMaxima(visualFrameStart, visualFrameStop + 1, maxima);
+
+        const unsigned char maxLow = math_max(
+                maxima[Left].filtered.low, maxima[Right].filtered.low);
+        const unsigned char maxMid = math_max(
+                maxima[Left].filtered.mid, maxima[Right].filtered.mid);
+        const unsigned char maxHigh = math_max(
+                maxima[Left].filtered.high, maxima[Right].filtered.high);
+        // The amplitude is composed from the per-band maxima of each
+        // channel. This is an upper bound of the amplitude of all
+        // contained data points that is exact when not zoomed out.
+        const float maxAll = squaredAmplitude(maxima[Left], lowGain, midGain, highGain);
+        const float maxAllNext = squaredAmplitude(maxima[Right], lowGain, midGain, highGain);
 
         qreal maxLowF = maxLow * lowGain;
         qreal maxMidF = maxMid * midGain;
@@ -0,0 +1,142 @@
+#include "waveform/renderers/waveformrendererrgbscanline.h"
+
+#include "track/track.h"
+#include "util/math.h"
+#include "util/painterscope.h"
+#include "waveform/renderers/waveformwidgetrenderer.h"
+#include "waveform/waveform.h"
+
+WaveformRendererRGBScanline::WaveformRendererRGBScanline(
+        WaveformWidgetRenderer* waveformWidgetRenderer)
+        : WaveformRendererSignalBase(waveformWidgetRenderer) {
+}
+
+WaveformRendererRGBScanline::~WaveformRendererRGBScanline() {
+}
+
+void WaveformRendererRGBScanline::onSetup(const QDomNode& /* node */) {
+}
+
+void WaveformRendererRGBScanline::draw(QPainter* painter,
+        QPaintEvent* /*event*/) {
+    const TrackPointer trackInfo = m_waveformRenderer->getTrackInfo();
+    if (!trackInfo) {
+        return;
+    }
+
+    ConstWaveformPointer waveform = trackInfo->getWaveform();
+    if (waveform.isNull()) {
+        return;
+    }
+
+    const int dataSize = waveform->getDataSize();
+    if (dataSize <= 1) {
+        return;
+    }
+
+    PainterScope PainterScope(painter);
+
+    painter->setRenderHints(QPainter::Antialiasing, false);
+    painter->setRenderHints(QPainter::SmoothPixmapTransform, false);
+    painter->setWorldMatrixEnabled(false);
+    painter->resetTransform();
+
+    // Rotate if drawing vertical waveforms
+    if (m_waveformRenderer->getOrientation() == Qt::Vertical) {
+        painter->setTransform(QTransform(0, 1, 1, 0, 0, 0));
+    }
+
+    const double firstVisualIndex = m_waveformRenderer->getFirstDisplayedPosition() * dataSize;
+    const double lastVisualIndex = m_waveformRenderer->getLastDisplayedPosition() * dataSize;
+
+    const double offset = firstVisualIndex;
+
+    const int length = m_waveformRenderer->getLength();
+
+    // Represents the # of waveform data points per horizontal pixel.
+    const double gain = (lastVisualIndex - firstVisualIndex) / (double)length;
+
+    // Per-band gain from the EQ knobs.
+    float allGain(1.0), lowGain(1.0), midGain(1.0), highGain(1.0);
+    getGains(&allGain, &lowGain, &midGain, &highGain);
+
+    const int breadth = m_waveformRenderer->getBreadth();
+    const float halfBreadth = (float)breadth / 2.0;
+
+    const float heightFactor = allGain * halfBreadth / sqrtf(255 * 255 * 3);
+
+    // Draw reference line
+    painter->setPen(m_pColors->getAxesColor());
+    painter->drawLine(0, halfBreadth, length, halfBreadth);
+
+    m_rasterizer.reset(length, breadth);
+
+    QColor color;
+    const int lastVisualFrame = dataSize / 2 - 1;
+    for (int x = 0; x < length; ++x) {
+        // The sampling of visual frames is identical to WaveformRendererRGB
+        const double xVisualSampleIndex = gain * x + offset;
+        const double maxSamplingRange = gain / 2.0;
+        const int visualFrameStart = math_clamp(
+                int(xVisualSampleIndex / 2.0 - maxSamplingRange + 0.5),
+                0,
+                lastVisualFrame);
+        const int visualFrameStop = math_clamp(
+                int(xVisualSampleIndex / 2.0 + maxSamplingRange + 0.5),
+                0,
+                lastVisualFrame);
+
+        // Including visualFrameStop
+        WaveformData maxima[ChannelCount];
+        waveform->getMaxima(visualFrameStart, visualFrameStop + 1, maxima);
+
+        const qreal maxLowF = math_max(
+                maxima[Left].filtered.low, maxima[Right].filtered.low) * lowGain;
+        const qreal maxMidF = math_max(
+                maxima[Left].filtered.mid, maxima[Right].filtered.mid) * midGain;
+        const qreal maxHighF = math_max(
+                maxima[Left].filtered.high, maxima[Right].filtered.high) * highGain;
+
+        const qreal red = maxLowF * m_rgbLowColor_r + maxMidF * m_rgbMidColor_r + maxHighF * m_rgbHighColor_r;
+        const qreal green = maxLowF * m_rgbLowColor_g + maxMidF * m_rgbMidColor_g + maxHighF * m_rgbHighColor_g;
+        const qreal blue = maxLowF * m_rgbLowColor_b + maxMidF * m_rgbMidColor_b + maxHighF * m_rgbHighColor_b;
+
+        // Compute maximum (needed for value normalization)
+        const qreal max = math_max3(red, green, blue);
+
+        // Prevent division by zero
+        if (max <= 0.0f) {
+            continue;
+        }
+
+        // Converting via QColor guarantees the same rounding as when
+        // drawing with a QPen.
+        color.setRgbF(red / max, green / max, blue / max);
+
+        const float maxAll = squaredAmplitude(maxima[Left], lowGain, midGain, highGain);
+        const float maxAllNext = squaredAmplitude(maxima[Right], lowGain, midGain, highGain);
+        switch (m_alignment) {
+        case Qt::AlignBottom:
+        case Qt::AlignRight:
+            m_rasterizer.setColumn(x,
+                    breadth,
+                    breadth - (int)(heightFactor * sqrtf(math_max(maxAll, maxAllNext))),
+                    color.rgb());
+            break;
+        case Qt::AlignTop:
+        case Qt::AlignLeft:
+            m_rasterizer.setColumn(x,
+                    0,
+                    (int)(heightFactor * sqrtf(math_max(maxAll, maxAllNext))),
+                    color.rgb());
+            break;
+        default:
+            m_rasterizer.setColumn(x,
+                    (int)(halfBreadth - heightFactor * sqrtf(maxAll)),
+                    (int)(halfBreadth + heightFactor * sqrtf(maxAllNext)),
+                    color.rgb());
+        }
+    }
+
+    painter->drawImage(0, 0, m_rasterizer.rasterize());
+}
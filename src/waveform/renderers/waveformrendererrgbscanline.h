@@ -0,0 +1,23 @@
+#pragma once
+
+#include "util/class.h"
+#include "waveform/renderers/waveformrenderersignalbase.h"
+#include "waveform/renderers/waveformscanlinerasterizer.h"
+
+// Renders the same RGB waveform as WaveformRendererRGB, but writes all
+// columns into the scanlines of an offscreen image with a
+// WaveformScanlineRasterizer that is drawn at once.
+class WaveformRendererRGBScanline : public WaveformRendererSignalBase {
+  public:
+    explicit WaveformRendererRGBScanline(
+        WaveformWidgetRenderer* waveformWidget);
+    ~WaveformRendererRGBScanline() override;
+
+    void onSetup(const QDomNode& node) override;
+    void draw(QPainter* painter, QPaintEvent* event) override;
+
+  private:
+    WaveformScanlineRasterizer m_rasterizer;
+
+    DISALLOW_COPY_AND_ASSIGN(WaveformRendererRGBScanline);
+};
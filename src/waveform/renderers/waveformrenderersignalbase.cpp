@@ -46,7 +46,11 @@ WaveformRendererSignalBase::WaveformRendererSignalBase(
       m_rgbMidColor_b(0),
       m_rgbHighColor_r(0),
       m_rgbHighColor_g(0),
-      m_rgbHighColor_b(0) {
+      m_rgbHighColor_b(0),
+      m_drawnAllGain(-1.0f),
+      m_drawnLowGain(-1.0f),
+      m_drawnMidGain(-1.0f),
+      m_drawnHighGain(-1.0f) {
 }
 
 WaveformRendererSignalBase::~WaveformRendererSignalBase() {
@@ -150,8 +154,34 @@ void WaveformRendererSignalBase::setup(const QDomNode& node,
     onSetup(node);
 }
 
+bool WaveformRendererSignalBase::needsRedraw() const {
+    float allGain, lowGain, midGain, highGain;
+    computeGains(&allGain, &lowGain, &midGain, &highGain);
+    return allGain != m_drawnAllGain ||
+            lowGain != m_drawnLowGain ||
+            midGain != m_drawnMidGain ||
+            highGain != m_drawnHighGain;
+}
+
 void WaveformRendererSignalBase::getGains(float* pAllGain, float* pLowGain,
                                           float* pMidGain, float* pHighGain) {
+    computeGains(&m_drawnAllGain, &m_drawnLowGain, &m_drawnMidGain, &m_drawnHighGain);
+    if (pAllGain != NULL) {
+        *pAllGain = m_drawnAllGain;
+    }
+    if (pLowGain != NULL) {
+        *pLowGain = m_drawnLowGain;
+    }
+    if (pMidGain != NULL) {
+        *pMidGain = m_drawnMidGain;
+    }
+    if (pHighGain != NULL) {
+        *pHighGain = m_drawnHighGain;
+    }
+}
+
+void WaveformRendererSignalBase::computeGains(float* pAllGain, float* pLowGain,
+                                              float* pMidGain, float* pHighGain) const {
     WaveformWidgetFactory* factory = WaveformWidgetFactory::instance();
     if (pAllGain != NULL) {
         float allGain = m_waveformRenderer->getGain();
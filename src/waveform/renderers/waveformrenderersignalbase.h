@@ -4,6 +4,7 @@
 #include "waveformrendererabstract.h"
 #include "waveformsignalcolors.h"
 #include "skin/skincontext.h"
+#include "waveform/waveform.h"
 
 class ControlObject;
 class ControlProxy;
@@ -19,12 +20,24 @@ public:
     virtual bool onInit() {return true;}
     virtual void onSetup(const QDomNode &node) = 0;
 
+    // The signal needs to be redrawn when the EQs have been changed
+    bool needsRedraw() const override;
+
   protected:
     void deleteControls();
 
     void getGains(float* pAllGain, float* pLowGain, float* pMidGain,
                   float* highGain);
 
+    // The squared amplitude of the filtered bands with the given gains
+    static inline float squaredAmplitude(const WaveformData& waveformData,
+            float lowGain, float midGain, float highGain) {
+        const float low = waveformData.filtered.low * lowGain;
+        const float mid = waveformData.filtered.mid * midGain;
+        const float high = waveformData.filtered.high * highGain;
+        return low * low + mid * mid + high * high;
+    }
+
   protected:
     ControlProxy* m_pEQEnabled;
     ControlProxy* m_pLowFilterControlObject;
@@ -46,6 +59,13 @@ public:
     qreal m_rgbLowColor_r, m_rgbLowColor_g, m_rgbLowColor_b;
     qreal m_rgbMidColor_r, m_rgbMidColor_g, m_rgbMidColor_b;
     qreal m_rgbHighColor_r, m_rgbHighColor_g, m_rgbHighColor_b;
+
+  private:
+    void computeGains(float* pAllGain, float* pLowGain, float* pMidGain,
+                  float* pHighGain) const;
+
+    // The gains of the last drawn signal
+    float m_drawnAllGain, m_drawnLowGain, m_drawnMidGain, m_drawnHighGain;
 };
 
 #endif // WAVEFORMRENDERERSIGNALBASE_H
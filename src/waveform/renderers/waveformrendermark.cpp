@@ -21,7 +21,8 @@ namespace {
 
 WaveformRenderMark::WaveformRenderMark(
         WaveformWidgetRenderer* waveformWidgetRenderer) :
-    WaveformRendererAbstract(waveformWidgetRenderer) {
+    WaveformRendererAbstract(waveformWidgetRenderer),
+    m_bMarksChanged(true) {
 }
 
 void WaveformRenderMark::setup(const QDomNode& node, const SkinContext& context) {
@@ -32,10 +33,27 @@ void WaveformRenderMark::setup(const QDomNode& node, const SkinContext& context)
             ? defaultMark->fillColor()
             : signalColors.getAxesColor();
     m_predefinedColorsRepresentation = context.getCueColorRepresentation(node, defaultColor);
+
+    for (const auto& pMark : m_marks) {
+        if (pMark->isValid()) {
+            pMark->connectSamplePositionChanged(this,
+                    &WaveformRenderMark::slotMarkChanged);
+        }
+        if (pMark->hasVisible()) {
+            pMark->connectVisibleChanged(this,
+                    &WaveformRenderMark::slotMarkChanged);
+        }
+    }
+}
+
+void WaveformRenderMark::slotMarkChanged(double v) {
+    Q_UNUSED(v);
+    m_bMarksChanged = true;
 }
 
 void WaveformRenderMark::draw(QPainter* painter, QPaintEvent* /*event*/) {
     PainterScope PainterScope(painter);
+    m_bMarksChanged = false;
 
     /*
     //DEBUG
@@ -108,6 +126,7 @@ void WaveformRenderMark::onSetTrack() {
 }
 
 void WaveformRenderMark::slotCuesUpdated() {
+    m_bMarksChanged = true;
     TrackPointer trackInfo = m_waveformRenderer->getTrackInfo();
     if (!trackInfo){
         return;
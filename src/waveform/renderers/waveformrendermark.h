@@ -25,6 +25,10 @@ class WaveformRenderMark : public QObject, public WaveformRendererAbstract {
     // Called when a new track is loaded.
     void onSetTrack() override;
 
+    bool needsRedraw() const override {
+        return m_bMarksChanged;
+    }
+
   public slots:
     // Called when the loaded track's cues are added, deleted or modified and
     // when a new track is loaded.
@@ -32,12 +36,16 @@ class WaveformRenderMark : public QObject, public WaveformRendererAbstract {
     // This method is used for hotcues.
     void slotCuesUpdated();
 
+  private slots:
+    void slotMarkChanged(double v);
+
   private:
     void generateMarkImage(WaveformMarkPointer pMark);
 
     PredefinedColorsRepresentation m_predefinedColorsRepresentation;
 
     WaveformMarkSet m_marks;
+    bool m_bMarksChanged;
     DISALLOW_COPY_AND_ASSIGN(WaveformRenderMark);
 };
 
@@ -37,9 +37,43 @@ void WaveformRenderMarkRange::setup(const QDomNode& node, const SkinContext& con
     }
 }
 
+namespace {
+
+constexpr int kStateValuesPerRange = 3;
+
+double rangeFlags(const WaveformMarkRange& markRange) {
+    return (markRange.active() ? 1.0 : 0.0) +
+            (markRange.visible() ? 2.0 : 0.0) +
+            (markRange.enabled() ? 4.0 : 0.0);
+}
+
+} // anonymous namespace
+
+bool WaveformRenderMarkRange::needsRedraw() const {
+    if (m_drawnState.size() != m_markRanges.size() * kStateValuesPerRange) {
+        return true;
+    }
+    auto state = m_drawnState.cbegin();
+    for (const auto& markRange : m_markRanges) {
+        if (*state++ != rangeFlags(markRange) ||
+                *state++ != markRange.start() ||
+                *state++ != markRange.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void WaveformRenderMarkRange::draw(QPainter *painter, QPaintEvent * /*event*/) {
     PainterScope PainterScope(painter);
 
+    m_drawnState.clear();
+    for (const auto& markRange : m_markRanges) {
+        m_drawnState.push_back(rangeFlags(markRange));
+        m_drawnState.push_back(markRange.start());
+        m_drawnState.push_back(markRange.end());
+    }
+
     painter->setWorldMatrixEnabled(false);
 
     if (isDirty()) {
@@ -24,11 +24,14 @@ class WaveformRenderMarkRange : public WaveformRendererAbstract {
 
     void setup(const QDomNode& node, const SkinContext& context) override;
     void draw(QPainter* painter, QPaintEvent* event) override;
+    bool needsRedraw() const override;
 
   private:
     void generateImages();
 
     std::vector<WaveformMarkRange> m_markRanges;
+    // The start, end and flags of each mark range at the last draw()
+    std::vector<double> m_drawnState;
 };
 
 #endif
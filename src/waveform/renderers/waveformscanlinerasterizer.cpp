@@ -0,0 +1,52 @@
+#include "waveform/renderers/waveformscanlinerasterizer.h"
+
+namespace {
+
+// The spans are rendered on top of the background that has been
+// painted by the previous renderers.
+const QRgb kTransparent = 0;
+
+void fillScanline(
+        QRgb* __restrict pScanline,
+        int y,
+        const int* __restrict pTops,
+        const int* __restrict pBottoms,
+        const QRgb* __restrict pColors,
+        int length) {
+    for (int x = 0; x < length; ++x) {
+        const bool covered = (y >= pTops[x]) & (y < pBottoms[x]);
+        pScanline[x] = covered ? pColors[x] : kTransparent;
+    }
+}
+
+} // anonymous namespace
+
+WaveformScanlineRasterizer::WaveformScanlineRasterizer() {
+}
+
+void WaveformScanlineRasterizer::reset(int length, int breadth) {
+    if (m_image.width() != length || m_image.height() != breadth) {
+        // Premultiplied alpha is the native format of the raster paint
+        // engine. All colors are opaque and don't need to be converted.
+        m_image = QImage(length, breadth, QImage::Format_ARGB32_Premultiplied);
+    }
+    // An empty span is never covered.
+    m_tops.assign(length, 0);
+    m_bottoms.assign(length, 0);
+    m_colors.assign(length, kTransparent);
+}
+
+const QImage& WaveformScanlineRasterizer::rasterize() {
+    const int imageLength = length();
+    const int imageBreadth = breadth();
+    for (int y = 0; y < imageBreadth; ++y) {
+        fillScanline(
+                reinterpret_cast<QRgb*>(m_image.scanLine(y)),
+                y,
+                m_tops.data(),
+                m_bottoms.data(),
+                m_colors.data(),
+                imageLength);
+    }
+    return m_image;
+}
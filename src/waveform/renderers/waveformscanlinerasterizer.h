@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QImage>
+#include <QRgb>
+#include <utility>
+#include <vector>
+
+// Software rasterizer for waveforms that consist of a single vertical
+// span per pixel column. Instead of drawing each column with a separate
+// QPainter::drawLine() call the spans are collected first and then
+// written into the ARGB32 scanlines of an image row by row. The inner
+// loop over all columns of a row is a branchless select that the
+// compiler is able to vectorize.
+//
+// The pixel coverage of each span matches a non-antialiased line with
+// a flat cap and a width of 1 pixel, i.e. the span [y1, y2) is filled
+// for a line from (x, y1) to (x, y2).
+//
+// The image is drawn in the coordinate system of the renderer, i.e.
+// the width is the length and the height is the breadth of the
+// waveform.
+class WaveformScanlineRasterizer {
+  public:
+    WaveformScanlineRasterizer();
+
+    // Resizes the image if needed and clears all columns.
+    void reset(int length, int breadth);
+
+    int length() const {
+        return static_cast<int>(m_colors.size());
+    }
+    int breadth() const {
+        return m_image.height();
+    }
+
+    // Sets the span of pixel column x. The y coordinates may be passed
+    // in any order and may exceed the image. Columns without a span
+    // remain transparent.
+    void setColumn(int x, int y1, int y2, QRgb color) {
+        if (y1 > y2) {
+            std::swap(y1, y2);
+        }
+        m_tops[x] = y1;
+        m_bottoms[x] = y2;
+        m_colors[x] = color;
+    }
+
+    // Writes all spans into the image.
+    const QImage& rasterize();
+
+    const QImage& image() const {
+        return m_image;
+    }
+
+  private:
+    QImage m_image;
+    std::vector<int> m_tops;
+    std::vector<int> m_bottoms;
+    std::vector<QRgb> m_colors;
+};
@@ -40,7 +40,8 @@ WaveformWidgetRenderer::WaveformWidgetRenderer(const char* group)
       m_pTrackSamplesControlObject(NULL),
       m_trackSamples(0.0),
       m_scaleFactor(1.0),
-      m_playMarkerPosition(s_defaultPlayMarkerPosition) {
+      m_playMarkerPosition(s_defaultPlayMarkerPosition),
+      m_bFrameDamaged(true) {
 
     //qDebug() << "WaveformWidgetRenderer";
 
@@ -95,8 +96,16 @@ bool WaveformWidgetRenderer::init() {
 }
 
 void WaveformWidgetRenderer::onPreRender(VSyncThread* vsyncThread) {
+    prepareFrame(m_visualPlayPosition->getAtNextVSync(vsyncThread));
+}
+
+void WaveformWidgetRenderer::prepareFrame(double truePlayPos) {
+    m_frameState = FrameState();
+    m_frameState.pTrack = m_pTrack.get();
+
     // For a valid track to render we need
     m_trackSamples = m_pTrackSamplesControlObject->get();
+    m_frameState.trackSamples = m_trackSamples;
     if (m_trackSamples <= 0.0) {
         return;
     }
@@ -119,12 +128,12 @@ void WaveformWidgetRenderer::onPreRender(VSyncThread* vsyncThread) {
     ConstWaveformPointer pWaveform = pTrack ? pTrack->getWaveform() : ConstWaveformPointer();
     if (pWaveform) {
         m_audioSamplePerPixel = m_visualSamplePerPixel * pWaveform->getAudioVisualRatio();
+        m_frameState.pWaveform = pWaveform.data();
+        m_frameState.waveformCompletion = pWaveform->getCompletion();
     } else {
         m_audioSamplePerPixel = 0.0;
     }
 
-
-    double truePlayPos = m_visualPlayPosition->getAtNextVSync(vsyncThread);
     // m_playPos = -1 happens, when a new track is in buffer but m_visualPlayPosition was not updated
 
     if (m_audioSamplePerPixel && truePlayPos != -1) {
@@ -155,7 +164,12 @@ void WaveformWidgetRenderer::onPreRender(VSyncThread* vsyncThread) {
         m_playPos = -1; // disable renderers
     }
 
-    //qDebug() << "WaveformWidgetRenderer::onPreRender" <<
+    m_frameState.playPos = m_playPos;
+    m_frameState.visualSamplePerPixel = m_visualSamplePerPixel;
+    m_frameState.gain = m_gain;
+    m_frameState.alphaBeatGrid = m_alphaBeatGrid;
+
+    //qDebug() << "WaveformWidgetRenderer::prepareFrame" <<
     //        "m_group" << m_group <<
     //        "m_trackSamples" << m_trackSamples <<
     //        "m_playPos" << m_playPos <<
@@ -243,10 +257,33 @@ void WaveformWidgetRenderer::draw(QPainter* painter, QPaintEvent* event) {
     //qDebug() << "draw() end" << timer.restart().formatNanosWithUnit();
 }
 
+bool WaveformWidgetRenderer::isFrameDamaged() const {
+    if (m_bFrameDamaged || m_frameState != m_renderedFrameState) {
+        return true;
+    }
+    // Without a valid play position only the background is drawn, see draw()
+    int stackSize = m_rendererStack.size();
+    if (m_trackSamples <= 0.0 || m_playPos == -1) {
+        stackSize = math_min(stackSize, 1);
+    }
+    for (int i = 0; i < stackSize; ++i) {
+        if (m_rendererStack.at(i)->needsRedraw()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void WaveformWidgetRenderer::setFrameRendered() {
+    m_renderedFrameState = m_frameState;
+    m_bFrameDamaged = false;
+}
+
 void WaveformWidgetRenderer::resize(int width, int height, float devicePixelRatio) {
     m_width = width;
     m_height = height;
     m_devicePixelRatio = devicePixelRatio;
+    m_bFrameDamaged = true;
     for (int i = 0; i < m_rendererStack.size(); ++i) {
         m_rendererStack[i]->setDirty(true);
         m_rendererStack[i]->onResize();
@@ -264,6 +301,7 @@ void WaveformWidgetRenderer::setup(
     }
 
     m_colors.setup(node, context);
+    m_bFrameDamaged = true;
     for (int i = 0; i < m_rendererStack.size(); ++i) {
         m_rendererStack[i]->setScaleFactor(m_scaleFactor);
         m_rendererStack[i]->setup(node, context);
@@ -283,6 +321,7 @@ void WaveformWidgetRenderer::setTrack(TrackPointer track) {
     m_pTrack = track;
     //used to postpone first display until track sample is actually available
     m_trackSamples = -1.0;
+    m_bFrameDamaged = true;
 
     for (int i = 0; i < m_rendererStack.size(); ++i) {
         m_rendererStack[i]->onSetTrack();
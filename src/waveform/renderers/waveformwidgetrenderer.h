@@ -17,6 +17,7 @@
 class Track;
 class ControlProxy;
 class VisualPlayPosition;
+class Waveform;
 class VSyncThread;
 
 class WaveformWidgetRenderer {
@@ -35,8 +36,24 @@ class WaveformWidgetRenderer {
 
     void setup(const QDomNode& node, const SkinContext& context);
     void onPreRender(VSyncThread* vsyncThread);
+    // Fetches the parameters of the next frame for the given play position.
+    // onPreRender() passes the play position at the next VSync, benchmarks
+    // pass arbitrary positions to render offscreen without a VSyncThread.
+    void prepareFrame(double truePlayPos);
     void draw(QPainter* painter, QPaintEvent* event);
 
+    // Returns true if the frame prepared by onPreRender() differs from the
+    // last rendered frame, i.e. if the play position, the zoom, the track
+    // data or the content of any renderer has changed.
+    bool isFrameDamaged() const;
+    // Marks the frame prepared by onPreRender() as rendered
+    void setFrameRendered();
+    // Forces rendering of the next frame, e.g. after the widget has been
+    // hidden and its content might have been lost.
+    void damageFrame() {
+        m_bFrameDamaged = true;
+    }
+
     inline const char* getGroup() const { return m_group;}
     const TrackPointer getTrackInfo() const { return m_pTrack;}
 
@@ -103,6 +120,7 @@ class WaveformWidgetRenderer {
             newPos = math_clamp(newPos, 0.0, 1.0);
         }
         m_playMarkerPosition = newPos;
+        m_bFrameDamaged = true;
     }
 
   protected:
@@ -149,6 +167,35 @@ class WaveformWidgetRenderer {
 #endif
 
 private:
+    // All parameters that are common for the renderers of a frame
+    struct FrameState {
+        const Track* pTrack = nullptr;
+        const Waveform* pWaveform = nullptr;
+        int waveformCompletion = -1;
+        int trackSamples = 0;
+        double playPos = -1.0;
+        double visualSamplePerPixel = 0.0;
+        double gain = 0.0;
+        int alphaBeatGrid = 0;
+
+        bool operator==(const FrameState& other) const {
+            return pTrack == other.pTrack &&
+                    pWaveform == other.pWaveform &&
+                    waveformCompletion == other.waveformCompletion &&
+                    trackSamples == other.trackSamples &&
+                    playPos == other.playPos &&
+                    visualSamplePerPixel == other.visualSamplePerPixel &&
+                    gain == other.gain &&
+                    alphaBeatGrid == other.alphaBeatGrid;
+        }
+        bool operator!=(const FrameState& other) const {
+            return !(*this == other);
+        }
+    };
+    FrameState m_frameState;
+    FrameState m_renderedFrameState;
+    bool m_bFrameDamaged;
+
     DISALLOW_COPY_AND_ASSIGN(WaveformWidgetRenderer);
     friend class WaveformWidgetFactory;
 };
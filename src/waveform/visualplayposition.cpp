@@ -13,8 +13,43 @@ namespace {
 // but does not continue in case of underflows.
 constexpr int kMaxOffsetBufferCnt = 2;
 constexpr int kMicrosPerMillis = 1000; // 1 ms contains 1000 µs
+// The share of the deviation from the extrapolated position that is
+// corrected per frame. Callback jitter is spread over ~10 frames.
+constexpr double kCorrectionRatio = 0.1;
+// Deviations of more than this time at the current speed are not
+// considered jitter and are applied immediately.
+constexpr double kMaxCorrectedMicros = 20000;
+// Targets that are closer than this belong to the same frame. They
+// might differ slightly when computed from different snapshots.
+constexpr qint64 kSameFrameMicros = 500;
 } // anonymous namespace
 
+VisualPlayPositionPredictor::VisualPlayPositionPredictor()
+        : m_valid(false),
+          m_targetMicros(0),
+          m_position(0) {
+}
+
+double VisualPlayPositionPredictor::predict(
+        qint64 targetMicros, double rawPosition, double positionPerMicro) {
+    const qint64 elapsedMicros = targetMicros - m_targetMicros;
+    if (m_valid && qAbs(elapsedMicros) < kSameFrameMicros) {
+        // Another widget of the same deck in the same frame
+        return m_position;
+    }
+    const double expectedPosition = m_position + positionPerMicro * elapsedMicros;
+    const double deviation = rawPosition - expectedPosition;
+    if (!m_valid || elapsedMicros < 0 ||
+            fabs(deviation) > fabs(positionPerMicro) * kMaxCorrectedMicros) {
+        m_position = rawPosition;
+    } else {
+        m_position = expectedPosition + deviation * kCorrectionRatio;
+    }
+    m_targetMicros = targetMicros;
+    m_valid = true;
+    return m_position;
+}
+
 
 //static
 QMap<QString, QWeakPointer<VisualPlayPosition> > VisualPlayPosition::m_listVisualPlayPosition;
@@ -24,6 +59,7 @@ double VisualPlayPosition::m_dCallbackEntryToDacSecs = 0;
 VisualPlayPosition::VisualPlayPosition(const QString& key)
         : m_valid(false),
           m_key(key) {
+    m_epoch.start();
     m_audioBufferSize = new ControlProxy(
             "[Master]", "audio_buffer_size", this);
     m_audioBufferSize->connectValueChanged(this, &VisualPlayPosition::slotAudioBufferSizeChanged);
@@ -51,42 +87,40 @@ void VisualPlayPosition::set(double playPos, double rate, double positionStep,
 }
 
 double VisualPlayPosition::getAtNextVSync(VSyncThread* vSyncThread) {
-    //static double testPos = 0;
-    //testPos += 0.000017759; //0.000016608; //  1.46257e-05;
-    //return testPos;
-
     if (m_valid) {
-        VisualPlayPositionData data = m_data.getValue();
-        int refToVSync = vSyncThread->fromTimerToNextSyncMicros(data.m_referenceTime);
-        int offset = refToVSync - data.m_callbackEntrytoDac;
-        offset = math_min(offset, m_audioBufferMicros * kMaxOffsetBufferCnt);
-        double playPos = data.m_enginePlayPos;  // load playPos for the first sample in Buffer
-        // add the offset for the position of the sample that will be transferred to the DAC
-        // When the next display frame is displayed
-        playPos += data.m_positionStep * offset * data.m_rate / m_audioBufferMicros;
-        //qDebug() << "playPos" << playPos << offset;
-        return playPos;
+        const VisualPlayPositionData data = m_data.getValue();
+        return getAtNextVSync(vSyncThread, data);
     }
     return -1;
 }
 
 void VisualPlayPosition::getPlaySlipAtNextVSync(VSyncThread* vSyncThread, double* pPlayPosition, double* pSlipPosition) {
-    //static double testPos = 0;
-    //testPos += 0.000017759; //0.000016608; //  1.46257e-05;
-    //return testPos;
-
     if (m_valid) {
-        VisualPlayPositionData data = m_data.getValue();
-        int refToVSync = vSyncThread->fromTimerToNextSyncMicros(data.m_referenceTime);
-        int offset = refToVSync - data.m_callbackEntrytoDac;
-        offset = math_min(offset, m_audioBufferMicros * kMaxOffsetBufferCnt);
-        double playPos = data.m_enginePlayPos;  // load playPos for the first sample in Buffer
-        playPos += data.m_positionStep * offset * data.m_rate / m_audioBufferMicros;
-        *pPlayPosition = playPos;
+        const VisualPlayPositionData data = m_data.getValue();
+        *pPlayPosition = getAtNextVSync(vSyncThread, data);
         *pSlipPosition = data.m_slipPosition;
     }
 }
 
+double VisualPlayPosition::getAtNextVSync(
+        VSyncThread* vSyncThread, const VisualPlayPositionData& data) {
+    if (m_audioBufferMicros <= 0) {
+        return data.m_enginePlayPos;
+    }
+    int refToVSync = vSyncThread->fromTimerToNextSyncMicros(data.m_referenceTime);
+    int offset = refToVSync - data.m_callbackEntrytoDac;
+    offset = math_min(offset, m_audioBufferMicros * kMaxOffsetBufferCnt);
+    const double positionPerMicro =
+            data.m_positionStep * data.m_rate / m_audioBufferMicros;
+    // The play position of the first sample in the buffer plus the offset
+    // of the sample that will be transferred to the DAC when the next
+    // display frame is displayed
+    const double playPos = data.m_enginePlayPos + positionPerMicro * offset;
+    const qint64 vSyncMicros =
+            data.m_referenceTime.difference(m_epoch).toIntegerMicros() + refToVSync;
+    return m_predictor.predict(vSyncMicros, playPos, positionPerMicro);
+}
+
 double VisualPlayPosition::getEnginePlayPos() {
     if (m_valid) {
         VisualPlayPositionData data = m_data.getValue();
@@ -5,9 +5,11 @@
 #include <QTime>
 #include <QMap>
 #include <QAtomicPointer>
+#include <QObject>
+#include <QSharedPointer>
 
 #include "util/performancetimer.h"
-#include "control/controlvalue.h"
+#include "util/seqlock.h"
 
 class ControlProxy;
 class VSyncThread;
@@ -37,6 +39,34 @@ class VisualPlayPositionData {
     double m_tempoTrackSeconds; // total track time, taking the current tempo into account
 };
 
+// Smooths the play positions that are displayed at consecutive VSyncs.
+//
+// The position extrapolated from the latest engine snapshot is only as
+// accurate as the timestamps of the audio callback. With large audio
+// buffers a new snapshot arrives only every few frames on high refresh
+// rate displays, and the callback jitter shows up as a visible step at
+// each of them. Instead, the predictor advances the previously displayed
+// position by the elapsed time at the current speed and only corrects a
+// fraction of the deviation from the extrapolated position per frame.
+// Larger deviations, e.g. after seeking, are applied immediately.
+//
+// Not thread safe. Must only be used from the GUI thread.
+class VisualPlayPositionPredictor {
+  public:
+    VisualPlayPositionPredictor();
+
+    // Returns the position that is displayed at targetMicros, measured
+    // on an arbitrary monotonic time scale. rawPosition is the position
+    // extrapolated for this time and positionPerMicro the current speed.
+    // Repeated invocations for the same frame return the same position.
+    double predict(qint64 targetMicros, double rawPosition, double positionPerMicro);
+
+  private:
+    bool m_valid;
+    qint64 m_targetMicros;
+    double m_position;
+};
+
 
 class VisualPlayPosition : public QObject {
     Q_OBJECT
@@ -66,7 +96,13 @@ class VisualPlayPosition : public QObject {
     void slotAudioBufferSizeChanged(double sizeMs);
 
   private:
-    ControlValueAtomic<VisualPlayPositionData> m_data;
+    double getAtNextVSync(VSyncThread* vSyncThread, const VisualPlayPositionData& data);
+
+    SeqLockValue<VisualPlayPositionData> m_data;
+    // Only used by the GUI thread
+    VisualPlayPositionPredictor m_predictor;
+    // The time scale of the predictor
+    PerformanceTimer m_epoch;
     ControlProxy* m_audioBufferSize;
     int m_audioBufferMicros; // Audio buffer size in µs
     bool m_valid;
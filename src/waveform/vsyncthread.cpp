@@ -4,6 +4,11 @@
 #include <QtDebug>
 #include <QTime>
 
+#if defined(Q_OS_LINUX)
+#include <errno.h>
+#include <time.h>
+#endif
+
 #include "vsyncthread.h"
 #include "util/performancetimer.h"
 #include "util/math.h"
@@ -34,7 +39,7 @@ void VSyncThread::run() {
     QThread::currentThread()->setObjectName("VSyncThread");
 
     m_waitToSwapMicros = m_syncIntervalTimeMicros;
-    m_timer.start();
+    restartTimer();
 
     //qDebug() << "VSyncThread::run()";
     while (m_bDoRendering) {
@@ -48,9 +53,9 @@ void VSyncThread::run() {
             emit vsyncSwap(); // swaps the new waveform to front
             m_semaVsyncSlot.acquire();
 
-            m_timer.restart();
+            restartTimer();
             m_waitToSwapMicros = 1000;
-            usleep(1000);
+            sleepUntilMicros(m_waitToSwapMicros);
         } else { // if (m_vSyncMode == ST_TIMER) {
             emit vsyncRender(); // renders the new waveform.
 
@@ -63,7 +68,7 @@ void VSyncThread::run() {
                 m_timer.elapsed().toIntegerMicros());
             // waiting for interval by sleep
             if (remainingForSwap > 100) {
-                usleep(remainingForSwap);
+                sleepUntilMicros(m_waitToSwapMicros);
             }
 
             // swaps the new waveform to front in case of gl-wf
@@ -74,7 +79,7 @@ void VSyncThread::run() {
             m_semaVsyncSlot.acquire();
 
             // <- Assume we are VSynced here ->
-            int lastSwapTime = static_cast<int>(m_timer.restart().toIntegerMicros());
+            int lastSwapTime = static_cast<int>(restartTimer().toIntegerMicros());
             if (remainingForSwap < 0) {
                 // Our swapping call was already delayed
                 // The real swap might happens on the following VSync, depending on driver settings
@@ -87,6 +92,34 @@ void VSyncThread::run() {
     }
 }
 
+mixxx::Duration VSyncThread::restartTimer() {
+#if defined(Q_OS_LINUX)
+    clock_gettime(CLOCK_MONOTONIC, &m_timerStart);
+#endif
+    return m_timer.restart();
+}
+
+void VSyncThread::sleepUntilMicros(int deadlineMicros) {
+#if defined(Q_OS_LINUX)
+    // Sleep until an absolute deadline on the monotonic clock. Unlike
+    // relative sleeps this neither accumulates the wake-up latency of
+    // interrupted sleeps nor oversleeps when a signal arrives.
+    struct timespec deadline = m_timerStart;
+    deadline.tv_sec += deadlineMicros / 1000000;
+    deadline.tv_nsec += static_cast<long>(deadlineMicros % 1000000) * 1000;
+    deadline.tv_sec += deadline.tv_nsec / 1000000000;
+    deadline.tv_nsec %= 1000000000;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+    }
+#else
+    const int remainingMicros = deadlineMicros -
+            static_cast<int>(m_timer.elapsed().toIntegerMicros());
+    if (remainingMicros > 0) {
+        usleep(remainingMicros);
+    }
+#endif
+}
+
 int VSyncThread::elapsed() {
     return static_cast<int>(m_timer.elapsed().toIntegerMicros());
 }
@@ -7,6 +7,10 @@
 #include <QPair>
 #include <QGLWidget>
 
+#if defined(Q_OS_LINUX)
+#include <time.h>
+#endif
+
 #include "util/performancetimer.h"
 
 class VSyncThread : public QThread {
@@ -44,6 +48,12 @@ class VSyncThread : public QThread {
     void vsyncSwap();
 
   private:
+    // Restarts the timer at the swap and returns the time since the
+    // previous swap
+    mixxx::Duration restartTimer();
+    // Sleeps until the given time has elapsed since the last swap
+    void sleepUntilMicros(int deadlineMicros);
+
     bool m_bDoRendering;
     bool m_vSyncTypeChanged;
     int m_syncIntervalTimeMicros;
@@ -53,6 +63,12 @@ class VSyncThread : public QThread {
     int m_droppedFrames;
     int m_swapWait;
     PerformanceTimer m_timer;
+#if defined(Q_OS_LINUX)
+    // The start of m_timer on the monotonic clock. The deadlines of all
+    // sleeps are relative to this time stamp and don't depend on when
+    // sleepUntilMicros() is invoked.
+    struct timespec m_timerStart;
+#endif
     QSemaphore m_semaVsyncSlot;
     double m_displayFrameRate;
     int m_vSyncPerRendering;
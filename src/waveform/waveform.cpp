@@ -2,6 +2,7 @@
 
 #include "waveform/waveform.h"
 #include "proto/waveform.pb.h"
+#include "util/math.h"
 
 using namespace mixxx::track;
 
@@ -64,6 +65,42 @@ Waveform::Waveform(int audioSampleRate, int audioSamples,
     setCompletion(0);
 }
 
+Waveform::Waveform(const WaveformBlockFile& blockFile, int priorityDataElement)
+        : m_id(-1),
+          m_saveState(SaveState::NotSaved),
+          m_dataSize(0),
+          m_visualSampleRate(0),
+          m_audioVisualRatio(0),
+          m_textureStride(computeTextureStride(0)),
+          m_completion(-1) {
+    if (!blockFile.isValid()) {
+        return;
+    }
+    m_visualSampleRate = blockFile.visualSampleRate();
+    m_audioVisualRatio = blockFile.audioVisualRatio();
+    assign(blockFile.dataSize(), 0);
+    m_completion = 0;
+    m_saveState = SaveState::Saved;
+    m_blockFile = blockFile;
+
+    // Alternate between the following and the preceding neighbours of
+    // the priority block
+    const int blockCount = blockFile.blockCount();
+    const int priorityBlock = math_clamp(
+            priorityDataElement / blockFile.blockSize(), 0, blockCount - 1);
+    m_pendingBlocks.reserve(blockCount);
+    m_pendingBlocks.push_back(priorityBlock);
+    for (int distance = 1; static_cast<int>(m_pendingBlocks.size()) < blockCount; ++distance) {
+        if (priorityBlock + distance < blockCount) {
+            m_pendingBlocks.push_back(priorityBlock + distance);
+        }
+        if (priorityBlock - distance >= 0) {
+            m_pendingBlocks.push_back(priorityBlock - distance);
+        }
+    }
+    std::reverse(m_pendingBlocks.begin(), m_pendingBlocks.end());
+}
+
 Waveform::~Waveform() {
 }
 
@@ -193,23 +230,140 @@ void Waveform::readByteArray(const QByteArray& data) {
         m_data[i].filtered.mid = use_mid ? static_cast<unsigned char>(mid.value(i)) : 0;
         m_data[i].filtered.high = use_high ? static_cast<unsigned char>(high.value(i)) : 0;
     }
+    buildPyramid();
     m_completion = dataSize;
     m_saveState = SaveState::Saved;
 }
 
+bool Waveform::decodeBlocks(int maxBlocks) {
+    for (int i = 0; i < maxBlocks && !m_pendingBlocks.empty(); ++i) {
+        const int block = m_pendingBlocks.back();
+        m_pendingBlocks.pop_back();
+        const int start = m_blockFile.blockStart(block);
+        const int length = m_blockFile.blockLength(block);
+        // Corrupt blocks remain silent
+        if (m_blockFile.decodeBlock(block, &m_data[start])) {
+            updatePyramid(
+                    start / kNumChannels,
+                    (start + length + kNumChannels - 1) / kNumChannels);
+        }
+        m_completion.fetchAndAddRelease(length);
+    }
+    if (m_pendingBlocks.empty()) {
+        // Release the file mapping
+        m_blockFile = WaveformBlockFile();
+        return false;
+    }
+    return true;
+}
+
 void Waveform::resize(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.resize(m_textureStride * m_textureStride);
+    allocatePyramid();
 }
 
 void Waveform::assign(int size, int value) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.assign(m_textureStride * m_textureStride, value);
+    allocatePyramid();
+    buildPyramid();
     m_saveState = SaveState::SavePending;
 }
 
+void Waveform::setCompletion(int completion) {
+    const int previousCompletion = atomicLoadRelaxed(m_completion);
+    if (completion > previousCompletion) {
+        updatePyramid(
+                math_max(previousCompletion, 0) / kNumChannels,
+                completion / kNumChannels);
+    }
+    m_completion = completion;
+}
+
+void Waveform::allocatePyramid() {
+    m_pyramid.clear();
+    int blockCount = m_dataSize / kNumChannels;
+    while (blockCount > 1) {
+        blockCount = (blockCount + 1) / 2;
+        m_pyramid.emplace_back(blockCount * kNumChannels, WaveformData(0));
+    }
+}
+
+void Waveform::buildPyramid() {
+    const WaveformData* pLowerLevel = m_data.data();
+    int lowerLevelSize = (m_dataSize / kNumChannels) * kNumChannels;
+    for (auto& level : m_pyramid) {
+        for (int i = 0; i < static_cast<int>(level.size()); ++i) {
+            // Even element = left channel, odd element = right channel
+            const int lowerIndex = (i / kNumChannels) * 2 * kNumChannels + i % kNumChannels;
+            WaveformData maximum = pLowerLevel[lowerIndex];
+            if (lowerIndex + kNumChannels < lowerLevelSize) {
+                maximum = maxOfWaveformData(
+                        maximum, pLowerLevel[lowerIndex + kNumChannels]);
+            }
+            level[i] = maximum;
+        }
+        pLowerLevel = level.data();
+        lowerLevelSize = static_cast<int>(level.size());
+    }
+}
+
+void Waveform::updatePyramid(int firstVisualFrame, int endVisualFrame) {
+    endVisualFrame = math_min(endVisualFrame, m_dataSize / kNumChannels);
+    for (int frame = firstVisualFrame; frame < endVisualFrame; ++frame) {
+        for (int channel = 0; channel < kNumChannels; ++channel) {
+            const WaveformData& datum = m_data[frame * kNumChannels + channel];
+            for (size_t level = 0; level < m_pyramid.size(); ++level) {
+                WaveformData& block = m_pyramid[level][
+                        (frame >> (level + 1)) * kNumChannels + channel];
+                const WaveformData maximum = maxOfWaveformData(block, datum);
+                if (maximum.m_i == block.m_i) {
+                    // All blocks on higher levels already contain
+                    // the maximum of this block.
+                    break;
+                }
+                block = maximum;
+            }
+        }
+    }
+}
+
+void Waveform::getMaxima(
+        int firstVisualFrame,
+        int endVisualFrame,
+        WaveformData* pMaxima) const {
+    pMaxima[Left] = WaveformData(0);
+    pMaxima[Right] = WaveformData(0);
+    int frame = math_max(firstVisualFrame, 0);
+    endVisualFrame = math_min(endVisualFrame, m_dataSize / kNumChannels);
+    const int levelCount = static_cast<int>(m_pyramid.size());
+    while (frame < endVisualFrame) {
+        // Find the largest aligned block that starts at frame and
+        // does not exceed the range. Level -1 is the data itself.
+        int level = -1;
+        while (level + 1 < levelCount) {
+            const int blockFrames = 2 << (level + 1);
+            if ((frame & (blockFrames - 1)) != 0 ||
+                    frame + blockFrames > endVisualFrame) {
+                break;
+            }
+            ++level;
+        }
+        const WaveformData* pBlock;
+        if (level < 0) {
+            pBlock = &m_data[frame * kNumChannels];
+        } else {
+            pBlock = &m_pyramid[level][(frame >> (level + 1)) * kNumChannels];
+        }
+        pMaxima[Left] = maxOfWaveformData(pMaxima[Left], pBlock[Left]);
+        pMaxima[Right] = maxOfWaveformData(pMaxima[Right], pBlock[Right]);
+        frame += 1 << (level + 1);
+    }
+}
+
 void Waveform::dump() const {
     qDebug() << "Waveform" << this
              << "size("+QString::number(getDataSize())+")"
@@ -1,6 +1,7 @@
 #ifndef WAVEFORM_H
 #define WAVEFORM_H
 
+#include <algorithm>
 #include <vector>
 
 #include <QMutex>
@@ -12,6 +13,7 @@
 
 #include "util/class.h"
 #include "util/compatibility.h"
+#include "waveform/waveformblockfile.h"
 
 enum FilterIndex { Low = 0, Mid = 1, High = 2, FilterCount = 3};
 enum ChannelIndex { Left = 0, Right = 1, ChannelCount = 2};
@@ -29,6 +31,17 @@ union WaveformData {
     WaveformData(int i) { m_i = i;}
 };
 
+// The maxima of all bands
+inline WaveformData maxOfWaveformData(
+        const WaveformData& lhs, const WaveformData& rhs) {
+    WaveformData result;
+    result.filtered.low = std::max(lhs.filtered.low, rhs.filtered.low);
+    result.filtered.mid = std::max(lhs.filtered.mid, rhs.filtered.mid);
+    result.filtered.high = std::max(lhs.filtered.high, rhs.filtered.high);
+    result.filtered.all = std::max(lhs.filtered.all, rhs.filtered.all);
+    return result;
+}
+
 class Waveform {
   public:
     enum class SaveState {
@@ -40,6 +53,10 @@ class Waveform {
     explicit Waveform(const QByteArray pData = QByteArray());
     Waveform(int audioSampleRate, int audioSamples,
              int desiredVisualSampleRate, int maxVisualSamples);
+    // Only the header of the block file is parsed. The data elements
+    // remain silent until their blocks are decoded by decodeBlocks(),
+    // starting with the block that contains priorityDataElement.
+    Waveform(const WaveformBlockFile& blockFile, int priorityDataElement);
 
     virtual ~Waveform();
 
@@ -75,6 +92,21 @@ class Waveform {
 
     QByteArray toByteArray() const;
 
+    // Decodes up to maxBlocks of the blocks that are still pending after
+    // constructing the waveform from a block file. Blocks are decoded in
+    // the order of their distance to the priority block. The completion
+    // counts the data elements of all decoded blocks, i.e. it is not
+    // contiguous while blocks are pending. Returns true if blocks remain.
+    // Must only be invoked from a single thread.
+    //
+    // Like the analyzer that fills m_data through data() and updates the
+    // pyramid in setCompletion(), the decoding thread writes m_data and
+    // m_pyramid without locking while the renderers read them. This race
+    // is tolerated: a renderer might draw a few stale or silent data
+    // elements for a single frame, which are redrawn with the decoded
+    // values once the completion has been published.
+    bool decodeBlocks(int maxBlocks);
+
     // We do not lock the mutex since m_dataSize and m_visualSampleRate are not
     // changed after the constructor runs.
     bool isValid() const {
@@ -97,14 +129,21 @@ class Waveform {
         return m_audioVisualRatio;
     }
 
+    // We do not lock the mutex since m_visualSampleRate is not changed after
+    // the constructor runs.
+    double getVisualSampleRate() const {
+        return m_visualSampleRate;
+    }
+
     // Atomically lookup the completion of the waveform. Represents the number
     // of data elements that have been processed out of dataSize.
     int getCompletion() const {
         return atomicLoadAcquire(m_completion);
     }
-    void setCompletion(int completion) {
-        m_completion = completion;
-    }
+    // Also updates the maxima pyramid for all data elements that have
+    // been completed since the last invocation. Must only be invoked
+    // from a single thread, i.e. the analyzer.
+    void setCompletion(int completion);
 
     // We do not lock the mutex since m_textureStride is not changed after
     // the constructor runs.
@@ -133,6 +172,20 @@ class Waveform {
     // constructor runs.
     const WaveformData* data() const { return &m_data[0];}
 
+    // Determines the maxima of all bands in the visual frame range
+    // [firstVisualFrame, endVisualFrame), separately for each channel.
+    // A visual frame consists of ChannelCount data elements. The maxima
+    // are stored into pMaxima[Left] and pMaxima[Right].
+    //
+    // Instead of scanning all data elements the maxima are composed
+    // from the precomputed maxima of aligned power-of-2 sized blocks.
+    // The costs only grow logarithmically with the length of the range,
+    // i.e. they are almost independent of the zoom level.
+    void getMaxima(
+            int firstVisualFrame,
+            int endVisualFrame,
+            WaveformData* pMaxima) const;
+
     void dump() const;
 
   private:
@@ -140,12 +193,15 @@ class Waveform {
     void resize(int size);
     void assign(int size, int value = 0);
 
+    void allocatePyramid();
+    void buildPyramid();
+    void updatePyramid(int firstVisualFrame, int endVisualFrame);
+
     inline WaveformData& at(int i) { return m_data[i];}
     inline unsigned char& low(int i) { return m_data[i].filtered.low;}
     inline unsigned char& mid(int i) { return m_data[i].filtered.mid;}
     inline unsigned char& high(int i) { return m_data[i].filtered.high;}
     inline unsigned char& all(int i) { return m_data[i].filtered.all;}
-    double getVisualSampleRate() const { return m_visualSampleRate; }
 
     // If stored in the database, the ID of the waveform.
     int m_id;
@@ -174,10 +230,23 @@ class Waveform {
     // stride is N. Not allowed to change after the constructor runs.
     int m_textureStride;
 
+    // Level n contains the maxima of aligned blocks of 2^(n+1) visual
+    // frames with the data elements of both channels interleaved like
+    // in m_data. Allocated together with m_data and not resized
+    // afterwards. Written by the analyzer or by decodeBlocks() while
+    // the renderers read it, see decodeBlocks().
+    std::vector<std::vector<WaveformData>> m_pyramid;
+
     // For performance, completion is shared as a QAtomicInt and does not lock
     // the mutex. The completion of the waveform calculation.
     QAtomicInt m_completion;
 
+    // Only accessed by decodeBlocks(). The block file is released after
+    // all blocks have been decoded.
+    WaveformBlockFile m_blockFile;
+    // In reverse decoding order
+    std::vector<int> m_pendingBlocks;
+
     mutable QMutex m_mutex;
 
     DISALLOW_COPY_AND_ASSIGN(Waveform);
@@ -0,0 +1,229 @@
+#include "waveform/waveformblockfile.h"
+
+#include <QtDebug>
+#include <QtEndian>
+#include <climits>
+#include <cstring>
+#include <utility>
+
+#include "util/assert.h"
+#include "util/math.h"
+#include "waveform/waveform.h"
+
+namespace {
+
+const char kMagic[4] = {'M', 'X', 'W', 'F'};
+const quint32 kFormatVersion = 1;
+
+// magic, version, visual sample rate, audio visual ratio, data size,
+// block size, block count
+const int kHeaderSize = 4 + 4 + 8 + 8 + 4 + 4 + 4;
+// offset, compressed size, checksum, reserved
+const int kIndexEntrySize = 4 + 4 + 2 + 2;
+
+// The bands of a data element in the order of their planes
+const int kPlaneCount = 4;
+
+// Same as for the legacy format in AnalysisDao
+const int kCompressionLevel = -1;
+
+// Rejects corrupt headers before the block size is used in any
+// calculations
+const quint32 kMaxBlockSize = 1 << 24;
+
+void appendUInt32(QByteArray* pData, quint32 value) {
+    uchar bytes[sizeof(value)];
+    qToLittleEndian(value, bytes);
+    pData->append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+void appendDouble(QByteArray* pData, double value) {
+    quint64 bits;
+    static_assert(sizeof(bits) == sizeof(value), "unexpected size of double");
+    std::memcpy(&bits, &value, sizeof(bits));
+    uchar bytes[sizeof(bits)];
+    qToLittleEndian(bits, bytes);
+    pData->append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+void writeUInt32(QByteArray* pData, int position, quint32 value) {
+    qToLittleEndian(value, reinterpret_cast<uchar*>(pData->data() + position));
+}
+
+quint16 readUInt16(const char* pData) {
+    return qFromLittleEndian<quint16>(reinterpret_cast<const uchar*>(pData));
+}
+
+quint32 readUInt32(const char* pData) {
+    return qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(pData));
+}
+
+double readDouble(const char* pData) {
+    const quint64 bits = qFromLittleEndian<quint64>(
+            reinterpret_cast<const uchar*>(pData));
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // anonymous namespace
+
+//static
+bool WaveformBlockFile::isBlockFile(const QByteArray& data) {
+    return data.size() >= kHeaderSize &&
+            std::memcmp(data.constData(), kMagic, sizeof(kMagic)) == 0;
+}
+
+//static
+QByteArray WaveformBlockFile::encode(const Waveform& waveform, int blockSize) {
+    VERIFY_OR_DEBUG_ASSERT(blockSize > 0) {
+        blockSize = kDefaultBlockSize;
+    }
+    const int dataSize = waveform.getDataSize();
+    const int blockCount = (dataSize + blockSize - 1) / blockSize;
+
+    QByteArray result;
+    result.append(kMagic, sizeof(kMagic));
+    appendUInt32(&result, kFormatVersion);
+    appendDouble(&result, waveform.getVisualSampleRate());
+    appendDouble(&result, waveform.getAudioVisualRatio());
+    appendUInt32(&result, dataSize);
+    appendUInt32(&result, blockSize);
+    appendUInt32(&result, blockCount);
+    const int indexPosition = result.size();
+    result.append(QByteArray(blockCount * kIndexEntrySize, '\0'));
+
+    QByteArray planes;
+    for (int block = 0; block < blockCount; ++block) {
+        const int start = block * blockSize;
+        const int length = math_min(blockSize, dataSize - start);
+        planes.resize(length * kPlaneCount);
+        char* pLow = planes.data();
+        char* pMid = pLow + length;
+        char* pHigh = pMid + length;
+        char* pAll = pHigh + length;
+        const WaveformData* pData = waveform.data() + start;
+        for (int i = 0; i < length; ++i) {
+            pLow[i] = static_cast<char>(pData[i].filtered.low);
+            pMid[i] = static_cast<char>(pData[i].filtered.mid);
+            pHigh[i] = static_cast<char>(pData[i].filtered.high);
+            pAll[i] = static_cast<char>(pData[i].filtered.all);
+        }
+        const QByteArray compressed = qCompress(planes, kCompressionLevel);
+
+        const int entryPosition = indexPosition + block * kIndexEntrySize;
+        writeUInt32(&result, entryPosition, result.size());
+        writeUInt32(&result, entryPosition + 4, compressed.size());
+        qToLittleEndian(
+                qChecksum(compressed.constData(), compressed.size()),
+                reinterpret_cast<uchar*>(result.data() + entryPosition + 8));
+        result.append(compressed);
+    }
+    return result;
+}
+
+//static
+QByteArray WaveformBlockFile::convertLegacyFormat(
+        const QByteArray& protobufData, int blockSize) {
+    const Waveform waveform(protobufData);
+    if (!waveform.isValid()) {
+        return QByteArray();
+    }
+    return encode(waveform, blockSize);
+}
+
+WaveformBlockFile::WaveformBlockFile()
+        : m_visualSampleRate(0),
+          m_audioVisualRatio(0),
+          m_dataSize(0),
+          m_blockSize(0),
+          m_checksum(0) {
+}
+
+WaveformBlockFile::WaveformBlockFile(
+        const QByteArray& data,
+        QSharedPointer<QFile> pMappedFile)
+        : WaveformBlockFile() {
+    if (!isBlockFile(data)) {
+        return;
+    }
+    const char* pHeader = data.constData();
+    const quint32 version = readUInt32(pHeader + 4);
+    if (version != kFormatVersion) {
+        qWarning() << "Unsupported waveform block file version" << version;
+        return;
+    }
+    const double visualSampleRate = readDouble(pHeader + 8);
+    const double audioVisualRatio = readDouble(pHeader + 16);
+    const quint32 dataSize = readUInt32(pHeader + 24);
+    const quint32 blockSize = readUInt32(pHeader + 28);
+    const quint32 blockCount = readUInt32(pHeader + 32);
+    if (dataSize == 0 || dataSize > static_cast<quint32>(INT_MAX / 2) ||
+            blockSize == 0 || blockSize > kMaxBlockSize ||
+            blockCount != (dataSize + blockSize - 1) / blockSize ||
+            static_cast<quint64>(blockCount) * kIndexEntrySize >
+                    static_cast<quint64>(data.size() - kHeaderSize)) {
+        qWarning() << "Corrupt waveform block file header";
+        return;
+    }
+    const int indexEnd = kHeaderSize + blockCount * kIndexEntrySize;
+
+    std::vector<BlockInfo> blocks(blockCount);
+    for (quint32 block = 0; block < blockCount; ++block) {
+        const char* pEntry = pHeader + kHeaderSize + block * kIndexEntrySize;
+        BlockInfo& info = blocks[block];
+        info.offset = readUInt32(pEntry);
+        info.compressedSize = readUInt32(pEntry + 4);
+        info.checksum = readUInt16(pEntry + 8);
+        if (info.offset < static_cast<quint32>(indexEnd) ||
+                static_cast<quint64>(info.offset) + info.compressedSize >
+                        static_cast<quint64>(data.size())) {
+            qWarning() << "Corrupt waveform block file index";
+            return;
+        }
+    }
+
+    m_data = data;
+    m_pMappedFile = std::move(pMappedFile);
+    m_visualSampleRate = visualSampleRate;
+    m_audioVisualRatio = audioVisualRatio;
+    m_dataSize = static_cast<int>(dataSize);
+    m_blockSize = static_cast<int>(blockSize);
+    m_checksum = qChecksum(pHeader, indexEnd);
+    m_blocks = std::move(blocks);
+}
+
+int WaveformBlockFile::blockLength(int block) const {
+    return math_min(m_blockSize, m_dataSize - blockStart(block));
+}
+
+bool WaveformBlockFile::decodeBlock(int block, WaveformData* pData) const {
+    VERIFY_OR_DEBUG_ASSERT(block >= 0 && block < blockCount()) {
+        return false;
+    }
+    const BlockInfo& info = m_blocks[block];
+    const char* pCompressed = m_data.constData() + info.offset;
+    if (qChecksum(pCompressed, info.compressedSize) != info.checksum) {
+        qWarning() << "Corrupt waveform block" << block;
+        return false;
+    }
+    const QByteArray planes = qUncompress(
+            reinterpret_cast<const uchar*>(pCompressed),
+            info.compressedSize);
+    const int length = blockLength(block);
+    if (planes.size() != length * kPlaneCount) {
+        qWarning() << "Corrupt waveform block" << block;
+        return false;
+    }
+    const uchar* pLow = reinterpret_cast<const uchar*>(planes.constData());
+    const uchar* pMid = pLow + length;
+    const uchar* pHigh = pMid + length;
+    const uchar* pAll = pHigh + length;
+    for (int i = 0; i < length; ++i) {
+        pData[i].filtered.low = pLow[i];
+        pData[i].filtered.mid = pMid[i];
+        pData[i].filtered.high = pHigh[i];
+        pData[i].filtered.all = pAll[i];
+    }
+    return true;
+}
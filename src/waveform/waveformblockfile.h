@@ -0,0 +1,110 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QSharedPointer>
+#include <vector>
+
+class Waveform;
+union WaveformData;
+
+// Chunked storage format for waveforms.
+//
+// The data elements of a waveform are split into blocks of a fixed number
+// of elements that are compressed independently. A small uncompressed
+// header contains the properties of the waveform and an index with the
+// offset, size and checksum of each block. Any block can be located and
+// decompressed without touching the remaining file, which allows to
+// memory map the file and to decode the region around the play position
+// first.
+//
+// Within a block the bands are stored as separate planes, i.e. all low
+// values followed by all mid, high and all values, which compresses
+// better than the interleaved representation in memory.
+//
+// All integers are stored in little endian byte order.
+class WaveformBlockFile {
+  public:
+    // 128 KiB of uncompressed data per block, i.e. ~37 s of audio at
+    // the visual sample rate of the main waveform.
+    static constexpr int kDefaultBlockSize = 32768;
+
+    // Returns true if data starts with the header of the block file format.
+    // Data without this header is considered to be in the legacy protobuf
+    // format.
+    static bool isBlockFile(const QByteArray& data);
+
+    static QByteArray encode(
+            const Waveform& waveform,
+            int blockSize = kDefaultBlockSize);
+
+    // Converts an uncompressed waveform in the legacy protobuf format.
+    // Returns an empty array if the data could not be parsed.
+    static QByteArray convertLegacyFormat(
+            const QByteArray& protobufData,
+            int blockSize = kDefaultBlockSize);
+
+    WaveformBlockFile();
+    // Parses the header and the block index. The blocks themselves are
+    // only accessed by decodeBlock(). If data refers to a memory mapped
+    // file pass the file to keep the mapping alive.
+    explicit WaveformBlockFile(
+            const QByteArray& data,
+            QSharedPointer<QFile> pMappedFile = QSharedPointer<QFile>());
+
+    bool isValid() const {
+        return m_dataSize > 0;
+    }
+
+    double visualSampleRate() const {
+        return m_visualSampleRate;
+    }
+    double audioVisualRatio() const {
+        return m_audioVisualRatio;
+    }
+    // The total number of data elements
+    int dataSize() const {
+        return m_dataSize;
+    }
+    // The number of data elements per block
+    int blockSize() const {
+        return m_blockSize;
+    }
+    int blockCount() const {
+        return static_cast<int>(m_blocks.size());
+    }
+
+    // The first data element of block and the number of elements in it.
+    // Only the last block might contain less than blockSize() elements.
+    int blockStart(int block) const {
+        return block * m_blockSize;
+    }
+    int blockLength(int block) const;
+
+    // The checksum of the header and the block index. The blocks are
+    // verified individually when decoded.
+    quint16 checksum() const {
+        return m_checksum;
+    }
+
+    // Decompresses all data elements of block into pData, which needs to
+    // provide room for blockLength(block) elements. Returns false if the
+    // block is corrupt.
+    bool decodeBlock(int block, WaveformData* pData) const;
+
+  private:
+    struct BlockInfo {
+        quint32 offset;
+        quint32 compressedSize;
+        quint16 checksum;
+    };
+
+    QByteArray m_data;
+    QSharedPointer<QFile> m_pMappedFile;
+    double m_visualSampleRate;
+    double m_audioVisualRatio;
+    int m_dataSize;
+    int m_blockSize;
+    quint16 m_checksum;
+    std::vector<BlockInfo> m_blocks;
+};
@@ -1,15 +1,53 @@
+#include <QtConcurrentRun>
 #include <QtDebug>
+#include <climits>
 
 #include "waveform/waveformfactory.h"
-#include "waveform/waveform.h"
+#include "waveform/waveformblockfile.h"
+
+namespace {
+
+// The priority block and its following neighbour
+const int kPriorityBlocks = 2;
+
+void decodeRemainingBlocks(QWeakPointer<Waveform> pWeakWaveform) {
+    while (WaveformPointer pWaveform = pWeakWaveform.toStrongRef()) {
+        if (!pWaveform->decodeBlocks(1)) {
+            return;
+        }
+    }
+}
+
+} // anonymous namespace
 
 // static
-Waveform* WaveformFactory::loadWaveformFromAnalysis(
-        const AnalysisDao::AnalysisInfo& analysis) {
-    Waveform* pWaveform = new Waveform(analysis.data);
+WaveformPointer WaveformFactory::loadWaveformFromAnalysis(
+        const AnalysisDao::AnalysisInfo& analysis,
+        double priorityPosition) {
+    if (!WaveformBlockFile::isBlockFile(analysis.data)) {
+        WaveformPointer pWaveform(new Waveform(analysis.data));
+        pWaveform->setId(analysis.analysisId);
+        pWaveform->setVersion(analysis.version);
+        pWaveform->setDescription(analysis.description);
+        return pWaveform;
+    }
+
+    const WaveformBlockFile blockFile(analysis.data, analysis.pMappedFile);
+    int priorityDataElement = 0;
+    if (blockFile.audioVisualRatio() > 0) {
+        priorityDataElement = static_cast<int>(
+                priorityPosition / blockFile.audioVisualRatio());
+    }
+    WaveformPointer pWaveform(new Waveform(blockFile, priorityDataElement));
     pWaveform->setId(analysis.analysisId);
     pWaveform->setVersion(analysis.version);
     pWaveform->setDescription(analysis.description);
+    // The overview needs to be complete from the beginning
+    const int blocks = analysis.type == AnalysisDao::TYPE_WAVESUMMARY
+            ? INT_MAX : kPriorityBlocks;
+    if (pWaveform->decodeBlocks(blocks)) {
+        QtConcurrent::run(decodeRemainingBlocks, pWaveform.toWeakRef());
+    }
     return pWaveform;
 }
 
@@ -20,6 +58,12 @@ WaveformFactory::VersionClass WaveformFactory::waveformVersionToVersionClass(con
         return VC_USE;
     }
 
+    if (version == WAVEFORM_5_VERSION) {
+        // keep for use with old Mixxx versions, converted into the
+        // current version by AnalysisDao
+        return VC_KEEP;
+    }
+
     if (version == WAVEFORM_4_VERSION) {
         // Used in Mixxx 1.12 beta, suffers Bug lp:1406389
         return VC_REMOVE;
@@ -46,6 +90,12 @@ WaveformFactory::VersionClass WaveformFactory::waveformSummaryVersionToVersionCl
         return VC_USE;
     }
 
+    if (version == WAVEFORMSUMMARY_5_VERSION) {
+        // keep for use with old Mixxx versions, converted into the
+        // current version by AnalysisDao
+        return VC_KEEP;
+    }
+
     if (version == WAVEFORMSUMMARY_4_VERSION) {
         // Used in Mixxx 1.12 beta, suffers Bug lp:1406389
         return VC_REMOVE;
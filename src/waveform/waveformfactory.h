@@ -2,8 +2,7 @@
 #define WAVEFORMFACTORY_H
 
 #include "library/dao/analysisdao.h"
-
-class Waveform;
+#include "waveform/waveform.h"
 
 #define WAVEFORM_2_VERSION "Waveform-2.0"
 #define WAVEFORMSUMMARY_2_VERSION "WaveformSummary-2.0"
@@ -28,10 +27,17 @@ class Waveform;
 #define WAVEFORM_5_DESCRIPTION "Waveform 5.0"
 #define WAVEFORMSUMMARY_5_DESCRIPTION "WaveformSummary 5.0"
 
-#define WAVEFORM_CURRENT_VERSION WAVEFORM_5_VERSION
-#define WAVEFORMSUMMARY_CURRENT_VERSION WAVEFORMSUMMARY_5_VERSION
-#define WAVEFORM_CURRENT_DESCRIPTION WAVEFORM_5_DESCRIPTION
-#define WAVEFORMSUMMARY_CURRENT_DESCRIPTION WAVEFORMSUMMARY_5_DESCRIPTION
+// Used from Mixxx 2.3, same data as version 5.0 stored in the block file
+// format that older versions can't read
+#define WAVEFORM_6_VERSION "Waveform-6.0"
+#define WAVEFORMSUMMARY_6_VERSION "WaveformSummary-6.0"
+#define WAVEFORM_6_DESCRIPTION "Waveform 6.0"
+#define WAVEFORMSUMMARY_6_DESCRIPTION "WaveformSummary 6.0"
+
+#define WAVEFORM_CURRENT_VERSION WAVEFORM_6_VERSION
+#define WAVEFORMSUMMARY_CURRENT_VERSION WAVEFORMSUMMARY_6_VERSION
+#define WAVEFORM_CURRENT_DESCRIPTION WAVEFORM_6_DESCRIPTION
+#define WAVEFORMSUMMARY_CURRENT_DESCRIPTION WAVEFORMSUMMARY_6_DESCRIPTION
 
 
 class WaveformFactory {
@@ -42,8 +48,13 @@ class WaveformFactory {
         VC_REMOVE
     };
 
-    static Waveform* loadWaveformFromAnalysis(
-            const AnalysisDao::AnalysisInfo& analysis);
+    // Waveforms in the block file format are returned as soon as the
+    // region around priorityPosition (in samples) has been decoded. The
+    // remaining blocks are decoded in the background until the waveform
+    // is discarded.
+    static WaveformPointer loadWaveformFromAnalysis(
+            const AnalysisDao::AnalysisInfo& analysis,
+            double priorityPosition = 0.0);
     static VersionClass waveformVersionToVersionClass(const QString& version);
     static VersionClass waveformSummaryVersionToVersionClass(const QString& version);
     static QString currentWaveformVersion();
@@ -0,0 +1,96 @@
+#include "waveform/waveformprefetcher.h"
+
+#include <QtConcurrentRun>
+
+#include "library/dao/analysisdao.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/db/dbconnectionpooler.h"
+#include "util/logger.h"
+#include "util/performancetimer.h"
+#include "waveform/waveformfactory.h"
+
+namespace {
+
+mixxx::Logger kLogger("WaveformPrefetcher");
+
+void loadStoredWaveforms(
+        UserSettingsPointer pConfig,
+        mixxx::DbConnectionPoolPtr pDbConnectionPool,
+        TrackPointer pTrack) {
+    PerformanceTimer timer;
+    timer.start();
+
+    // Each invocation runs on an arbitrary thread of the global
+    // thread pool and needs its own database connection.
+    const mixxx::DbConnectionPooler dbConnectionPooler(pDbConnectionPool);
+    if (!dbConnectionPooler.isPooling()) {
+        kLogger.warning()
+                << "Failed to obtain database connection for prefetching waveforms";
+        return;
+    }
+    QSqlDatabase dbConnection = mixxx::DbConnectionPooled(pDbConnectionPool);
+    AnalysisDao analysisDao(pConfig);
+    analysisDao.initialize(dbConnection);
+
+    bool missingWaveform = pTrack->getWaveform().isNull();
+    bool missingWaveformSummary = pTrack->getWaveformSummary().isNull();
+    const QList<AnalysisDao::AnalysisInfo> analyses =
+            analysisDao.getAnalysesForTrack(pTrack->getId());
+    for (const auto& analysis : analyses) {
+        if (missingWaveform &&
+                analysis.type == AnalysisDao::TYPE_WAVEFORM &&
+                WaveformFactory::waveformVersionToVersionClass(analysis.version) ==
+                        WaveformFactory::VC_USE) {
+            ConstWaveformPointer pWaveform(
+                    WaveformFactory::loadWaveformFromAnalysis(
+                            analysis, pTrack->getCuePoint().getPosition()));
+            // The analyzer might have been faster. Outdated analyses
+            // are left untouched and will be deleted by the analyzer.
+            if (pTrack->getWaveform().isNull()) {
+                pTrack->setWaveform(pWaveform);
+            }
+            missingWaveform = false;
+        }
+        if (missingWaveformSummary &&
+                analysis.type == AnalysisDao::TYPE_WAVESUMMARY &&
+                WaveformFactory::waveformSummaryVersionToVersionClass(analysis.version) ==
+                        WaveformFactory::VC_USE) {
+            ConstWaveformPointer pWaveformSummary(
+                    WaveformFactory::loadWaveformFromAnalysis(analysis));
+            if (pTrack->getWaveformSummary().isNull()) {
+                pTrack->setWaveformSummary(pWaveformSummary);
+            }
+            missingWaveformSummary = false;
+        }
+    }
+
+    kLogger.debug()
+            << "Loading stored waveforms of track"
+            << pTrack->getId()
+            << "took"
+            << timer.elapsed().formatMillisWithUnit();
+}
+
+} // anonymous namespace
+
+WaveformPrefetcher::WaveformPrefetcher(
+        UserSettingsPointer pConfig,
+        mixxx::DbConnectionPoolPtr pDbConnectionPool)
+        : m_pConfig(std::move(pConfig)),
+          m_pDbConnectionPool(std::move(pDbConnectionPool)) {
+}
+
+void WaveformPrefetcher::prefetch(TrackPointer pTrack) const {
+    if (!pTrack || !pTrack->getId().isValid()) {
+        return;
+    }
+    if (pTrack->getWaveform() && pTrack->getWaveformSummary()) {
+        return;
+    }
+    // The future is not needed, the results are stored in the track
+    QtConcurrent::run(
+            loadStoredWaveforms,
+            m_pConfig,
+            m_pDbConnectionPool,
+            std::move(pTrack));
+}
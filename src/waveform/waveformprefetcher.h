@@ -0,0 +1,30 @@
+#pragma once
+
+#include "preferences/usersettings.h"
+#include "track/track.h"
+#include "util/db/dbconnectionpool.h"
+
+// Loads the stored waveform and waveform summary of a track from the
+// database while the track is being loaded into a player.
+//
+// Without prefetching the stored waveforms are only loaded by the
+// analyzer after the audio source has been opened for playback and
+// the track has been handed over to the analyzer queue, where the
+// file is opened once again. Prefetching runs concurrently to opening
+// the audio source and the waveforms are usually available before the
+// player has finished loading.
+class WaveformPrefetcher {
+  public:
+    WaveformPrefetcher(
+            UserSettingsPointer pConfig,
+            mixxx::DbConnectionPoolPtr pDbConnectionPool);
+
+    // Returns immediately and loads the waveforms on a worker thread.
+    // Tracks that are not stored in the database or that already
+    // provide both waveforms are ignored.
+    void prefetch(TrackPointer pTrack) const;
+
+  private:
+    const UserSettingsPointer m_pConfig;
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+};
@@ -17,6 +17,7 @@
 #include "waveform/widgets/softwarewaveformwidget.h"
 #include "waveform/widgets/hsvwaveformwidget.h"
 #include "waveform/widgets/rgbwaveformwidget.h"
+#include "waveform/widgets/scanlinergbwaveformwidget.h"
 #include "waveform/widgets/qthsvwaveformwidget.h"
 #include "waveform/widgets/qtrgbwaveformwidget.h"
 #include "waveform/widgets/glrgbwaveformwidget.h"
@@ -79,7 +80,8 @@ WaveformWidgetAbstractHandle::WaveformWidgetAbstractHandle()
 WaveformWidgetHolder::WaveformWidgetHolder()
     : m_waveformWidget(NULL),
       m_waveformViewer(NULL),
-      m_skinContextCache(UserSettingsPointer(), QString()) {
+      m_skinContextCache(UserSettingsPointer(), QString()),
+      m_swapPending(false) {
 }
 
 WaveformWidgetHolder::WaveformWidgetHolder(WaveformWidgetAbstract* waveformWidget,
@@ -89,7 +91,8 @@ WaveformWidgetHolder::WaveformWidgetHolder(WaveformWidgetAbstract* waveformWidge
     : m_waveformWidget(waveformWidget),
       m_waveformViewer(waveformViewer),
       m_skinNodeCache(node.cloneNode()),
-      m_skinContextCache(&parentContext) {
+      m_skinContextCache(&parentContext),
+      m_swapPending(false) {
 }
 
 ///////////////////////////////////////////
@@ -111,6 +114,8 @@ WaveformWidgetFactory::WaveformWidgetFactory()
           m_pGuiTick(nullptr),
           m_pVisualsManager(nullptr),
           m_frameCnt(0),
+          m_renderedWaveformCnt(0),
+          m_skippedWaveformCnt(0),
           m_actualFrameRate(0),
           m_vSyncType(0),
           m_playMarkerPosition(WaveformWidgetRenderer::s_defaultPlayMarkerPosition) {
@@ -548,6 +553,11 @@ void WaveformWidgetFactory::setVisualGain(FilterIndex index, double gain) {
     m_visualGain[index] = gain;
     if (m_config)
         m_config->set(ConfigKey("[Waveform]","VisualGain_" + QString::number(index)), QString::number(m_visualGain[index]));
+
+    // The visual gain is not part of the frame state of the renderers
+    for (const auto& holder : m_waveformWidgetHolders) {
+        holder.m_waveformWidget->damageFrame();
+    }
 }
 
 double WaveformWidgetFactory::getVisualGain(FilterIndex index) const {
@@ -599,18 +609,27 @@ void WaveformWidgetFactory::render() {
     if (!m_skipRender) {
         if (m_type) {   // no regular updates for an empty waveform
             // next rendered frame is displayed after next buffer swap and than after VSync
-            QVarLengthArray<bool, 10> shouldRenderWaveforms(m_waveformWidgetHolders.size());
             for (std::size_t i = 0; i < m_waveformWidgetHolders.size(); i++) {
-                WaveformWidgetAbstract* pWaveformWidget = m_waveformWidgetHolders[i].m_waveformWidget;
+                WaveformWidgetHolder& holder = m_waveformWidgetHolders[i];
+                WaveformWidgetAbstract* pWaveformWidget = holder.m_waveformWidget;
+                holder.m_swapPending = false;
                 // Don't bother doing the pre-render work if we aren't going to
                 // render this widget.
-                bool shouldRender = shouldRenderWaveform(pWaveformWidget);
-                shouldRenderWaveforms[i] = shouldRender;
-                if (!shouldRender) {
+                if (!shouldRenderWaveform(pWaveformWidget)) {
+                    if (pWaveformWidget) {
+                        // The content is not preserved while hidden
+                        pWaveformWidget->damageFrame();
+                    }
                     continue;
                 }
                 // Calculate play position for the new Frame in following run
                 pWaveformWidget->preRender(m_vsyncThread);
+                // Idle widgets, e.g. of paused decks, keep their last frame
+                if (!pWaveformWidget->isFrameDamaged()) {
+                    ++m_skippedWaveformCnt;
+                    continue;
+                }
+                holder.m_swapPending = true;
             }
             //qDebug() << "prerender" << m_vsyncThread->elapsed();
 
@@ -619,10 +638,12 @@ void WaveformWidgetFactory::render() {
             // all render commands are delayed until the swap from the previous run is executed
             for (std::size_t i = 0; i < m_waveformWidgetHolders.size(); i++) {
                 WaveformWidgetAbstract* pWaveformWidget = m_waveformWidgetHolders[i].m_waveformWidget;
-                if (!shouldRenderWaveforms[i]) {
+                if (!m_waveformWidgetHolders[i].m_swapPending) {
                     continue;
                 }
                 pWaveformWidget->render();
+                pWaveformWidget->setFrameRendered();
+                ++m_renderedWaveformCnt;
                 //qDebug() << "render" << i << m_vsyncThread->elapsed();
             }
         }
@@ -641,9 +662,14 @@ void WaveformWidgetFactory::render() {
         mixxx::Duration timeCnt = m_time.elapsed();
         if (timeCnt > mixxx::Duration::fromSeconds(1)) {
             m_time.start();
-            m_frameCnt = m_frameCnt * 1000 / timeCnt.toIntegerMillis(); // latency correction
-            emit waveformMeasured(m_frameCnt, m_vsyncThread->droppedFrames());
+            const qint64 timeCntMillis = timeCnt.toIntegerMillis();
+            m_frameCnt = m_frameCnt * 1000 / timeCntMillis; // latency correction
+            emit waveformMeasured(m_frameCnt, m_vsyncThread->droppedFrames(),
+                    static_cast<int>(m_renderedWaveformCnt * 1000 / timeCntMillis),
+                    static_cast<int>(m_skippedWaveformCnt * 1000 / timeCntMillis));
             m_frameCnt = 0.0;
+            m_renderedWaveformCnt = 0;
+            m_skippedWaveformCnt = 0;
         }
     }
 
@@ -669,7 +695,10 @@ void WaveformWidgetFactory::swap() {
                 // unexposed window. Prevents continuous log spew of
                 // "QOpenGLContext::swapBuffers() called with non-exposed
                 // window, behavior is undefined" on Qt5. See Bug #1779487.
-                if (!shouldRenderWaveform(pWaveformWidget)) {
+                // Widgets that have not been rendered in this frame keep
+                // showing their previous frame.
+                if (!m_waveformWidgetHolders[i].m_swapPending ||
+                        !shouldRenderWaveform(pWaveformWidget)) {
                     continue;
                 }
                 QGLWidget* glw = dynamic_cast<QGLWidget*>(pWaveformWidget->getWidget());
@@ -816,6 +845,13 @@ void WaveformWidgetFactory::evaluateWidgets() {
             useOpenGLShaders = QtRGBWaveformWidget::useOpenGLShaders();
             developerOnly = QtRGBWaveformWidget::developerOnly();
             break;
+        case WaveformWidgetType::ScanlineRGBWaveform:
+            widgetName = ScanlineRGBWaveformWidget::getWaveformWidgetName();
+            useOpenGl = ScanlineRGBWaveformWidget::useOpenGl();
+            useOpenGles = ScanlineRGBWaveformWidget::useOpenGles();
+            useOpenGLShaders = ScanlineRGBWaveformWidget::useOpenGLShaders();
+            developerOnly = ScanlineRGBWaveformWidget::developerOnly();
+            break;
         default:
             DEBUG_ASSERT(!"Unexpected WaveformWidgetType");
             continue;
@@ -919,6 +955,9 @@ WaveformWidgetAbstract* WaveformWidgetFactory::createWaveformWidget(
         case WaveformWidgetType::QtRGBWaveform:
             widget = new QtRGBWaveformWidget(viewer->getGroup(), viewer);
             break;
+        case WaveformWidgetType::ScanlineRGBWaveform:
+            widget = new ScanlineRGBWaveformWidget(viewer->getGroup(), viewer);
+            break;
         default:
         //case WaveformWidgetType::SoftwareSimpleWaveform: TODO: (vrince)
         //case WaveformWidgetType::EmptyWaveform:
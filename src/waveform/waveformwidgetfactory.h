@@ -50,6 +50,8 @@ class WaveformWidgetHolder {
     WWaveformViewer* m_waveformViewer;
     QDomNode m_skinNodeCache;
     SkinContext m_skinContextCache;
+    // The widget has been rendered and needs to be swapped
+    bool m_swapPending;
 
     friend class WaveformWidgetFactory;
 };
@@ -121,7 +123,11 @@ class WaveformWidgetFactory : public QObject, public Singleton<WaveformWidgetFac
 
   signals:
     void waveformUpdateTick();
-    void waveformMeasured(float frameRate, int droppedFrames);
+    // Reports the measured frame rate and the number of waveform widgets
+    // per second that have been rendered or skipped, because nothing
+    // visible has changed since their last rendered frame.
+    void waveformMeasured(float frameRate, int droppedFrames,
+            int renderedWaveforms, int skippedWaveforms);
     void renderSpinnies(VSyncThread*);
     void swapSpinnies();
 
@@ -172,6 +178,8 @@ class WaveformWidgetFactory : public QObject, public Singleton<WaveformWidgetFac
     //Debug
     PerformanceTimer m_time;
     float m_frameCnt;
+    int m_renderedWaveformCnt;
+    int m_skippedWaveformCnt;
     double m_actualFrameRate;
     int m_vSyncType;
     double m_playMarkerPosition;
@@ -0,0 +1,41 @@
+#include "waveform/widgets/scanlinergbwaveformwidget.h"
+
+#include <QPainter>
+
+#include "waveform/renderers/waveformwidgetrenderer.h"
+#include "waveform/renderers/waveformrenderbackground.h"
+#include "waveform/renderers/waveformrendermark.h"
+#include "waveform/renderers/waveformrendermarkrange.h"
+#include "waveform/renderers/waveformrendererrgbscanline.h"
+#include "waveform/renderers/waveformrendererpreroll.h"
+#include "waveform/renderers/waveformrendererendoftrack.h"
+#include "waveform/renderers/waveformrenderbeat.h"
+
+ScanlineRGBWaveformWidget::ScanlineRGBWaveformWidget(const char* group, QWidget* parent)
+        : QWidget(parent),
+          WaveformWidgetAbstract(group) {
+    addRenderer<WaveformRenderBackground>();
+    addRenderer<WaveformRendererEndOfTrack>();
+    addRenderer<WaveformRendererPreroll>();
+    addRenderer<WaveformRenderMarkRange>();
+    addRenderer<WaveformRendererRGBScanline>();
+    addRenderer<WaveformRenderBeat>();
+    addRenderer<WaveformRenderMark>();
+
+    setAttribute(Qt::WA_NoSystemBackground);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    m_initSuccess = init();
+}
+
+ScanlineRGBWaveformWidget::~ScanlineRGBWaveformWidget() {
+}
+
+void ScanlineRGBWaveformWidget::castToQWidget() {
+    m_widget = static_cast<QWidget*>(this);
+}
+
+void ScanlineRGBWaveformWidget::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    draw(&painter, event);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QWidget>
+
+#include "waveformwidgetabstract.h"
+
+class ScanlineRGBWaveformWidget : public QWidget, public WaveformWidgetAbstract {
+    Q_OBJECT
+  public:
+    ~ScanlineRGBWaveformWidget() override;
+
+    WaveformWidgetType::Type getType() const override {
+        return WaveformWidgetType::ScanlineRGBWaveform;
+    }
+
+    static inline QString getWaveformWidgetName() { return tr("RGB (Scanline)"); }
+    static inline bool useOpenGl() { return false; }
+    static inline bool useOpenGles() { return false; }
+    static inline bool useOpenGLShaders() { return false; }
+    static inline bool developerOnly() { return false; }
+
+  protected:
+    void castToQWidget() override;
+    void paintEvent(QPaintEvent* event) override;
+
+  private:
+    ScanlineRGBWaveformWidget(const char* group, QWidget* parent);
+    friend class WaveformWidgetFactory;
+};
@@ -14,7 +14,8 @@ ControlWidgetConnection::ControlWidgetConnection(
         : m_pWidget(pBaseWidget),
           m_pValueTransformer(pTransformer) {
     m_pControl = new ControlProxy(key, this);
-    m_pControl->connectValueChanged(this, &ControlWidgetConnection::slotControlValueChanged);
+    // Widgets only need to display the latest value once per frame
+    m_pControl->connectValueChangedCoalesced(this, &ControlWidgetConnection::slotControlValueChanged);
 }
 
 void ControlWidgetConnection::setControlParameter(double parameter) {
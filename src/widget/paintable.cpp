@@ -53,6 +53,35 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
     if (!source.isSVG()) {
         m_pPixmap.reset(WPixmapStore::getPixmapNoCache(source.getPath(), scaleFactor));
     } else {
+#ifdef __APPLE__
+        // Apple does Retina scaling behind the scenes, so we also pass a
+        // Paintable::FIXED image. On the other targets, it is better to
+        // cache the pixmap. We do not do this for TILE and color schemas.
+        // which can result in a correct but possibly blurry picture at a
+        // Retina display. This can be fixed when switching to QT5
+        const bool rasterize = mode == TILE || WPixmapStore::willCorrectColors();
+#else
+        const bool rasterize = mode == TILE || mode == Paintable::FIXED ||
+                WPixmapStore::willCorrectColors();
+#endif
+        // Images that have been rasterized in advance or on a previous
+        // launch don't need to parse the SVG at all.
+        const QSharedPointer<SkinCache> pSkinCache =
+                rasterize ? WPixmapStore::skinCache() : QSharedPointer<SkinCache>();
+        if (rasterize) {
+            QImage image = WPixmapStore::prefetchedImage(source.getId(), scaleFactor);
+            if (image.isNull() && pSkinCache) {
+                image = pSkinCache->image(source.getId());
+            }
+            if (!image.isNull()) {
+                if (pSkinCache && !pSkinCache->contains(source.getId())) {
+                    pSkinCache->insertImage(source.getId(), image);
+                }
+                m_pPixmap.reset(new QPixmap(QPixmap::fromImage(image)));
+                return;
+            }
+        }
+
         auto pSvg = std::make_unique<QSvgRenderer>();
         if (!source.getSvgSourceData().isEmpty()) {
             // Call here the different overload for svg content
@@ -69,23 +98,13 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
             return;
         }
         m_pSvg.reset(pSvg.release());
-#ifdef __APPLE__
-        // Apple does Retina scaling behind the scenes, so we also pass a
-        // Paintable::FIXED image. On the other targets, it is better to
-        // cache the pixmap. We do not do this for TILE and color schemas.
-        // which can result in a correct but possibly blurry picture at a
-        // Retina display. This can be fixed when switching to QT5
-        if (mode == TILE || WPixmapStore::willCorrectColors()) {
-#else
-        if (mode == TILE || mode == Paintable::FIXED || WPixmapStore::willCorrectColors()) {
-#endif
+        if (rasterize) {
             // The SVG renderer doesn't directly support tiling, so we render
             // it to a pixmap which will then get tiled.
-            QImage copy_buffer(m_pSvg->defaultSize() * scaleFactor, QImage::Format_ARGB32);
-            copy_buffer.fill(0x00000000);  // Transparent black.
-            QPainter painter(&copy_buffer);
-            m_pSvg->render(&painter);
-            WPixmapStore::correctImageColors(&copy_buffer);
+            const QImage copy_buffer = WPixmapStore::renderSvg(m_pSvg.data(), scaleFactor);
+            if (pSkinCache) {
+                pSkinCache->insertImage(source.getId(), copy_buffer);
+            }
 
             m_pPixmap.reset(new QPixmap(copy_buffer.size()));
             m_pPixmap->convertFromImage(copy_buffer);
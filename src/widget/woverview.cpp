@@ -69,7 +69,10 @@ WOverview::WOverview(
           m_b(0.0),
           m_analyzerProgress(kAnalyzerProgressUnknown),
           m_trackLoaded(false),
-          m_scaleFactor(1.0) {
+          m_scaleFactor(1.0),
+          m_bWaveformLayerDirty(true),
+          m_bMarksLayerDirty(true),
+          m_marksLayerGain(0.0f) {
     m_endOfTrackControl = new ControlProxy(
             m_group, "end_of_track", this);
     m_endOfTrackControl->connectValueChanged(this, &WOverview::onEndOfTrackChange);
@@ -228,6 +231,8 @@ void WOverview::onConnectedControlChanged(double dParameter, double dValue) {
     int oldPositionSeconds = m_iPosSeconds;
     m_iPosSeconds = static_cast<int>(dParameter * m_trackSamplesControl->get());
     if ((m_bTimeRulerActive || m_pHoveredMark != nullptr) && oldPositionSeconds != m_iPosSeconds) {
+        // The time distance of the hovered cue is prerendered with the marks
+        m_bMarksLayerDirty = m_bMarksLayerDirty || m_pHoveredMark != nullptr;
         redraw = true;
     }
 
@@ -258,6 +263,7 @@ void WOverview::slotWaveformSummaryUpdated() {
         m_actualCompletion = 0;
         m_waveformPeak = -1.0;
         m_pixmapDone = false;
+        m_bWaveformLayerDirty = true;
 
         update();
     }
@@ -282,6 +288,7 @@ void WOverview::slotTrackLoaded(TrackPointer pTrack) {
     if (m_pCurrentTrack) {
         updateCues(m_pCurrentTrack->getCuePoints());
     }
+    m_bMarksLayerDirty = true;
     update();
 }
 
@@ -301,6 +308,8 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
     m_pixmapDone = false;
     m_trackLoaded = false;
     m_endOfTrack = false;
+    m_bWaveformLayerDirty = true;
+    m_bMarksLayerDirty = true;
 
     if (pNewTrack) {
         m_pCurrentTrack = pNewTrack;
@@ -321,6 +330,7 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
 void WOverview::onEndOfTrackChange(double v) {
     //qDebug() << "WOverview::onEndOfTrackChange()" << v;
     m_endOfTrack = v > 0.0;
+    m_bWaveformLayerDirty = true;
     update();
 }
 
@@ -336,15 +346,19 @@ void WOverview::onMarkChanged(double v) {
 void WOverview::onMarkRangeChange(double v) {
     Q_UNUSED(v);
     //qDebug() << "WOverview::onMarkRangeChange()" << v;
+    m_bMarksLayerDirty = true;
     update();
 }
 
 void WOverview::onRateRatioChange(double v) {
     Q_UNUSED(v);
+    // The durations of the mark ranges depend on the rate
+    m_bMarksLayerDirty = true;
     update();
 }
 
 void WOverview::updateCues(const QList<CuePointer> &loadedCues) {
+    m_bMarksLayerDirty = true;
     m_marksToRender.clear();
     for (CuePointer currentCue: loadedCues) {
         const WaveformMarkPointer pMark = m_marks.getHotCueMark(currentCue->getHotCue());
@@ -409,6 +423,7 @@ void WOverview::mouseMoveEvent(QMouseEvent* e) {
         return;
     }
 
+    const WaveformMarkPointer pPreviouslyHoveredMark = m_pHoveredMark;
     m_pHoveredMark.clear();
     // Without some padding, the user would only have a single pixel width that
     // would count as hovering over the WaveformMark.
@@ -436,6 +451,12 @@ void WOverview::mouseMoveEvent(QMouseEvent* e) {
         }
     }
 
+    if (m_pHoveredMark != pPreviouslyHoveredMark) {
+        // Labels are elided and the cue times are shown depending on
+        // the hovered mark.
+        m_bMarksLayerDirty = true;
+    }
+
     //qDebug() << "WOverview::mouseMoveEvent" << e->pos() << m_iPos;
     update();
 }
@@ -517,13 +538,15 @@ void WOverview::mousePressEvent(QMouseEvent* e) {
 void WOverview::slotCueMenuPopupAboutToHide() {
     m_bHotcueMenuShowing = false;
     m_pHoveredMark.clear();
+    m_bMarksLayerDirty = true;
     update();
 }
 
 void WOverview::leaveEvent(QEvent* pEvent) {
     Q_UNUSED(pEvent);
-    if (!m_bHotcueMenuShowing) {
+    if (!m_bHotcueMenuShowing && m_pHoveredMark) {
         m_pHoveredMark.clear();
+        m_bMarksLayerDirty = true;
     }
     m_bLeftClickDragging = false;
     m_bTimeRulerActive = false;
@@ -534,35 +557,75 @@ void WOverview::paintEvent(QPaintEvent* pEvent) {
     Q_UNUSED(pEvent);
     ScopedTimer t("WOverview::paintEvent");
 
-    QPainter painter(this);
-    painter.fillRect(rect(), m_qColorBackground);
-
-    if (!m_backgroundPixmap.isNull()) {
-        painter.drawPixmap(rect(), m_backgroundPixmap);
+    if (m_bWaveformLayerDirty ||
+            (!m_waveformSourceImage.isNull() &&
+                    (m_waveformImageScaled.isNull() ||
+                            m_diffGain != waveformDiffGain()))) {
+        renderWaveformLayer();
     }
 
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, m_waveformLayer);
+
     if (m_pCurrentTrack) {
         // Refer to util/ScopePainter.h to understand the semantics of
         // ScopePainter.
-        drawEndOfTrackBackground(&painter);
-        drawAxis(&painter);
-        drawWaveformPixmap(&painter);
+        drawPlayedOverlay(&painter);
         drawEndOfTrackFrame(&painter);
         drawAnalyzerProgress(&painter);
 
         double trackSamples = m_trackSamplesControl->get();
         if (m_trackLoaded && trackSamples > 0) {
             const float offset = 1.0f;
-            const float gain = static_cast<float>(length() - 2) / m_trackSamplesControl->get();
+            const float gain = static_cast<float>(length() - 2) / trackSamples;
 
-            drawRangeMarks(&painter, offset, gain);
-            drawMarks(&painter, offset, gain);
+            if (m_bMarksLayerDirty || m_marksLayerGain != gain) {
+                renderMarksLayer(offset, gain);
+            }
+            painter.drawPixmap(0, 0, m_marksLayer);
             drawPickupPosition(&painter);
             drawTimeRuler(&painter);
-            drawMarkLabels(&painter, offset, gain);
+            drawMarkLabels(&painter);
         }
     }
 }
+
+void WOverview::renderWaveformLayer() {
+    ScopedTimer t("WOverview::renderWaveformLayer");
+    m_waveformLayer = QPixmap(size() * m_devicePixelRatio);
+    m_waveformLayer.setDevicePixelRatio(m_devicePixelRatio);
+
+    QPainter painter(&m_waveformLayer);
+    painter.setFont(font());
+    painter.fillRect(rect(), m_qColorBackground);
+
+    if (!m_backgroundPixmap.isNull()) {
+        painter.drawPixmap(rect(), m_backgroundPixmap);
+    }
+
+    if (m_pCurrentTrack) {
+        drawEndOfTrackBackground(&painter);
+        drawAxis(&painter);
+        drawWaveformPixmap(&painter);
+    }
+    m_bWaveformLayerDirty = false;
+}
+
+void WOverview::renderMarksLayer(const float offset, const float gain) {
+    ScopedTimer t("WOverview::renderMarksLayer");
+    m_marksLayer = QPixmap(size() * m_devicePixelRatio);
+    m_marksLayer.setDevicePixelRatio(m_devicePixelRatio);
+    m_marksLayer.fill(Qt::transparent);
+
+    QPainter painter(&m_marksLayer);
+    painter.setFont(font());
+    drawRangeMarks(&painter, offset, gain);
+    drawMarks(&painter, offset, gain);
+    prerenderMarkRangeLabels(&painter, offset, gain);
+    m_marksLayerGain = gain;
+    m_bMarksLayerDirty = false;
+}
+
 void WOverview::drawEndOfTrackBackground(QPainter* pPainter) {
     if (m_endOfTrack) {
         PainterScope painterScope(pPainter);
@@ -582,19 +645,21 @@ void WOverview::drawAxis(QPainter* pPainter) {
     }
 }
 
-void WOverview::drawWaveformPixmap(QPainter* pPainter) {
+int WOverview::waveformDiffGain() const {
     WaveformWidgetFactory* widgetFactory = WaveformWidgetFactory::instance();
+    bool normalize = widgetFactory->isOverviewNormalized();
+    if (normalize && m_pixmapDone && m_waveformPeak > 1) {
+        return 255 - m_waveformPeak - 1;
+    } else {
+        const double visualGain = widgetFactory->getVisualGain(WaveformWidgetFactory::All);
+        return 255.0 - 255.0 / visualGain;
+    }
+}
+
+void WOverview::drawWaveformPixmap(QPainter* pPainter) {
     if (!m_waveformSourceImage.isNull()) {
         PainterScope painterScope(pPainter);
-        int diffGain;
-        bool normalize = widgetFactory->isOverviewNormalized();
-        if (normalize && m_pixmapDone && m_waveformPeak > 1) {
-            diffGain = 255 - m_waveformPeak - 1;
-        } else {
-            const double visualGain = widgetFactory->getVisualGain(WaveformWidgetFactory::All);
-            diffGain = 255.0 - 255.0 / visualGain;
-        }
-
+        const int diffGain = waveformDiffGain();
         if (m_diffGain != diffGain || m_waveformImageScaled.isNull()) {
             QRect sourceRect(0, diffGain, m_waveformSourceImage.width(), m_waveformSourceImage.height() - 2 * diffGain);
             QImage croppedImage = m_waveformSourceImage.copy(sourceRect);
@@ -609,14 +674,18 @@ void WOverview::drawWaveformPixmap(QPainter* pPainter) {
         }
 
         pPainter->drawImage(rect(), m_waveformImageScaled);
+    }
+}
 
+void WOverview::drawPlayedOverlay(QPainter* pPainter) {
+    if (!m_waveformSourceImage.isNull()) {
         // Overlay the played part of the overview-waveform with a skin defined color
         QColor playedOverlayColor = m_signalColors.getPlayedOverlayColor();
         if (playedOverlayColor.alpha() > 0) {
             if (m_orientation == Qt::Vertical) {
-                pPainter->fillRect(0, 0, m_waveformImageScaled.width(), m_iPlayPos, playedOverlayColor);
+                pPainter->fillRect(0, 0, width(), m_iPlayPos, playedOverlayColor);
             } else {
-                pPainter->fillRect(0, 0, m_iPlayPos, m_waveformImageScaled.height(), playedOverlayColor);
+                pPainter->fillRect(0, 0, m_iPlayPos, height(), playedOverlayColor);
             }
         }
     }
@@ -984,35 +1053,12 @@ void WOverview::drawTimeRuler(QPainter* pPainter) {
     }
 }
 
-void WOverview::drawMarkLabels(QPainter* pPainter, const float offset, const float gain) {
+void WOverview::prerenderMarkRangeLabels(QPainter* pPainter, const float offset, const float gain) {
     QFont markerFont = pPainter->font();
     markerFont.setPixelSize(m_iLabelFontSize * m_scaleFactor);
     QFontMetricsF fontMetrics(markerFont);
 
-    // Draw WaveformMark labels
-    for (const auto& pMark : m_marksToRender) {
-        if (m_pHoveredMark != nullptr && pMark != m_pHoveredMark) {
-            if (pMark->m_label.intersects(m_pHoveredMark->m_label)) {
-                continue;
-            }
-        }
-        if (m_bShowCueTimes &&
-                (pMark->m_label.intersects(m_cuePositionLabel) || pMark->m_label.intersects(m_cueTimeDistanceLabel))) {
-            continue;
-        }
-        if (pMark->m_label.intersects(m_timeRulerPositionLabel) || pMark->m_label.intersects(m_timeRulerDistanceLabel)) {
-            continue;
-        }
-
-        pMark->m_label.draw(pPainter);
-    }
-
-    if (m_bShowCueTimes) {
-        m_cuePositionLabel.draw(pPainter);
-        m_cueTimeDistanceLabel.draw(pPainter);
-    }
-
-    // draw duration of WaveformMarkRanges
+    // Prerender the durations of WaveformMarkRanges
     for (auto&& markRange : m_markRanges) {
         if (markRange.showDuration() && markRange.active() && markRange.visible()) {
             // Active mark ranges by definition have starts/ends that are not
@@ -1024,6 +1070,7 @@ void WOverview::drawMarkLabels(QPainter* pPainter, const float offset, const flo
             const qreal endPosition = offset + endValue * gain;
 
             if (startPosition < 0.0 && endPosition < 0.0) {
+                markRange.m_durationLabel.clear();
                 continue;
             }
             QString duration = mixxx::Duration::formatTime(
@@ -1042,7 +1089,37 @@ void WOverview::drawMarkLabels(QPainter* pPainter, const float offset, const flo
             QPointF durationBottomLeft(x, fontMetrics.height());
 
             markRange.m_durationLabel.prerender(durationBottomLeft, QPixmap(), duration, markerFont, m_labelTextColor, m_labelBackgroundColor, width(), getDevicePixelRatioF(this));
+        }
+    }
+}
+
+void WOverview::drawMarkLabels(QPainter* pPainter) {
+    // Draw WaveformMark labels
+    for (const auto& pMark : m_marksToRender) {
+        if (m_pHoveredMark != nullptr && pMark != m_pHoveredMark) {
+            if (pMark->m_label.intersects(m_pHoveredMark->m_label)) {
+                continue;
+            }
+        }
+        if (m_bShowCueTimes &&
+                (pMark->m_label.intersects(m_cuePositionLabel) || pMark->m_label.intersects(m_cueTimeDistanceLabel))) {
+            continue;
+        }
+        if (pMark->m_label.intersects(m_timeRulerPositionLabel) || pMark->m_label.intersects(m_timeRulerDistanceLabel)) {
+            continue;
+        }
+
+        pMark->m_label.draw(pPainter);
+    }
 
+    if (m_bShowCueTimes) {
+        m_cuePositionLabel.draw(pPainter);
+        m_cueTimeDistanceLabel.draw(pPainter);
+    }
+
+    // Draw the durations of WaveformMarkRanges
+    for (auto&& markRange : m_markRanges) {
+        if (markRange.showDuration() && markRange.active() && markRange.visible()) {
             if (!(markRange.m_durationLabel.intersects(m_cuePositionLabel) || markRange.m_durationLabel.intersects(m_cueTimeDistanceLabel) || markRange.m_durationLabel.intersects(m_timeRulerPositionLabel) || markRange.m_durationLabel.intersects(m_timeRulerDistanceLabel))) {
                 markRange.m_durationLabel.draw(pPainter);
             }
@@ -1115,6 +1192,8 @@ void WOverview::resizeEvent(QResizeEvent* pEvent) {
 
     m_waveformImageScaled = QImage();
     m_diffGain = 0;
+    m_bWaveformLayerDirty = true;
+    m_bMarksLayerDirty = true;
     Init();
 }
 
@@ -107,16 +107,24 @@ class WOverview : public WWidget, public TrackDropTarget {
     // Append the waveform overview pixmap according to available data
     // in waveform
     virtual bool drawNextPixmapPart() = 0;
+    // The static parts of the overview are rendered into cached layers that
+    // are only redrawn when their content changes and not on every change
+    // of the play position.
+    void renderWaveformLayer();
+    void renderMarksLayer(const float offset, const float gain);
+    int waveformDiffGain() const;
     void drawEndOfTrackBackground(QPainter* pPainter);
     void drawAxis(QPainter* pPainter);
     void drawWaveformPixmap(QPainter* pPainter);
+    void drawPlayedOverlay(QPainter* pPainter);
     void drawEndOfTrackFrame(QPainter* pPainter);
     void drawAnalyzerProgress(QPainter* pPainter);
     void drawRangeMarks(QPainter* pPainter, const float& offset, const float& gain);
     void drawMarks(QPainter* pPainter, const float offset, const float gain);
     void drawPickupPosition(QPainter* pPainter);
     void drawTimeRuler(QPainter* pPainter);
-    void drawMarkLabels(QPainter* pPainter, const float offset, const float gain);
+    void prerenderMarkRangeLabels(QPainter* pPainter, const float offset, const float gain);
+    void drawMarkLabels(QPainter* pPainter);
     void paintText(const QString& text, QPainter* pPainter);
     double samplePositionToSeconds(double sample);
     inline int valueToPosition(double value) const {
@@ -185,6 +193,15 @@ class WOverview : public WWidget, public TrackDropTarget {
     AnalyzerProgress m_analyzerProgress;
     bool m_trackLoaded;
     double m_scaleFactor;
+
+    // Background, axis and scaled waveform
+    QPixmap m_waveformLayer;
+    bool m_bWaveformLayerDirty;
+    // Mark ranges and mark lines. The labels are prerendered together with
+    // this layer but drawn on top of the play position.
+    QPixmap m_marksLayer;
+    bool m_bMarksLayerDirty;
+    float m_marksLayerGain;
 };
 
 #endif
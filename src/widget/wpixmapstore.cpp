@@ -2,15 +2,60 @@
 
 #include <QDir>
 #include <QString>
+#include <QtConcurrentRun>
 #include <QtDebug>
 
+#include "util/compatibility.h"
 #include "util/math.h"
+#include "util/timer.h"
 #include "skin/imgloader.h"
 
+namespace {
+
+// Loads a single image for WPixmapStore::prefetchImages() on a worker
+// thread. The result must be identical to what Paintable would create.
+// The loader is passed by value, because WPixmapStore::setLoader() might
+// replace the static loader while tasks are still running.
+QImage loadImage(
+        const QString& sourceId,
+        double scaleFactor,
+        QSharedPointer<ImgSource> pLoader,
+        QSharedPointer<SkinCache> pSkinCache,
+        QSharedPointer<QAtomicInt> pCanceled) {
+    if (atomicLoadRelaxed(*pCanceled)) {
+        // Not needed anymore
+        return QImage();
+    }
+    if (pSkinCache) {
+        QImage image = pSkinCache->image(sourceId);
+        if (!image.isNull()) {
+            return image;
+        }
+    }
+    PixmapSource source(sourceId);
+    if (!source.isSVG()) {
+        std::unique_ptr<QImage> pImage(pLoader->getImage(sourceId, scaleFactor));
+        return pImage ? *pImage : QImage();
+    }
+    QSvgRenderer svg;
+    if (!svg.load(sourceId)) {
+        return QImage();
+    }
+    // Paintable stores the image in the skin cache if it is actually
+    // used as a pixmap
+    return WPixmapStore::renderSvg(&svg, scaleFactor, pLoader.data());
+}
+
+} // anonymous namespace
+
 // static
 QHash<QString, WeakPaintablePointer> WPixmapStore::m_paintableCache;
 QSharedPointer<ImgSource> WPixmapStore::m_loader
         = QSharedPointer<ImgSource>(new ImgLoader());
+QSharedPointer<SkinCache> WPixmapStore::m_pSkinCache;
+QHash<QString, QFuture<QImage>> WPixmapStore::m_prefetchedImages;
+QSharedPointer<QAtomicInt> WPixmapStore::m_pPrefetchCanceled;
+double WPixmapStore::m_prefetchScaleFactor = 0.0;
 
 // static
 PaintablePointer WPixmapStore::getPaintable(PixmapSource source,
@@ -40,6 +85,10 @@ QPixmap* WPixmapStore::getPixmapNoCache(
         const QString& fileName,
         double scaleFactor) {
     QPixmap* pPixmap = nullptr;
+    const QImage prefetchedImage = prefetchedImage(fileName, scaleFactor);
+    if (!prefetchedImage.isNull()) {
+        return new QPixmap(QPixmap::fromImage(prefetchedImage));
+    }
     QImage* img = m_loader->getImage(fileName, scaleFactor);
     pPixmap = new QPixmap();
     pPixmap->convertFromImage(*img);
@@ -57,6 +106,8 @@ bool WPixmapStore::willCorrectColors() {
 };
 
 void WPixmapStore::setLoader(QSharedPointer<ImgSource> ld) {
+    // Prefetching uses the previous loader
+    clearPrefetchedImages();
     m_loader = ld;
 
     // We shouldn't hand out pointers to existing pixmaps anymore since our
@@ -64,3 +115,89 @@ void WPixmapStore::setLoader(QSharedPointer<ImgSource> ld) {
     // referring to them are destroyed.
     m_paintableCache.clear();
 }
+
+// static
+void WPixmapStore::setSkinCache(QSharedPointer<SkinCache> pSkinCache) {
+    m_pSkinCache = pSkinCache;
+}
+
+// static
+QSharedPointer<SkinCache> WPixmapStore::skinCache() {
+    return m_pSkinCache;
+}
+
+// static
+QImage WPixmapStore::renderSvg(QSvgRenderer* pSvg, double scaleFactor) {
+    return renderSvg(pSvg, scaleFactor, m_loader.data());
+}
+
+// static
+QImage WPixmapStore::renderSvg(
+        QSvgRenderer* pSvg,
+        double scaleFactor,
+        ImgSource* pLoader) {
+    QImage image(pSvg->defaultSize() * scaleFactor, QImage::Format_ARGB32);
+    image.fill(0x00000000);  // Transparent black.
+    QPainter painter(&image);
+    pSvg->render(&painter);
+    painter.end();
+    pLoader->correctImageColors(&image);
+    return image;
+}
+
+// static
+void WPixmapStore::prefetchImages(const QStringList& sourceIds, double scaleFactor) {
+    ScopedTimer timer("WPixmapStore::prefetchImages");
+    clearPrefetchedImages();
+    m_prefetchScaleFactor = scaleFactor;
+    m_pPrefetchCanceled = QSharedPointer<QAtomicInt>::create(0);
+    QStringList allSourceIds = sourceIds;
+    if (m_pSkinCache) {
+        // Decode the images of inline SVGs in parallel
+        allSourceIds.append(m_pSkinCache->keys());
+    }
+    for (const auto& sourceId : allSourceIds) {
+        if (m_prefetchedImages.contains(sourceId)) {
+            continue;
+        }
+        m_prefetchedImages.insert(
+                sourceId,
+                QtConcurrent::run(
+                        loadImage,
+                        sourceId,
+                        scaleFactor,
+                        m_loader,
+                        m_pSkinCache,
+                        m_pPrefetchCanceled));
+    }
+    qDebug() << "WPixmapStore: Prefetching" << m_prefetchedImages.size() << "images";
+}
+
+// static
+QImage WPixmapStore::prefetchedImage(const QString& sourceId, double scaleFactor) {
+    if (scaleFactor != m_prefetchScaleFactor) {
+        return QImage();
+    }
+    // The image might be requested again with a different draw mode
+    QFuture<QImage> future = m_prefetchedImages.value(sourceId);
+    if (future.isCanceled()) {
+        // Default constructed, i.e. not prefetched
+        return QImage();
+    }
+    return future.result();
+}
+
+// static
+void WPixmapStore::clearPrefetchedImages() {
+    if (m_pPrefetchCanceled) {
+        // Tasks that have not started yet return immediately
+        m_pPrefetchCanceled->storeRelease(1);
+        m_pPrefetchCanceled.clear();
+    }
+    // Running tasks might still access the skin cache and the loader,
+    // which both belong to the current skin
+    for (auto& future : m_prefetchedImages) {
+        future.waitForFinished();
+    }
+    m_prefetchedImages.clear();
+}
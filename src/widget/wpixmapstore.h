@@ -19,6 +19,8 @@
 #define WPIXMAPSTORE_H
 
 #include <QPixmap>
+#include <QAtomicInt>
+#include <QFuture>
 #include <QHash>
 #include <QSharedPointer>
 #include <QSvgRenderer>
@@ -30,6 +32,7 @@
 
 #include "skin/imgsource.h"
 #include "skin/pixmapsource.h"
+#include "skin/skincache.h"
 #include "widget/paintable.h"
 
 
@@ -47,9 +50,39 @@ class WPixmapStore {
     static void correctImageColors(QImage* p);
     static bool willCorrectColors();
 
+    // Pre-rasterized images of the current skin, might be null
+    static void setSkinCache(QSharedPointer<SkinCache> pSkinCache);
+    static QSharedPointer<SkinCache> skinCache();
+
+    // Renders the SVG into an image with the size scaled by scaleFactor
+    // and corrects its colors with the current loader.
+    static QImage renderSvg(QSvgRenderer* pSvg, double scaleFactor);
+    // Same as above with the given loader. Thread-safe.
+    static QImage renderSvg(
+            QSvgRenderer* pSvg,
+            double scaleFactor,
+            ImgSource* pLoader);
+
+    // Starts loading and rasterizing the given image files and all images
+    // of the skin cache on the global thread pool. Each source is
+    // identified by its PixmapSource::getId(). Must be invoked from the
+    // GUI thread like all other functions.
+    static void prefetchImages(const QStringList& sourceIds, double scaleFactor);
+    // Returns the prefetched image for the given source. Blocks until
+    // the image is ready. Returns a null image if the source has not been
+    // prefetched with the same scale factor or if it could not be loaded.
+    static QImage prefetchedImage(const QString& sourceId, double scaleFactor);
+    // Discards all prefetched images that have not been taken. Pending
+    // tasks are canceled and running tasks are waited for.
+    static void clearPrefetchedImages();
+
   private:
     static QHash<QString, WeakPaintablePointer> m_paintableCache;
     static QSharedPointer<ImgSource> m_loader;
+    static QSharedPointer<SkinCache> m_pSkinCache;
+    static QHash<QString, QFuture<QImage>> m_prefetchedImages;
+    static QSharedPointer<QAtomicInt> m_pPrefetchCanceled;
+    static double m_prefetchScaleFactor;
 };
 
 #endif
@@ -1560,16 +1560,15 @@ void WTrackTableView::slotImportTrackMetadataFromFileTags() {
         return;
     }
 
-    for (const QModelIndex& index : indices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            // The user has explicitly requested to reload metadata from the file
-            // to override the information within Mixxx! Custom cover art must be
-            // reloaded separately.
-            SoundSourceProxy(pTrack).updateTrackFromSource(
-                    SoundSourceProxy::ImportTrackMetadataMode::Again);
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
+        // The user has explicitly requested to reload metadata from the file
+        // to override the information within Mixxx! Custom cover art must be
+        // reloaded separately.
+        SoundSourceProxy(pTrack).updateTrackFromSource(
+                SoundSourceProxy::ImportTrackMetadataMode::Again);
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotExportTrackMetadataIntoFileTags() {
@@ -1643,12 +1642,11 @@ void WTrackTableView::slotClearPlayCount() {
         return;
     }
 
-    for (const QModelIndex& index : indices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->resetPlayCounter();
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
+        pTrack->resetPlayCounter();
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotPopulatePlaylistMenu() {
@@ -1950,15 +1948,16 @@ void WTrackTableView::slotScaleBpm(int scale) {
     }
 
     const QModelIndexList selectedTrackIndices = selectionModel()->selectedRows();
-    for (const auto& index : selectedTrackIndices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack && !pTrack->isBpmLocked()) {
+    const QList<TrackPointer> tracks = trackModel->getTracks(selectedTrackIndices);
+    for (const auto& pTrack : tracks) {
+        if (!pTrack->isBpmLocked()) {
             BeatsPointer pBeats = pTrack->getBeats();
             if (pBeats) {
                 pBeats->scale(static_cast<Beats::BPMScale>(scale));
             }
         }
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::lockBpm(bool lock) {
@@ -1969,12 +1968,11 @@ void WTrackTableView::lockBpm(bool lock) {
 
     const QModelIndexList selectedTrackIndices = selectionModel()->selectedRows();
     // TODO: This should be done in a thread for large selections
-    for (const auto& index : selectedTrackIndices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->setBpmLocked(lock);
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(selectedTrackIndices);
+    for (const auto& pTrack : tracks) {
+        pTrack->setBpmLocked(lock);
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotColorPicked(PredefinedColorPointer pColor) {
@@ -1985,12 +1983,11 @@ void WTrackTableView::slotColorPicked(PredefinedColorPointer pColor) {
 
     const QModelIndexList selectedTrackIndices = selectionModel()->selectedRows();
     // TODO: This should be done in a thread for large selections
-    for (const auto& index : selectedTrackIndices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->setColor(mixxx::RgbColor::fromQColor(pColor->m_defaultRgba));
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(selectedTrackIndices);
+    for (const auto& pTrack : tracks) {
+        pTrack->setColor(mixxx::RgbColor::fromQColor(pColor->m_defaultRgba));
     }
+    saveTracks(tracks);
 
     m_pMenu->hide();
 }
@@ -2003,12 +2000,13 @@ void WTrackTableView::slotClearBeats() {
 
     const QModelIndexList selectedTrackIndices = selectionModel()->selectedRows();
     // TODO: This should be done in a thread for large selections
-    for (const auto& index : selectedTrackIndices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack && !pTrack->isBpmLocked()) {
+    const QList<TrackPointer> tracks = trackModel->getTracks(selectedTrackIndices);
+    for (const auto& pTrack : tracks) {
+        if (!pTrack->isBpmLocked()) {
             pTrack->setBeats(BeatsPointer());
         }
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotClearMainCue() {
@@ -2019,12 +2017,11 @@ void WTrackTableView::slotClearMainCue() {
         return;
     }
 
-    for (const QModelIndex& index : indices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->removeCuesOfType(mixxx::CueType::MainCue);
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
+        pTrack->removeCuesOfType(mixxx::CueType::MainCue);
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotClearHotCues() {
@@ -2035,12 +2032,11 @@ void WTrackTableView::slotClearHotCues() {
         return;
     }
 
-    for (const QModelIndex& index : indices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->removeCuesOfType(mixxx::CueType::HotCue);
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
+        pTrack->removeCuesOfType(mixxx::CueType::HotCue);
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotClearIntroCue() {
@@ -2051,12 +2047,11 @@ void WTrackTableView::slotClearIntroCue() {
         return;
     }
 
-    for (const QModelIndex& index : indices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->removeCuesOfType(mixxx::CueType::Intro);
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
+        pTrack->removeCuesOfType(mixxx::CueType::Intro);
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotClearOutroCue() {
@@ -2067,12 +2062,11 @@ void WTrackTableView::slotClearOutroCue() {
         return;
     }
 
-    for (const QModelIndex& index : indices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->removeCuesOfType(mixxx::CueType::Outro);
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
+        pTrack->removeCuesOfType(mixxx::CueType::Outro);
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotClearLoop() {
@@ -2083,12 +2077,11 @@ void WTrackTableView::slotClearLoop() {
         return;
     }
 
-    for (const QModelIndex& index : indices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->removeCuesOfType(mixxx::CueType::Loop);
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
+        pTrack->removeCuesOfType(mixxx::CueType::Loop);
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotClearKey() {
@@ -2099,12 +2092,11 @@ void WTrackTableView::slotClearKey() {
         return;
     }
 
-    for (const QModelIndex& index : indices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->resetKeys();
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
+        pTrack->resetKeys();
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotClearReplayGain() {
@@ -2115,12 +2107,11 @@ void WTrackTableView::slotClearReplayGain() {
         return;
     }
 
-    for (const QModelIndex& index : indices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->setReplayGain(mixxx::ReplayGain());
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
+        pTrack->setReplayGain(mixxx::ReplayGain());
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotClearWaveform() {
@@ -2131,17 +2122,21 @@ void WTrackTableView::slotClearWaveform() {
 
     AnalysisDao& analysisDao = m_pTrackCollectionManager->internalCollection()->getAnalysisDAO();
     const QModelIndexList indices = selectionModel()->selectedRows();
-    for (const QModelIndex& index : indices) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (!pTrack) {
-            continue;
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
         analysisDao.deleteAnalysesForTrack(pTrack->getId());
         pTrack->setWaveform(WaveformPointer());
         pTrack->setWaveformSummary(WaveformPointer());
     }
 }
 
+void WTrackTableView::saveTracks(const QList<TrackPointer>& tracks) {
+    // Save all modified tracks at once within a single database
+    // transaction instead of saving them individually when they
+    // are evicted from the cache.
+    m_pTrackCollectionManager->saveTracks(tracks);
+}
+
 void WTrackTableView::slotClearAllMetadata() {
     slotClearBeats();
     slotClearMainCue();
@@ -2160,12 +2155,11 @@ void WTrackTableView::slotCoverInfoSelected(const CoverInfoRelative& coverInfo)
         return;
     }
     const QModelIndexList selection = selectionModel()->selectedRows();
-    for (const QModelIndex& index : selection) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            pTrack->setCoverInfo(coverInfo);
-        }
+    const QList<TrackPointer> tracks = trackModel->getTracks(selection);
+    for (const auto& pTrack : tracks) {
+        pTrack->setCoverInfo(coverInfo);
     }
+    saveTracks(tracks);
 }
 
 void WTrackTableView::slotReloadCoverArt() {
@@ -2173,14 +2167,8 @@ void WTrackTableView::slotReloadCoverArt() {
     if (trackModel == nullptr) {
         return;
     }
-    QList<TrackPointer> selectedTracks;
     const QModelIndexList selection = selectionModel()->selectedRows();
-    for (const QModelIndex& index : selection) {
-        TrackPointer pTrack = trackModel->getTrack(index);
-        if (pTrack) {
-            selectedTracks.append(pTrack);
-        }
-    }
+    const QList<TrackPointer> selectedTracks = trackModel->getTracks(selection);
     CoverArtCache* pCache = CoverArtCache::instance();
     if (pCache) {
         pCache->requestGuessCovers(selectedTracks);
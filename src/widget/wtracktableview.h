@@ -116,6 +116,7 @@ class WTrackTableView : public WLibraryTableView {
     void dragEnterEvent(QDragEnterEvent * event) override;
     void dropEvent(QDropEvent * event) override;
     void lockBpm(bool lock);
+    void saveTracks(const QList<TrackPointer>& tracks);
 
     void enableCachedOnly();
     void selectionChanged(const QItemSelection &selected,